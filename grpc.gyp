@@ -361,6 +361,7 @@
         'absl/container:flat_hash_set',
         'absl/container:inlined_vector',
         'absl/functional:bind_front',
+        'absl/functional:function_ref',
         'absl/hash:hash',
         'absl/meta:type_traits',
         'absl/status:statusor',
@@ -395,6 +396,7 @@
         'src/core/ext/filters/client_channel/lb_policy/grpclb/grpclb_balancer_addresses.cc',
         'src/core/ext/filters/client_channel/lb_policy/grpclb/grpclb_client_stats.cc',
         'src/core/ext/filters/client_channel/lb_policy/grpclb/load_balancer_api.cc',
+        'src/core/ext/filters/client_channel/lb_policy/least_request/least_request.cc',
         'src/core/ext/filters/client_channel/lb_policy/oob_backend_metric.cc',
         'src/core/ext/filters/client_channel/lb_policy/outlier_detection/outlier_detection.cc',
         'src/core/ext/filters/client_channel/lb_policy/pick_first/pick_first.cc',
@@ -402,6 +404,10 @@
         'src/core/ext/filters/client_channel/lb_policy/ring_hash/ring_hash.cc',
         'src/core/ext/filters/client_channel/lb_policy/rls/rls.cc',
         'src/core/ext/filters/client_channel/lb_policy/round_robin/round_robin.cc',
+        'src/core/ext/filters/client_channel/lb_policy/subsetting/deterministic_subset.cc',
+        'src/core/ext/filters/client_channel/lb_policy/subsetting/deterministic_subsetting.cc',
+        'src/core/ext/filters/client_channel/lb_policy/weighted_round_robin/static_stride_scheduler.cc',
+        'src/core/ext/filters/client_channel/lb_policy/weighted_round_robin/weighted_round_robin.cc',
         'src/core/ext/filters/client_channel/lb_policy/weighted_target/weighted_target.cc',
         'src/core/ext/filters/client_channel/lb_policy/xds/cds.cc',
         'src/core/ext/filters/client_channel/lb_policy/xds/xds_cluster_impl.cc',
@@ -435,6 +441,7 @@
         'src/core/ext/filters/deadline/deadline_filter.cc',
         'src/core/ext/filters/fault_injection/fault_injection_filter.cc',
         'src/core/ext/filters/fault_injection/service_config_parser.cc',
+        'src/core/ext/filters/fused/fused_filters.cc',
         'src/core/ext/filters/http/client/http_client_filter.cc',
         'src/core/ext/filters/http/client_authority_filter.cc',
         'src/core/ext/filters/http/http_filters_plugin.cc',
@@ -776,6 +783,7 @@
         'src/core/lib/address_utils/parse_address.cc',
         'src/core/lib/address_utils/sockaddr_utils.cc',
         'src/core/lib/backoff/backoff.cc',
+        'src/core/lib/channel/call_timeline.cc',
         'src/core/lib/channel/channel_args.cc',
         'src/core/lib/channel/channel_args_preconditioning.cc',
         'src/core/lib/channel/channel_stack.cc',
@@ -791,6 +799,7 @@
         'src/core/lib/compression/compression_internal.cc',
         'src/core/lib/compression/message_compress.cc',
         'src/core/lib/config/core_configuration.cc',
+        'src/core/lib/debug/latency_histogram.cc',
         'src/core/lib/debug/stats.cc',
         'src/core/lib/debug/stats_data.cc',
         'src/core/lib/debug/trace.cc',
@@ -887,8 +896,12 @@
         'src/core/lib/iomgr/work_serializer.cc',
         'src/core/lib/json/json_reader.cc',
         'src/core/lib/json/json_util.cc',
+        'src/core/lib/json/json_view.cc',
         'src/core/lib/json/json_writer.cc',
         'src/core/lib/matchers/matchers.cc',
+        'src/core/lib/profiling/contention_profiler.cc',
+        'src/core/lib/profiling/sampling_countdown.cc',
+        'src/core/lib/profiling/trace_point.cc',
         'src/core/lib/promise/activity.cc',
         'src/core/lib/promise/sleep.cc',
         'src/core/lib/resolver/resolver.cc',
@@ -906,6 +919,7 @@
         'src/core/lib/security/authorization/grpc_server_authz_filter.cc',
         'src/core/lib/security/authorization/matchers.cc',
         'src/core/lib/security/authorization/rbac_policy.cc',
+        'src/core/lib/security/authorization/rbac_program.cc',
         'src/core/lib/security/context/security_context.cc',
         'src/core/lib/security/credentials/alts/alts_credentials.cc',
         'src/core/lib/security/credentials/alts/check_gcp_environment.cc',
@@ -1070,6 +1084,7 @@
         'test/core/util/test_tcp_server.cc',
         'test/core/util/tls_utils.cc',
         'test/core/util/tracer_util.cc',
+        'test/core/util/trickle_endpoint.cc',
       ],
     },
     {
@@ -1103,6 +1118,7 @@
         'test/core/util/test_config.cc',
         'test/core/util/test_tcp_server.cc',
         'test/core/util/tracer_util.cc',
+        'test/core/util/trickle_endpoint.cc',
       ],
     },
     {
@@ -1114,6 +1130,7 @@
         'absl/container:flat_hash_set',
         'absl/container:inlined_vector',
         'absl/functional:bind_front',
+        'absl/functional:function_ref',
         'absl/hash:hash',
         'absl/meta:type_traits',
         'absl/status:statusor',
@@ -1148,6 +1165,7 @@
         'src/core/ext/filters/client_channel/lb_policy/grpclb/grpclb_balancer_addresses.cc',
         'src/core/ext/filters/client_channel/lb_policy/grpclb/grpclb_client_stats.cc',
         'src/core/ext/filters/client_channel/lb_policy/grpclb/load_balancer_api.cc',
+        'src/core/ext/filters/client_channel/lb_policy/least_request/least_request.cc',
         'src/core/ext/filters/client_channel/lb_policy/oob_backend_metric.cc',
         'src/core/ext/filters/client_channel/lb_policy/outlier_detection/outlier_detection.cc',
         'src/core/ext/filters/client_channel/lb_policy/pick_first/pick_first.cc',
@@ -1155,6 +1173,10 @@
         'src/core/ext/filters/client_channel/lb_policy/ring_hash/ring_hash.cc',
         'src/core/ext/filters/client_channel/lb_policy/rls/rls.cc',
         'src/core/ext/filters/client_channel/lb_policy/round_robin/round_robin.cc',
+        'src/core/ext/filters/client_channel/lb_policy/subsetting/deterministic_subset.cc',
+        'src/core/ext/filters/client_channel/lb_policy/subsetting/deterministic_subsetting.cc',
+        'src/core/ext/filters/client_channel/lb_policy/weighted_round_robin/static_stride_scheduler.cc',
+        'src/core/ext/filters/client_channel/lb_policy/weighted_round_robin/weighted_round_robin.cc',
         'src/core/ext/filters/client_channel/lb_policy/weighted_target/weighted_target.cc',
         'src/core/ext/filters/client_channel/lb_policy_registry.cc',
         'src/core/ext/filters/client_channel/local_subchannel_pool.cc',
@@ -1182,6 +1204,7 @@
         'src/core/ext/filters/deadline/deadline_filter.cc',
         'src/core/ext/filters/fault_injection/fault_injection_filter.cc',
         'src/core/ext/filters/fault_injection/service_config_parser.cc',
+        'src/core/ext/filters/fused/fused_filters.cc',
         'src/core/ext/filters/http/client/http_client_filter.cc',
         'src/core/ext/filters/http/client_authority_filter.cc',
         'src/core/ext/filters/http/http_filters_plugin.cc',
@@ -1235,6 +1258,7 @@
         'src/core/lib/address_utils/parse_address.cc',
         'src/core/lib/address_utils/sockaddr_utils.cc',
         'src/core/lib/backoff/backoff.cc',
+        'src/core/lib/channel/call_timeline.cc',
         'src/core/lib/channel/channel_args.cc',
         'src/core/lib/channel/channel_args_preconditioning.cc',
         'src/core/lib/channel/channel_stack.cc',
@@ -1250,6 +1274,7 @@
         'src/core/lib/compression/compression_internal.cc',
         'src/core/lib/compression/message_compress.cc',
         'src/core/lib/config/core_configuration.cc',
+        'src/core/lib/debug/latency_histogram.cc',
         'src/core/lib/debug/stats.cc',
         'src/core/lib/debug/stats_data.cc',
         'src/core/lib/debug/trace.cc',
@@ -1345,7 +1370,11 @@
         'src/core/lib/iomgr/work_serializer.cc',
         'src/core/lib/json/json_reader.cc',
         'src/core/lib/json/json_util.cc',
+        'src/core/lib/json/json_view.cc',
         'src/core/lib/json/json_writer.cc',
+        'src/core/lib/profiling/contention_profiler.cc',
+        'src/core/lib/profiling/sampling_countdown.cc',
+        'src/core/lib/profiling/trace_point.cc',
         'src/core/lib/promise/activity.cc',
         'src/core/lib/promise/sleep.cc',
         'src/core/lib/resolver/resolver.cc',
@@ -28,6 +28,7 @@
 #include <set>
 #include <vector>
 
+#include "absl/base/attributes.h"
 #include "absl/container/inlined_vector.h"
 #include "absl/memory/memory.h"
 #include "absl/status/status.h"
@@ -63,6 +64,7 @@
 #include "src/core/ext/filters/client_channel/subchannel_interface.h"
 #include "src/core/ext/filters/client_channel/subchannel_interface_internal.h"
 #include "src/core/ext/filters/deadline/deadline_filter.h"
+#include "src/core/lib/channel/call_timeline.h"
 #include "src/core/lib/channel/channel_args.h"
 #include "src/core/lib/channel/channel_stack.h"
 #include "src/core/lib/channel/channel_trace.h"
@@ -76,6 +78,7 @@
 #include "src/core/lib/iomgr/pollset_set.h"
 #include "src/core/lib/iomgr/work_serializer.h"
 #include "src/core/lib/json/json.h"
+#include "src/core/lib/profiling/contention_profiler.h"
 #include "src/core/lib/profiling/timers.h"
 #include "src/core/lib/resolver/resolver_registry.h"
 #include "src/core/lib/resolver/server_address.h"
@@ -103,6 +106,14 @@ TraceFlag grpc_client_channel_trace(false, "client_channel");
 TraceFlag grpc_client_channel_call_trace(false, "client_channel_call");
 TraceFlag grpc_client_channel_lb_call_trace(false, "client_channel_lb_call");
 
+namespace {
+
+// Contention on the data plane mutexes of all channels.
+ABSL_CONST_INIT ContentionSite g_data_plane_mu_contention(
+    "ClientChannel::data_plane_mu_");
+
+}  // namespace
+
 //
 // ClientChannel::CallData definition
 //
@@ -1303,10 +1314,13 @@ void ClientChannel::OnResolverResultChangedLocked(Resolver::Result result) {
     // Choose LB policy config.
     RefCountedPtr<LoadBalancingPolicy::Config> lb_policy_config =
         ChooseLbPolicy(result, parsed_service_config);
-    // Check if the ServiceConfig has changed.
+    // Check if the ServiceConfig has changed. Resolvers that keep returning
+    // the same config usually return the very same object.
     const bool service_config_changed =
         saved_service_config_ == nullptr ||
-        service_config->json_string() != saved_service_config_->json_string();
+        (service_config != saved_service_config_ &&
+         service_config->json_string() !=
+             saved_service_config_->json_string());
     // Check if the ConfigSelector has changed.
     const bool config_selector_changed = !ConfigSelector::Equals(
         saved_config_selector_.get(), config_selector.get());
@@ -1630,7 +1644,8 @@ void ClientChannel::UpdateStateAndPickerLocked(
   }
   // Grab data plane lock to update the picker.
   {
-    MutexLock lock(&data_plane_mu_);
+    ProfiledMutexLock lock(&data_plane_mu_, &g_data_plane_mu_contention,
+                           DEBUG_LOCATION);
     // Swap out the picker.
     // Note: Original value will be destroyed after the lock is released.
     picker_.swap(picker);
@@ -1694,7 +1709,8 @@ grpc_error_handle ClientChannel::DoPingLocked(grpc_transport_op* op) {
   }
   LoadBalancingPolicy::PickResult result;
   {
-    MutexLock lock(&data_plane_mu_);
+    ProfiledMutexLock lock(&data_plane_mu_, &g_data_plane_mu_contention,
+                           DEBUG_LOCATION);
     result = picker_->Pick(LoadBalancingPolicy::PickArgs());
   }
   return HandlePickResult<grpc_error_handle>(
@@ -2208,6 +2224,8 @@ void ClientChannel::CallData::MaybeRemoveCallFromResolverQueuedCallsLocked(
   }
   chand->RemoveResolverQueuedCall(&resolver_queued_call_, pollent_);
   queued_pending_resolver_result_ = false;
+  CallTimeline* timeline = CallTimeline::FromContext(call_context_);
+  if (timeline != nullptr) timeline->Mark(CallTimeline::Event::kResolverDone);
   // Lame the call combiner canceller.
   resolver_call_canceller_ = nullptr;
 }
@@ -2221,6 +2239,10 @@ void ClientChannel::CallData::MaybeAddCallToResolverQueuedCallsLocked(
             chand, this);
   }
   queued_pending_resolver_result_ = true;
+  CallTimeline* timeline = CallTimeline::FromContext(call_context_);
+  if (timeline != nullptr) {
+    timeline->Mark(CallTimeline::Event::kResolverQueued);
+  }
   resolver_queued_call_.elem = elem;
   chand->AddResolverQueuedCall(&resolver_queued_call_, pollent_);
   // Register call combiner cancellation callback.
@@ -3075,7 +3097,8 @@ class ClientChannel::LoadBalancedCall::LbQueuedCallCanceller {
     auto* lb_call = self->lb_call_.get();
     auto* chand = lb_call->chand_;
     {
-      MutexLock lock(&chand->data_plane_mu_);
+      ProfiledMutexLock lock(&chand->data_plane_mu_,
+                             &g_data_plane_mu_contention, DEBUG_LOCATION);
       if (GRPC_TRACE_FLAG_ENABLED(grpc_client_channel_lb_call_trace)) {
         gpr_log(GPR_INFO,
                 "chand=%p lb_call=%p: cancelling queued pick: "
@@ -3108,6 +3131,8 @@ void ClientChannel::LoadBalancedCall::MaybeRemoveCallFromLbQueuedCallsLocked() {
   }
   chand_->RemoveLbQueuedCall(&queued_call_, pollent_);
   queued_pending_lb_pick_ = false;
+  CallTimeline* timeline = CallTimeline::FromContext(call_context_);
+  if (timeline != nullptr) timeline->Mark(CallTimeline::Event::kLbPickDone);
   // Lame the call combiner canceller.
   lb_call_canceller_ = nullptr;
 }
@@ -3119,6 +3144,8 @@ void ClientChannel::LoadBalancedCall::MaybeAddCallToLbQueuedCallsLocked() {
             chand_, this);
   }
   queued_pending_lb_pick_ = true;
+  CallTimeline* timeline = CallTimeline::FromContext(call_context_);
+  if (timeline != nullptr) timeline->Mark(CallTimeline::Event::kLbPickQueued);
   queued_call_.lb_call = this;
   chand_->AddLbQueuedCall(&queued_call_, pollent_);
   // Register call combiner cancellation callback.
@@ -3152,7 +3179,8 @@ void ClientChannel::LoadBalancedCall::PickSubchannel(void* arg,
   auto* self = static_cast<LoadBalancedCall*>(arg);
   bool pick_complete;
   {
-    MutexLock lock(&self->chand_->data_plane_mu_);
+    ProfiledMutexLock lock(&self->chand_->data_plane_mu_,
+                           &g_data_plane_mu_contention, DEBUG_LOCATION);
     pick_complete = self->PickSubchannelLocked(&error);
   }
   if (pick_complete) {
@@ -22,10 +22,20 @@
 
 #include <utility>
 
+#include "absl/base/attributes.h"
+
 #include "src/core/ext/filters/client_channel/subchannel.h"
+#include "src/core/lib/gprpp/debug_location.h"
+#include "src/core/lib/profiling/contention_profiler.h"
 
 namespace grpc_core {
 
+namespace {
+
+ABSL_CONST_INIT ContentionSite g_mu_contention("GlobalSubchannelPool::mu_");
+
+}  // namespace
+
 RefCountedPtr<GlobalSubchannelPool> GlobalSubchannelPool::instance() {
   static GlobalSubchannelPool* p = new GlobalSubchannelPool();
   return p->Ref();
@@ -33,19 +43,19 @@ RefCountedPtr<GlobalSubchannelPool> GlobalSubchannelPool::instance() {
 
 RefCountedPtr<Subchannel> GlobalSubchannelPool::RegisterSubchannel(
     const SubchannelKey& key, RefCountedPtr<Subchannel> constructed) {
-  MutexLock lock(&mu_);
-  auto it = subchannel_map_.find(key);
-  if (it != subchannel_map_.end()) {
-    RefCountedPtr<Subchannel> existing = it->second->RefIfNonZero();
+  ProfiledMutexLock lock(&mu_, &g_mu_contention, DEBUG_LOCATION);
+  Subchannel*& registered = subchannel_map_[key];
+  if (registered != nullptr) {
+    RefCountedPtr<Subchannel> existing = registered->RefIfNonZero();
     if (existing != nullptr) return existing;
   }
-  subchannel_map_[key] = constructed.get();
+  registered = constructed.get();
   return constructed;
 }
 
 void GlobalSubchannelPool::UnregisterSubchannel(const SubchannelKey& key,
                                                 Subchannel* subchannel) {
-  MutexLock lock(&mu_);
+  ProfiledMutexLock lock(&mu_, &g_mu_contention, DEBUG_LOCATION);
   auto it = subchannel_map_.find(key);
   // delete only if key hasn't been re-registered to a different subchannel
   // between strong-unreffing and unregistration of subchannel.
@@ -56,7 +66,7 @@ void GlobalSubchannelPool::UnregisterSubchannel(const SubchannelKey& key,
 
 RefCountedPtr<Subchannel> GlobalSubchannelPool::FindSubchannel(
     const SubchannelKey& key) {
-  MutexLock lock(&mu_);
+  ProfiledMutexLock lock(&mu_, &g_mu_contention, DEBUG_LOCATION);
   auto it = subchannel_map_.find(key);
   if (it == subchannel_map_.end()) return nullptr;
   return it->second->RefIfNonZero();
@@ -21,9 +21,8 @@
 
 #include <grpc/support/port_platform.h>
 
-#include <map>
-
 #include "absl/base/thread_annotations.h"
+#include "absl/container/flat_hash_map.h"
 
 #include "src/core/ext/filters/client_channel/subchannel_pool_interface.h"
 #include "src/core/lib/gprpp/ref_counted_ptr.h"
@@ -53,7 +52,8 @@ class GlobalSubchannelPool final : public SubchannelPoolInterface {
   ~GlobalSubchannelPool() override {}
 
   // A map from subchannel key to subchannel.
-  std::map<SubchannelKey, Subchannel*> subchannel_map_ ABSL_GUARDED_BY(mu_);
+  absl::flat_hash_map<SubchannelKey, Subchannel*> subchannel_map_
+      ABSL_GUARDED_BY(mu_);
   // To protect subchannel_map_.
   Mutex mu_;
 };
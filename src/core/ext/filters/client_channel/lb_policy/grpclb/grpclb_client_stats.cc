@@ -24,7 +24,6 @@
 
 #include "absl/memory/memory.h"
 
-#include <grpc/support/atm.h>
 #include <grpc/support/string_util.h>
 
 #include "src/core/lib/gprpp/sync.h"
@@ -32,25 +31,29 @@
 namespace grpc_core {
 
 void GrpcLbClientStats::AddCallStarted() {
-  gpr_atm_full_fetch_add(&num_calls_started_, (gpr_atm)1);
+  counters_.this_cpu().num_calls_started.fetch_add(1,
+                                                   std::memory_order_relaxed);
 }
 
 void GrpcLbClientStats::AddCallFinished(
     bool finished_with_client_failed_to_send, bool finished_known_received) {
-  gpr_atm_full_fetch_add(&num_calls_finished_, (gpr_atm)1);
+  Counters& counters = counters_.this_cpu();
+  counters.num_calls_finished.fetch_add(1, std::memory_order_relaxed);
   if (finished_with_client_failed_to_send) {
-    gpr_atm_full_fetch_add(&num_calls_finished_with_client_failed_to_send_,
-                           (gpr_atm)1);
+    counters.num_calls_finished_with_client_failed_to_send.fetch_add(
+        1, std::memory_order_relaxed);
   }
   if (finished_known_received) {
-    gpr_atm_full_fetch_add(&num_calls_finished_known_received_, (gpr_atm)1);
+    counters.num_calls_finished_known_received.fetch_add(
+        1, std::memory_order_relaxed);
   }
 }
 
 void GrpcLbClientStats::AddCallDropped(const char* token) {
   // Increment num_calls_started and num_calls_finished.
-  gpr_atm_full_fetch_add(&num_calls_started_, (gpr_atm)1);
-  gpr_atm_full_fetch_add(&num_calls_finished_, (gpr_atm)1);
+  Counters& counters = counters_.this_cpu();
+  counters.num_calls_started.fetch_add(1, std::memory_order_relaxed);
+  counters.num_calls_finished.fetch_add(1, std::memory_order_relaxed);
   // Record the drop.
   MutexLock lock(&drop_count_mu_);
   if (drop_token_counts_ == nullptr) {
@@ -68,8 +71,8 @@ void GrpcLbClientStats::AddCallDropped(const char* token) {
 
 namespace {
 
-void AtomicGetAndResetCounter(int64_t* value, gpr_atm* counter) {
-  *value = static_cast<int64_t>(gpr_atm_full_xchg(counter, (gpr_atm)0));
+int64_t AtomicGetAndResetCounter(std::atomic<int64_t>* counter) {
+  return counter->exchange(0, std::memory_order_relaxed);
 }
 
 }  // namespace
@@ -79,12 +82,20 @@ void GrpcLbClientStats::Get(
     int64_t* num_calls_finished_with_client_failed_to_send,
     int64_t* num_calls_finished_known_received,
     std::unique_ptr<DroppedCallCounts>* drop_token_counts) {
-  AtomicGetAndResetCounter(num_calls_started, &num_calls_started_);
-  AtomicGetAndResetCounter(num_calls_finished, &num_calls_finished_);
-  AtomicGetAndResetCounter(num_calls_finished_with_client_failed_to_send,
-                           &num_calls_finished_with_client_failed_to_send_);
-  AtomicGetAndResetCounter(num_calls_finished_known_received,
-                           &num_calls_finished_known_received_);
+  *num_calls_started = 0;
+  *num_calls_finished = 0;
+  *num_calls_finished_with_client_failed_to_send = 0;
+  *num_calls_finished_known_received = 0;
+  for (size_t cpu = 0; cpu < counters_.size(); ++cpu) {
+    Counters& counters = counters_[cpu];
+    *num_calls_started += AtomicGetAndResetCounter(&counters.num_calls_started);
+    *num_calls_finished +=
+        AtomicGetAndResetCounter(&counters.num_calls_finished);
+    *num_calls_finished_with_client_failed_to_send += AtomicGetAndResetCounter(
+        &counters.num_calls_finished_with_client_failed_to_send);
+    *num_calls_finished_known_received +=
+        AtomicGetAndResetCounter(&counters.num_calls_finished_known_received);
+  }
   MutexLock lock(&drop_count_mu_);
   *drop_token_counts = std::move(drop_token_counts_);
 }
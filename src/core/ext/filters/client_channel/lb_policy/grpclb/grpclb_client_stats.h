@@ -23,15 +23,15 @@
 
 #include <stdint.h>
 
+#include <atomic>
 #include <memory>
 #include <utility>
 
 #include "absl/base/thread_annotations.h"
 #include "absl/container/inlined_vector.h"
 
-#include <grpc/support/atm.h>
-
 #include "src/core/lib/gprpp/memory.h"
+#include "src/core/lib/gprpp/per_cpu.h"
 #include "src/core/lib/gprpp/ref_counted.h"
 #include "src/core/lib/gprpp/sync.h"
 
@@ -67,10 +67,15 @@ class GrpcLbClientStats : public RefCounted<GrpcLbClientStats> {
   }
 
  private:
-  gpr_atm num_calls_started_ = 0;
-  gpr_atm num_calls_finished_ = 0;
-  gpr_atm num_calls_finished_with_client_failed_to_send_ = 0;
-  gpr_atm num_calls_finished_known_received_ = 0;
+  // Kept per CPU so that concurrent calls do not contend; merged by Get().
+  struct Counters {
+    std::atomic<int64_t> num_calls_started{0};
+    std::atomic<int64_t> num_calls_finished{0};
+    std::atomic<int64_t> num_calls_finished_with_client_failed_to_send{0};
+    std::atomic<int64_t> num_calls_finished_known_received{0};
+  };
+
+  PerCpu<Counters> counters_;
   Mutex drop_count_mu_;  // Guards drop_token_counts_.
   std::unique_ptr<DroppedCallCounts> drop_token_counts_
       ABSL_GUARDED_BY(drop_count_mu_);
@@ -0,0 +1,640 @@
+//
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include <grpc/support/port_platform.h>
+
+#include <inttypes.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "absl/container/inlined_vector.h"
+#include "absl/memory/memory.h"
+#include "absl/random/random.h"
+#include "absl/status/status.h"
+#include "absl/status/statusor.h"
+#include "absl/strings/str_cat.h"
+#include "absl/types/optional.h"
+
+#include <grpc/impl/codegen/connectivity_state.h>
+#include <grpc/impl/codegen/grpc_types.h>
+#include <grpc/support/log.h>
+
+#include "src/core/ext/filters/client_channel/lb_policy.h"
+#include "src/core/ext/filters/client_channel/lb_policy/subchannel_list.h"
+#include "src/core/ext/filters/client_channel/lb_policy_factory.h"
+#include "src/core/ext/filters/client_channel/lb_policy_registry.h"
+#include "src/core/ext/filters/client_channel/subchannel_interface.h"
+#include "src/core/lib/debug/trace.h"
+#include "src/core/lib/gprpp/debug_location.h"
+#include "src/core/lib/gprpp/orphanable.h"
+#include "src/core/lib/gprpp/ref_counted.h"
+#include "src/core/lib/gprpp/ref_counted_ptr.h"
+#include "src/core/lib/iomgr/error.h"
+#include "src/core/lib/json/json.h"
+#include "src/core/lib/json/json_util.h"
+#include "src/core/lib/resolver/server_address.h"
+#include "src/core/lib/transport/connectivity_state.h"
+
+namespace grpc_core {
+
+TraceFlag grpc_lb_least_request_trace(false, "least_request_lb");
+
+namespace {
+
+//
+// least_request LB policy
+//
+
+constexpr char kLeastRequest[] = "least_request_experimental";
+
+// Config for least_request LB policy.
+class LeastRequestConfig : public LoadBalancingPolicy::Config {
+ public:
+  explicit LeastRequestConfig(size_t choice_count)
+      : choice_count_(choice_count) {}
+
+  const char* name() const override { return kLeastRequest; }
+
+  size_t choice_count() const { return choice_count_; }
+
+ private:
+  size_t choice_count_;
+};
+
+// Like round_robin, this keeps a connection to every address, but each
+// pick samples choice_count of the READY subchannels at random and takes
+// the one with the fewest calls in flight.  Unlike round_robin, this keeps
+// a momentarily slow backend from getting its full share of new calls.
+class LeastRequest : public LoadBalancingPolicy {
+ public:
+  explicit LeastRequest(Args args);
+
+  const char* name() const override { return kLeastRequest; }
+
+  void UpdateLocked(UpdateArgs args) override;
+  void ResetBackoffLocked() override;
+
+ private:
+  ~LeastRequest() override;
+
+  // The number of calls in flight on a subchannel.  Shared between the
+  // subchannel list, pickers, and the call trackers of calls in flight.
+  class CallCounter : public RefCounted<CallCounter> {
+   public:
+    uint32_t Load() const {
+      return outstanding_requests_.load(std::memory_order_relaxed);
+    }
+    void Increment() {
+      outstanding_requests_.fetch_add(1, std::memory_order_relaxed);
+    }
+    void Decrement() {
+      outstanding_requests_.fetch_sub(1, std::memory_order_relaxed);
+    }
+
+   private:
+    std::atomic<uint32_t> outstanding_requests_{0};
+  };
+
+  // Forward declaration.
+  class LeastRequestSubchannelList;
+
+  // Data for a particular subchannel in a subchannel list.
+  // This subclass adds the following functionality:
+  // - Tracks the previous connectivity state of the subchannel, so that
+  //   we know how many subchannels are in each state.
+  // - Counts the calls in flight on the subchannel.
+  class LeastRequestSubchannelData
+      : public SubchannelData<LeastRequestSubchannelList,
+                              LeastRequestSubchannelData> {
+   public:
+    LeastRequestSubchannelData(
+        SubchannelList<LeastRequestSubchannelList, LeastRequestSubchannelData>*
+            subchannel_list,
+        const ServerAddress& address,
+        RefCountedPtr<SubchannelInterface> subchannel)
+        : SubchannelData(subchannel_list, address, std::move(subchannel)),
+          call_counter_(MakeRefCounted<CallCounter>()) {}
+
+    absl::optional<grpc_connectivity_state> connectivity_state() const {
+      return logical_connectivity_state_;
+    }
+
+    const RefCountedPtr<CallCounter>& call_counter() const {
+      return call_counter_;
+    }
+
+   private:
+    // Performs connectivity state updates that need to be done only
+    // after we have started watching.
+    void ProcessConnectivityChangeLocked(
+        absl::optional<grpc_connectivity_state> old_state,
+        grpc_connectivity_state new_state) override;
+
+    // Updates the logical connectivity state.  Returns true if the
+    // state has changed.
+    bool UpdateLogicalConnectivityStateLocked(
+        grpc_connectivity_state connectivity_state);
+
+    // The logical connectivity state of the subchannel.
+    // Note that the logical connectivity state may differ from the
+    // actual reported state in some cases (e.g., after we see
+    // TRANSIENT_FAILURE, we ignore any subsequent state changes until
+    // we see READY).
+    absl::optional<grpc_connectivity_state> logical_connectivity_state_;
+
+    RefCountedPtr<CallCounter> call_counter_;
+  };
+
+  // A list of subchannels.
+  class LeastRequestSubchannelList
+      : public SubchannelList<LeastRequestSubchannelList,
+                              LeastRequestSubchannelData> {
+   public:
+    LeastRequestSubchannelList(LeastRequest* policy,
+                               ServerAddressList addresses,
+                               const grpc_channel_args& args)
+        : SubchannelList(policy,
+                         (GRPC_TRACE_FLAG_ENABLED(grpc_lb_least_request_trace)
+                              ? "LeastRequestSubchannelList"
+                              : nullptr),
+                         std::move(addresses), policy->channel_control_helper(),
+                         args) {
+      // Need to maintain a ref to the LB policy as long as we maintain
+      // any references to subchannels, since the subchannels'
+      // pollset_sets will include the LB policy's pollset_set.
+      policy->Ref(DEBUG_LOCATION, "subchannel_list").release();
+      // Start connecting to all subchannels.
+      for (size_t i = 0; i < num_subchannels(); i++) {
+        subchannel(i)->subchannel()->RequestConnection();
+      }
+    }
+
+    ~LeastRequestSubchannelList() override {
+      LeastRequest* p = static_cast<LeastRequest*>(policy());
+      p->Unref(DEBUG_LOCATION, "subchannel_list");
+    }
+
+    // Updates the counters of subchannels in each state when a
+    // subchannel transitions from old_state to new_state.
+    void UpdateStateCountersLocked(
+        absl::optional<grpc_connectivity_state> old_state,
+        grpc_connectivity_state new_state);
+
+    // Ensures that the right subchannel list is used and then updates
+    // the LR policy's connectivity state based on the subchannel list's
+    // state counters.
+    void MaybeUpdateLeastRequestConnectivityStateLocked(
+        absl::Status status_for_tf);
+
+   private:
+    std::string CountersString() const {
+      return absl::StrCat("num_subchannels=", num_subchannels(),
+                          " num_ready=", num_ready_,
+                          " num_connecting=", num_connecting_,
+                          " num_transient_failure=", num_transient_failure_);
+    }
+
+    size_t num_ready_ = 0;
+    size_t num_connecting_ = 0;
+    size_t num_transient_failure_ = 0;
+  };
+
+  class Picker : public SubchannelPicker {
+   public:
+    Picker(LeastRequest* parent, LeastRequestSubchannelList* subchannel_list);
+
+    PickResult Pick(PickArgs args) override;
+
+   private:
+    // Counts the call as in flight from when it starts until it finishes.
+    class SubchannelCallTracker : public SubchannelCallTrackerInterface {
+     public:
+      explicit SubchannelCallTracker(RefCountedPtr<CallCounter> call_counter)
+          : call_counter_(std::move(call_counter)) {}
+
+      void Start() override { call_counter_->Increment(); }
+
+      void Finish(FinishArgs /*args*/) override {
+        call_counter_->Decrement();
+      }
+
+     private:
+      RefCountedPtr<CallCounter> call_counter_;
+    };
+
+    struct Endpoint {
+      RefCountedPtr<SubchannelInterface> subchannel;
+      RefCountedPtr<CallCounter> call_counter;
+    };
+
+    // Using pointer value only, no ref held -- do not dereference!
+    LeastRequest* parent_;
+
+    const size_t choice_count_;
+    absl::InlinedVector<Endpoint, 10> endpoints_;
+    absl::BitGen bit_gen_;
+  };
+
+  void ShutdownLocked() override;
+
+  // Current config from the resolver.
+  RefCountedPtr<LeastRequestConfig> config_;
+
+  // List of subchannels.
+  OrphanablePtr<LeastRequestSubchannelList> subchannel_list_;
+  // Latest pending subchannel list.
+  // When we get an updated address list, we create a new subchannel list
+  // for it here, and we wait to swap it into subchannel_list_ until the new
+  // list becomes READY.
+  OrphanablePtr<LeastRequestSubchannelList> latest_pending_subchannel_list_;
+
+  bool shutdown_ = false;
+};
+
+//
+// LeastRequest::Picker
+//
+
+LeastRequest::Picker::Picker(LeastRequest* parent,
+                             LeastRequestSubchannelList* subchannel_list)
+    : parent_(parent), choice_count_(parent->config_->choice_count()) {
+  for (size_t i = 0; i < subchannel_list->num_subchannels(); ++i) {
+    LeastRequestSubchannelData* sd = subchannel_list->subchannel(i);
+    if (sd->connectivity_state().value_or(GRPC_CHANNEL_IDLE) ==
+        GRPC_CHANNEL_READY) {
+      endpoints_.push_back({sd->subchannel()->Ref(), sd->call_counter()});
+    }
+  }
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_least_request_trace)) {
+    gpr_log(GPR_INFO,
+            "[LR %p picker %p] created picker from subchannel_list=%p "
+            "with %" PRIuPTR " READY subchannels; choice_count=%" PRIuPTR,
+            parent_, this, subchannel_list, endpoints_.size(), choice_count_);
+  }
+}
+
+LeastRequest::PickResult LeastRequest::Picker::Pick(PickArgs /*args*/) {
+  // Sample choice_count distinct endpoints, or all of them if there are
+  // not that many, and take the one with the fewest calls in flight.
+  // Sampling without replacement matters: otherwise a slow endpoint is
+  // still picked whenever it is the only one sampled.
+  const size_t num_endpoints = endpoints_.size();
+  size_t best_index = absl::Uniform<size_t>(bit_gen_, 0, num_endpoints);
+  uint32_t best_load = endpoints_[best_index].call_counter->Load();
+  if (choice_count_ >= num_endpoints) {
+    for (size_t i = 0; i < num_endpoints; ++i) {
+      const uint32_t load = endpoints_[i].call_counter->Load();
+      if (load < best_load) {
+        best_index = i;
+        best_load = load;
+      }
+    }
+  } else {
+    absl::InlinedVector<size_t, 10> sampled = {best_index};
+    while (sampled.size() < choice_count_) {
+      const size_t index = absl::Uniform<size_t>(bit_gen_, 0, num_endpoints);
+      if (std::find(sampled.begin(), sampled.end(), index) != sampled.end()) {
+        continue;
+      }
+      sampled.push_back(index);
+      const uint32_t load = endpoints_[index].call_counter->Load();
+      if (load < best_load) {
+        best_index = index;
+        best_load = load;
+      }
+    }
+  }
+  const Endpoint& endpoint = endpoints_[best_index];
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_least_request_trace)) {
+    gpr_log(GPR_INFO,
+            "[LR %p picker %p] returning index %" PRIuPTR
+            ", subchannel=%p, outstanding_requests=%" PRIu32,
+            parent_, this, best_index, endpoint.subchannel.get(), best_load);
+  }
+  return PickResult::Complete(
+      endpoint.subchannel,
+      absl::make_unique<SubchannelCallTracker>(endpoint.call_counter));
+}
+
+//
+// LeastRequest
+//
+
+LeastRequest::LeastRequest(Args args) : LoadBalancingPolicy(std::move(args)) {
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_least_request_trace)) {
+    gpr_log(GPR_INFO, "[LR %p] Created", this);
+  }
+}
+
+LeastRequest::~LeastRequest() {
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_least_request_trace)) {
+    gpr_log(GPR_INFO, "[LR %p] Destroying Least Request policy", this);
+  }
+  GPR_ASSERT(subchannel_list_ == nullptr);
+  GPR_ASSERT(latest_pending_subchannel_list_ == nullptr);
+}
+
+void LeastRequest::ShutdownLocked() {
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_least_request_trace)) {
+    gpr_log(GPR_INFO, "[LR %p] Shutting down", this);
+  }
+  shutdown_ = true;
+  subchannel_list_.reset();
+  latest_pending_subchannel_list_.reset();
+}
+
+void LeastRequest::ResetBackoffLocked() {
+  subchannel_list_->ResetBackoffLocked();
+  if (latest_pending_subchannel_list_ != nullptr) {
+    latest_pending_subchannel_list_->ResetBackoffLocked();
+  }
+}
+
+void LeastRequest::UpdateLocked(UpdateArgs args) {
+  config_ = std::move(args.config);
+  ServerAddressList addresses;
+  if (args.addresses.ok()) {
+    if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_least_request_trace)) {
+      gpr_log(GPR_INFO, "[LR %p] received update with %" PRIuPTR " addresses",
+              this, args.addresses->size());
+    }
+    addresses = std::move(*args.addresses);
+  } else {
+    if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_least_request_trace)) {
+      gpr_log(GPR_INFO, "[LR %p] received update with address error: %s", this,
+              args.addresses.status().ToString().c_str());
+    }
+    // If we already have a subchannel list, then ignore the resolver
+    // failure and keep using the existing list.
+    if (subchannel_list_ != nullptr) return;
+  }
+  // Create new subchannel list, replacing the previous pending list, if any.
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_least_request_trace) &&
+      latest_pending_subchannel_list_ != nullptr) {
+    gpr_log(GPR_INFO, "[LR %p] replacing previous pending subchannel list %p",
+            this, latest_pending_subchannel_list_.get());
+  }
+  latest_pending_subchannel_list_ = MakeOrphanable<LeastRequestSubchannelList>(
+      this, std::move(addresses), *args.args);
+  // If the new list is empty, immediately promote it to
+  // subchannel_list_ and report TRANSIENT_FAILURE.
+  if (latest_pending_subchannel_list_->num_subchannels() == 0) {
+    if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_least_request_trace) &&
+        subchannel_list_ != nullptr) {
+      gpr_log(GPR_INFO, "[LR %p] replacing previous subchannel list %p", this,
+              subchannel_list_.get());
+    }
+    subchannel_list_ = std::move(latest_pending_subchannel_list_);
+    absl::Status status =
+        args.addresses.ok() ? absl::UnavailableError(absl::StrCat(
+                                  "empty address list: ", args.resolution_note))
+                            : args.addresses.status();
+    channel_control_helper()->UpdateState(
+        GRPC_CHANNEL_TRANSIENT_FAILURE, status,
+        absl::make_unique<TransientFailurePicker>(status));
+  }
+  // Otherwise, if this is the initial update, immediately promote it to
+  // subchannel_list_ and report CONNECTING.
+  else if (subchannel_list_.get() == nullptr) {
+    subchannel_list_ = std::move(latest_pending_subchannel_list_);
+    channel_control_helper()->UpdateState(
+        GRPC_CHANNEL_CONNECTING, absl::Status(),
+        absl::make_unique<QueuePicker>(Ref(DEBUG_LOCATION, "QueuePicker")));
+  }
+}
+
+//
+// LeastRequestSubchannelList
+//
+
+void LeastRequest::LeastRequestSubchannelList::UpdateStateCountersLocked(
+    absl::optional<grpc_connectivity_state> old_state,
+    grpc_connectivity_state new_state) {
+  if (old_state.has_value()) {
+    GPR_ASSERT(*old_state != GRPC_CHANNEL_SHUTDOWN);
+    if (*old_state == GRPC_CHANNEL_READY) {
+      GPR_ASSERT(num_ready_ > 0);
+      --num_ready_;
+    } else if (*old_state == GRPC_CHANNEL_CONNECTING) {
+      GPR_ASSERT(num_connecting_ > 0);
+      --num_connecting_;
+    } else if (*old_state == GRPC_CHANNEL_TRANSIENT_FAILURE) {
+      GPR_ASSERT(num_transient_failure_ > 0);
+      --num_transient_failure_;
+    }
+  }
+  GPR_ASSERT(new_state != GRPC_CHANNEL_SHUTDOWN);
+  if (new_state == GRPC_CHANNEL_READY) {
+    ++num_ready_;
+  } else if (new_state == GRPC_CHANNEL_CONNECTING) {
+    ++num_connecting_;
+  } else if (new_state == GRPC_CHANNEL_TRANSIENT_FAILURE) {
+    ++num_transient_failure_;
+  }
+}
+
+void LeastRequest::LeastRequestSubchannelList::
+    MaybeUpdateLeastRequestConnectivityStateLocked(absl::Status status_for_tf) {
+  LeastRequest* p = static_cast<LeastRequest*>(policy());
+  // If this is latest_pending_subchannel_list_, then swap it into
+  // subchannel_list_ in the following cases:
+  // - subchannel_list_ has no READY subchannels.
+  // - This list has at least one READY subchannel.
+  // - All of the subchannels in this list are in TRANSIENT_FAILURE.
+  //   (This may cause the channel to go from READY to TRANSIENT_FAILURE,
+  //   but we're doing what the control plane told us to do.)
+  if (p->latest_pending_subchannel_list_.get() == this &&
+      (p->subchannel_list_->num_ready_ == 0 || num_ready_ > 0 ||
+       num_transient_failure_ == num_subchannels())) {
+    if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_least_request_trace)) {
+      const std::string old_counters_string =
+          p->subchannel_list_ != nullptr ? p->subchannel_list_->CountersString()
+                                         : "";
+      gpr_log(
+          GPR_INFO,
+          "[LR %p] swapping out subchannel list %p (%s) in favor of %p (%s)", p,
+          p->subchannel_list_.get(), old_counters_string.c_str(), this,
+          CountersString().c_str());
+    }
+    p->subchannel_list_ = std::move(p->latest_pending_subchannel_list_);
+  }
+  // Only set connectivity state if this is the current subchannel list.
+  if (p->subchannel_list_.get() != this) return;
+  // First matching rule wins:
+  // 1) ANY subchannel is READY => policy is READY.
+  // 2) ANY subchannel is CONNECTING => policy is CONNECTING.
+  // 3) ALL subchannels are TRANSIENT_FAILURE => policy is TRANSIENT_FAILURE.
+  if (num_ready_ > 0) {
+    if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_least_request_trace)) {
+      gpr_log(GPR_INFO, "[LR %p] reporting READY with subchannel list %p", p,
+              this);
+    }
+    p->channel_control_helper()->UpdateState(
+        GRPC_CHANNEL_READY, absl::Status(), absl::make_unique<Picker>(p, this));
+  } else if (num_connecting_ > 0) {
+    if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_least_request_trace)) {
+      gpr_log(GPR_INFO, "[LR %p] reporting CONNECTING with subchannel list %p",
+              p, this);
+    }
+    p->channel_control_helper()->UpdateState(
+        GRPC_CHANNEL_CONNECTING, absl::Status(),
+        absl::make_unique<QueuePicker>(p->Ref(DEBUG_LOCATION, "QueuePicker")));
+  } else if (num_transient_failure_ == num_subchannels()) {
+    if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_least_request_trace)) {
+      gpr_log(GPR_INFO,
+              "[LR %p] reporting TRANSIENT_FAILURE with subchannel list %p: %s",
+              p, this, status_for_tf.ToString().c_str());
+    }
+    p->channel_control_helper()->UpdateState(
+        GRPC_CHANNEL_TRANSIENT_FAILURE, status_for_tf,
+        absl::make_unique<TransientFailurePicker>(status_for_tf));
+  }
+}
+
+//
+// LeastRequestSubchannelData
+//
+
+void LeastRequest::LeastRequestSubchannelData::ProcessConnectivityChangeLocked(
+    absl::optional<grpc_connectivity_state> old_state,
+    grpc_connectivity_state new_state) {
+  LeastRequest* p = static_cast<LeastRequest*>(subchannel_list()->policy());
+  GPR_ASSERT(subchannel() != nullptr);
+  // If this is not the initial state notification and the new state is
+  // TRANSIENT_FAILURE or IDLE, re-resolve and attempt to reconnect.
+  // Note that we don't want to do this on the initial state
+  // notification, because that would result in an endless loop of
+  // re-resolution.
+  if (old_state.has_value() && (new_state == GRPC_CHANNEL_TRANSIENT_FAILURE ||
+                                new_state == GRPC_CHANNEL_IDLE)) {
+    if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_least_request_trace)) {
+      gpr_log(GPR_INFO,
+              "[LR %p] Subchannel %p reported %s; requesting re-resolution", p,
+              subchannel(), ConnectivityStateName(new_state));
+    }
+    p->channel_control_helper()->RequestReresolution();
+    subchannel()->RequestConnection();
+  }
+  // Update logical connectivity state.
+  // If it changed, update the policy state.
+  if (UpdateLogicalConnectivityStateLocked(new_state)) {
+    subchannel_list()->MaybeUpdateLeastRequestConnectivityStateLocked(
+        absl::UnavailableError(
+            absl::StrCat("connections to all backends failing; last error: ",
+                         connectivity_status().ToString())));
+  }
+}
+
+bool LeastRequest::LeastRequestSubchannelData::
+    UpdateLogicalConnectivityStateLocked(
+        grpc_connectivity_state connectivity_state) {
+  LeastRequest* p = static_cast<LeastRequest*>(subchannel_list()->policy());
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_least_request_trace)) {
+    gpr_log(
+        GPR_INFO,
+        "[LR %p] connectivity changed for subchannel %p, subchannel_list %p "
+        "(index %" PRIuPTR " of %" PRIuPTR "): prev_state=%s new_state=%s",
+        p, subchannel(), subchannel_list(), Index(),
+        subchannel_list()->num_subchannels(),
+        (logical_connectivity_state_.has_value()
+             ? ConnectivityStateName(*logical_connectivity_state_)
+             : "N/A"),
+        ConnectivityStateName(connectivity_state));
+  }
+  // Decide what state to report for aggregation purposes.
+  // If the last logical state was TRANSIENT_FAILURE, then ignore the
+  // state change unless the new state is READY.
+  if (logical_connectivity_state_.has_value() &&
+      *logical_connectivity_state_ == GRPC_CHANNEL_TRANSIENT_FAILURE &&
+      connectivity_state != GRPC_CHANNEL_READY) {
+    return false;
+  }
+  // If the new state is IDLE, treat it as CONNECTING, since it will
+  // immediately transition into CONNECTING anyway.
+  if (connectivity_state == GRPC_CHANNEL_IDLE) {
+    if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_least_request_trace)) {
+      gpr_log(GPR_INFO,
+              "[LR %p] subchannel %p, subchannel_list %p (index %" PRIuPTR
+              " of %" PRIuPTR "): treating IDLE as CONNECTING",
+              p, subchannel(), subchannel_list(), Index(),
+              subchannel_list()->num_subchannels());
+    }
+    connectivity_state = GRPC_CHANNEL_CONNECTING;
+  }
+  // If no change, return false.
+  if (logical_connectivity_state_.has_value() &&
+      *logical_connectivity_state_ == connectivity_state) {
+    return false;
+  }
+  // Otherwise, update counters and logical state.
+  subchannel_list()->UpdateStateCountersLocked(logical_connectivity_state_,
+                                               connectivity_state);
+  logical_connectivity_state_ = connectivity_state;
+  return true;
+}
+
+//
+// factory
+//
+
+class LeastRequestFactory : public LoadBalancingPolicyFactory {
+ public:
+  OrphanablePtr<LoadBalancingPolicy> CreateLoadBalancingPolicy(
+      LoadBalancingPolicy::Args args) const override {
+    return MakeOrphanable<LeastRequest>(std::move(args));
+  }
+
+  const char* name() const override { return kLeastRequest; }
+
+  RefCountedPtr<LoadBalancingPolicy::Config> ParseLoadBalancingConfig(
+      const Json& json, grpc_error_handle* error) const override {
+    GPR_DEBUG_ASSERT(error != nullptr && *error == GRPC_ERROR_NONE);
+    size_t choice_count = 2;
+    std::vector<grpc_error_handle> error_list;
+    // All fields are optional, so the policy may also be selected in the
+    // deprecated loadBalancingPolicy field or in the client API.
+    if (json.type() == Json::Type::OBJECT) {
+      ParseJsonObjectField(json.object_value(), "choiceCount", &choice_count,
+                           &error_list, /*required=*/false);
+    }
+    if (!error_list.empty()) {
+      *error = GRPC_ERROR_CREATE_FROM_VECTOR(
+          "least_request_experimental LB policy config", &error_list);
+      return nullptr;
+    }
+    // Fewer than two choices is random; more than ten buys little.
+    return MakeRefCounted<LeastRequestConfig>(
+        std::max<size_t>(2, std::min<size_t>(choice_count, 10)));
+  }
+};
+
+}  // namespace
+
+void GrpcLbPolicyLeastRequestInit() {
+  LoadBalancingPolicyRegistry::Builder::RegisterLoadBalancingPolicyFactory(
+      absl::make_unique<LeastRequestFactory>());
+}
+
+void GrpcLbPolicyLeastRequestShutdown() {}
+
+}  // namespace grpc_core
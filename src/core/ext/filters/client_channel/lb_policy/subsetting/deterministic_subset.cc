@@ -0,0 +1,47 @@
+//
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include <grpc/support/port_platform.h>
+
+#include "src/core/ext/filters/client_channel/lb_policy/subsetting/deterministic_subset.h"
+
+#include <algorithm>
+#include <numeric>
+#include <random>
+#include <utility>
+
+namespace grpc_core {
+
+std::vector<size_t> DeterministicSubset(size_t num_backends,
+                                        size_t subset_size,
+                                        uint64_t client_index) {
+  std::vector<size_t> backends(num_backends);
+  std::iota(backends.begin(), backends.end(), 0);
+  if (subset_size == 0 || num_backends <= subset_size) return backends;
+  const size_t subset_count = num_backends / subset_size;
+  const uint64_t round = client_index / subset_count;
+  const size_t subset_id = client_index % subset_count;
+  // Fisher-Yates with the raw generator output rather than std::shuffle,
+  // whose algorithm is implementation-defined.
+  std::mt19937_64 rng(round);
+  for (size_t i = num_backends - 1; i > 0; --i) {
+    std::swap(backends[i], backends[rng() % (i + 1)]);
+  }
+  auto begin = backends.begin() + subset_id * subset_size;
+  return std::vector<size_t>(begin, begin + subset_size);
+}
+
+}  // namespace grpc_core
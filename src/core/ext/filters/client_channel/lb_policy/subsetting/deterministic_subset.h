@@ -0,0 +1,58 @@
+//
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#ifndef GRPC_CORE_EXT_FILTERS_CLIENT_CHANNEL_LB_POLICY_SUBSETTING_DETERMINISTIC_SUBSET_H
+#define GRPC_CORE_EXT_FILTERS_CLIENT_CHANNEL_LB_POLICY_SUBSETTING_DETERMINISTIC_SUBSET_H
+
+#include <grpc/support/port_platform.h>
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <vector>
+
+// Channel arg: this client's index among the clients that share a set of
+// backends (integer, non-negative).  Used by the
+// deterministic_subsetting LB policy.  Clients with consecutive indices
+// get disjoint subsets until the backends run out.
+#define GRPC_ARG_SUBSETTING_CLIENT_INDEX \
+  "grpc.experimental.subsetting_client_index"
+
+namespace grpc_core {
+
+// Returns the indices of the backends that the client with the given
+// index should connect to, out of num_backends backends.
+//
+// Clients are grouped into rounds of num_backends / subset_size clients.
+// Every client in a round shuffles the backends the same way, seeded by
+// the round number, and takes its own slice of subset_size of them.  So
+// each round connects to every backend at most once, and a contiguous
+// range of client indices spreads its connections evenly; different
+// rounds use different shuffles, so the backends left over when
+// num_backends is not a multiple of subset_size differ from round to
+// round.
+//
+// The result depends only on the arguments (the shuffle uses a
+// generator whose output is fixed by the standard), so it is the same
+// across restarts and platforms.  If num_backends <= subset_size, all
+// backends are returned.
+std::vector<size_t> DeterministicSubset(size_t num_backends,
+                                        size_t subset_size,
+                                        uint64_t client_index);
+
+}  // namespace grpc_core
+
+#endif  // GRPC_CORE_EXT_FILTERS_CLIENT_CHANNEL_LB_POLICY_SUBSETTING_DETERMINISTIC_SUBSET_H
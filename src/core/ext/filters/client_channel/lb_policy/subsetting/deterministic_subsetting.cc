@@ -0,0 +1,400 @@
+//
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include <grpc/support/port_platform.h>
+
+#include <inttypes.h>
+#include <limits.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "absl/memory/memory.h"
+#include "absl/random/random.h"
+#include "absl/status/status.h"
+#include "absl/status/statusor.h"
+#include "absl/strings/string_view.h"
+
+#include <grpc/impl/codegen/connectivity_state.h>
+#include <grpc/impl/codegen/grpc_types.h>
+#include <grpc/support/log.h>
+
+#include "src/core/ext/filters/client_channel/lb_policy.h"
+#include "src/core/ext/filters/client_channel/lb_policy/child_policy_handler.h"
+#include "src/core/ext/filters/client_channel/lb_policy/subsetting/deterministic_subset.h"
+#include "src/core/ext/filters/client_channel/lb_policy_factory.h"
+#include "src/core/ext/filters/client_channel/lb_policy_registry.h"
+#include "src/core/ext/filters/client_channel/subchannel_interface.h"
+#include "src/core/lib/address_utils/sockaddr_utils.h"
+#include "src/core/lib/channel/channel_args.h"
+#include "src/core/lib/debug/trace.h"
+#include "src/core/lib/gprpp/debug_location.h"
+#include "src/core/lib/gprpp/orphanable.h"
+#include "src/core/lib/gprpp/ref_counted_ptr.h"
+#include "src/core/lib/iomgr/error.h"
+#include "src/core/lib/iomgr/pollset_set.h"
+#include "src/core/lib/json/json.h"
+#include "src/core/lib/json/json_util.h"
+#include "src/core/lib/resolver/server_address.h"
+#include "src/core/lib/transport/connectivity_state.h"
+
+namespace grpc_core {
+
+TraceFlag grpc_deterministic_subsetting_lb_trace(false,
+                                                 "deterministic_subsetting_lb");
+
+namespace {
+
+constexpr char kDeterministicSubsetting[] =
+    "deterministic_subsetting_experimental";
+
+// Config for deterministic_subsetting LB policy.
+class DeterministicSubsettingLbConfig : public LoadBalancingPolicy::Config {
+ public:
+  DeterministicSubsettingLbConfig(
+      uint32_t subset_size,
+      RefCountedPtr<LoadBalancingPolicy::Config> child_policy)
+      : subset_size_(subset_size), child_policy_(std::move(child_policy)) {}
+
+  const char* name() const override { return kDeterministicSubsetting; }
+
+  uint32_t subset_size() const { return subset_size_; }
+  RefCountedPtr<LoadBalancingPolicy::Config> child_policy() const {
+    return child_policy_;
+  }
+
+ private:
+  uint32_t subset_size_;
+  RefCountedPtr<LoadBalancingPolicy::Config> child_policy_;
+};
+
+// Deterministic subsetting LB policy.  Passes only this client's subset of
+// the addresses (see DeterministicSubset()) to the child policy, so that
+// the number of connections to each backend stays bounded no matter how
+// many clients there are.
+class DeterministicSubsettingLb : public LoadBalancingPolicy {
+ public:
+  explicit DeterministicSubsettingLb(Args args);
+
+  const char* name() const override { return kDeterministicSubsetting; }
+
+  void UpdateLocked(UpdateArgs args) override;
+  void ExitIdleLocked() override;
+  void ResetBackoffLocked() override;
+
+ private:
+  class Helper : public ChannelControlHelper {
+   public:
+    explicit Helper(RefCountedPtr<DeterministicSubsettingLb> subsetting_policy)
+        : subsetting_policy_(std::move(subsetting_policy)) {}
+
+    ~Helper() override { subsetting_policy_.reset(DEBUG_LOCATION, "Helper"); }
+
+    RefCountedPtr<SubchannelInterface> CreateSubchannel(
+        ServerAddress address, const grpc_channel_args& args) override;
+    void UpdateState(grpc_connectivity_state state, const absl::Status& status,
+                     std::unique_ptr<SubchannelPicker> picker) override;
+    void RequestReresolution() override;
+    absl::string_view GetAuthority() override;
+    void AddTraceEvent(TraceSeverity severity,
+                       absl::string_view message) override;
+
+   private:
+    RefCountedPtr<DeterministicSubsettingLb> subsetting_policy_;
+  };
+
+  ~DeterministicSubsettingLb() override;
+
+  void ShutdownLocked() override;
+
+  OrphanablePtr<LoadBalancingPolicy> CreateChildPolicyLocked(
+      const grpc_channel_args* args);
+
+  // Returns this client's subset of addresses.
+  ServerAddressList SubsetLocked(ServerAddressList addresses);
+
+  // This client's index, from the channel args or else picked at random.
+  const uint64_t client_index_;
+
+  // Current config from the resolver.
+  RefCountedPtr<DeterministicSubsettingLbConfig> config_;
+
+  // Internal state.
+  bool shutting_down_ = false;
+
+  OrphanablePtr<LoadBalancingPolicy> child_policy_;
+};
+
+uint64_t GetClientIndex(const grpc_channel_args* args) {
+  int client_index = grpc_channel_args_find_integer(
+      args, GRPC_ARG_SUBSETTING_CLIENT_INDEX, {-1, -1, INT_MAX});
+  if (client_index >= 0) return client_index;
+  // Without an index, subsets are still spread evenly in expectation, but
+  // not exactly.
+  absl::BitGen bit_gen;
+  return absl::Uniform<uint64_t>(bit_gen);
+}
+
+//
+// DeterministicSubsettingLb
+//
+
+DeterministicSubsettingLb::DeterministicSubsettingLb(Args args)
+    : LoadBalancingPolicy(std::move(args)),
+      client_index_(GetClientIndex(args.args)) {
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_deterministic_subsetting_lb_trace)) {
+    gpr_log(GPR_INFO,
+            "[deterministic_subsetting_lb %p] created -- client index %" PRIu64,
+            this, client_index_);
+  }
+}
+
+DeterministicSubsettingLb::~DeterministicSubsettingLb() {
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_deterministic_subsetting_lb_trace)) {
+    gpr_log(GPR_INFO,
+            "[deterministic_subsetting_lb %p] destroying "
+            "deterministic_subsetting LB policy",
+            this);
+  }
+}
+
+void DeterministicSubsettingLb::ShutdownLocked() {
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_deterministic_subsetting_lb_trace)) {
+    gpr_log(GPR_INFO, "[deterministic_subsetting_lb %p] shutting down", this);
+  }
+  shutting_down_ = true;
+  // Remove the child policy's interested_parties pollset_set from this
+  // policy.
+  if (child_policy_ != nullptr) {
+    grpc_pollset_set_del_pollset_set(child_policy_->interested_parties(),
+                                     interested_parties());
+    child_policy_.reset();
+  }
+}
+
+void DeterministicSubsettingLb::ExitIdleLocked() {
+  if (child_policy_ != nullptr) child_policy_->ExitIdleLocked();
+}
+
+void DeterministicSubsettingLb::ResetBackoffLocked() {
+  if (child_policy_ != nullptr) child_policy_->ResetBackoffLocked();
+}
+
+void DeterministicSubsettingLb::UpdateLocked(UpdateArgs args) {
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_deterministic_subsetting_lb_trace)) {
+    gpr_log(GPR_INFO, "[deterministic_subsetting_lb %p] Received update",
+            this);
+  }
+  // Update config.
+  config_ = std::move(args.config);
+  // Create policy if needed.
+  if (child_policy_ == nullptr) {
+    child_policy_ = CreateChildPolicyLocked(args.args);
+  }
+  // Construct update args.
+  UpdateArgs update_args;
+  if (args.addresses.ok()) {
+    update_args.addresses = SubsetLocked(std::move(*args.addresses));
+  } else {
+    update_args.addresses = args.addresses.status();
+  }
+  update_args.config = config_->child_policy();
+  update_args.args = grpc_channel_args_copy(args.args);
+  // Update the policy.
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_deterministic_subsetting_lb_trace)) {
+    gpr_log(GPR_INFO,
+            "[deterministic_subsetting_lb %p] Updating child policy handler "
+            "%p",
+            this, child_policy_.get());
+  }
+  child_policy_->UpdateLocked(std::move(update_args));
+}
+
+ServerAddressList DeterministicSubsettingLb::SubsetLocked(
+    ServerAddressList addresses) {
+  if (addresses.size() <= config_->subset_size()) return addresses;
+  // Sort the addresses, so that every client sees the same order no matter
+  // what order the resolver returned them in.
+  std::vector<std::pair<std::string, size_t>> keys;
+  keys.reserve(addresses.size());
+  for (size_t i = 0; i < addresses.size(); ++i) {
+    auto key = grpc_sockaddr_to_string(&addresses[i].address(), false);
+    keys.emplace_back(key.ok() ? std::move(*key) : "", i);
+  }
+  std::sort(keys.begin(), keys.end());
+  ServerAddressList subset;
+  for (size_t i : DeterministicSubset(addresses.size(),
+                                      config_->subset_size(), client_index_)) {
+    subset.push_back(std::move(addresses[keys[i].second]));
+  }
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_deterministic_subsetting_lb_trace)) {
+    gpr_log(GPR_INFO,
+            "[deterministic_subsetting_lb %p] using %" PRIuPTR " of %" PRIuPTR
+            " addresses",
+            this, subset.size(), addresses.size());
+  }
+  return subset;
+}
+
+OrphanablePtr<LoadBalancingPolicy>
+DeterministicSubsettingLb::CreateChildPolicyLocked(
+    const grpc_channel_args* args) {
+  LoadBalancingPolicy::Args lb_policy_args;
+  lb_policy_args.work_serializer = work_serializer();
+  lb_policy_args.args = args;
+  lb_policy_args.channel_control_helper =
+      absl::make_unique<Helper>(Ref(DEBUG_LOCATION, "Helper"));
+  OrphanablePtr<LoadBalancingPolicy> lb_policy =
+      MakeOrphanable<ChildPolicyHandler>(
+          std::move(lb_policy_args), &grpc_deterministic_subsetting_lb_trace);
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_deterministic_subsetting_lb_trace)) {
+    gpr_log(GPR_INFO,
+            "[deterministic_subsetting_lb %p] Created new child policy handler "
+            "%p",
+            this, lb_policy.get());
+  }
+  // Add our interested_parties pollset_set to that of the newly created
+  // child policy. This will make the child policy progress upon activity on
+  // this policy, which in turn is tied to the application's call.
+  grpc_pollset_set_add_pollset_set(lb_policy->interested_parties(),
+                                   interested_parties());
+  return lb_policy;
+}
+
+//
+// DeterministicSubsettingLb::Helper
+//
+
+RefCountedPtr<SubchannelInterface>
+DeterministicSubsettingLb::Helper::CreateSubchannel(
+    ServerAddress address, const grpc_channel_args& args) {
+  if (subsetting_policy_->shutting_down_) return nullptr;
+  return subsetting_policy_->channel_control_helper()->CreateSubchannel(
+      std::move(address), args);
+}
+
+void DeterministicSubsettingLb::Helper::UpdateState(
+    grpc_connectivity_state state, const absl::Status& status,
+    std::unique_ptr<SubchannelPicker> picker) {
+  if (subsetting_policy_->shutting_down_) return;
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_deterministic_subsetting_lb_trace)) {
+    gpr_log(GPR_INFO,
+            "[deterministic_subsetting_lb %p] child connectivity state "
+            "update: state=%s (%s) picker=%p",
+            subsetting_policy_.get(), ConnectivityStateName(state),
+            status.ToString().c_str(), picker.get());
+  }
+  // The child's picker only sees our subset, so pass it on as is.
+  subsetting_policy_->channel_control_helper()->UpdateState(state, status,
+                                                            std::move(picker));
+}
+
+void DeterministicSubsettingLb::Helper::RequestReresolution() {
+  if (subsetting_policy_->shutting_down_) return;
+  subsetting_policy_->channel_control_helper()->RequestReresolution();
+}
+
+absl::string_view DeterministicSubsettingLb::Helper::GetAuthority() {
+  return subsetting_policy_->channel_control_helper()->GetAuthority();
+}
+
+void DeterministicSubsettingLb::Helper::AddTraceEvent(
+    TraceSeverity severity, absl::string_view message) {
+  if (subsetting_policy_->shutting_down_) return;
+  subsetting_policy_->channel_control_helper()->AddTraceEvent(severity,
+                                                              message);
+}
+
+//
+// factory
+//
+
+class DeterministicSubsettingLbFactory : public LoadBalancingPolicyFactory {
+ public:
+  OrphanablePtr<LoadBalancingPolicy> CreateLoadBalancingPolicy(
+      LoadBalancingPolicy::Args args) const override {
+    return MakeOrphanable<DeterministicSubsettingLb>(std::move(args));
+  }
+
+  const char* name() const override { return kDeterministicSubsetting; }
+
+  RefCountedPtr<LoadBalancingPolicy::Config> ParseLoadBalancingConfig(
+      const Json& json, grpc_error_handle* error) const override {
+    GPR_DEBUG_ASSERT(error != nullptr && *error == GRPC_ERROR_NONE);
+    if (json.type() == Json::Type::JSON_NULL) {
+      // This policy was configured in the deprecated loadBalancingPolicy
+      // field or in the client API.
+      *error = GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+          "field:loadBalancingPolicy error:deterministic_subsetting policy "
+          "requires configuration. Please use loadBalancingConfig field of "
+          "service config instead.");
+      return nullptr;
+    }
+    std::vector<grpc_error_handle> error_list;
+    uint32_t subset_size = 20;
+    if (ParseJsonObjectField(json.object_value(), "subsetSize", &subset_size,
+                             &error_list, /*required=*/false) &&
+        subset_size == 0) {
+      error_list.push_back(GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+          "field:subsetSize error:must be greater than 0"));
+    }
+    RefCountedPtr<LoadBalancingPolicy::Config> child_policy;
+    auto it = json.object_value().find("childPolicy");
+    if (it == json.object_value().end()) {
+      error_list.push_back(GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+          "field:childPolicy error:required field missing"));
+    } else {
+      grpc_error_handle parse_error = GRPC_ERROR_NONE;
+      child_policy = LoadBalancingPolicyRegistry::ParseLoadBalancingConfig(
+          it->second, &parse_error);
+      if (child_policy == nullptr) {
+        GPR_DEBUG_ASSERT(parse_error != GRPC_ERROR_NONE);
+        std::vector<grpc_error_handle> child_errors;
+        child_errors.push_back(parse_error);
+        error_list.push_back(
+            GRPC_ERROR_CREATE_FROM_VECTOR("field:childPolicy", &child_errors));
+      }
+    }
+    if (!error_list.empty()) {
+      *error = GRPC_ERROR_CREATE_FROM_VECTOR(
+          "deterministic_subsetting_experimental LB policy config",
+          &error_list);
+      return nullptr;
+    }
+    return MakeRefCounted<DeterministicSubsettingLbConfig>(
+        subset_size, std::move(child_policy));
+  }
+};
+
+}  // namespace
+
+//
+// Plugin registration
+//
+
+void GrpcLbPolicyDeterministicSubsettingInit() {
+  LoadBalancingPolicyRegistry::Builder::RegisterLoadBalancingPolicyFactory(
+      absl::make_unique<DeterministicSubsettingLbFactory>());
+}
+
+void GrpcLbPolicyDeterministicSubsettingShutdown() {}
+
+}  // namespace grpc_core
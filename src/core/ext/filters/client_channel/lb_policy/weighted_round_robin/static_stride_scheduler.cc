@@ -0,0 +1,84 @@
+//
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include <grpc/support/port_platform.h>
+
+#include "src/core/ext/filters/client_channel/lb_policy/weighted_round_robin/static_stride_scheduler.h"
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+namespace grpc_core {
+
+constexpr uint16_t StaticStrideScheduler::kMaxWeight;
+constexpr float StaticStrideScheduler::kMaxRatio;
+constexpr float StaticStrideScheduler::kMinRatio;
+
+std::unique_ptr<StaticStrideScheduler> StaticStrideScheduler::Make(
+    absl::Span<const float> weights, uint32_t initial_sequence) {
+  if (weights.size() < 2) return nullptr;
+  double sum = 0;
+  size_t num_positive = 0;
+  for (float weight : weights) {
+    if (weight > 0) {
+      sum += weight;
+      ++num_positive;
+    }
+  }
+  if (num_positive == 0) return nullptr;
+  const double mean = sum / num_positive;
+  const double max_weight = mean * kMaxRatio;
+  const double min_weight = mean * kMinRatio;
+  std::vector<double> clamped_weights;
+  clamped_weights.reserve(weights.size());
+  for (float weight : weights) {
+    clamped_weights.push_back(
+        weight > 0 ? std::min(std::max<double>(weight, min_weight), max_weight)
+                   : mean);
+  }
+  const double scale =
+      kMaxWeight /
+      *std::max_element(clamped_weights.begin(), clamped_weights.end());
+  std::vector<uint16_t> scaled_weights;
+  scaled_weights.reserve(weights.size());
+  for (double weight : clamped_weights) {
+    scaled_weights.push_back(static_cast<uint16_t>(
+        std::max(1.0, std::min(std::round(weight * scale), 1.0 * kMaxWeight))));
+  }
+  return std::unique_ptr<StaticStrideScheduler>(
+      new StaticStrideScheduler(std::move(scaled_weights), initial_sequence));
+}
+
+size_t StaticStrideScheduler::Pick() {
+  // Spreads the backends' acceptance windows across the sequence, so
+  // that backends with equal weights are not all accepted in a burst.
+  static constexpr uint64_t kOffset = kMaxWeight / 2;
+  const size_t num_backends = weights_.size();
+  while (true) {
+    const uint32_t sequence =
+        sequence_.fetch_add(1, std::memory_order_relaxed);
+    const size_t index = sequence % num_backends;
+    const uint64_t generation = sequence / num_backends;
+    const uint64_t weight = weights_[index];
+    if ((weight * generation + index * kOffset) % kMaxWeight >=
+        kMaxWeight - weight) {
+      return index;
+    }
+  }
+}
+
+}  // namespace grpc_core
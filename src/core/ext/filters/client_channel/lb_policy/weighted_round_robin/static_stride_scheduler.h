@@ -0,0 +1,84 @@
+//
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#ifndef GRPC_CORE_EXT_FILTERS_CLIENT_CHANNEL_LB_POLICY_WEIGHTED_ROUND_ROBIN_STATIC_STRIDE_SCHEDULER_H
+#define GRPC_CORE_EXT_FILTERS_CLIENT_CHANNEL_LB_POLICY_WEIGHTED_ROUND_ROBIN_STATIC_STRIDE_SCHEDULER_H
+
+#include <grpc/support/port_platform.h>
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+#include "absl/types/span.h"
+
+namespace grpc_core {
+
+// Picks indices in proportion to a fixed set of weights.
+//
+// The weights are scaled to integers no larger than kMaxWeight, and each
+// pick takes the next value of a shared sequence number.  The sequence
+// number walks the backends in round robin order; on its g-th visit to
+// a backend with scaled weight w, the backend is accepted only if
+// (w * g + offset) mod kMaxWeight >= kMaxWeight - w, which happens on
+// exactly w of every kMaxWeight visits.  Since the heaviest backend is
+// always accepted, a pick takes at most one pass over the backends.
+//
+// Pick() only does an atomic increment of the sequence number, so it may
+// be called concurrently from any number of threads without locking.
+// The weights cannot be changed; to apply new weights, build a new
+// scheduler.
+class StaticStrideScheduler {
+ public:
+  // The scaled weight of the heaviest backend.
+  static constexpr uint16_t kMaxWeight = UINT16_MAX;
+  // Weights are clamped to this multiple of the mean, so that a backend
+  // reporting a tiny utilization cannot take all of the traffic.
+  static constexpr float kMaxRatio = 10;
+  // Weights are clamped to this fraction of the mean, so that every
+  // backend still gets picked now and then.
+  static constexpr float kMinRatio = 0.01f;
+
+  // Returns a scheduler for the given weights, with the sequence number
+  // starting at initial_sequence.  Weights that are zero or negative
+  // (i.e., not known yet) are given the mean of the positive weights.
+  // Returns null if there are fewer than two weights or none of them are
+  // positive, in which case the caller should fall back to plain round
+  // robin.
+  static std::unique_ptr<StaticStrideScheduler> Make(
+      absl::Span<const float> weights, uint32_t initial_sequence);
+
+  // Returns the index of the picked backend.
+  size_t Pick();
+
+  // Returns the scaled weights.  For testing.
+  const std::vector<uint16_t>& weights() const { return weights_; }
+
+ private:
+  StaticStrideScheduler(std::vector<uint16_t> weights,
+                        uint32_t initial_sequence)
+      : weights_(std::move(weights)), sequence_(initial_sequence) {}
+
+  const std::vector<uint16_t> weights_;
+  std::atomic<uint32_t> sequence_;
+};
+
+}  // namespace grpc_core
+
+#endif  // GRPC_CORE_EXT_FILTERS_CLIENT_CHANNEL_LB_POLICY_WEIGHTED_ROUND_ROBIN_STATIC_STRIDE_SCHEDULER_H
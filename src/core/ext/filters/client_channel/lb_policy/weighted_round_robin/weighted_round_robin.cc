@@ -0,0 +1,913 @@
+//
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include <grpc/support/port_platform.h>
+
+#include <inttypes.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <algorithm>
+#include <atomic>
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "absl/memory/memory.h"
+#include "absl/random/random.h"
+#include "absl/status/status.h"
+#include "absl/status/statusor.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/str_join.h"
+#include "absl/types/optional.h"
+
+#include <grpc/impl/codegen/connectivity_state.h>
+#include <grpc/impl/codegen/grpc_types.h>
+#include <grpc/support/log.h>
+
+#include "src/core/ext/filters/client_channel/lb_policy.h"
+#include "src/core/ext/filters/client_channel/lb_policy/backend_metric_data.h"
+#include "src/core/ext/filters/client_channel/lb_policy/oob_backend_metric.h"
+#include "src/core/ext/filters/client_channel/lb_policy/subchannel_list.h"
+#include "src/core/ext/filters/client_channel/lb_policy/weighted_round_robin/static_stride_scheduler.h"
+#include "src/core/ext/filters/client_channel/lb_policy_factory.h"
+#include "src/core/ext/filters/client_channel/lb_policy_registry.h"
+#include "src/core/ext/filters/client_channel/subchannel_interface.h"
+#include "src/core/lib/address_utils/sockaddr_utils.h"
+#include "src/core/lib/debug/trace.h"
+#include "src/core/lib/gprpp/debug_location.h"
+#include "src/core/lib/gprpp/orphanable.h"
+#include "src/core/lib/gprpp/ref_counted.h"
+#include "src/core/lib/gprpp/ref_counted_ptr.h"
+#include "src/core/lib/gprpp/sync.h"
+#include "src/core/lib/gprpp/time.h"
+#include "src/core/lib/iomgr/closure.h"
+#include "src/core/lib/iomgr/error.h"
+#include "src/core/lib/iomgr/exec_ctx.h"
+#include "src/core/lib/iomgr/timer.h"
+#include "src/core/lib/iomgr/work_serializer.h"
+#include "src/core/lib/json/json.h"
+#include "src/core/lib/json/json_util.h"
+#include "src/core/lib/resolver/server_address.h"
+#include "src/core/lib/transport/connectivity_state.h"
+
+namespace grpc_core {
+
+TraceFlag grpc_lb_wrr_trace(false, "weighted_round_robin_lb");
+
+namespace {
+
+constexpr char kWeightedRoundRobin[] = "weighted_round_robin_experimental";
+
+// Config for WRR policy.
+class WeightedRoundRobinConfig : public LoadBalancingPolicy::Config {
+ public:
+  WeightedRoundRobinConfig(bool enable_oob_load_report,
+                           Duration oob_reporting_period,
+                           Duration blackout_period,
+                           Duration weight_update_period,
+                           Duration weight_expiration_period)
+      : enable_oob_load_report_(enable_oob_load_report),
+        oob_reporting_period_(oob_reporting_period),
+        blackout_period_(blackout_period),
+        weight_update_period_(weight_update_period),
+        weight_expiration_period_(weight_expiration_period) {}
+
+  const char* name() const override { return kWeightedRoundRobin; }
+
+  bool enable_oob_load_report() const { return enable_oob_load_report_; }
+  Duration oob_reporting_period() const { return oob_reporting_period_; }
+  Duration blackout_period() const { return blackout_period_; }
+  Duration weight_update_period() const { return weight_update_period_; }
+  Duration weight_expiration_period() const {
+    return weight_expiration_period_;
+  }
+
+ private:
+  bool enable_oob_load_report_;
+  Duration oob_reporting_period_;
+  Duration blackout_period_;
+  Duration weight_update_period_;
+  Duration weight_expiration_period_;
+};
+
+// WRR LB policy.
+//
+// Like round_robin, this keeps a connection to every address and spreads
+// picks across the READY ones.  Each address is weighted by qps divided
+// by CPU utilization, as reported by the backend via ORCA, either in the
+// trailing metadata of each call or on an out-of-band stream.
+//
+// Pickers are immutable and pick without locking.  Every
+// weight_update_period, the policy recomputes the weights and, if they
+// have changed, reports a new picker.
+class WeightedRoundRobin : public LoadBalancingPolicy {
+ public:
+  explicit WeightedRoundRobin(Args args);
+
+  const char* name() const override { return kWeightedRoundRobin; }
+
+  void UpdateLocked(UpdateArgs args) override;
+  void ResetBackoffLocked() override;
+
+ private:
+  // The weight for a particular address.  Outlives any one subchannel
+  // list, so that an address keeps its weight across resolver updates.
+  // Updated from backend metric reports, which may come in on any thread.
+  class AddressWeight : public RefCounted<AddressWeight> {
+   public:
+    explicit AddressWeight(std::string key) : key_(std::move(key)) {}
+
+    const std::string& key() const { return key_; }
+
+    // Updates the weight from a backend metric report.  Reports that
+    // lack qps or CPU utilization are ignored.
+    void MaybeUpdateWeight(double qps, double cpu_utilization);
+
+    // Returns the weight to use at time now, or zero if the weight is
+    // not usable, i.e., there has been no report within the expiration
+    // period or the address is still in its blackout period.
+    float GetWeight(Timestamp now, Duration weight_expiration_period,
+                    Duration blackout_period);
+
+    // Restarts the blackout period.  Called when the subchannel becomes
+    // READY, since its load may not be like what was last reported.
+    void ResetNonEmptySince();
+
+   private:
+    const std::string key_;
+
+    Mutex mu_;
+    float weight_ ABSL_GUARDED_BY(&mu_) = 0;
+    // The time of the first report since the weight was last reset.
+    Timestamp non_empty_since_ ABSL_GUARDED_BY(&mu_) = Timestamp::InfFuture();
+    Timestamp last_update_time_ ABSL_GUARDED_BY(&mu_) = Timestamp::InfPast();
+  };
+
+  // Forward declaration.
+  class WrrSubchannelList;
+
+  // Data for a particular subchannel in a subchannel list.
+  // This subclass adds the following functionality:
+  // - Tracks the previous connectivity state of the subchannel, so that
+  //   we know how many subchannels are in each state.
+  // - Holds the weight for the subchannel's address, and feeds it from
+  //   an OOB backend metric watcher if so configured.
+  class WrrSubchannelData
+      : public SubchannelData<WrrSubchannelList, WrrSubchannelData> {
+   public:
+    WrrSubchannelData(
+        SubchannelList<WrrSubchannelList, WrrSubchannelData>* subchannel_list,
+        const ServerAddress& address,
+        RefCountedPtr<SubchannelInterface> subchannel);
+
+    absl::optional<grpc_connectivity_state> connectivity_state() const {
+      return logical_connectivity_state_;
+    }
+
+    const RefCountedPtr<AddressWeight>& weight() const { return weight_; }
+
+   private:
+    class OobWatcher : public OobBackendMetricWatcher {
+     public:
+      explicit OobWatcher(RefCountedPtr<AddressWeight> weight)
+          : weight_(std::move(weight)) {}
+
+      void OnBackendMetricReport(
+          const BackendMetricData& backend_metric_data) override {
+        weight_->MaybeUpdateWeight(backend_metric_data.qps,
+                                   backend_metric_data.cpu_utilization);
+      }
+
+     private:
+      RefCountedPtr<AddressWeight> weight_;
+    };
+
+    // Performs connectivity state updates that need to be done only
+    // after we have started watching.
+    void ProcessConnectivityChangeLocked(
+        absl::optional<grpc_connectivity_state> old_state,
+        grpc_connectivity_state new_state) override;
+
+    // Updates the logical connectivity state.  Returns true if the
+    // state has changed.
+    bool UpdateLogicalConnectivityStateLocked(
+        grpc_connectivity_state connectivity_state);
+
+    // The logical connectivity state of the subchannel.
+    // Note that the logical connectivity state may differ from the
+    // actual reported state in some cases (e.g., after we see
+    // TRANSIENT_FAILURE, we ignore any subsequent state changes until
+    // we see READY).
+    absl::optional<grpc_connectivity_state> logical_connectivity_state_;
+
+    RefCountedPtr<AddressWeight> weight_;
+  };
+
+  // A list of subchannels.
+  class WrrSubchannelList
+      : public SubchannelList<WrrSubchannelList, WrrSubchannelData> {
+   public:
+    WrrSubchannelList(WeightedRoundRobin* policy, ServerAddressList addresses,
+                      const grpc_channel_args& args)
+        : SubchannelList(policy,
+                         (GRPC_TRACE_FLAG_ENABLED(grpc_lb_wrr_trace)
+                              ? "WrrSubchannelList"
+                              : nullptr),
+                         std::move(addresses), policy->channel_control_helper(),
+                         args) {
+      // Need to maintain a ref to the LB policy as long as we maintain
+      // any references to subchannels, since the subchannels'
+      // pollset_sets will include the LB policy's pollset_set.
+      policy->Ref(DEBUG_LOCATION, "subchannel_list").release();
+      // Start connecting to all subchannels.
+      for (size_t i = 0; i < num_subchannels(); i++) {
+        subchannel(i)->subchannel()->RequestConnection();
+      }
+    }
+
+    ~WrrSubchannelList() override {
+      WeightedRoundRobin* p = static_cast<WeightedRoundRobin*>(policy());
+      p->Unref(DEBUG_LOCATION, "subchannel_list");
+    }
+
+    size_t num_ready() const { return num_ready_; }
+
+    // Updates the counters of subchannels in each state when a
+    // subchannel transitions from old_state to new_state.
+    void UpdateStateCountersLocked(
+        absl::optional<grpc_connectivity_state> old_state,
+        grpc_connectivity_state new_state);
+
+    // Ensures that the right subchannel list is used and then updates
+    // the WRR policy's connectivity state based on the subchannel list's
+    // state counters.
+    void MaybeUpdateWrrConnectivityStateLocked(absl::Status status_for_tf);
+
+   private:
+    std::string CountersString() const {
+      return absl::StrCat("num_subchannels=", num_subchannels(),
+                          " num_ready=", num_ready_,
+                          " num_connecting=", num_connecting_,
+                          " num_transient_failure=", num_transient_failure_);
+    }
+
+    size_t num_ready_ = 0;
+    size_t num_connecting_ = 0;
+    size_t num_transient_failure_ = 0;
+  };
+
+  class Picker : public SubchannelPicker {
+   public:
+    struct Endpoint {
+      RefCountedPtr<SubchannelInterface> subchannel;
+      RefCountedPtr<AddressWeight> weight;
+    };
+
+    Picker(WeightedRoundRobin* parent, std::vector<Endpoint> endpoints,
+           const std::vector<float>& weights, uint32_t initial_sequence);
+
+    PickResult Pick(PickArgs args) override;
+
+   private:
+    // Feeds per-call backend metric reports into the address's weight.
+    class SubchannelCallTracker : public SubchannelCallTrackerInterface {
+     public:
+      explicit SubchannelCallTracker(RefCountedPtr<AddressWeight> weight)
+          : weight_(std::move(weight)) {}
+
+      void Start() override {}
+
+      void Finish(FinishArgs args) override {
+        const BackendMetricData* backend_metric_data =
+            args.backend_metric_accessor->GetBackendMetricData();
+        if (backend_metric_data != nullptr) {
+          weight_->MaybeUpdateWeight(backend_metric_data->qps,
+                                     backend_metric_data->cpu_utilization);
+        }
+      }
+
+     private:
+      RefCountedPtr<AddressWeight> weight_;
+    };
+
+    // Using pointer value only, no ref held -- do not dereference!
+    WeightedRoundRobin* parent_;
+
+    const bool use_per_call_reports_;
+    const std::vector<Endpoint> endpoints_;
+    // Null if there are not enough weights to go by, in which case we
+    // fall back to round robin.
+    const std::unique_ptr<StaticStrideScheduler> scheduler_;
+    std::atomic<size_t> last_picked_index_;
+  };
+
+  // Periodically recomputes the weights.
+  class WeightUpdateTimer : public InternallyRefCounted<WeightUpdateTimer> {
+   public:
+    explicit WeightUpdateTimer(RefCountedPtr<WeightedRoundRobin> parent);
+
+    void Orphan() override;
+
+   private:
+    static void OnTimer(void* arg, grpc_error_handle error);
+    void OnTimerLocked(grpc_error_handle error);
+
+    RefCountedPtr<WeightedRoundRobin> parent_;
+    grpc_timer timer_;
+    grpc_closure on_timer_;
+    bool timer_pending_ = true;
+  };
+
+  ~WeightedRoundRobin() override;
+
+  void ShutdownLocked() override;
+
+  // Returns the weight for address, creating it if needed.
+  RefCountedPtr<AddressWeight> GetOrCreateWeightLocked(
+      const ServerAddress& address);
+
+  // Reports READY with a new picker for the READY subchannels in
+  // subchannel_list_.  Unless force is true, does nothing if the weights
+  // are the same as in the last picker.
+  void UpdatePickerLocked(bool force);
+
+  // Current config from the resolver.
+  RefCountedPtr<WeightedRoundRobinConfig> config_;
+
+  // List of subchannels.
+  OrphanablePtr<WrrSubchannelList> subchannel_list_;
+  // Latest pending subchannel list.
+  // When we get an updated address list, we create a new subchannel list
+  // for it here, and we wait to swap it into subchannel_list_ until the new
+  // list becomes READY.
+  OrphanablePtr<WrrSubchannelList> latest_pending_subchannel_list_;
+
+  // Weights for the addresses in subchannel_list_ and
+  // latest_pending_subchannel_list_, keyed by address.
+  std::map<std::string, RefCountedPtr<AddressWeight>> address_weight_map_;
+
+  // The weights in the last picker we reported.
+  std::vector<float> picker_weights_;
+
+  OrphanablePtr<WeightUpdateTimer> weight_update_timer_;
+
+  absl::BitGen bit_gen_;
+
+  bool shutdown_ = false;
+};
+
+//
+// WeightedRoundRobin::AddressWeight
+//
+
+void WeightedRoundRobin::AddressWeight::MaybeUpdateWeight(
+    double qps, double cpu_utilization) {
+  if (qps <= 0 || cpu_utilization <= 0) {
+    if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_wrr_trace)) {
+      gpr_log(GPR_INFO,
+              "[WRR %p] subchannel %s: qps=%f, cpu_utilization=%f: "
+              "ignoring report",
+              this, key_.c_str(), qps, cpu_utilization);
+    }
+    return;
+  }
+  const float weight = qps / cpu_utilization;
+  const Timestamp now = ExecCtx::Get()->Now();
+  MutexLock lock(&mu_);
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_wrr_trace)) {
+    gpr_log(GPR_INFO,
+            "[WRR %p] subchannel %s: qps=%f, cpu_utilization=%f: "
+            "weight=%f (prev=%f)",
+            this, key_.c_str(), qps, cpu_utilization, weight, weight_);
+  }
+  if (non_empty_since_ == Timestamp::InfFuture()) non_empty_since_ = now;
+  weight_ = weight;
+  last_update_time_ = now;
+}
+
+float WeightedRoundRobin::AddressWeight::GetWeight(
+    Timestamp now, Duration weight_expiration_period,
+    Duration blackout_period) {
+  MutexLock lock(&mu_);
+  // If the most recent update was longer ago than the expiration
+  // period, reset non_empty_since_ so that we apply the blackout period
+  // again if we start getting data again in the future, and return 0.
+  if (now - last_update_time_ >= weight_expiration_period) {
+    non_empty_since_ = Timestamp::InfFuture();
+    return 0;
+  }
+  // If we don't have at least blackout_period worth of data, return 0.
+  if (blackout_period > Duration::Zero() &&
+      now - non_empty_since_ < blackout_period) {
+    return 0;
+  }
+  return weight_;
+}
+
+void WeightedRoundRobin::AddressWeight::ResetNonEmptySince() {
+  MutexLock lock(&mu_);
+  non_empty_since_ = Timestamp::InfFuture();
+}
+
+//
+// WeightedRoundRobin::Picker
+//
+
+WeightedRoundRobin::Picker::Picker(WeightedRoundRobin* parent,
+                                   std::vector<Endpoint> endpoints,
+                                   const std::vector<float>& weights,
+                                   uint32_t initial_sequence)
+    : parent_(parent),
+      use_per_call_reports_(!parent->config_->enable_oob_load_report()),
+      endpoints_(std::move(endpoints)),
+      scheduler_(StaticStrideScheduler::Make(weights, initial_sequence)),
+      last_picked_index_(initial_sequence) {
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_wrr_trace)) {
+    gpr_log(GPR_INFO,
+            "[WRR %p picker %p] created picker with %" PRIuPTR
+            " READY subchannels; weights=[%s]; using %s",
+            parent_, this, endpoints_.size(),
+            absl::StrJoin(weights, " ").c_str(),
+            scheduler_ != nullptr ? "stride scheduler" : "round robin");
+  }
+}
+
+WeightedRoundRobin::PickResult WeightedRoundRobin::Picker::Pick(
+    PickArgs /*args*/) {
+  const size_t index =
+      scheduler_ != nullptr
+          ? scheduler_->Pick()
+          : last_picked_index_.fetch_add(1, std::memory_order_relaxed) %
+                endpoints_.size();
+  const Endpoint& endpoint = endpoints_[index];
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_wrr_trace)) {
+    gpr_log(GPR_INFO,
+            "[WRR %p picker %p] returning index %" PRIuPTR ", subchannel=%p",
+            parent_, this, index, endpoint.subchannel.get());
+  }
+  std::unique_ptr<SubchannelCallTrackerInterface> subchannel_call_tracker;
+  if (use_per_call_reports_) {
+    subchannel_call_tracker =
+        absl::make_unique<SubchannelCallTracker>(endpoint.weight);
+  }
+  return PickResult::Complete(endpoint.subchannel,
+                              std::move(subchannel_call_tracker));
+}
+
+//
+// WeightedRoundRobin::WeightUpdateTimer
+//
+
+WeightedRoundRobin::WeightUpdateTimer::WeightUpdateTimer(
+    RefCountedPtr<WeightedRoundRobin> parent)
+    : parent_(std::move(parent)) {
+  GRPC_CLOSURE_INIT(&on_timer_, OnTimer, this, nullptr);
+  Ref().release();
+  grpc_timer_init(
+      &timer_,
+      ExecCtx::Get()->Now() + parent_->config_->weight_update_period(),
+      &on_timer_);
+}
+
+void WeightedRoundRobin::WeightUpdateTimer::Orphan() {
+  if (timer_pending_) {
+    timer_pending_ = false;
+    grpc_timer_cancel(&timer_);
+  }
+  Unref();
+}
+
+void WeightedRoundRobin::WeightUpdateTimer::OnTimer(void* arg,
+                                                    grpc_error_handle error) {
+  auto* self = static_cast<WeightUpdateTimer*>(arg);
+  (void)GRPC_ERROR_REF(error);  // ref owned by lambda
+  self->parent_->work_serializer()->Run(
+      [self, error]() { self->OnTimerLocked(error); }, DEBUG_LOCATION);
+}
+
+void WeightedRoundRobin::WeightUpdateTimer::OnTimerLocked(
+    grpc_error_handle error) {
+  if (error == GRPC_ERROR_NONE && timer_pending_) {
+    timer_pending_ = false;
+    if (parent_->subchannel_list_ != nullptr &&
+        parent_->subchannel_list_->num_ready() > 0) {
+      parent_->UpdatePickerLocked(/*force=*/false);
+    }
+    parent_->weight_update_timer_ = MakeOrphanable<WeightUpdateTimer>(parent_);
+  }
+  Unref(DEBUG_LOCATION, "Timer");
+  GRPC_ERROR_UNREF(error);
+}
+
+//
+// WeightedRoundRobin
+//
+
+WeightedRoundRobin::WeightedRoundRobin(Args args)
+    : LoadBalancingPolicy(std::move(args)) {
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_wrr_trace)) {
+    gpr_log(GPR_INFO, "[WRR %p] Created", this);
+  }
+}
+
+WeightedRoundRobin::~WeightedRoundRobin() {
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_wrr_trace)) {
+    gpr_log(GPR_INFO, "[WRR %p] Destroying WRR policy", this);
+  }
+  GPR_ASSERT(subchannel_list_ == nullptr);
+  GPR_ASSERT(latest_pending_subchannel_list_ == nullptr);
+}
+
+void WeightedRoundRobin::ShutdownLocked() {
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_wrr_trace)) {
+    gpr_log(GPR_INFO, "[WRR %p] Shutting down", this);
+  }
+  shutdown_ = true;
+  weight_update_timer_.reset();
+  subchannel_list_.reset();
+  latest_pending_subchannel_list_.reset();
+}
+
+void WeightedRoundRobin::ResetBackoffLocked() {
+  subchannel_list_->ResetBackoffLocked();
+  if (latest_pending_subchannel_list_ != nullptr) {
+    latest_pending_subchannel_list_->ResetBackoffLocked();
+  }
+}
+
+RefCountedPtr<WeightedRoundRobin::AddressWeight>
+WeightedRoundRobin::GetOrCreateWeightLocked(const ServerAddress& address) {
+  absl::StatusOr<std::string> key =
+      grpc_sockaddr_to_string(&address.address(), /*normalize=*/false);
+  std::string key_str = key.ok() ? std::move(*key) : address.ToString();
+  auto& weight = address_weight_map_[key_str];
+  if (weight == nullptr) {
+    weight = MakeRefCounted<AddressWeight>(std::move(key_str));
+  }
+  return weight;
+}
+
+void WeightedRoundRobin::UpdatePickerLocked(bool force) {
+  const Timestamp now = ExecCtx::Get()->Now();
+  std::vector<Picker::Endpoint> endpoints;
+  std::vector<float> weights;
+  for (size_t i = 0; i < subchannel_list_->num_subchannels(); ++i) {
+    WrrSubchannelData* sd = subchannel_list_->subchannel(i);
+    if (sd->connectivity_state().value_or(GRPC_CHANNEL_IDLE) !=
+        GRPC_CHANNEL_READY) {
+      continue;
+    }
+    endpoints.push_back({sd->subchannel()->Ref(), sd->weight()});
+    weights.push_back(
+        sd->weight()->GetWeight(now, config_->weight_expiration_period(),
+                                config_->blackout_period()));
+  }
+  if (!force && weights == picker_weights_) return;
+  picker_weights_ = weights;
+  channel_control_helper()->UpdateState(
+      GRPC_CHANNEL_READY, absl::Status(),
+      absl::make_unique<Picker>(this, std::move(endpoints), weights,
+                                absl::Uniform<uint32_t>(bit_gen_)));
+}
+
+void WeightedRoundRobin::UpdateLocked(UpdateArgs args) {
+  config_ = std::move(args.config);
+  ServerAddressList addresses;
+  if (args.addresses.ok()) {
+    if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_wrr_trace)) {
+      gpr_log(GPR_INFO, "[WRR %p] received update with %" PRIuPTR " addresses",
+              this, args.addresses->size());
+    }
+    addresses = std::move(*args.addresses);
+  } else {
+    if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_wrr_trace)) {
+      gpr_log(GPR_INFO, "[WRR %p] received update with address error: %s",
+              this, args.addresses.status().ToString().c_str());
+    }
+    // If we already have a subchannel list, then ignore the resolver
+    // failure and keep using the existing list.
+    if (subchannel_list_ != nullptr) return;
+  }
+  // Restart the weight update timer, in case its period has changed.
+  weight_update_timer_ = MakeOrphanable<WeightUpdateTimer>(
+      Ref(DEBUG_LOCATION, "WeightUpdateTimer"));
+  // Create new subchannel list, replacing the previous pending list, if any.
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_wrr_trace) &&
+      latest_pending_subchannel_list_ != nullptr) {
+    gpr_log(GPR_INFO, "[WRR %p] replacing previous pending subchannel list %p",
+            this, latest_pending_subchannel_list_.get());
+  }
+  latest_pending_subchannel_list_ = MakeOrphanable<WrrSubchannelList>(
+      this, std::move(addresses), *args.args);
+  // Drop the weights of addresses that are in neither list.
+  std::map<std::string, RefCountedPtr<AddressWeight>> address_weight_map;
+  for (WrrSubchannelList* subchannel_list :
+       {subchannel_list_.get(), latest_pending_subchannel_list_.get()}) {
+    if (subchannel_list == nullptr) continue;
+    for (size_t i = 0; i < subchannel_list->num_subchannels(); ++i) {
+      const auto& weight = subchannel_list->subchannel(i)->weight();
+      address_weight_map.emplace(weight->key(), weight);
+    }
+  }
+  address_weight_map_ = std::move(address_weight_map);
+  // If the new list is empty, immediately promote it to
+  // subchannel_list_ and report TRANSIENT_FAILURE.
+  if (latest_pending_subchannel_list_->num_subchannels() == 0) {
+    if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_wrr_trace) &&
+        subchannel_list_ != nullptr) {
+      gpr_log(GPR_INFO, "[WRR %p] replacing previous subchannel list %p", this,
+              subchannel_list_.get());
+    }
+    subchannel_list_ = std::move(latest_pending_subchannel_list_);
+    absl::Status status =
+        args.addresses.ok() ? absl::UnavailableError(absl::StrCat(
+                                  "empty address list: ", args.resolution_note))
+                            : args.addresses.status();
+    channel_control_helper()->UpdateState(
+        GRPC_CHANNEL_TRANSIENT_FAILURE, status,
+        absl::make_unique<TransientFailurePicker>(status));
+  }
+  // Otherwise, if this is the initial update, immediately promote it to
+  // subchannel_list_ and report CONNECTING.
+  else if (subchannel_list_.get() == nullptr) {
+    subchannel_list_ = std::move(latest_pending_subchannel_list_);
+    channel_control_helper()->UpdateState(
+        GRPC_CHANNEL_CONNECTING, absl::Status(),
+        absl::make_unique<QueuePicker>(Ref(DEBUG_LOCATION, "QueuePicker")));
+  }
+}
+
+//
+// WrrSubchannelList
+//
+
+void WeightedRoundRobin::WrrSubchannelList::UpdateStateCountersLocked(
+    absl::optional<grpc_connectivity_state> old_state,
+    grpc_connectivity_state new_state) {
+  if (old_state.has_value()) {
+    GPR_ASSERT(*old_state != GRPC_CHANNEL_SHUTDOWN);
+    if (*old_state == GRPC_CHANNEL_READY) {
+      GPR_ASSERT(num_ready_ > 0);
+      --num_ready_;
+    } else if (*old_state == GRPC_CHANNEL_CONNECTING) {
+      GPR_ASSERT(num_connecting_ > 0);
+      --num_connecting_;
+    } else if (*old_state == GRPC_CHANNEL_TRANSIENT_FAILURE) {
+      GPR_ASSERT(num_transient_failure_ > 0);
+      --num_transient_failure_;
+    }
+  }
+  GPR_ASSERT(new_state != GRPC_CHANNEL_SHUTDOWN);
+  if (new_state == GRPC_CHANNEL_READY) {
+    ++num_ready_;
+  } else if (new_state == GRPC_CHANNEL_CONNECTING) {
+    ++num_connecting_;
+  } else if (new_state == GRPC_CHANNEL_TRANSIENT_FAILURE) {
+    ++num_transient_failure_;
+  }
+}
+
+void WeightedRoundRobin::WrrSubchannelList::
+    MaybeUpdateWrrConnectivityStateLocked(absl::Status status_for_tf) {
+  WeightedRoundRobin* p = static_cast<WeightedRoundRobin*>(policy());
+  // If this is latest_pending_subchannel_list_, then swap it into
+  // subchannel_list_ in the following cases:
+  // - subchannel_list_ has no READY subchannels.
+  // - This list has at least one READY subchannel.
+  // - All of the subchannels in this list are in TRANSIENT_FAILURE.
+  //   (This may cause the channel to go from READY to TRANSIENT_FAILURE,
+  //   but we're doing what the control plane told us to do.)
+  if (p->latest_pending_subchannel_list_.get() == this &&
+      (p->subchannel_list_->num_ready_ == 0 || num_ready_ > 0 ||
+       num_transient_failure_ == num_subchannels())) {
+    if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_wrr_trace)) {
+      const std::string old_counters_string =
+          p->subchannel_list_ != nullptr ? p->subchannel_list_->CountersString()
+                                         : "";
+      gpr_log(
+          GPR_INFO,
+          "[WRR %p] swapping out subchannel list %p (%s) in favor of %p (%s)",
+          p, p->subchannel_list_.get(), old_counters_string.c_str(), this,
+          CountersString().c_str());
+    }
+    p->subchannel_list_ = std::move(p->latest_pending_subchannel_list_);
+  }
+  // Only set connectivity state if this is the current subchannel list.
+  if (p->subchannel_list_.get() != this) return;
+  // First matching rule wins:
+  // 1) ANY subchannel is READY => policy is READY.
+  // 2) ANY subchannel is CONNECTING => policy is CONNECTING.
+  // 3) ALL subchannels are TRANSIENT_FAILURE => policy is TRANSIENT_FAILURE.
+  if (num_ready_ > 0) {
+    if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_wrr_trace)) {
+      gpr_log(GPR_INFO, "[WRR %p] reporting READY with subchannel list %p", p,
+              this);
+    }
+    p->UpdatePickerLocked(/*force=*/true);
+  } else if (num_connecting_ > 0) {
+    if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_wrr_trace)) {
+      gpr_log(GPR_INFO, "[WRR %p] reporting CONNECTING with subchannel list %p",
+              p, this);
+    }
+    p->channel_control_helper()->UpdateState(
+        GRPC_CHANNEL_CONNECTING, absl::Status(),
+        absl::make_unique<QueuePicker>(p->Ref(DEBUG_LOCATION, "QueuePicker")));
+  } else if (num_transient_failure_ == num_subchannels()) {
+    if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_wrr_trace)) {
+      gpr_log(GPR_INFO,
+              "[WRR %p] reporting TRANSIENT_FAILURE with subchannel list %p: "
+              "%s",
+              p, this, status_for_tf.ToString().c_str());
+    }
+    p->channel_control_helper()->UpdateState(
+        GRPC_CHANNEL_TRANSIENT_FAILURE, status_for_tf,
+        absl::make_unique<TransientFailurePicker>(status_for_tf));
+  }
+}
+
+//
+// WrrSubchannelData
+//
+
+WeightedRoundRobin::WrrSubchannelData::WrrSubchannelData(
+    SubchannelList<WrrSubchannelList, WrrSubchannelData>* subchannel_list,
+    const ServerAddress& address, RefCountedPtr<SubchannelInterface> subchannel)
+    : SubchannelData(subchannel_list, address, std::move(subchannel)) {
+  WeightedRoundRobin* p =
+      static_cast<WeightedRoundRobin*>(subchannel_list->policy());
+  weight_ = p->GetOrCreateWeightLocked(address);
+  if (p->config_->enable_oob_load_report()) {
+    this->subchannel()->AddDataWatcher(MakeOobBackendMetricWatcher(
+        p->config_->oob_reporting_period(),
+        absl::make_unique<OobWatcher>(weight_)));
+  }
+}
+
+void WeightedRoundRobin::WrrSubchannelData::ProcessConnectivityChangeLocked(
+    absl::optional<grpc_connectivity_state> old_state,
+    grpc_connectivity_state new_state) {
+  WeightedRoundRobin* p =
+      static_cast<WeightedRoundRobin*>(subchannel_list()->policy());
+  GPR_ASSERT(subchannel() != nullptr);
+  // If this is not the initial state notification and the new state is
+  // TRANSIENT_FAILURE or IDLE, re-resolve and attempt to reconnect.
+  // Note that we don't want to do this on the initial state
+  // notification, because that would result in an endless loop of
+  // re-resolution.
+  if (old_state.has_value() && (new_state == GRPC_CHANNEL_TRANSIENT_FAILURE ||
+                                new_state == GRPC_CHANNEL_IDLE)) {
+    if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_wrr_trace)) {
+      gpr_log(GPR_INFO,
+              "[WRR %p] Subchannel %p reported %s; requesting re-resolution", p,
+              subchannel(), ConnectivityStateName(new_state));
+    }
+    p->channel_control_helper()->RequestReresolution();
+    subchannel()->RequestConnection();
+  }
+  // A newly connected backend may have a very different load than it
+  // last reported, so apply the blackout period again.  The initial
+  // notification is not a reconnection: a subchannel that is already
+  // READY when a resolver update creates a new list keeps its weight.
+  if (new_state == GRPC_CHANNEL_READY && old_state.has_value() &&
+      *old_state != GRPC_CHANNEL_READY) {
+    weight_->ResetNonEmptySince();
+  }
+  // Update logical connectivity state.
+  // If it changed, update the policy state.
+  if (UpdateLogicalConnectivityStateLocked(new_state)) {
+    subchannel_list()->MaybeUpdateWrrConnectivityStateLocked(
+        absl::UnavailableError(
+            absl::StrCat("connections to all backends failing; last error: ",
+                         connectivity_status().ToString())));
+  }
+}
+
+bool WeightedRoundRobin::WrrSubchannelData::
+    UpdateLogicalConnectivityStateLocked(
+        grpc_connectivity_state connectivity_state) {
+  WeightedRoundRobin* p =
+      static_cast<WeightedRoundRobin*>(subchannel_list()->policy());
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_wrr_trace)) {
+    gpr_log(
+        GPR_INFO,
+        "[WRR %p] connectivity changed for subchannel %p, subchannel_list %p "
+        "(index %" PRIuPTR " of %" PRIuPTR "): prev_state=%s new_state=%s",
+        p, subchannel(), subchannel_list(), Index(),
+        subchannel_list()->num_subchannels(),
+        (logical_connectivity_state_.has_value()
+             ? ConnectivityStateName(*logical_connectivity_state_)
+             : "N/A"),
+        ConnectivityStateName(connectivity_state));
+  }
+  // Decide what state to report for aggregation purposes.
+  // If the last logical state was TRANSIENT_FAILURE, then ignore the
+  // state change unless the new state is READY.
+  if (logical_connectivity_state_.has_value() &&
+      *logical_connectivity_state_ == GRPC_CHANNEL_TRANSIENT_FAILURE &&
+      connectivity_state != GRPC_CHANNEL_READY) {
+    return false;
+  }
+  // If the new state is IDLE, treat it as CONNECTING, since it will
+  // immediately transition into CONNECTING anyway.
+  if (connectivity_state == GRPC_CHANNEL_IDLE) {
+    if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_wrr_trace)) {
+      gpr_log(GPR_INFO,
+              "[WRR %p] subchannel %p, subchannel_list %p (index %" PRIuPTR
+              " of %" PRIuPTR "): treating IDLE as CONNECTING",
+              p, subchannel(), subchannel_list(), Index(),
+              subchannel_list()->num_subchannels());
+    }
+    connectivity_state = GRPC_CHANNEL_CONNECTING;
+  }
+  // If no change, return false.
+  if (logical_connectivity_state_.has_value() &&
+      *logical_connectivity_state_ == connectivity_state) {
+    return false;
+  }
+  // Otherwise, update counters and logical state.
+  subchannel_list()->UpdateStateCountersLocked(logical_connectivity_state_,
+                                               connectivity_state);
+  logical_connectivity_state_ = connectivity_state;
+  return true;
+}
+
+//
+// factory
+//
+
+class WeightedRoundRobinFactory : public LoadBalancingPolicyFactory {
+ public:
+  OrphanablePtr<LoadBalancingPolicy> CreateLoadBalancingPolicy(
+      LoadBalancingPolicy::Args args) const override {
+    return MakeOrphanable<WeightedRoundRobin>(std::move(args));
+  }
+
+  const char* name() const override { return kWeightedRoundRobin; }
+
+  RefCountedPtr<LoadBalancingPolicy::Config> ParseLoadBalancingConfig(
+      const Json& json, grpc_error_handle* error) const override {
+    GPR_DEBUG_ASSERT(error != nullptr && *error == GRPC_ERROR_NONE);
+    bool enable_oob_load_report = false;
+    Duration oob_reporting_period = Duration::Seconds(10);
+    Duration blackout_period = Duration::Seconds(10);
+    Duration weight_update_period = Duration::Seconds(1);
+    Duration weight_expiration_period = Duration::Minutes(3);
+    std::vector<grpc_error_handle> error_list;
+    // All fields are optional, so the policy may also be selected in the
+    // deprecated loadBalancingPolicy field or in the client API.
+    if (json.type() == Json::Type::OBJECT) {
+      const Json::Object& object = json.object_value();
+      ParseJsonObjectField(object, "enableOobLoadReport",
+                           &enable_oob_load_report, &error_list,
+                           /*required=*/false);
+      ParseJsonObjectFieldAsDuration(object, "oobReportingPeriod",
+                                     &oob_reporting_period, &error_list,
+                                     /*required=*/false);
+      ParseJsonObjectFieldAsDuration(object, "blackoutPeriod",
+                                     &blackout_period, &error_list,
+                                     /*required=*/false);
+      ParseJsonObjectFieldAsDuration(object, "weightUpdatePeriod",
+                                     &weight_update_period, &error_list,
+                                     /*required=*/false);
+      ParseJsonObjectFieldAsDuration(object, "weightExpirationPeriod",
+                                     &weight_expiration_period, &error_list,
+                                     /*required=*/false);
+    }
+    if (!error_list.empty()) {
+      *error = GRPC_ERROR_CREATE_FROM_VECTOR(
+          "weighted_round_robin_experimental LB policy config", &error_list);
+      return nullptr;
+    }
+    return MakeRefCounted<WeightedRoundRobinConfig>(
+        enable_oob_load_report, oob_reporting_period, blackout_period,
+        std::max(weight_update_period, Duration::Milliseconds(100)),
+        weight_expiration_period);
+  }
+};
+
+}  // namespace
+
+void GrpcLbPolicyWeightedRoundRobinInit() {
+  LoadBalancingPolicyRegistry::Builder::RegisterLoadBalancingPolicyFactory(
+      absl::make_unique<WeightedRoundRobinFactory>());
+}
+
+void GrpcLbPolicyWeightedRoundRobinShutdown() {}
+
+}  // namespace grpc_core
@@ -107,13 +107,12 @@ class CdsLb : public LoadBalancingPolicy {
     ClusterWatcher(RefCountedPtr<CdsLb> parent, std::string name)
         : parent_(std::move(parent)), name_(std::move(name)) {}
 
-    void OnResourceChanged(XdsClusterResource cluster_data) override {
+    void OnResourceChanged(
+        std::shared_ptr<const XdsClusterResource> cluster_data) override {
       Ref().release();  // Ref held by lambda
       parent_->work_serializer()->Run(
-          // TODO(roth): When we move to C++14, capture cluster_data with
-          // std::move().
-          [this, cluster_data]() mutable {
-            parent_->OnClusterChanged(name_, std::move(cluster_data));
+          [this, cluster_data]() {
+            parent_->OnClusterChanged(name_, *cluster_data);
             Unref();
           },
           DEBUG_LOCATION);
@@ -175,7 +174,7 @@ class CdsLb : public LoadBalancingPolicy {
       const std::string& name, int depth, Json::Array* discovery_mechanisms,
       std::set<std::string>* clusters_added);
   void OnClusterChanged(const std::string& name,
-                        XdsClusterResource cluster_data);
+                        const XdsClusterResource& cluster_data);
   void OnError(const std::string& name, absl::Status status);
   void OnResourceDoesNotExist(const std::string& name);
 
@@ -454,7 +453,7 @@ absl::StatusOr<bool> CdsLb::GenerateDiscoveryMechanismForCluster(
 }
 
 void CdsLb::OnClusterChanged(const std::string& name,
-                             XdsClusterResource cluster_data) {
+                             const XdsClusterResource& cluster_data) {
   if (GRPC_TRACE_FLAG_ENABLED(grpc_cds_lb_trace)) {
     gpr_log(
         GPR_INFO,
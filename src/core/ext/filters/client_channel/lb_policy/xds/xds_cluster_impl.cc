@@ -41,6 +41,7 @@
 #include <grpc/support/log.h>
 
 #include "src/core/ext/filters/client_channel/lb_policy.h"
+#include "src/core/ext/filters/client_channel/lb_policy/backend_metric_data.h"
 #include "src/core/ext/filters/client_channel/lb_policy/child_policy_handler.h"
 #include "src/core/ext/filters/client_channel/lb_policy/xds/xds.h"
 #include "src/core/ext/filters/client_channel/lb_policy/xds/xds_channel_args.h"
@@ -339,7 +340,14 @@ class XdsClusterImplLb::Picker::SubchannelCallTracker
     }
     // Record call completion for load reporting.
     if (locality_stats_ != nullptr) {
-      locality_stats_->AddCallFinished(!args.status.ok());
+      const BackendMetricData* backend_metric_data =
+          args.backend_metric_accessor != nullptr
+              ? args.backend_metric_accessor->GetBackendMetricData()
+              : nullptr;
+      locality_stats_->AddCallFinished(
+          backend_metric_data != nullptr ? &backend_metric_data->request_cost
+                                         : nullptr,
+          !args.status.ok());
     }
     // Decrement number of calls in flight.
     call_counter_->Decrement();
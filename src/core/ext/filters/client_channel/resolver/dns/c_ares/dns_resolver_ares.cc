@@ -34,6 +34,7 @@
 #include "absl/status/statusor.h"
 #include "absl/strings/string_view.h"
 #include "absl/strings/strip.h"
+#include "absl/types/optional.h"
 
 #include <grpc/event_engine/event_engine.h>
 #include <grpc/impl/codegen/grpc_types.h>
@@ -82,6 +83,7 @@
 #include "src/core/lib/iomgr/gethostname.h"
 #include "src/core/lib/iomgr/resolve_address.h"
 #include "src/core/lib/json/json.h"
+#include "src/core/lib/json/json_view.h"
 #include "src/core/lib/resolver/resolver_registry.h"
 #include "src/core/lib/resolver/server_address.h"
 #include "src/core/lib/service_config/service_config_impl.h"
@@ -188,66 +190,80 @@ OrphanablePtr<Orphanable> AresClientChannelDNSResolver::StartRequest() {
       Ref(DEBUG_LOCATION, "dns-resolving"));
 }
 
-bool ValueInJsonArray(const Json::Array& array, const char* value) {
-  for (const Json& entry : array) {
-    if (entry.type() == Json::Type::STRING && entry.string_value() == value) {
+bool ValueInJsonArray(JsonView array, absl::string_view value) {
+  for (size_t i = 0; i < array.size(); ++i) {
+    if (array[i].type() == Json::Type::STRING &&
+        array[i].string_value() == value) {
       return true;
     }
   }
   return false;
 }
 
+// Only the chosen service config is copied out of the choices, which are
+// otherwise read in place.
 std::string ChooseServiceConfig(char* service_config_choice_json,
                                 grpc_error_handle* error) {
-  Json json = Json::Parse(service_config_choice_json, error);
-  if (*error != GRPC_ERROR_NONE) return "";
+  absl::optional<JsonDocument> document =
+      JsonDocument::Parse(service_config_choice_json);
+  if (!document.has_value()) {
+    // Let the reader describe what is wrong with the input.
+    Json::Parse(service_config_choice_json, error);
+    if (*error == GRPC_ERROR_NONE) {
+      *error = GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+          "Service Config Choices, error: invalid JSON");
+    }
+    return "";
+  }
+  JsonView json = document->root();
   if (json.type() != Json::Type::ARRAY) {
     *error = GRPC_ERROR_CREATE_FROM_STATIC_STRING(
         "Service Config Choices, error: should be of type array");
     return "";
   }
-  const Json* service_config = nullptr;
+  absl::optional<JsonView> service_config;
   absl::InlinedVector<grpc_error_handle, 4> error_list;
-  for (const Json& choice : json.array_value()) {
+  for (size_t i = 0; i < json.size(); ++i) {
+    JsonView choice = json[i];
     if (choice.type() != Json::Type::OBJECT) {
       error_list.push_back(GRPC_ERROR_CREATE_FROM_STATIC_STRING(
           "Service Config Choice, error: should be of type object"));
       continue;
     }
     // Check client language, if specified.
-    auto it = choice.object_value().find("clientLanguage");
-    if (it != choice.object_value().end()) {
-      if (it->second.type() != Json::Type::ARRAY) {
+    absl::optional<JsonView> field = choice.Find("clientLanguage");
+    if (field.has_value()) {
+      if (field->type() != Json::Type::ARRAY) {
         error_list.push_back(GRPC_ERROR_CREATE_FROM_STATIC_STRING(
             "field:clientLanguage error:should be of type array"));
-      } else if (!ValueInJsonArray(it->second.array_value(), "c++")) {
+      } else if (!ValueInJsonArray(*field, "c++")) {
         continue;
       }
     }
     // Check client hostname, if specified.
-    it = choice.object_value().find("clientHostname");
-    if (it != choice.object_value().end()) {
-      if (it->second.type() != Json::Type::ARRAY) {
+    field = choice.Find("clientHostname");
+    if (field.has_value()) {
+      if (field->type() != Json::Type::ARRAY) {
         error_list.push_back(GRPC_ERROR_CREATE_FROM_STATIC_STRING(
             "field:clientHostname error:should be of type array"));
       } else {
         char* hostname = grpc_gethostname();
-        if (hostname == nullptr ||
-            !ValueInJsonArray(it->second.array_value(), hostname)) {
+        if (hostname == nullptr || !ValueInJsonArray(*field, hostname)) {
           continue;
         }
       }
     }
     // Check percentage, if specified.
-    it = choice.object_value().find("percentage");
-    if (it != choice.object_value().end()) {
-      if (it->second.type() != Json::Type::NUMBER) {
+    field = choice.Find("percentage");
+    if (field.has_value()) {
+      if (field->type() != Json::Type::NUMBER) {
         error_list.push_back(GRPC_ERROR_CREATE_FROM_STATIC_STRING(
             "field:percentage error:should be of type number"));
       } else {
         int random_pct = rand() % 100;
         int percentage;
-        if (sscanf(it->second.string_value().c_str(), "%d", &percentage) != 1) {
+        if (sscanf(std::string(field->string_value()).c_str(), "%d",
+                   &percentage) != 1) {
           error_list.push_back(GRPC_ERROR_CREATE_FROM_STATIC_STRING(
               "field:percentage error:should be of type integer"));
         } else if (random_pct > percentage || percentage == 0) {
@@ -256,24 +272,24 @@ std::string ChooseServiceConfig(char* service_config_choice_json,
       }
     }
     // Found service config.
-    it = choice.object_value().find("serviceConfig");
-    if (it == choice.object_value().end()) {
+    field = choice.Find("serviceConfig");
+    if (!field.has_value()) {
       error_list.push_back(GRPC_ERROR_CREATE_FROM_STATIC_STRING(
           "field:serviceConfig error:required field missing"));
-    } else if (it->second.type() != Json::Type::OBJECT) {
+    } else if (field->type() != Json::Type::OBJECT) {
       error_list.push_back(GRPC_ERROR_CREATE_FROM_STATIC_STRING(
           "field:serviceConfig error:should be of type object"));
-    } else if (service_config == nullptr) {
-      service_config = &it->second;
+    } else if (!service_config.has_value()) {
+      service_config = field;
     }
   }
   if (!error_list.empty()) {
-    service_config = nullptr;
     *error = GRPC_ERROR_CREATE_FROM_VECTOR("Service Config Choices Parser",
                                            &error_list);
+    return "";
   }
-  if (service_config == nullptr) return "";
-  return service_config->Dump();
+  if (!service_config.has_value()) return "";
+  return service_config->ToJson().Dump();
 }
 
 void AresClientChannelDNSResolver::AresRequestWrapper::OnResolved(
@@ -163,13 +163,12 @@ class XdsResolver : public Resolver {
    public:
     explicit ListenerWatcher(RefCountedPtr<XdsResolver> resolver)
         : resolver_(std::move(resolver)) {}
-    void OnResourceChanged(XdsListenerResource listener) override {
+    void OnResourceChanged(
+        std::shared_ptr<const XdsListenerResource> listener) override {
       Ref().release();  // ref held by lambda
       resolver_->work_serializer_->Run(
-          // TODO(yashykt): When we move to C++14, capture listener with
-          // std::move
-          [this, listener]() mutable {
-            resolver_->OnListenerUpdate(std::move(listener));
+          [this, listener]() {
+            resolver_->OnListenerUpdate(*listener);
             Unref();
           },
           DEBUG_LOCATION);
@@ -202,13 +201,12 @@ class XdsResolver : public Resolver {
    public:
     explicit RouteConfigWatcher(RefCountedPtr<XdsResolver> resolver)
         : resolver_(std::move(resolver)) {}
-    void OnResourceChanged(XdsRouteConfigResource route_config) override {
+    void OnResourceChanged(
+        std::shared_ptr<const XdsRouteConfigResource> route_config) override {
       Ref().release();  // ref held by lambda
       resolver_->work_serializer_->Run(
-          // TODO(yashykt): When we move to C++14, capture route_config with
-          // std::move
-          [this, route_config]() mutable {
-            resolver_->OnRouteConfigUpdate(std::move(route_config));
+          [this, route_config]() {
+            resolver_->OnRouteConfigUpdate(*route_config);
             Unref();
           },
           DEBUG_LOCATION);
@@ -350,12 +348,13 @@ class XdsResolver : public Resolver {
 
     RefCountedPtr<XdsResolver> resolver_;
     RouteTable route_table_;
+    XdsRouting::CompiledRouteList compiled_routes_;
     std::map<absl::string_view, RefCountedPtr<ClusterState>> clusters_;
     std::vector<const grpc_channel_filter*> filters_;
   };
 
   void OnListenerUpdate(XdsListenerResource listener);
-  void OnRouteConfigUpdate(XdsRouteConfigResource rds_update);
+  void OnRouteConfigUpdate(const XdsRouteConfigResource& rds_update);
   void OnError(absl::string_view context, absl::Status status);
   void OnResourceDoesNotExist();
 
@@ -513,6 +512,8 @@ XdsResolver::XdsConfigSelector::XdsConfigSelector(
       }
     }
   }
+  compiled_routes_ =
+      XdsRouting::CompiledRouteList(RouteListIterator(&route_table_));
   // Populate filter list.
   for (const auto& http_filter :
        resolver_->current_listener_.http_connection_manager.http_filters) {
@@ -666,7 +667,7 @@ absl::optional<uint64_t> HeaderHashHelper(
 
 ConfigSelector::CallConfig XdsResolver::XdsConfigSelector::GetCallConfig(
     GetCallConfigArgs args) {
-  auto route_index = XdsRouting::GetRouteForRequest(
+  auto route_index = compiled_routes_.GetRouteForRequest(
       RouteListIterator(&route_table_), StringViewFromSlice(*args.path),
       args.initial_metadata);
   if (!route_index.has_value()) {
@@ -908,8 +909,8 @@ void XdsResolver::OnListenerUpdate(XdsListenerResource listener) {
   if (route_config_name_.empty()) {
     GPR_ASSERT(
         current_listener_.http_connection_manager.rds_update.has_value());
-    OnRouteConfigUpdate(
-        std::move(*current_listener_.http_connection_manager.rds_update));
+    OnRouteConfigUpdate(*current_listener_.http_connection_manager.rds_update);
+    current_listener_.http_connection_manager.rds_update.reset();
   } else {
     // HCM may contain newer filter config. We need to propagate the update as
     // config selector to the channel
@@ -917,26 +918,8 @@ void XdsResolver::OnListenerUpdate(XdsListenerResource listener) {
   }
 }
 
-namespace {
-class VirtualHostListIterator : public XdsRouting::VirtualHostListIterator {
- public:
-  explicit VirtualHostListIterator(
-      const std::vector<XdsRouteConfigResource::VirtualHost>* virtual_hosts)
-      : virtual_hosts_(virtual_hosts) {}
-
-  size_t Size() const override { return virtual_hosts_->size(); }
-
-  const std::vector<std::string>& GetDomainsForVirtualHost(
-      size_t index) const override {
-    return (*virtual_hosts_)[index].domains;
-  }
-
- private:
-  const std::vector<XdsRouteConfigResource::VirtualHost>* virtual_hosts_;
-};
-}  // namespace
-
-void XdsResolver::OnRouteConfigUpdate(XdsRouteConfigResource rds_update) {
+void XdsResolver::OnRouteConfigUpdate(
+    const XdsRouteConfigResource& rds_update) {
   if (GRPC_TRACE_FLAG_ENABLED(grpc_xds_resolver_trace)) {
     gpr_log(GPR_INFO, "[xds_resolver %p] received updated route config", this);
   }
@@ -944,9 +927,7 @@ void XdsResolver::OnRouteConfigUpdate(XdsRouteConfigResource rds_update) {
     return;
   }
   // Find the relevant VirtualHost from the RouteConfiguration.
-  auto vhost_index = XdsRouting::FindVirtualHostForDomain(
-      VirtualHostListIterator(&rds_update.virtual_hosts),
-      data_plane_authority_);
+  auto vhost_index = rds_update.FindVirtualHostForDomain(data_plane_authority_);
   if (!vhost_index.has_value()) {
     OnError(
         route_config_name_.empty() ? lds_resource_name_ : route_config_name_,
@@ -956,9 +937,8 @@ void XdsResolver::OnRouteConfigUpdate(XdsRouteConfigResource rds_update) {
     return;
   }
   // Save the virtual host in the resolver.
-  current_virtual_host_ = std::move(rds_update.virtual_hosts[*vhost_index]);
-  cluster_specifier_plugin_map_ =
-      std::move(rds_update.cluster_specifier_plugin_map);
+  current_virtual_host_ = rds_update.virtual_hosts[*vhost_index];
+  cluster_specifier_plugin_map_ = rds_update.cluster_specifier_plugin_map;
   // Send a new result to the channel.
   GenerateResult();
 }
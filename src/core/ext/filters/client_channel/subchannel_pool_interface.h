@@ -21,10 +21,16 @@
 
 #include <grpc/support/port_platform.h>
 
+#include <string.h>
+
 #include <string>
+#include <utility>
+
+#include "absl/strings/string_view.h"
 
 #include <grpc/impl/codegen/grpc_types.h>
 
+#include "src/core/lib/channel/channel_args.h"
 #include "src/core/lib/debug/trace.h"
 #include "src/core/lib/gprpp/ref_counted.h"
 #include "src/core/lib/gprpp/ref_counted_ptr.h"
@@ -37,36 +43,41 @@ class Subchannel;
 extern TraceFlag grpc_subchannel_pool_trace;
 
 // A key that can uniquely identify a subchannel.
+// The args are interned, so copying a key only takes a ref and keys compare
+// and hash without walking the args.
 class SubchannelKey {
  public:
   SubchannelKey(const grpc_resolved_address& address,
                 const grpc_channel_args* args);
-  ~SubchannelKey();
 
   // Copyable.
-  SubchannelKey(const SubchannelKey& other);
-  SubchannelKey& operator=(const SubchannelKey& other);
+  SubchannelKey(const SubchannelKey& other) = default;
+  SubchannelKey& operator=(const SubchannelKey& other) = default;
   // Movable
-  SubchannelKey(SubchannelKey&&) noexcept;
-  SubchannelKey& operator=(SubchannelKey&&) noexcept;
+  SubchannelKey(SubchannelKey&&) noexcept = default;
+  SubchannelKey& operator=(SubchannelKey&&) noexcept = default;
 
-  bool operator<(const SubchannelKey& other) const;
+  bool operator==(const SubchannelKey& other) const {
+    return args_ == other.args_ && address_.len == other.address_.len &&
+           memcmp(address_.addr, other.address_.addr, address_.len) == 0;
+  }
+
+  template <typename H>
+  friend H AbslHashValue(H h, const SubchannelKey& key) {
+    return H::combine(std::move(h),
+                      absl::string_view(key.address_.addr, key.address_.len),
+                      key.args_->hash());
+  }
 
   const grpc_resolved_address& address() const { return address_; }
-  const grpc_channel_args* args() const { return args_; }
+  const grpc_channel_args* args() const { return args_->args(); }
 
   // Human-readable string suitable for logging.
   std::string ToString() const;
 
  private:
-  // Initializes the subchannel key with the given \a args and the function to
-  // copy channel args.
-  void Init(
-      const grpc_resolved_address& address, const grpc_channel_args* args,
-      grpc_channel_args* (*copy_channel_args)(const grpc_channel_args* args));
-
   grpc_resolved_address address_;
-  const grpc_channel_args* args_;
+  RefCountedPtr<InternedChannelArgs> args_;
 };
 
 // Interface for subchannel pool.
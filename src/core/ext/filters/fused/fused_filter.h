@@ -0,0 +1,159 @@
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GRPC_CORE_EXT_FILTERS_FUSED_FUSED_FILTER_H
+#define GRPC_CORE_EXT_FILTERS_FUSED_FUSED_FILTER_H
+
+#include <grpc/support/port_platform.h>
+
+#include <stddef.h>
+
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "absl/status/statusor.h"
+
+#include "src/core/lib/channel/call_finalization.h"
+#include "src/core/lib/channel/channel_args.h"
+#include "src/core/lib/channel/channel_fwd.h"
+#include "src/core/lib/channel/promise_based_filter.h"
+#include "src/core/lib/promise/arena_promise.h"
+#include "src/core/lib/promise/context.h"
+#include "src/core/lib/resource_quota/arena.h"
+#include "src/core/lib/transport/transport.h"
+
+// Channel arg (bool): replace runs of adjacent promise based filters that form
+// one of the known combinations with a single fused filter. Defaults to false.
+#define GRPC_ARG_FUSE_FILTERS "grpc.experimental.fuse_filters"
+
+namespace grpc_core {
+
+// A channel filter that runs each of Filters in turn, in the order given, as
+// though they were adjacent in the channel stack.
+// Wrapped with MakePromiseBasedFilter the whole sequence shares one call data
+// block and one interception of each batch, and calls into each filter are
+// resolved at compile time rather than through the channel stack.
+template <typename... Filters>
+class FusedFilter final : public ChannelFilter {
+ public:
+  static_assert(sizeof...(Filters) >= 2, "Nothing to fuse");
+
+  static absl::StatusOr<FusedFilter> Create(ChannelArgs args,
+                                            ChannelFilter::Args filter_args) {
+    return CreateFrom(std::integral_constant<size_t, 0>(), args, filter_args);
+  }
+
+  ArenaPromise<ServerMetadataHandle> MakeCallPromise(
+      CallArgs call_args, NextPromiseFactory next_promise_factory) override {
+    // Keep the factory for the rest of the stack alive for as long as the
+    // call: any of the filters may ask for the next promise asynchronously.
+    auto* next = GetContext<Arena>()->New<NextPromiseFactory>(
+        std::move(next_promise_factory));
+    GetContext<CallFinalization>()->Add(
+        [next](const grpc_call_final_info*) { next->~NextPromiseFactory(); });
+    return MakeCallPromiseFrom(std::integral_constant<size_t, 0>(),
+                               std::move(call_args), next);
+  }
+
+  bool StartTransportOp(grpc_transport_op* op) override {
+    return StartTransportOpFrom(std::integral_constant<size_t, 0>(), op);
+  }
+
+  bool GetChannelInfo(const grpc_channel_info* info) override {
+    return GetChannelInfoFrom(std::integral_constant<size_t, 0>(), info);
+  }
+
+  void PostInit() override {
+    PostInitFrom(std::integral_constant<size_t, 0>());
+  }
+
+ private:
+  static constexpr size_t kLast = sizeof...(Filters) - 1;
+  using Tuple = std::tuple<Filters...>;
+  template <size_t I>
+  using Filter = typename std::tuple_element<I, Tuple>::type;
+  template <size_t I>
+  using Index = std::integral_constant<size_t, I>;
+
+  explicit FusedFilter(Filters&&... filters)
+      : filters_(std::move(filters)...) {}
+
+  // Create each filter in turn, stopping at the first failure.
+  template <size_t I, typename... Created>
+  static absl::StatusOr<FusedFilter> CreateFrom(
+      Index<I>, const ChannelArgs& args, ChannelFilter::Args filter_args,
+      Created&&... created) {
+    auto filter = Filter<I>::Create(args, filter_args);
+    if (!filter.ok()) return filter.status();
+    return CreateFrom(Index<I + 1>(), args, filter_args,
+                      std::forward<Created>(created)..., std::move(*filter));
+  }
+  template <typename... Created>
+  static absl::StatusOr<FusedFilter> CreateFrom(Index<kLast + 1>,
+                                                const ChannelArgs&,
+                                                ChannelFilter::Args,
+                                                Created&&... created) {
+    return FusedFilter(std::forward<Created>(created)...);
+  }
+
+  // The qualified calls below let the compiler bind each filter's
+  // implementation directly instead of going through its vtable.
+  template <size_t I>
+  ArenaPromise<ServerMetadataHandle> MakeCallPromiseFrom(
+      Index<I>, CallArgs call_args, NextPromiseFactory* next) {
+    return std::get<I>(filters_).Filter<I>::MakeCallPromise(
+        std::move(call_args), [this, next](CallArgs call_args) {
+          return MakeCallPromiseFrom(Index<I + 1>(), std::move(call_args),
+                                     next);
+        });
+  }
+  ArenaPromise<ServerMetadataHandle> MakeCallPromiseFrom(
+      Index<kLast>, CallArgs call_args, NextPromiseFactory* next) {
+    return std::get<kLast>(filters_).Filter<kLast>::MakeCallPromise(
+        std::move(call_args),
+        [next](CallArgs call_args) { return (*next)(std::move(call_args)); });
+  }
+
+  template <size_t I>
+  bool StartTransportOpFrom(Index<I>, grpc_transport_op* op) {
+    return std::get<I>(filters_).Filter<I>::StartTransportOp(op) ||
+           StartTransportOpFrom(Index<I + 1>(), op);
+  }
+  bool StartTransportOpFrom(Index<kLast + 1>, grpc_transport_op*) {
+    return false;
+  }
+
+  template <size_t I>
+  bool GetChannelInfoFrom(Index<I>, const grpc_channel_info* info) {
+    return std::get<I>(filters_).Filter<I>::GetChannelInfo(info) ||
+           GetChannelInfoFrom(Index<I + 1>(), info);
+  }
+  bool GetChannelInfoFrom(Index<kLast + 1>, const grpc_channel_info*) {
+    return false;
+  }
+
+  template <size_t I>
+  void PostInitFrom(Index<I>) {
+    std::get<I>(filters_).Filter<I>::PostInit();
+    PostInitFrom(Index<I + 1>());
+  }
+  void PostInitFrom(Index<kLast + 1>) {}
+
+  Tuple filters_;
+};
+
+}  // namespace grpc_core
+
+#endif  // GRPC_CORE_EXT_FILTERS_FUSED_FUSED_FILTER_H
@@ -0,0 +1,140 @@
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <grpc/support/port_platform.h>
+
+#include "src/core/ext/filters/fused/fused_filters.h"
+
+#include <limits.h>
+#include <stddef.h>
+
+#include <algorithm>
+#include <initializer_list>
+#include <utility>
+#include <vector>
+
+#include "src/core/ext/filters/channel_idle/channel_idle_filter.h"
+#include "src/core/ext/filters/fused/fused_filter.h"
+#include "src/core/ext/filters/http/client/http_client_filter.h"
+#include "src/core/ext/filters/http/client_authority_filter.h"
+#include "src/core/ext/filters/http/server/http_server_filter.h"
+#include "src/core/lib/channel/channel_args.h"
+#include "src/core/lib/channel/channel_fwd.h"
+#include "src/core/lib/channel/channel_stack.h"
+#include "src/core/lib/channel/channel_stack_builder.h"
+#include "src/core/lib/channel/promise_based_filter.h"
+#include "src/core/lib/config/core_configuration.h"
+#include "src/core/lib/security/transport/auth_filters.h"
+#include "src/core/lib/surface/channel_init.h"
+#include "src/core/lib/surface/channel_stack_type.h"
+
+namespace grpc_core {
+
+const grpc_channel_filter kFusedAuthorityHttpClientFilter =
+    MakePromiseBasedFilter<FusedFilter<ClientAuthorityFilter, HttpClientFilter>,
+                           FilterEndpoint::kClient,
+                           kFilterExaminesServerInitialMetadata>(
+        "authority+http-client");
+
+const grpc_channel_filter kFusedAuthorityClientAuthFilter =
+    MakePromiseBasedFilter<FusedFilter<ClientAuthorityFilter, ClientAuthFilter>,
+                           FilterEndpoint::kClient>("authority+client-auth");
+
+const grpc_channel_filter kFusedAuthorityClientAuthHttpClientFilter =
+    MakePromiseBasedFilter<
+        FusedFilter<ClientAuthorityFilter, ClientAuthFilter, HttpClientFilter>,
+        FilterEndpoint::kClient, kFilterExaminesServerInitialMetadata>(
+        "authority+client-auth+http-client");
+
+const grpc_channel_filter kFusedHttpServerMaxAgeFilter = MakePromiseBasedFilter<
+    FusedFilter<HttpServerFilter, MaxAgeFilter>, FilterEndpoint::kServer,
+    kFilterExaminesServerInitialMetadata>("http-server+max_age");
+
+namespace {
+
+struct FusedFilterEntry {
+  std::vector<const grpc_channel_filter*> filters;
+  const grpc_channel_filter* fused;
+};
+
+// Longest combinations first, so that a run is fused as a whole rather than
+// split at a shorter match.
+const std::vector<FusedFilterEntry>& ClientFusedFilters() {
+  static const auto* entries = new std::vector<FusedFilterEntry>{
+      {{&ClientAuthorityFilter::kFilter, &ClientAuthFilter::kFilter,
+        &HttpClientFilter::kFilter},
+       &kFusedAuthorityClientAuthHttpClientFilter},
+      {{&ClientAuthorityFilter::kFilter, &HttpClientFilter::kFilter},
+       &kFusedAuthorityHttpClientFilter},
+      {{&ClientAuthorityFilter::kFilter, &ClientAuthFilter::kFilter},
+       &kFusedAuthorityClientAuthFilter},
+  };
+  return *entries;
+}
+
+const std::vector<FusedFilterEntry>& ServerFusedFilters() {
+  static const auto* entries = new std::vector<FusedFilterEntry>{
+      {{&HttpServerFilter::kFilter, &MaxAgeFilter::kFilter},
+       &kFusedHttpServerMaxAgeFilter},
+  };
+  return *entries;
+}
+
+void FuseFilters(const std::vector<FusedFilterEntry>& entries,
+                 std::vector<const grpc_channel_filter*>* stack) {
+  std::vector<const grpc_channel_filter*> fused;
+  fused.reserve(stack->size());
+  for (size_t i = 0; i < stack->size();) {
+    auto entry = std::find_if(
+        entries.begin(), entries.end(), [stack, i](const FusedFilterEntry& e) {
+          return stack->size() - i >= e.filters.size() &&
+                 std::equal(e.filters.begin(), e.filters.end(),
+                            stack->begin() + i);
+        });
+    if (entry == entries.end()) {
+      fused.push_back((*stack)[i]);
+      ++i;
+    } else {
+      fused.push_back(entry->fused);
+      i += entry->filters.size();
+    }
+  }
+  *stack = std::move(fused);
+}
+
+ChannelInit::Stage FuseFiltersStage(
+    const std::vector<FusedFilterEntry>& entries) {
+  return [&entries](ChannelStackBuilder* builder) {
+    if (builder->channel_args().GetBool(GRPC_ARG_FUSE_FILTERS).value_or(
+            false)) {
+      FuseFilters(entries, builder->mutable_stack());
+    }
+    return true;
+  };
+}
+
+}  // namespace
+
+void RegisterFusedFilters(CoreConfiguration::Builder* builder) {
+  // Must run after every other stage has placed its filters: this is
+  // registered last, at the highest priority.
+  for (auto type : {GRPC_CLIENT_SUBCHANNEL, GRPC_CLIENT_DIRECT_CHANNEL}) {
+    builder->channel_init()->RegisterStage(
+        type, INT_MAX, FuseFiltersStage(ClientFusedFilters()));
+  }
+  builder->channel_init()->RegisterStage(
+      GRPC_SERVER_CHANNEL, INT_MAX, FuseFiltersStage(ServerFusedFilters()));
+}
+
+}  // namespace grpc_core
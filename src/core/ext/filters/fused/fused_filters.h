@@ -0,0 +1,40 @@
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GRPC_CORE_EXT_FILTERS_FUSED_FUSED_FILTERS_H
+#define GRPC_CORE_EXT_FILTERS_FUSED_FUSED_FILTERS_H
+
+#include <grpc/support/port_platform.h>
+
+#include "src/core/ext/filters/fused/fused_filter.h"
+#include "src/core/lib/channel/channel_stack.h"
+
+namespace grpc_core {
+
+// Fused versions of the runs of promise based filters that the default channel
+// configurations produce. With GRPC_ARG_FUSE_FILTERS set, each replaces its
+// run wherever that appears in a stack.
+
+// Minimal insecure client stack.
+extern const grpc_channel_filter kFusedAuthorityHttpClientFilter;
+// Full TLS client stack, where message_size follows client-auth.
+extern const grpc_channel_filter kFusedAuthorityClientAuthFilter;
+// Minimal TLS client stack.
+extern const grpc_channel_filter kFusedAuthorityClientAuthHttpClientFilter;
+// Server with max_age enabled and compression disabled.
+extern const grpc_channel_filter kFusedHttpServerMaxAgeFilter;
+
+}  // namespace grpc_core
+
+#endif  // GRPC_CORE_EXT_FILTERS_FUSED_FUSED_FILTERS_H
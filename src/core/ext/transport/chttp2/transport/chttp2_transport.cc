@@ -72,6 +72,7 @@
 #include "src/core/lib/iomgr/pollset.h"
 #include "src/core/lib/iomgr/timer.h"
 #include "src/core/lib/profiling/timers.h"
+#include "src/core/lib/profiling/trace_point.h"
 #include "src/core/lib/promise/poll.h"
 #include "src/core/lib/resource_quota/api.h"
 #include "src/core/lib/resource_quota/arena.h"
@@ -174,6 +175,8 @@ static void finish_bdp_ping(void* tp, grpc_error_handle error);
 static void start_bdp_ping_locked(void* tp, grpc_error_handle error);
 static void finish_bdp_ping_locked(void* tp, grpc_error_handle error);
 static void next_bdp_ping_timer_expired(void* tp, grpc_error_handle error);
+static void pacing_timer_expired(void* tp, grpc_error_handle error);
+static void pacing_timer_expired_locked(void* tp, grpc_error_handle error);
 static void next_bdp_ping_timer_expired_locked(void* tp,
                                                grpc_error_handle error);
 
@@ -325,6 +328,10 @@ static void read_channel_args(grpc_chttp2_transport* t,
               grpc_integer_options{
                   g_default_min_recv_ping_interval_without_data_ms, 0,
                   INT_MAX}));
+    } else if (0 == strcmp(channel_args->args[i].key,
+                           GRPC_ARG_HTTP2_PACING_RATE)) {
+      t->pacer.SetRate(grpc_channel_arg_get_integer(&channel_args->args[i],
+                                                    {0, 0, INT_MAX}));
     } else if (0 == strcmp(channel_args->args[i].key,
                            GRPC_ARG_HTTP2_WRITE_BUFFER_SIZE)) {
       t->write_buffer_size = static_cast<uint32_t>(grpc_channel_arg_get_integer(
@@ -609,6 +616,9 @@ static void close_transport_locked(grpc_chttp2_transport* t,
     if (t->have_next_bdp_ping_timer) {
       grpc_timer_cancel(&t->next_bdp_ping_timer);
     }
+    if (t->have_pacing_timer) {
+      grpc_timer_cancel(&t->pacing_timer);
+    }
     switch (t->keepalive_state) {
       case GRPC_CHTTP2_KEEPALIVE_STATE_WAITING:
         grpc_timer_cancel(&t->keepalive_ping_timer);
@@ -703,6 +713,10 @@ grpc_chttp2_stream::~grpc_chttp2_stream() {
     GPR_ASSERT(grpc_chttp2_stream_map_find(&t->stream_map, id) == nullptr);
   }
 
+  // Whatever the stream still buffers goes away with it.
+  grpc_slice_buffer_reset_and_unref_internal(&frame_storage);
+  grpc_slice_buffer_reset_and_unref_internal(&flow_controlled_buffer);
+  grpc_chttp2_update_buffered_bytes(t, this);
   grpc_slice_buffer_destroy_internal(&frame_storage);
 
   for (int i = 0; i < STREAM_LIST_COUNT; i++) {
@@ -877,6 +891,36 @@ static void inc_initiate_write_reason(
   }
 }
 
+void grpc_chttp2_schedule_paced_write(grpc_chttp2_transport* t) {
+  if (t->have_pacing_timer || t->closed_with_error != GRPC_ERROR_NONE) return;
+  t->have_pacing_timer = true;
+  GRPC_CHTTP2_REF_TRANSPORT(t, "pacing_timer");
+  GRPC_CLOSURE_INIT(&t->pacing_timer_expired_locked, pacing_timer_expired, t,
+                    grpc_schedule_on_exec_ctx);
+  grpc_timer_init(&t->pacing_timer, t->pacer.NextSendTime(),
+                  &t->pacing_timer_expired_locked);
+}
+
+static void pacing_timer_expired(void* tp, grpc_error_handle error) {
+  grpc_chttp2_transport* t = static_cast<grpc_chttp2_transport*>(tp);
+  t->combiner->Run(GRPC_CLOSURE_INIT(&t->pacing_timer_expired_locked,
+                                     pacing_timer_expired_locked, t, nullptr),
+                   GRPC_ERROR_REF(error));
+}
+
+static void pacing_timer_expired_locked(void* tp, grpc_error_handle error) {
+  grpc_chttp2_transport* t = static_cast<grpc_chttp2_transport*>(tp);
+  GPR_ASSERT(t->have_pacing_timer);
+  t->have_pacing_timer = false;
+  if (error == GRPC_ERROR_NONE && t->closed_with_error == GRPC_ERROR_NONE) {
+    // Streams held back by the pacer wait on the stalled-by-transport list,
+    // like those held back by the transport window.
+    grpc_chttp2_initiate_write(
+        t, GRPC_CHTTP2_INITIATE_WRITE_TRANSPORT_FLOW_CONTROL_UNSTALLED);
+  }
+  GRPC_CHTTP2_UNREF_TRANSPORT(t, "pacing_timer");
+}
+
 void grpc_chttp2_initiate_write(grpc_chttp2_transport* t,
                                 grpc_chttp2_initiate_write_reason reason) {
   GPR_TIMER_SCOPE("grpc_chttp2_initiate_write", 0);
@@ -975,6 +1019,7 @@ static void write_action_begin_locked(void* gt,
 
 static void write_action(void* gt, grpc_error_handle /*error*/) {
   GPR_TIMER_SCOPE("write_action", 0);
+  GRPC_TRACE_POINT_SCOPE("write_action");
   grpc_chttp2_transport* t = static_cast<grpc_chttp2_transport*>(gt);
   void* cl = t->cl;
   t->cl = nullptr;
@@ -1309,6 +1354,8 @@ static void perform_stream_op_locked(void* stream_op,
   GRPC_STATS_INC_HTTP2_OP_BATCHES();
 
   s->context = op->payload->context;
+  s->call_timeline = grpc_core::CallTimeline::FromContext(
+      static_cast<grpc_call_context_element*>(s->context));
   s->traced = op->is_traced;
   if (GRPC_TRACE_FLAG_ENABLED(grpc_http_trace)) {
     gpr_log(GPR_INFO,
@@ -1344,6 +1391,9 @@ static void perform_stream_op_locked(void* stream_op,
       t->channelz_socket->RecordStreamStartedFromLocal();
     }
     GRPC_STATS_INC_HTTP2_OP_SEND_INITIAL_METADATA();
+    if (s->call_timeline != nullptr) {
+      s->call_timeline->Mark(grpc_core::CallTimeline::Event::kTransportQueued);
+    }
     GPR_ASSERT(s->send_initial_metadata_finished == nullptr);
     on_complete->next_data.scratch |= CLOSURE_BARRIER_MAY_COVER_WRITE;
 
@@ -1445,6 +1495,7 @@ static void perform_stream_op_locked(void* stream_op,
         grpc_slice_buffer_add(&s->flow_controlled_buffer,
                               grpc_slice_ref_internal(*slice));
       }
+      grpc_chttp2_update_buffered_bytes(t, s);
 
       int64_t notify_offset = s->next_message_end_offset;
       if (notify_offset <= s->flow_controlled_bytes_written) {
@@ -1908,6 +1959,7 @@ void grpc_chttp2_maybe_complete_recv_initial_metadata(grpc_chttp2_transport* t,
       s->published_metadata[0] != GRPC_METADATA_NOT_PUBLISHED) {
     if (s->seen_error) {
       grpc_slice_buffer_reset_and_unref_internal(&s->frame_storage);
+      grpc_chttp2_update_buffered_bytes(t, s);
     }
     *s->recv_initial_metadata = std::move(s->initial_metadata_buffer);
     s->recv_initial_metadata->Set(grpc_core::PeerString(), t->peer_string);
@@ -1947,6 +1999,7 @@ void grpc_chttp2_maybe_complete_recv_message(grpc_chttp2_transport* t,
               s->flow_control.UpdateProgress(min_progress_size);
               grpc_chttp2_act_on_flowctl_action(s->flow_control.MakeAction(), t,
                                                 s);
+              grpc_chttp2_update_buffered_bytes(t, s);
               return;
             }
           } else {
@@ -1968,6 +2021,7 @@ void grpc_chttp2_maybe_complete_recv_message(grpc_chttp2_transport* t,
       } else {
         s->flow_control.UpdateProgress(GRPC_HEADER_SIZE_IN_BYTES);
         grpc_chttp2_act_on_flowctl_action(s->flow_control.MakeAction(), t, s);
+        grpc_chttp2_update_buffered_bytes(t, s);
         return;
       }
     }
@@ -1984,6 +2038,7 @@ void grpc_chttp2_maybe_complete_recv_message(grpc_chttp2_transport* t,
     }
     GRPC_ERROR_UNREF(error);
   }
+  grpc_chttp2_update_buffered_bytes(t, s);
 }
 
 void grpc_chttp2_maybe_complete_recv_trailing_metadata(grpc_chttp2_transport* t,
@@ -2003,6 +2058,19 @@ void grpc_chttp2_maybe_complete_recv_trailing_metadata(grpc_chttp2_transport* t,
       null_then_sched_closure(&s->recv_trailing_metadata_finished);
     }
   }
+  grpc_chttp2_update_buffered_bytes(t, s);
+}
+
+void grpc_chttp2_update_buffered_bytes(grpc_chttp2_transport* t,
+                                       grpc_chttp2_stream* s) {
+  int64_t buffered_bytes = static_cast<int64_t>(
+      s->frame_storage.length + s->flow_controlled_buffer.length);
+  if (buffered_bytes == s->buffered_bytes) return;
+  t->buffered_bytes += buffered_bytes - s->buffered_bytes;
+  s->buffered_bytes = buffered_bytes;
+  if (t->channelz_socket != nullptr) {
+    t->channelz_socket->RecordBufferedBytes(t->buffered_bytes);
+  }
 }
 
 static void remove_stream(grpc_chttp2_transport* t, uint32_t id,
@@ -2491,6 +2559,7 @@ static void read_action_locked(void* tp, grpc_error_handle error) {
   GRPC_ERROR_UNREF(err);
   if (t->closed_with_error == GRPC_ERROR_NONE) {
     GPR_TIMER_SCOPE("reading_action.parse", 0);
+    GRPC_TRACE_POINT_SCOPE("reading_action.parse");
     size_t i = 0;
     grpc_error_handle errors[3] = {GRPC_ERROR_REF(error), GRPC_ERROR_NONE,
                                    GRPC_ERROR_NONE};
@@ -2569,7 +2638,8 @@ static void continue_read_action_locked(grpc_chttp2_transport* t) {
                     grpc_schedule_on_exec_ctx);
   grpc_endpoint_read(t->ep, &t->read_buffer, &t->read_action_locked, urgent,
                      /*min_progress_size=*/1);
-  grpc_chttp2_act_on_flowctl_action(t->flow_control.MakeAction(), t, nullptr);
+  grpc_chttp2_act_on_flowctl_action(t->flow_control.MemoryPressureUpdate(), t,
+                                    nullptr);
 }
 
 // t is reffed prior to calling the first time, and once the callback chain
@@ -31,6 +31,11 @@
 #include "src/core/lib/iomgr/endpoint.h"
 #include "src/core/lib/transport/transport_fwd.h"
 
+/// Maximum rate, in bytes per second, at which data frames are written. Zero
+/// (the default) writes data as fast as flow control allows.
+#define GRPC_ARG_HTTP2_PACING_RATE \
+  "grpc.experimental.http2.pacing_rate_bytes_per_second"
+
 extern grpc_core::TraceFlag grpc_http_trace;
 extern grpc_core::TraceFlag grpc_keepalive_trace;
 extern grpc_core::TraceFlag grpc_trace_http2_stream_state;
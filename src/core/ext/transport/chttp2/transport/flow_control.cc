@@ -36,7 +36,6 @@
 #include <grpc/support/log.h>
 
 #include "src/core/lib/gpr/useful.h"
-#include "src/core/lib/iomgr/exec_ctx.h"
 #include "src/core/lib/resource_quota/memory_quota.h"
 
 grpc_core::TraceFlag grpc_flowctl_trace(false, "flowctl");
@@ -105,16 +104,7 @@ TransportFlowControl::TransportFlowControl(const char* name,
                                            MemoryOwner* memory_owner)
     : memory_owner_(memory_owner),
       enable_bdp_probe_(enable_bdp_probe),
-      bdp_estimator_(name),
-      pid_controller_(PidController::Args()
-                          .set_gain_p(4)
-                          .set_gain_i(8)
-                          .set_gain_d(0)
-                          .set_initial_control_value(TargetLogBdp())
-                          .set_min_control_value(-1)
-                          .set_max_control_value(25)
-                          .set_integral_range(10)),
-      last_pid_update_(ExecCtx::Get()->Now()) {}
+      bdp_estimator_(name) {}
 
 uint32_t TransportFlowControl::MaybeSendUpdate(bool writing_anyway) {
   const uint32_t target_announced_window =
@@ -229,37 +219,37 @@ FlowControlAction TransportFlowControl::UpdateAction(FlowControlAction action) {
   return action;
 }
 
-// Take in a target and modifies it based on the memory pressure of the system
-static double AdjustForMemoryPressure(double memory_pressure, double target) {
-  // do not increase window under heavy memory pressure.
-  static const double kLowMemPressure = 0.1;
-  static const double kZeroTarget = 22;
-  static const double kHighMemPressure = 0.8;
-  static const double kMaxMemPressure = 0.9;
-  if (memory_pressure < kLowMemPressure && target < kZeroTarget) {
-    target = (target - kZeroTarget) * memory_pressure / kLowMemPressure +
-             kZeroTarget;
-  } else if (memory_pressure > kHighMemPressure) {
-    target *= 1 - std::min(1.0, (memory_pressure - kHighMemPressure) /
-                                    (kMaxMemPressure - kHighMemPressure));
-  }
-  return target;
-}
-
-double TransportFlowControl::TargetLogBdp() {
-  return AdjustForMemoryPressure(
-      memory_owner_->is_valid() ? memory_owner_->InstantaneousPressure() : 0.0,
-      1 + log2(bdp_estimator_.EstimateBdp()));
+double TransportFlowControl::CurrentMemoryPressure() const {
+  return memory_owner_->is_valid() ? memory_owner_->InstantaneousPressure()
+                                   : 0.0;
 }
 
-double TransportFlowControl::SmoothLogBdp(double value) {
-  Timestamp now = ExecCtx::Get()->Now();
-  double bdp_error = value - pid_controller_.last_control_value();
-  const double dt = (now - last_pid_update_).seconds();
-  last_pid_update_ = now;
-  // Limit dt to 100ms
-  const double kMaxDt = 0.1;
-  return pid_controller_.Update(bdp_error, dt > kMaxDt ? kMaxDt : dt);
+double TransportFlowControl::TargetInitialWindowSize(
+    double memory_pressure) const {
+  // Linear interpolation of the window between two pressures.
+  auto lerp = [memory_pressure](double p0, double p1, double w0, double w1) {
+    return w0 + (w1 - w0) * (memory_pressure - p0) / (p1 - p0);
+  };
+  // Memory pressure falls into three regions:
+  // 1. Low: memory is plentiful, so advertise a generous window and let the
+  //    peer send as fast as it can.
+  // 2. Moderate: ramp the window down towards twice the BDP, which still
+  //    keeps the link full.
+  // 3. High: ramp the window down to nothing as the quota runs out, so peers
+  //    slow down gradually rather than having the reclaimer reset streams.
+  static const double kLowMemPressure = 0.2;
+  static const double kModerateMemPressure = 0.5;
+  const double bdp_window = 2 * bdp_estimator_.EstimateBdp();
+  const double generous_window = std::max(double(1 << 22), bdp_window);
+  if (memory_pressure < kLowMemPressure) return generous_window;
+  if (memory_pressure < kModerateMemPressure) {
+    return lerp(kLowMemPressure, kModerateMemPressure, generous_window,
+                bdp_window);
+  }
+  if (memory_pressure < 1.0) {
+    return lerp(kModerateMemPressure, 1.0, bdp_window, 0);
+  }
+  return 0;
 }
 
 void TransportFlowControl::UpdateSetting(
@@ -276,27 +266,31 @@ void TransportFlowControl::UpdateSetting(
   }
 }
 
+void TransportFlowControl::UpdateTargetInitialWindowSize(
+    double target, FlowControlAction* action) {
+  // Though initial window 'could' drop to 0, we keep the floor at
+  // kMinInitialWindowSize
+  UpdateSetting(
+      &target_initial_window_size_,
+      static_cast<int32_t>(Clamp(target, double(kMinInitialWindowSize),
+                                 double(kMaxInitialWindowSize))),
+      action, &FlowControlAction::set_send_initial_window_update);
+}
+
 FlowControlAction TransportFlowControl::PeriodicUpdate() {
   FlowControlAction action;
   if (enable_bdp_probe_) {
     // get bdp estimate and update initial_window accordingly.
     // target might change based on how much memory pressure we are under
-    // TODO(ncteisen): experiment with setting target to be huge under low
-    // memory pressure.
-    double target = pow(2, SmoothLogBdp(TargetLogBdp()));
+    last_memory_pressure_ = CurrentMemoryPressure();
+    double target = TargetInitialWindowSize(last_memory_pressure_);
     if (g_test_only_transport_target_window_estimates_mocker != nullptr) {
       // Hook for simulating unusual flow control situations in tests.
       target = g_test_only_transport_target_window_estimates_mocker
                    ->ComputeNextTargetInitialWindowSizeFromPeriodicUpdate(
                        target_initial_window_size_ /* current target */);
     }
-    // Though initial window 'could' drop to 0, we keep the floor at
-    // kMinInitialWindowSize
-    UpdateSetting(
-        &target_initial_window_size_,
-        static_cast<int32_t>(Clamp(target, double(kMinInitialWindowSize),
-                                   double(kMaxInitialWindowSize))),
-        &action, &FlowControlAction::set_send_initial_window_update);
+    UpdateTargetInitialWindowSize(target, &action);
 
     // get bandwidth estimate and update max_frame accordingly.
     double bw_dbl = bdp_estimator_.EstimateBandwidth();
@@ -313,6 +307,22 @@ FlowControlAction TransportFlowControl::PeriodicUpdate() {
   return UpdateAction(action);
 }
 
+FlowControlAction TransportFlowControl::MemoryPressureUpdate() {
+  // Pressure changes a lot faster than BDP pings complete, so the window is
+  // resized whenever pressure has moved noticeably since it was last sized.
+  static const double kMemPressureStep = 0.05;
+  FlowControlAction action;
+  if (enable_bdp_probe_) {
+    double memory_pressure = CurrentMemoryPressure();
+    if (std::abs(memory_pressure - last_memory_pressure_) >= kMemPressureStep) {
+      last_memory_pressure_ = memory_pressure;
+      UpdateTargetInitialWindowSize(TargetInitialWindowSize(memory_pressure),
+                                    &action);
+    }
+  }
+  return UpdateAction(action);
+}
+
 FlowControlAction StreamFlowControl::UpdateAction(FlowControlAction action) {
   const uint32_t sent_init_window = tfc_->sent_init_window();
   if (local_window_delta_ > announced_window_delta_ &&
@@ -338,5 +348,30 @@ void StreamFlowControl::SentData(int64_t outgoing_frame_size) {
   remote_window_delta_ -= outgoing_frame_size;
 }
 
+int64_t Pacer::MaxCredit() const {
+  // Allow bursts of up to 10ms worth of data, but at least a frame.
+  return std::max(static_cast<int64_t>(kDefaultFrameSize), rate_ / 100);
+}
+
+void Pacer::Refill(Timestamp now) {
+  if (last_refill_ == Timestamp::InfPast()) {
+    credit_ = MaxCredit();
+    last_refill_ = now;
+    return;
+  }
+  const int64_t added = rate_ * (now - last_refill_).millis() / 1000;
+  // At low rates, wait for at least a byte of credit to accumulate.
+  if (added <= 0) return;
+  credit_ = std::min(MaxCredit(), credit_ + added);
+  last_refill_ = now;
+}
+
+Timestamp Pacer::NextSendTime() const {
+  const int64_t needed = static_cast<int64_t>(kDefaultFrameSize) - credit_;
+  if (needed <= 0) return last_refill_;
+  return last_refill_ +
+         Duration::Milliseconds((needed * 1000 + rate_ - 1) / rate_);
+}
+
 }  // namespace chttp2
 }  // namespace grpc_core
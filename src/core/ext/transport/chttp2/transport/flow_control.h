@@ -32,7 +32,6 @@
 #include "src/core/lib/gprpp/time.h"
 #include "src/core/lib/resource_quota/memory_quota.h"
 #include "src/core/lib/transport/bdp_estimator.h"
-#include "src/core/lib/transport/pid_controller.h"
 
 extern grpc_core::TraceFlag grpc_flowctl_trace;
 
@@ -135,6 +134,8 @@ std::ostream& operator<<(std::ostream& out, const FlowControlAction& action);
 // to be as performant as possible.
 class TransportFlowControl final {
  public:
+  friend class grpc::testing::TrickledCHTTP2;
+
   explicit TransportFlowControl(const char* name, bool enable_bdp_probe,
                                 MemoryOwner* memory_owner);
   ~TransportFlowControl() {}
@@ -156,6 +157,10 @@ class TransportFlowControl final {
   // to let chttp2 change its parameters
   FlowControlAction PeriodicUpdate();
 
+  // Like MakeAction(), but first resizes windows if memory pressure has moved
+  // far enough since they were last sized. Cheap enough to call on every read.
+  FlowControlAction MemoryPressureUpdate();
+
   void StreamSentData(int64_t size) { remote_window_ -= size; }
 
   absl::Status ValidateRecvData(int64_t incoming_frame_size);
@@ -200,8 +205,11 @@ class TransportFlowControl final {
   int64_t announced_window() const { return announced_window_; }
 
  private:
-  double TargetLogBdp();
-  double SmoothLogBdp(double value);
+  double CurrentMemoryPressure() const;
+  // The initial window we would like to advertise, given the BDP estimate
+  // and the memory pressure.
+  double TargetInitialWindowSize(double memory_pressure) const;
+  void UpdateTargetInitialWindowSize(double target, FlowControlAction* action);
   static void UpdateSetting(int64_t* desired_value, int64_t new_desired_value,
                             FlowControlAction* action,
                             FlowControlAction& (FlowControlAction::*set)(
@@ -227,16 +235,14 @@ class TransportFlowControl final {
   /* bdp estimation */
   BdpEstimator bdp_estimator_;
 
-  /* pid controller */
-  PidController pid_controller_;
-  Timestamp last_pid_update_;
-
   int64_t remote_window_ = kDefaultWindow;
   int64_t target_initial_window_size_ = kDefaultWindow;
   int64_t target_frame_size_ = kDefaultFrameSize;
   int64_t announced_window_ = kDefaultWindow;
   uint32_t sent_init_window_ = kDefaultWindow;
   uint32_t acked_init_window_ = kDefaultWindow;
+  // The memory pressure target_initial_window_size_ was last sized for.
+  double last_memory_pressure_ = 0;
 };
 
 // Implementation of flow control that abides to HTTP/2 spec and attempts
@@ -289,6 +295,31 @@ class StreamFlowControl final {
   void UpdateAnnouncedWindowDelta(TransportFlowControl* tfc, int64_t change);
 };
 
+// Paces the data frames written by a transport: rather than writing as much as
+// flow control allows in one burst, data is released at a fixed rate, a few
+// milliseconds worth at a time.
+class Pacer final {
+ public:
+  // rate is in bytes per second; zero (the default) disables pacing.
+  void SetRate(int64_t rate) { rate_ = rate; }
+  bool enabled() const { return rate_ > 0; }
+
+  // Accumulate credit for the time elapsed until now.
+  void Refill(Timestamp now);
+  // Number of bytes that may be written now.
+  int64_t credit() const { return credit_; }
+  void SentData(int64_t size) { credit_ -= size; }
+  // When there will be enough credit to write a default sized frame.
+  Timestamp NextSendTime() const;
+
+ private:
+  int64_t MaxCredit() const;
+
+  int64_t rate_ = 0;
+  int64_t credit_ = 0;
+  Timestamp last_refill_ = Timestamp::InfPast();
+};
+
 class TestOnlyTransportTargetWindowEstimatesMocker {
  public:
   virtual ~TestOnlyTransportTargetWindowEstimatesMocker() {}
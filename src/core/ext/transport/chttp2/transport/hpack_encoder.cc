@@ -22,6 +22,7 @@
 
 #include <algorithm>
 #include <cstdint>
+#include <cstring>
 #include <memory>
 
 #include "absl/utility/utility.h"
@@ -131,7 +132,7 @@ void HPackCompressor::Framer::EnsureSpace(size_t need_bytes) {
   prefix_ = BeginFrame();
 }
 
-void HPackCompressor::Framer::Add(Slice slice) {
+void HPackCompressor::Framer::AddSlice(Slice slice) {
   while (true) {
     const size_t len = slice.length();
     if (len == 0) return;
@@ -151,7 +152,7 @@ void HPackCompressor::Framer::Add(Slice slice) {
   }
 }
 
-uint8_t* HPackCompressor::Framer::AddTiny(size_t len) {
+uint8_t* HPackCompressor::Framer::AddTinyBytes(size_t len) {
   EnsureSpace(len);
   stats_->header_bytes += len;
   return grpc_slice_buffer_tiny_add(output_, len);
@@ -160,7 +161,95 @@ uint8_t* HPackCompressor::Framer::AddTiny(size_t len) {
 void HPackCompressor::Framer::EmitIndexed(uint32_t elem_index) {
   GRPC_STATS_INC_HPACK_SEND_INDEXED();
   VarintWriter<1> w(elem_index);
-  w.Write(0x80, AddTiny(w.length()));
+  if (GPR_UNLIKELY(prefix_state_ != PrefixState::kDone)) {
+    if (!in_prefix_field_) {
+      EndPrefix();
+    } else if (prefix_field_length_ == 0) {
+      w.Write(0x80, prefix_field_encoding_);
+      prefix_field_length_ = w.length();
+    } else {
+      prefix_field_cacheable_ = false;
+    }
+  }
+  w.Write(0x80, AddTinyBytes(w.length()));
+}
+
+bool HPackCompressor::Framer::MatchCachedPrefix(PrefixFieldKey key,
+                                                const Slice* slice,
+                                                uint8_t value) {
+  if (cached_prefix_ == nullptr) {
+    cached_prefix_ = compressor_->CachedPrefixFor(key, slice, value);
+  }
+  auto& cached = *cached_prefix_;
+  if (prefix_fields_matched_ < cached.fields.size()) {
+    const PrefixField& field = cached.fields[prefix_fields_matched_];
+    if (field.key == key &&
+        (slice == nullptr ? field.value == value : field.slice == *slice)) {
+      if (++prefix_fields_matched_ == cached.fields.size()) {
+        // Everything we know is matched: emit it, and extend the cache with
+        // whatever prefix fields follow.
+        prefix_state_ = PrefixState::kRecording;
+        EmitCachedPrefix(prefix_fields_matched_);
+      }
+      return true;
+    }
+  }
+  // Mismatch: emit what matched so far, and replace the rest of the cache
+  // with the fields of this header block.
+  prefix_state_ = PrefixState::kRecording;
+  if (prefix_fields_matched_ != 0) EmitCachedPrefix(prefix_fields_matched_);
+  cached.fields.resize(prefix_fields_matched_);
+  cached.encoding.resize(
+      cached.fields.empty() ? 0 : cached.fields.back().end);
+  return false;
+}
+
+void HPackCompressor::Framer::RecordPrefixField(PrefixFieldKey key,
+                                                const Slice* slice,
+                                                uint8_t value,
+                                                uint32_t generation) {
+  auto& cached = *cached_prefix_;
+  // Only fields that encoded as a single reference to an unchanged table can
+  // be replayed later.
+  if (!prefix_field_cacheable_ || prefix_field_length_ == 0 ||
+      generation != compressor_->table_.generation() ||
+      cached.fields.size() == kMaxPrefixFields) {
+    prefix_state_ = PrefixState::kDone;
+    return;
+  }
+  GPR_DEBUG_ASSERT(cached.table_generation == generation);
+  cached.encoding.insert(cached.encoding.end(), prefix_field_encoding_,
+                         prefix_field_encoding_ + prefix_field_length_);
+  cached.fields.push_back(
+      PrefixField{key, slice == nullptr ? Slice() : slice->Ref(), value,
+                  static_cast<uint8_t>(cached.encoding.size())});
+}
+
+void HPackCompressor::Framer::EmitCachedPrefix(size_t num_fields) {
+  const auto& cached = *cached_prefix_;
+  // Copy the encoding in as few tiny slices as possible, breaking only at
+  // field boundaries.
+  size_t begin = 0;
+  size_t end = 0;
+  for (size_t i = 0; i < num_fields; i++) {
+    GRPC_STATS_INC_HPACK_SEND_INDEXED();
+    const size_t field_end = cached.fields[i].end;
+    if (field_end - begin > GRPC_SLICE_INLINED_SIZE) {
+      memcpy(AddTinyBytes(end - begin), cached.encoding.data() + begin,
+             end - begin);
+      begin = end;
+    }
+    end = field_end;
+  }
+  memcpy(AddTinyBytes(end - begin), cached.encoding.data() + begin,
+         end - begin);
+}
+
+void HPackCompressor::Framer::EndPrefix() {
+  const PrefixState state = absl::exchange(prefix_state_, PrefixState::kDone);
+  if (state == PrefixState::kMatching && prefix_fields_matched_ != 0) {
+    EmitCachedPrefix(prefix_fields_matched_);
+  }
 }
 
 struct WireValue {
@@ -387,20 +476,27 @@ void HPackCompressor::Framer::Encode(const Slice& key, const Slice& value) {
 }
 
 void HPackCompressor::Framer::Encode(HttpPathMetadata, const Slice& value) {
-  compressor_->path_index_.EmitTo(HttpPathMetadata::key(), value, this);
+  EncodePrefixField(PrefixFieldKey::kPath, &value, 0, [&] {
+    compressor_->path_index_.EmitTo(HttpPathMetadata::key(), value, this);
+  });
 }
 
 void HPackCompressor::Framer::Encode(HttpAuthorityMetadata,
                                      const Slice& value) {
-  compressor_->authority_index_.EmitTo(HttpAuthorityMetadata::key(), value,
-                                       this);
+  EncodePrefixField(PrefixFieldKey::kAuthority, &value, 0, [&] {
+    compressor_->authority_index_.EmitTo(HttpAuthorityMetadata::key(), value,
+                                         this);
+  });
 }
 
 void HPackCompressor::Framer::Encode(TeMetadata, TeMetadata::ValueType value) {
   GPR_ASSERT(value == TeMetadata::ValueType::kTrailers);
-  EncodeAlwaysIndexed(
-      &compressor_->te_index_, "te", Slice::FromStaticString("trailers"),
-      2 /* te */ + 8 /* trailers */ + hpack_constants::kEntryOverhead);
+  EncodePrefixField(
+      PrefixFieldKey::kTe, nullptr, static_cast<uint8_t>(value), [&] {
+        EncodeAlwaysIndexed(
+            &compressor_->te_index_, "te", Slice::FromStaticString("trailers"),
+            2 /* te */ + 8 /* trailers */ + hpack_constants::kEntryOverhead);
+      });
 }
 
 void HPackCompressor::Framer::Encode(ContentTypeMetadata,
@@ -409,25 +505,31 @@ void HPackCompressor::Framer::Encode(ContentTypeMetadata,
     gpr_log(GPR_ERROR, "Not encoding bad content-type header");
     return;
   }
-  EncodeAlwaysIndexed(&compressor_->content_type_index_, "content-type",
-                      Slice::FromStaticString("application/grpc"),
-                      12 /* content-type */ + 16 /* application/grpc */ +
-                          hpack_constants::kEntryOverhead);
+  EncodePrefixField(
+      PrefixFieldKey::kContentType, nullptr, static_cast<uint8_t>(value), [&] {
+        EncodeAlwaysIndexed(&compressor_->content_type_index_, "content-type",
+                            Slice::FromStaticString("application/grpc"),
+                            12 /* content-type */ + 16 /* application/grpc */ +
+                                hpack_constants::kEntryOverhead);
+      });
 }
 
 void HPackCompressor::Framer::Encode(HttpSchemeMetadata,
                                      HttpSchemeMetadata::ValueType value) {
-  switch (value) {
-    case HttpSchemeMetadata::ValueType::kHttp:
-      EmitIndexed(6);  // :scheme: http
-      break;
-    case HttpSchemeMetadata::ValueType::kHttps:
-      EmitIndexed(7);  // :scheme: https
-      break;
-    case HttpSchemeMetadata::ValueType::kInvalid:
-      GPR_ASSERT(false);
-      break;
-  }
+  EncodePrefixField(
+      PrefixFieldKey::kScheme, nullptr, static_cast<uint8_t>(value), [&] {
+        switch (value) {
+          case HttpSchemeMetadata::ValueType::kHttp:
+            EmitIndexed(6);  // :scheme: http
+            break;
+          case HttpSchemeMetadata::ValueType::kHttps:
+            EmitIndexed(7);  // :scheme: https
+            break;
+          case HttpSchemeMetadata::ValueType::kInvalid:
+            GPR_ASSERT(false);
+            break;
+        }
+      });
 }
 
 void HPackCompressor::Framer::Encode(GrpcTraceBinMetadata, const Slice& slice) {
@@ -476,23 +578,27 @@ void HPackCompressor::Framer::Encode(HttpStatusMetadata, uint32_t status) {
 
 void HPackCompressor::Framer::Encode(HttpMethodMetadata,
                                      HttpMethodMetadata::ValueType method) {
-  switch (method) {
-    case HttpMethodMetadata::ValueType::kPost:
-      EmitIndexed(3);  // :method: POST
-      break;
-    case HttpMethodMetadata::ValueType::kGet:
-      EmitIndexed(2);  // :method: GET
-      break;
-    case HttpMethodMetadata::ValueType::kPut:
-      // Right now, we only emit PUT as a method for testing purposes, so it's
-      // fine to not index it.
-      EmitLitHdrWithNonBinaryStringKeyNotIdx(Slice::FromStaticString(":method"),
-                                             Slice::FromStaticString("PUT"));
-      break;
-    case HttpMethodMetadata::ValueType::kInvalid:
-      GPR_ASSERT(false);
-      break;
-  }
+  EncodePrefixField(
+      PrefixFieldKey::kMethod, nullptr, static_cast<uint8_t>(method), [&] {
+        switch (method) {
+          case HttpMethodMetadata::ValueType::kPost:
+            EmitIndexed(3);  // :method: POST
+            break;
+          case HttpMethodMetadata::ValueType::kGet:
+            EmitIndexed(2);  // :method: GET
+            break;
+          case HttpMethodMetadata::ValueType::kPut:
+            // Right now, we only emit PUT as a method for testing purposes, so
+            // it's fine to not index it.
+            EmitLitHdrWithNonBinaryStringKeyNotIdx(
+                Slice::FromStaticString(":method"),
+                Slice::FromStaticString("PUT"));
+            break;
+          case HttpMethodMetadata::ValueType::kInvalid:
+            GPR_ASSERT(false);
+            break;
+        }
+      });
 }
 
 void HPackCompressor::Framer::EncodeAlwaysIndexed(uint32_t* index,
@@ -664,6 +770,39 @@ HPackCompressor::Framer::Framer(const EncodeHeaderOptions& options,
   if (absl::exchange(compressor_->advertise_table_size_change_, false)) {
     AdvertiseTableSizeChange();
   }
+  prefix_state_ = PrefixState::kMatching;
+}
+
+HPackCompressor::CachedPrefix* HPackCompressor::CachedPrefixFor(
+    PrefixFieldKey key, const Slice* slice, uint8_t value) {
+  const uint32_t generation = table_.generation();
+  const uint32_t use = ++prefix_uses_;
+  CachedPrefix* victim = &cached_prefixes_[0];
+  for (CachedPrefix& cached : cached_prefixes_) {
+    const bool valid =
+        !cached.fields.empty() && cached.table_generation == generation;
+    if (valid) {
+      const PrefixField& field = cached.fields[0];
+      if (field.key == key &&
+          (slice == nullptr ? field.value == value : field.slice == *slice)) {
+        cached.last_use = use;
+        return &cached;
+      }
+    }
+    // Prefer recycling prefixes that can't match anymore, then the least
+    // recently used one.
+    const bool victim_valid =
+        !victim->fields.empty() && victim->table_generation == generation;
+    const uint32_t age = use - cached.last_use;
+    if (victim_valid && (!valid || age > use - victim->last_use)) {
+      victim = &cached;
+    }
+  }
+  victim->table_generation = generation;
+  victim->last_use = use;
+  victim->fields.clear();
+  victim->encoding.clear();
+  return victim;
 }
 
 }  // namespace grpc_core
@@ -27,6 +27,7 @@
 #include <utility>
 #include <vector>
 
+#include "absl/container/inlined_vector.h"
 #include "absl/strings/match.h"
 #include "absl/strings/string_view.h"
 
@@ -50,6 +51,13 @@ namespace grpc_core {
 
 class HPackCompressor {
   class SliceIndex;
+  enum class PrefixFieldKey : uint8_t;
+  struct CachedPrefix;
+  static constexpr size_t kMaxPrefixFields = 6;
+  static constexpr size_t kMaxCachedPrefixes = 8;
+  // Longest encoding of an indexed header field: a one byte prefix followed
+  // by a varint of up to five bytes.
+  static constexpr size_t kMaxIndexedFieldLength = 6;
 
  public:
   HPackCompressor() = default;
@@ -84,7 +92,10 @@ class HPackCompressor {
    public:
     Framer(const EncodeHeaderOptions& options, HPackCompressor* compressor,
            grpc_slice_buffer* output);
-    ~Framer() { FinishFrame(true); }
+    ~Framer() {
+      if (prefix_state_ == PrefixState::kMatching) EndPrefix();
+      FinishFrame(true);
+    }
 
     Framer(const Framer&) = delete;
     Framer& operator=(const Framer&) = delete;
@@ -132,6 +143,53 @@ class HPackCompressor {
       size_t output_length_at_start_of_frame;
     };
 
+    // How this header block uses cached_prefix_.
+    enum class PrefixState : uint8_t {
+      // The fields seen so far match the cached prefix, and haven't been
+      // emitted yet.
+      kMatching,
+      // Fields are appended to the cached prefix as they are encoded.
+      kRecording,
+      // The cached prefix is neither used nor updated anymore.
+      kDone,
+    };
+
+    // Encode a field that may be part of the cached prefix. \a encode emits
+    // the field normally.
+    template <typename EncodeFn>
+    void EncodePrefixField(PrefixFieldKey key, const Slice* slice,
+                           uint8_t value, EncodeFn encode) {
+      if (prefix_state_ == PrefixState::kMatching &&
+          MatchCachedPrefix(key, slice, value)) {
+        return;
+      }
+      if (prefix_state_ != PrefixState::kRecording) {
+        encode();
+        return;
+      }
+      const uint32_t generation = compressor_->table_.generation();
+      in_prefix_field_ = true;
+      prefix_field_cacheable_ = true;
+      prefix_field_length_ = 0;
+      encode();
+      in_prefix_field_ = false;
+      RecordPrefixField(key, slice, value, generation);
+    }
+    bool MatchCachedPrefix(PrefixFieldKey key, const Slice* slice,
+                           uint8_t value);
+    void RecordPrefixField(PrefixFieldKey key, const Slice* slice,
+                           uint8_t value, uint32_t generation);
+    void EmitCachedPrefix(size_t num_fields);
+    void EndPrefix();
+    // Called before emitting anything other than an indexed field.
+    void AddingLiteral() {
+      if (in_prefix_field_) {
+        prefix_field_cacheable_ = false;
+      } else {
+        EndPrefix();
+      }
+    }
+
     FramePrefix BeginFrame();
     void FinishFrame(bool is_header_boundary);
     void EnsureSpace(size_t need_bytes);
@@ -155,8 +213,16 @@ class HPackCompressor {
                                          Slice value);
 
     size_t CurrentFrameSize() const;
-    void Add(Slice slice);
-    uint8_t* AddTiny(size_t len);
+    void Add(Slice slice) {
+      if (GPR_UNLIKELY(prefix_state_ != PrefixState::kDone)) AddingLiteral();
+      AddSlice(std::move(slice));
+    }
+    uint8_t* AddTiny(size_t len) {
+      if (GPR_UNLIKELY(prefix_state_ != PrefixState::kDone)) AddingLiteral();
+      return AddTinyBytes(len);
+    }
+    void AddSlice(Slice slice);
+    uint8_t* AddTinyBytes(size_t len);
 
     // maximum size of a frame
     const size_t max_frame_size_;
@@ -169,6 +235,19 @@ class HPackCompressor {
     grpc_transport_one_way_stats* const stats_;
     HPackCompressor* const compressor_;
     FramePrefix prefix_;
+    PrefixState prefix_state_ = PrefixState::kDone;
+    // The compressor's cached prefix for this header block's first field,
+    // chosen when that field is encoded.
+    CachedPrefix* cached_prefix_ = nullptr;
+    // Number of fields of the cached prefix matched while kMatching.
+    uint8_t prefix_fields_matched_ = 0;
+    // True while encoding a field for the cached prefix: the field's encoding
+    // is captured in prefix_field_encoding_.
+    bool in_prefix_field_ = false;
+    // Whether the field being captured encoded as a single indexed field.
+    bool prefix_field_cacheable_ = false;
+    uint8_t prefix_field_length_ = 0;
+    uint8_t prefix_field_encoding_[kMaxIndexedFieldLength];
   };
 
  private:
@@ -183,6 +262,49 @@ class HPackCompressor {
   bool advertise_table_size_change_ = false;
   HPackEncoderTable table_;
 
+  // Fields that usually start the header blocks of client requests, and so can
+  // be part of the cached prefix.
+  enum class PrefixFieldKey : uint8_t {
+    kPath,
+    kAuthority,
+    kMethod,
+    kScheme,
+    kContentType,
+    kTe,
+  };
+  struct PrefixField {
+    PrefixFieldKey key;
+    // Value of :path and :authority.
+    Slice slice;
+    // Value of the other (enum valued) fields.
+    uint8_t value;
+    // Offset in CachedPrefix::encoding just past this field's encoding.
+    uint8_t end;
+  };
+
+  // Requests to a method on a connection mostly start with the same :path,
+  // :authority, :method, :scheme, content-type and te fields, which once
+  // they're in the HPACK table all encode as table references. We remember
+  // the fields and encoding of the leading run of such references of recent
+  // header blocks, one per leading field (i.e. per :path for requests). As
+  // long as the table doesn't change (which would shift the indices), a header
+  // block starting with the same fields can copy that encoding instead of
+  // re-encoding each field.
+  struct CachedPrefix {
+    // HPackEncoderTable::generation() the encoding is valid for.
+    uint32_t table_generation = 0;
+    // Value of prefix_uses_ when the prefix was last looked up.
+    uint32_t last_use = 0;
+    absl::InlinedVector<PrefixField, kMaxPrefixFields> fields;
+    absl::InlinedVector<uint8_t, kMaxPrefixFields * kMaxIndexedFieldLength>
+        encoding;
+  };
+
+  // Returns the cached prefix whose first field matches, or else recycles the
+  // least recently used one for the current table generation.
+  CachedPrefix* CachedPrefixFor(PrefixFieldKey key, const Slice* slice,
+                                uint8_t value);
+
   class SliceIndex {
    public:
     void EmitTo(absl::string_view key, const Slice& value, Framer* framer);
@@ -225,6 +347,8 @@ class HPackCompressor {
   SliceIndex path_index_;
   SliceIndex authority_index_;
   std::vector<PreviousTimeout> previous_timeouts_;
+  CachedPrefix cached_prefixes_[kMaxCachedPrefixes];
+  uint32_t prefix_uses_ = 0;
 };
 
 }  // namespace grpc_core
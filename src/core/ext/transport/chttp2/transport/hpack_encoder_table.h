@@ -44,6 +44,10 @@ class HPackEncoderTable {
   uint32_t max_size() const { return max_table_size_; }
   // Get the current table size
   uint32_t test_only_table_size() const { return table_size_; }
+  // Changes whenever an element is added to or evicted from the table, or the
+  // table is resized - that is, whenever a previously computed dynamic index
+  // might become stale.
+  uint32_t generation() const { return generation_; }
 
   // Convert an element index into a dynamic index
   uint32_t DynamicIndex(uint32_t index) const {
@@ -64,6 +68,7 @@ class HPackEncoderTable {
   uint32_t max_table_size_ = hpack_constants::kInitialTableSize;
   uint32_t table_elems_ = 0;
   uint32_t table_size_ = 0;
+  uint32_t generation_ = 0;
   // The size of each element in the HPACK table.
   absl::InlinedVector<uint16_t, hpack_constants::kInitialTableEntries>
       elem_size_;
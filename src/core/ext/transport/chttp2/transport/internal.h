@@ -44,6 +44,7 @@
 #include "src/core/ext/transport/chttp2/transport/hpack_parser.h"
 #include "src/core/ext/transport/chttp2/transport/http2_settings.h"
 #include "src/core/ext/transport/chttp2/transport/stream_map.h"
+#include "src/core/lib/channel/call_timeline.h"
 #include "src/core/lib/channel/channelz.h"
 #include "src/core/lib/debug/trace.h"
 #include "src/core/lib/gprpp/bitset.h"
@@ -411,6 +412,13 @@ struct grpc_chttp2_transport {
   bool bdp_ping_started = false;
   grpc_timer next_bdp_ping_timer;
 
+  /* data frame pacing */
+  grpc_core::chttp2::Pacer pacer;
+  /** is a write scheduled for when the pacer allows more data? */
+  bool have_pacing_timer = false;
+  grpc_timer pacing_timer;
+  grpc_closure pacing_timer_expired_locked;
+
   /* keep-alive ping support */
   /** Closure to initialize a keepalive ping */
   grpc_closure init_keepalive_ping_locked;
@@ -437,6 +445,8 @@ struct grpc_chttp2_transport {
   grpc_core::ContextList* cl = nullptr;
   grpc_core::RefCountedPtr<grpc_core::channelz::SocketNode> channelz_socket;
   uint32_t num_messages_in_next_write = 0;
+  /** Sum of the streams' buffered_bytes, published to channelz */
+  int64_t buffered_bytes = 0;
   /** The number of pending induced frames (SETTINGS_ACK, PINGS_ACK and
    * RST_STREAM) in the outgoing buffer (t->qbuf). If this number goes beyond
    * DEFAULT_MAX_PENDING_INDUCED_FRAMES, we pause reading new frames. We would
@@ -459,6 +469,8 @@ struct grpc_chttp2_stream {
   ~grpc_chttp2_stream();
 
   void* context;
+  // The call's timeline, if it is sampled; found in context.
+  grpc_core::CallTimeline* call_timeline = nullptr;
   grpc_chttp2_transport* t;
   grpc_stream_refcount* refcount;
   // Reffer is a 0-len structure, simply reffing `t` and `refcount` in its ctor
@@ -554,6 +566,9 @@ struct grpc_chttp2_stream {
   grpc_core::chttp2::StreamFlowControl flow_control;
 
   grpc_slice_buffer flow_controlled_buffer;
+  /** frame_storage plus flow_controlled_buffer, as last counted towards the
+      transport's buffered_bytes */
+  int64_t buffered_bytes = 0;
 
   grpc_chttp2_write_cb* on_flow_controlled_cbs = nullptr;
   grpc_chttp2_write_cb* on_write_finished_cbs = nullptr;
@@ -581,6 +596,9 @@ struct grpc_chttp2_stream {
 void grpc_chttp2_initiate_write(grpc_chttp2_transport* t,
                                 grpc_chttp2_initiate_write_reason reason);
 
+/** Initiate a write once the pacer allows more data to be written */
+void grpc_chttp2_schedule_paced_write(grpc_chttp2_transport* t);
+
 struct grpc_chttp2_begin_write_result {
   /** are we writing? */
   bool writing;
@@ -768,6 +786,11 @@ void grpc_chttp2_maybe_complete_recv_message(grpc_chttp2_transport* t,
 void grpc_chttp2_maybe_complete_recv_trailing_metadata(grpc_chttp2_transport* t,
                                                        grpc_chttp2_stream* s);
 
+/** Bring the transport's count of buffered bytes up to date after \a s's
+    incoming or outgoing data buffers changed */
+void grpc_chttp2_update_buffered_bytes(grpc_chttp2_transport* t,
+                                       grpc_chttp2_stream* s);
+
 void grpc_chttp2_fail_pending_writes(grpc_chttp2_transport* t,
                                      grpc_chttp2_stream* s,
                                      grpc_error_handle error);
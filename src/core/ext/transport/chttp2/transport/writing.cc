@@ -58,6 +58,7 @@
 #include "src/core/lib/iomgr/exec_ctx.h"
 #include "src/core/lib/iomgr/timer.h"
 #include "src/core/lib/profiling/timers.h"
+#include "src/core/lib/profiling/trace_point.h"
 #include "src/core/lib/slice/slice.h"
 #include "src/core/lib/slice/slice_internal.h"
 #include "src/core/lib/transport/bdp_estimator.h"
@@ -206,6 +207,7 @@ static bool update_list(grpc_chttp2_transport* t, grpc_chttp2_stream* s,
 
 static void report_stall(grpc_chttp2_transport* t, grpc_chttp2_stream* s,
                          const char* staller) {
+  if (s->call_timeline != nullptr) s->call_timeline->FlowControlStalled();
   if (GRPC_TRACE_FLAG_ENABLED(grpc_flowctl_trace)) {
     gpr_log(
         GPR_DEBUG,
@@ -267,6 +269,7 @@ class WriteContext {
   explicit WriteContext(grpc_chttp2_transport* t) : t_(t) {
     GRPC_STATS_INC_HTTP2_WRITES_BEGUN();
     GPR_TIMER_SCOPE("grpc_chttp2_begin_write", 0);
+    if (t_->pacer.enabled()) t_->pacer.Refill(grpc_core::ExecCtx::Get()->Now());
   }
 
   // TODO(ctiller): make this the destructor
@@ -364,6 +367,10 @@ class WriteContext {
 
   void NoteScheduledResults() { result_.early_results_scheduled = true; }
 
+  // Some stream had data to send, but the pacer held it back.
+  void NotePaced() { paced_ = true; }
+  bool paced() const { return paced_; }
+
   grpc_chttp2_transport* transport() const { return t_; }
 
   grpc_chttp2_begin_write_result Result() {
@@ -380,6 +387,7 @@ class WriteContext {
   int initial_metadata_writes_ = 0;
   int trailing_metadata_writes_ = 0;
   int message_writes_ = 0;
+  bool paced_ = false;
   grpc_chttp2_begin_write_result result_ = {false, false, false};
 };
 
@@ -402,10 +410,12 @@ class DataSendContext {
   }
 
   uint32_t max_outgoing() const {
+    int64_t window = std::min(int64_t(stream_remote_window()),
+                              t_->flow_control.remote_window());
+    if (t_->pacer.enabled()) window = std::min(window, t_->pacer.credit());
     return static_cast<uint32_t>(std::min(
         t_->settings[GRPC_PEER_SETTINGS][GRPC_CHTTP2_SETTINGS_MAX_FRAME_SIZE],
-        static_cast<uint32_t>(std::min(int64_t(stream_remote_window()),
-                                       t_->flow_control.remote_window()))));
+        static_cast<uint32_t>(std::max(int64_t(0), window))));
   }
 
   bool AnyOutgoing() const { return max_outgoing() > 0; }
@@ -419,7 +429,9 @@ class DataSendContext {
     grpc_chttp2_encode_data(s_->id, &s_->flow_controlled_buffer, send_bytes,
                             is_last_frame_, &s_->stats.outgoing, &t_->outbuf);
     s_->flow_control.SentData(send_bytes);
+    if (t_->pacer.enabled()) t_->pacer.SentData(send_bytes);
     s_->sending_bytes += send_bytes;
+    grpc_chttp2_update_buffered_bytes(t_, s_);
   }
 
   bool is_last_frame() const { return is_last_frame_; }
@@ -489,6 +501,9 @@ class StreamWriteContext {
 
     s_->send_initial_metadata = nullptr;
     s_->sent_initial_metadata = true;
+    if (s_->call_timeline != nullptr) {
+      s_->call_timeline->Mark(grpc_core::CallTimeline::Event::kHeadersWritten);
+    }
     write_context_->NoteScheduledResults();
     grpc_chttp2_complete_closure_step(
         t_, s_, &s_->send_initial_metadata_finished, GRPC_ERROR_NONE,
@@ -523,10 +538,15 @@ class StreamWriteContext {
       } else if (data_send_context.stream_remote_window() <= 0) {
         report_stall(t_, s_, "stream");
         grpc_chttp2_list_add_stalled_by_stream(t_, s_);
+      } else if (t_->pacer.enabled() && t_->pacer.credit() <= 0) {
+        report_stall(t_, s_, "pacing");
+        grpc_chttp2_list_add_stalled_by_transport(t_, s_);
+        write_context_->NotePaced();
       }
       return;  // early out: nothing to do
     }
 
+    if (s_->call_timeline != nullptr) s_->call_timeline->FlowControlResumed();
     while (s_->flow_controlled_buffer.length > 0 &&
            data_send_context.max_outgoing() > 0) {
       data_send_context.FlushBytes();
@@ -629,6 +649,7 @@ class StreamWriteContext {
 
 grpc_chttp2_begin_write_result grpc_chttp2_begin_write(
     grpc_chttp2_transport* t) {
+  GRPC_TRACE_POINT_SCOPE("grpc_chttp2_begin_write");
   WriteContext ctx(t);
   ctx.FlushSettings();
   ctx.FlushPingAcks();
@@ -669,6 +690,8 @@ grpc_chttp2_begin_write_result grpc_chttp2_begin_write(
 
   ctx.FlushWindowUpdates();
 
+  if (ctx.paced()) grpc_chttp2_schedule_paced_write(t);
+
   maybe_initiate_ping(t);
 
   return ctx.Result();
@@ -676,6 +699,7 @@ grpc_chttp2_begin_write_result grpc_chttp2_begin_write(
 
 void grpc_chttp2_end_write(grpc_chttp2_transport* t, grpc_error_handle error) {
   GPR_TIMER_SCOPE("grpc_chttp2_end_write", 0);
+  GRPC_TRACE_POINT_SCOPE("grpc_chttp2_end_write");
   grpc_chttp2_stream* s;
 
   if (t->channelz_socket != nullptr) {
@@ -72,9 +72,15 @@ class XdsApi {
     virtual absl::Status ProcessAdsResponseFields(AdsResponseFields fields) = 0;
 
     // Called to parse each individual resource in the ADS response.
+    // For delta responses, \a version is the version of the individual
+    // resource; for state-of-the-world responses, it is empty.
     virtual void ParseResource(const XdsEncodingContext& context, size_t idx,
                                absl::string_view type_url,
+                               absl::string_view version,
                                absl::string_view serialized_resource) = 0;
+
+    // Called for each resource that a delta ADS response says was removed.
+    virtual void RemoveResource(absl::string_view resource_name) = 0;
   };
 
   struct ClusterLoadReport {
@@ -163,6 +169,27 @@ class XdsApi {
                                 const grpc_slice& encoded_response,
                                 AdsResponseParserInterface* parser);
 
+  // Creates a delta ADS request, which changes the set of subscribed
+  // resources by \a resource_names_subscribe and \a
+  // resource_names_unsubscribe rather than restating it.  \a
+  // initial_resource_versions lists the resources that are already cached,
+  // so that the server need not resend them; it is only sent on the first
+  // request for the type on a stream.
+  // Takes ownership of \a error.
+  grpc_slice CreateDeltaAdsRequest(
+      const XdsBootstrap::XdsServer& server, absl::string_view type_url,
+      absl::string_view nonce,
+      const std::vector<std::string>& resource_names_subscribe,
+      const std::vector<std::string>& resource_names_unsubscribe,
+      const std::map<std::string, std::string>& initial_resource_versions,
+      grpc_error_handle error, bool populate_node);
+
+  // Like ParseAdsResponse(), but for a delta ADS response, which carries
+  // only the resources that changed, and the names of those removed.
+  absl::Status ParseDeltaAdsResponse(const XdsBootstrap::XdsServer& server,
+                                     const grpc_slice& encoded_response,
+                                     AdsResponseParserInterface* parser);
+
   // Creates an initial LRS request.
   grpc_slice CreateLrsInitialRequest(const XdsBootstrap::XdsServer& server);
 
@@ -129,7 +129,8 @@ XdsBootstrap::XdsServer XdsBootstrap::XdsServer::Parse(
   if (server_features_array != nullptr) {
     for (const Json& feature_json : *server_features_array) {
       if (feature_json.type() == Json::Type::STRING &&
-          feature_json.string_value() == "xds_v3") {
+          (feature_json.string_value() == "xds_v3" ||
+           feature_json.string_value() == "xds_delta")) {
         server.server_features.insert(feature_json.string_value());
       }
     }
@@ -162,6 +163,11 @@ bool XdsBootstrap::XdsServer::ShouldUseV3() const {
   return server_features.find("xds_v3") != server_features.end();
 }
 
+bool XdsBootstrap::XdsServer::ShouldUseDelta() const {
+  return ShouldUseV3() &&
+         server_features.find("xds_delta") != server_features.end();
+}
+
 //
 // XdsBootstrap
 //
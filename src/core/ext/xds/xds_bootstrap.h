@@ -76,6 +76,9 @@ class XdsBootstrap {
     Json::Object ToJson() const;
 
     bool ShouldUseV3() const;
+    // Whether to use the incremental (delta) variant of ADS, which sends
+    // only the resources that changed.  Requires v3.
+    bool ShouldUseDelta() const;
   };
 
   struct Authority {
@@ -23,6 +23,7 @@
 #include <string.h>
 
 #include <algorithm>
+#include <iterator>
 
 #include "absl/container/inlined_vector.h"
 #include "absl/strings/match.h"
@@ -32,6 +33,7 @@
 #include "absl/strings/str_split.h"
 #include "absl/strings/string_view.h"
 #include "absl/strings/strip.h"
+#include "absl/types/optional.h"
 
 #include <grpc/byte_buffer.h>
 #include <grpc/byte_buffer_reader.h>
@@ -188,15 +190,27 @@ class XdsClient::ChannelState::AdsCallState
         ABSL_EXCLUSIVE_LOCKS_REQUIRED(&XdsClient::mu_);
 
     void ParseResource(const XdsEncodingContext& context, size_t idx,
-                       absl::string_view type_url,
+                       absl::string_view type_url, absl::string_view version,
                        absl::string_view serialized_resource) override
         ABSL_EXCLUSIVE_LOCKS_REQUIRED(&XdsClient::mu_);
 
+    void RemoveResource(absl::string_view resource_name) override
+        ABSL_EXCLUSIVE_LOCKS_REQUIRED(&XdsClient::mu_);
+
     Result TakeResult() { return std::move(result_); }
 
    private:
     XdsClient* xds_client() const { return ads_call_state_->xds_client(); }
 
+    // Cancels the resource-does-not-exist timer for the resource, if any.
+    void MaybeCancelTimer(const XdsResourceName& resource_name)
+        ABSL_EXCLUSIVE_LOCKS_REQUIRED(&XdsClient::mu_);
+
+    // Returns the cached state of the resource, or null if we have no
+    // subscription for it.
+    ResourceState* FindResourceState(const XdsResourceName& resource_name)
+        ABSL_EXCLUSIVE_LOCKS_REQUIRED(&XdsClient::mu_);
+
     AdsCallState* ads_call_state_;
     const Timestamp update_time_ = ExecCtx::Get()->Now();
     Result result_;
@@ -315,10 +329,19 @@ class XdsClient::ChannelState::AdsCallState
     std::map<std::string /*authority*/,
              std::map<XdsResourceKey, OrphanablePtr<ResourceTimer>>>
         subscribed_resources;
+
+    // For delta ADS: the names of the resources that the server has been
+    // told we are subscribed to on this call, and whether we have sent a
+    // request for this type on this call yet.
+    std::set<std::string> sent_resource_names;
+    bool sent_request = false;
   };
 
   void SendMessageLocked(const XdsResourceType* type)
       ABSL_EXCLUSIVE_LOCKS_REQUIRED(&XdsClient::mu_);
+  grpc_slice CreateDeltaRequestLocked(const XdsResourceType* type,
+                                      ResourceTypeState* state)
+      ABSL_EXCLUSIVE_LOCKS_REQUIRED(&XdsClient::mu_);
 
   static void OnRequestSent(void* arg, grpc_error_handle error);
   void OnRequestSentLocked(grpc_error_handle error)
@@ -340,6 +363,8 @@ class XdsClient::ChannelState::AdsCallState
   // The owning RetryableCall<>.
   RefCountedPtr<RetryableCall<AdsCallState>> parent_;
 
+  // Whether this call uses delta ADS.
+  const bool delta_;
   bool sent_initial_message_ = false;
   bool seen_response_ = false;
 
@@ -810,9 +835,39 @@ void UpdateResourceMetadataNacked(const std::string& version,
 
 }  // namespace
 
+void XdsClient::ChannelState::AdsCallState::AdsResponseParser::
+    MaybeCancelTimer(const XdsResourceName& resource_name) {
+  auto timer_it = ads_call_state_->state_map_.find(result_.type);
+  if (timer_it == ads_call_state_->state_map_.end()) return;
+  auto it = timer_it->second.subscribed_resources.find(resource_name.authority);
+  if (it == timer_it->second.subscribed_resources.end()) return;
+  auto res_it = it->second.find(resource_name.key);
+  if (res_it != it->second.end()) res_it->second->MaybeCancelTimer();
+}
+
+XdsClient::ResourceState*
+XdsClient::ChannelState::AdsCallState::AdsResponseParser::FindResourceState(
+    const XdsResourceName& resource_name) {
+  // Lookup the authority in the cache.
+  auto authority_it =
+      xds_client()->authority_state_map_.find(resource_name.authority);
+  if (authority_it == xds_client()->authority_state_map_.end()) {
+    return nullptr;
+  }
+  // Found authority, so look up type.
+  AuthorityState& authority_state = authority_it->second;
+  auto type_it = authority_state.resource_map.find(result_.type);
+  if (type_it == authority_state.resource_map.end()) return nullptr;
+  auto& type_map = type_it->second;
+  // Found type, so look up resource key.
+  auto it = type_map.find(resource_name.key);
+  if (it == type_map.end()) return nullptr;
+  return &it->second;
+}
+
 void XdsClient::ChannelState::AdsCallState::AdsResponseParser::ParseResource(
     const XdsEncodingContext& context, size_t idx, absl::string_view type_url,
-    absl::string_view serialized_resource) {
+    absl::string_view version, absl::string_view serialized_resource) {
   // Check the type_url of the resource.
   bool is_v2 = false;
   if (!result_.type->IsType(type_url, &is_v2)) {
@@ -821,6 +876,35 @@ void XdsClient::ChannelState::AdsCallState::AdsResponseParser::ParseResource(
                      type_url, " (should be ", result_.type_url, ")"));
     return;
   }
+  // If the name can be read without decoding the resource, skip decoding
+  // resources we don't have a subscription for, and those whose bytes are
+  // the same as the ones we already have.
+  absl::optional<absl::string_view> peeked_name =
+      result_.type->PeekName(serialized_resource);
+  if (peeked_name.has_value()) {
+    auto resource_name =
+        xds_client()->ParseXdsResourceName(*peeked_name, result_.type);
+    if (resource_name.ok()) {
+      ResourceState* resource_state = FindResourceState(*resource_name);
+      if (resource_state == nullptr) return;
+      if (resource_state->resource != nullptr &&
+          resource_state->meta.serialized_proto == serialized_resource) {
+        MaybeCancelTimer(*resource_name);
+        if (result_.type->AllResourcesRequiredInSotW()) {
+          result_.resources_seen[resource_name->authority].insert(
+              resource_name->key);
+        }
+        result_.have_valid_resources = true;
+        if (GRPC_TRACE_FLAG_ENABLED(grpc_xds_client_trace)) {
+          gpr_log(GPR_INFO,
+                  "[xds_client %p] %s resource %s unchanged, not decoding.",
+                  xds_client(), result_.type_url.c_str(),
+                  std::string(*peeked_name).c_str());
+        }
+        return;
+      }
+    }
+  }
   // Parse the resource.
   absl::StatusOr<XdsResourceType::DecodeResult> result =
       result_.type->Decode(context, serialized_resource, is_v2);
@@ -839,36 +923,15 @@ void XdsClient::ChannelState::AdsCallState::AdsResponseParser::ParseResource(
     return;
   }
   // Cancel resource-does-not-exist timer, if needed.
-  auto timer_it = ads_call_state_->state_map_.find(result_.type);
-  if (timer_it != ads_call_state_->state_map_.end()) {
-    auto it =
-        timer_it->second.subscribed_resources.find(resource_name->authority);
-    if (it != timer_it->second.subscribed_resources.end()) {
-      auto res_it = it->second.find(resource_name->key);
-      if (res_it != it->second.end()) {
-        res_it->second->MaybeCancelTimer();
-      }
-    }
-  }
-  // Lookup the authority in the cache.
-  auto authority_it =
-      xds_client()->authority_state_map_.find(resource_name->authority);
-  if (authority_it == xds_client()->authority_state_map_.end()) {
-    return;  // Skip resource -- we don't have a subscription for it.
-  }
-  // Found authority, so look up type.
-  AuthorityState& authority_state = authority_it->second;
-  auto type_it = authority_state.resource_map.find(result_.type);
-  if (type_it == authority_state.resource_map.end()) {
+  MaybeCancelTimer(*resource_name);
+  ResourceState* resource_state_ptr = FindResourceState(*resource_name);
+  if (resource_state_ptr == nullptr) {
     return;  // Skip resource -- we don't have a subscription for it.
   }
-  auto& type_map = type_it->second;
-  // Found type, so look up resource key.
-  auto it = type_map.find(resource_name->key);
-  if (it == type_map.end()) {
-    return;  // Skip resource -- we don't have a subscription for it.
-  }
-  ResourceState& resource_state = it->second;
+  ResourceState& resource_state = *resource_state_ptr;
+  // Delta responses version each resource separately.
+  std::string resource_version =
+      version.empty() ? result_.version : std::string(version);
   // If needed, record that we've seen this resource.
   if (result_.type->AllResourcesRequiredInSotW()) {
     result_.resources_seen[resource_name->authority].insert(resource_name->key);
@@ -882,7 +945,7 @@ void XdsClient::ChannelState::AdsCallState::AdsResponseParser::ParseResource(
         resource_state.watchers,
         absl::UnavailableError(absl::StrCat(
             "invalid resource: ", result->resource.status().ToString())));
-    UpdateResourceMetadataNacked(result_.version,
+    UpdateResourceMetadataNacked(resource_version,
                                  result->resource.status().ToString(),
                                  update_time_, &resource_state.meta);
     return;
@@ -903,22 +966,47 @@ void XdsClient::ChannelState::AdsCallState::AdsResponseParser::ParseResource(
   // Update the resource state.
   resource_state.resource = std::move(*result->resource);
   resource_state.meta = CreateResourceMetadataAcked(
-      std::string(serialized_resource), result_.version, update_time_);
+      std::string(serialized_resource), std::move(resource_version),
+      update_time_);
   // Notify watchers.
   auto& watchers_list = resource_state.watchers;
-  auto* value =
-      result_.type->CopyResource(resource_state.resource.get()).release();
+  std::shared_ptr<const XdsResourceType::ResourceData> value =
+      resource_state.resource;
   xds_client()->work_serializer_.Schedule(
       [watchers_list, value]()
           ABSL_EXCLUSIVE_LOCKS_REQUIRED(&xds_client()->work_serializer_) {
             for (const auto& p : watchers_list) {
               p.first->OnGenericResourceChanged(value);
             }
-            delete value;
           },
       DEBUG_LOCATION);
 }
 
+void XdsClient::ChannelState::AdsCallState::AdsResponseParser::RemoveResource(
+    absl::string_view resource_name) {
+  auto parsed_name =
+      xds_client()->ParseXdsResourceName(resource_name, result_.type);
+  if (!parsed_name.ok()) {
+    result_.errors.emplace_back(
+        absl::StrCat("removed resource: Cannot parse xDS resource name \"",
+                     resource_name, "\""));
+    return;
+  }
+  MaybeCancelTimer(*parsed_name);
+  ResourceState* resource_state = FindResourceState(*parsed_name);
+  if (resource_state == nullptr) return;
+  // Unlike the absence of a resource from a state-of-the-world response,
+  // this is definitive even for a resource we have not yet received.
+  if (resource_state->meta.client_status ==
+      XdsApi::ResourceMetadata::DOES_NOT_EXIST) {
+    return;
+  }
+  resource_state->resource.reset();
+  resource_state->meta.client_status =
+      XdsApi::ResourceMetadata::DOES_NOT_EXIST;
+  xds_client()->NotifyWatchersOnResourceDoesNotExist(resource_state->watchers);
+}
+
 //
 // XdsClient::ChannelState::AdsCallState
 //
@@ -929,7 +1017,8 @@ XdsClient::ChannelState::AdsCallState::AdsCallState(
           GRPC_TRACE_FLAG_ENABLED(grpc_xds_client_refcount_trace)
               ? "AdsCallState"
               : nullptr),
-      parent_(std::move(parent)) {
+      parent_(std::move(parent)),
+      delta_(chand()->server_.ShouldUseDelta()) {
   // Init the ADS call. Note that the call will progress every time there's
   // activity in xds_client()->interested_parties_, which is comprised of
   // the polling entities from client_channel.
@@ -941,6 +1030,11 @@ XdsClient::ChannelState::AdsCallState::AdsCallState(
             "StreamAggregatedResources"
           : "/envoy.service.discovery.v2.AggregatedDiscoveryService/"
             "StreamAggregatedResources";
+  if (delta_) {
+    method =
+        "/envoy.service.discovery.v3.AggregatedDiscoveryService/"
+        "DeltaAggregatedResources";
+  }
   call_ = grpc_channel_create_pollset_set_call(
       chand()->channel_, nullptr, GRPC_PROPAGATE_DEFAULTS,
       xds_client()->interested_parties_,
@@ -1061,12 +1155,16 @@ void XdsClient::ChannelState::AdsCallState::SendMessageLocked(
   }
   auto& state = state_map_[type];
   grpc_slice request_payload_slice;
-  request_payload_slice = xds_client()->api_.CreateAdsRequest(
-      chand()->server_,
-      chand()->server_.ShouldUseV3() ? type->type_url() : type->v2_type_url(),
-      chand()->resource_type_version_map_[type], state.nonce,
-      ResourceNamesForRequest(type), GRPC_ERROR_REF(state.error),
-      !sent_initial_message_);
+  if (delta_) {
+    request_payload_slice = CreateDeltaRequestLocked(type, &state);
+  } else {
+    request_payload_slice = xds_client()->api_.CreateAdsRequest(
+        chand()->server_,
+        chand()->server_.ShouldUseV3() ? type->type_url() : type->v2_type_url(),
+        chand()->resource_type_version_map_[type], state.nonce,
+        ResourceNamesForRequest(type), GRPC_ERROR_REF(state.error),
+        !sent_initial_message_);
+  }
   sent_initial_message_ = true;
   if (GRPC_TRACE_FLAG_ENABLED(grpc_xds_client_trace)) {
     gpr_log(GPR_INFO,
@@ -1103,6 +1201,51 @@ void XdsClient::ChannelState::AdsCallState::SendMessageLocked(
   }
 }
 
+grpc_slice XdsClient::ChannelState::AdsCallState::CreateDeltaRequestLocked(
+    const XdsResourceType* type, ResourceTypeState* state) {
+  // Send only the changes since the last request on this call.
+  std::vector<std::string> resource_names = ResourceNamesForRequest(type);
+  std::sort(resource_names.begin(), resource_names.end());
+  std::vector<std::string> subscribe;
+  std::set_difference(resource_names.begin(), resource_names.end(),
+                      state->sent_resource_names.begin(),
+                      state->sent_resource_names.end(),
+                      std::back_inserter(subscribe));
+  std::vector<std::string> unsubscribe;
+  std::set_difference(state->sent_resource_names.begin(),
+                      state->sent_resource_names.end(), resource_names.begin(),
+                      resource_names.end(), std::back_inserter(unsubscribe));
+  // On the first request of a call, tell the server which resources we
+  // already have, so that it need not resend those that did not change.
+  std::map<std::string, std::string> initial_resource_versions;
+  if (!state->sent_request) {
+    for (const auto& a : state->subscribed_resources) {
+      const std::string& authority = a.first;
+      auto authority_it = xds_client()->authority_state_map_.find(authority);
+      if (authority_it == xds_client()->authority_state_map_.end()) continue;
+      auto type_it = authority_it->second.resource_map.find(type);
+      if (type_it == authority_it->second.resource_map.end()) continue;
+      for (const auto& r : a.second) {
+        auto it = type_it->second.find(r.first);
+        if (it == type_it->second.end() || it->second.resource == nullptr) {
+          continue;
+        }
+        initial_resource_versions.emplace(
+            XdsClient::ConstructFullXdsResourceName(authority, type->type_url(),
+                                                    r.first),
+            it->second.meta.version);
+      }
+    }
+  }
+  state->sent_request = true;
+  state->sent_resource_names =
+      std::set<std::string>(resource_names.begin(), resource_names.end());
+  return xds_client()->api_.CreateDeltaAdsRequest(
+      chand()->server_, type->type_url(), state->nonce, subscribe, unsubscribe,
+      initial_resource_versions, GRPC_ERROR_REF(state->error),
+      !sent_initial_message_);
+}
+
 void XdsClient::ChannelState::AdsCallState::SubscribeLocked(
     const XdsResourceType* type, const XdsResourceName& name, bool delay_send) {
   auto& state = state_map_[type].subscribed_resources[name.authority][name.key];
@@ -1191,8 +1334,11 @@ bool XdsClient::ChannelState::AdsCallState::OnResponseReceivedLocked() {
   recv_message_payload_ = nullptr;
   // Parse and validate the response.
   AdsResponseParser parser(this);
-  absl::Status status = xds_client()->api_.ParseAdsResponse(
-      chand()->server_, response_slice, &parser);
+  absl::Status status =
+      delta_ ? xds_client()->api_.ParseDeltaAdsResponse(chand()->server_,
+                                                        response_slice, &parser)
+             : xds_client()->api_.ParseAdsResponse(chand()->server_,
+                                                   response_slice, &parser);
   grpc_slice_unref_internal(response_slice);
   if (!status.ok()) {
     // Ignore unparsable response.
@@ -1222,8 +1368,9 @@ bool XdsClient::ChannelState::AdsCallState::OnResponseReceivedLocked() {
                                        GRPC_ERROR_INT_GRPC_STATUS,
                                        GRPC_STATUS_UNAVAILABLE);
     }
-    // Delete resources not seen in update if needed.
-    if (result.type->AllResourcesRequiredInSotW()) {
+    // Delete resources not seen in update if needed.  Delta responses
+    // list deleted resources explicitly instead.
+    if (!delta_ && result.type->AllResourcesRequiredInSotW()) {
       for (auto& a : xds_client()->authority_state_map_) {
         const std::string& authority = a.first;
         AuthorityState& authority_state = a.second;
@@ -1943,11 +2090,11 @@ void XdsClient::WatchResource(const XdsResourceType* type,
                 "[xds_client %p] returning cached listener data for %s", this,
                 std::string(name).c_str());
       }
-      auto* value = type->CopyResource(resource_state.resource.get()).release();
+      std::shared_ptr<const XdsResourceType::ResourceData> value =
+          resource_state.resource;
       work_serializer_.Schedule(
           [watcher, value]() ABSL_EXCLUSIVE_LOCKS_REQUIRED(&work_serializer_) {
             watcher->OnGenericResourceChanged(value);
-            delete value;
           },
           DEBUG_LOCATION);
     }
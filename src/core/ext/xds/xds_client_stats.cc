@@ -20,6 +20,8 @@
 
 #include "src/core/ext/xds/xds_client_stats.h"
 
+#include <algorithm>
+
 #include <grpc/support/log.h>
 
 #include "src/core/ext/xds/xds_client.h"
@@ -131,29 +133,61 @@ XdsClusterLocalityStats::~XdsClusterLocalityStats() {
 
 XdsClusterLocalityStats::Snapshot
 XdsClusterLocalityStats::GetSnapshotAndReset() {
-  Snapshot snapshot = {
-      GetAndResetCounter(&total_successful_requests_),
-      // Don't reset total_requests_in_progress because it's
-      // not related to a single reporting interval.
-      total_requests_in_progress_.load(std::memory_order_relaxed),
-      GetAndResetCounter(&total_error_requests_),
-      GetAndResetCounter(&total_issued_requests_),
-      {}};
-  MutexLock lock(&backend_metrics_mu_);
-  snapshot.backend_metrics = std::move(backend_metrics_);
+  Snapshot snapshot = {0, 0, 0, 0, {}};
+  int64_t total_requests_in_progress = 0;
+  for (size_t cpu = 0; cpu < stats_.size(); ++cpu) {
+    Stats& stats = stats_[cpu];
+    snapshot.total_successful_requests +=
+        GetAndResetCounter(&stats.total_successful_requests);
+    // Don't reset total_requests_in_progress because it's
+    // not related to a single reporting interval.
+    total_requests_in_progress +=
+        stats.total_requests_in_progress.load(std::memory_order_relaxed);
+    snapshot.total_error_requests +=
+        GetAndResetCounter(&stats.total_error_requests);
+    snapshot.total_issued_requests +=
+        GetAndResetCounter(&stats.total_issued_requests);
+    std::map<std::string, BackendMetric> backend_metrics;
+    {
+      MutexLock lock(&stats.backend_metrics_mu);
+      backend_metrics = std::move(stats.backend_metrics);
+      stats.backend_metrics.clear();
+    }
+    if (snapshot.backend_metrics.empty()) {
+      snapshot.backend_metrics = std::move(backend_metrics);
+    } else {
+      for (const auto& p : backend_metrics) {
+        snapshot.backend_metrics[p.first] += p.second;
+      }
+    }
+  }
+  // The shards are read one at a time, so a call that moved between them
+  // while they were being read may briefly make the sum negative.
+  snapshot.total_requests_in_progress =
+      static_cast<uint64_t>(std::max<int64_t>(total_requests_in_progress, 0));
   return snapshot;
 }
 
 void XdsClusterLocalityStats::AddCallStarted() {
-  total_issued_requests_.fetch_add(1, std::memory_order_relaxed);
-  total_requests_in_progress_.fetch_add(1, std::memory_order_relaxed);
+  Stats& stats = stats_.this_cpu();
+  stats.total_issued_requests.fetch_add(1, std::memory_order_relaxed);
+  stats.total_requests_in_progress.fetch_add(1, std::memory_order_relaxed);
 }
 
-void XdsClusterLocalityStats::AddCallFinished(bool fail) {
+void XdsClusterLocalityStats::AddCallFinished(
+    const std::map<absl::string_view, double>* named_metrics, bool fail) {
+  Stats& stats = stats_.this_cpu();
   std::atomic<uint64_t>& to_increment =
-      fail ? total_error_requests_ : total_successful_requests_;
+      fail ? stats.total_error_requests : stats.total_successful_requests;
   to_increment.fetch_add(1, std::memory_order_relaxed);
-  total_requests_in_progress_.fetch_add(-1, std::memory_order_acq_rel);
+  stats.total_requests_in_progress.fetch_add(-1, std::memory_order_acq_rel);
+  if (named_metrics == nullptr || named_metrics->empty()) return;
+  MutexLock lock(&stats.backend_metrics_mu);
+  for (const auto& m : *named_metrics) {
+    BackendMetric& metric = stats.backend_metrics[std::string(m.first)];
+    ++metric.num_requests_finished_with_metric;
+    metric.total_metric_value += m.second;
+  }
 }
 
 }  // namespace grpc_core
@@ -33,6 +33,7 @@
 
 #include "src/core/ext/xds/xds_bootstrap.h"
 #include "src/core/lib/gpr/useful.h"
+#include "src/core/lib/gprpp/per_cpu.h"
 #include "src/core/lib/gprpp/ref_counted.h"
 #include "src/core/lib/gprpp/ref_counted_ptr.h"
 #include "src/core/lib/gprpp/sync.h"
@@ -214,27 +215,39 @@ class XdsClusterLocalityStats : public RefCounted<XdsClusterLocalityStats> {
   Snapshot GetSnapshotAndReset();
 
   void AddCallStarted();
-  void AddCallFinished(bool fail = false);
+  // named_metrics, if non-null, holds the backend metrics reported for
+  // the call.
+  void AddCallFinished(const std::map<absl::string_view, double>* named_metrics,
+                       bool fail = false);
 
  private:
+  // The counters are kept per CPU, so that calls finishing on different
+  // cores do not contend, and are only merged by GetSnapshotAndReset().
+  struct Stats {
+    std::atomic<uint64_t> total_successful_requests{0};
+    // Calls may finish on a different CPU than they started on, so this
+    // may be negative for a single CPU; only the sum is meaningful.
+    std::atomic<int64_t> total_requests_in_progress{0};
+    std::atomic<uint64_t> total_error_requests{0};
+    std::atomic<uint64_t> total_issued_requests{0};
+
+    // Protects backend_metrics.  A mutex is necessary because the map can
+    // be accessed by both the callback intercepting the call's
+    // recv_trailing_metadata (not from the control plane work serializer)
+    // and the load reporting thread (from the control plane work
+    // serializer), but since each CPU has its own it is rarely contended.
+    Mutex backend_metrics_mu;
+    std::map<std::string, BackendMetric> backend_metrics
+        ABSL_GUARDED_BY(backend_metrics_mu);
+  };
+
   RefCountedPtr<XdsClient> xds_client_;
   const XdsBootstrap::XdsServer& lrs_server_;
   absl::string_view cluster_name_;
   absl::string_view eds_service_name_;
   RefCountedPtr<XdsLocalityName> name_;
 
-  std::atomic<uint64_t> total_successful_requests_{0};
-  std::atomic<uint64_t> total_requests_in_progress_{0};
-  std::atomic<uint64_t> total_error_requests_{0};
-  std::atomic<uint64_t> total_issued_requests_{0};
-
-  // Protects backend_metrics_. A mutex is necessary because the length of
-  // backend_metrics_ can be accessed by both the callback intercepting the
-  // call's recv_trailing_metadata (not from the control plane work serializer)
-  // and the load reporting thread (from the control plane work serializer).
-  Mutex backend_metrics_mu_;
-  std::map<std::string, BackendMetric> backend_metrics_
-      ABSL_GUARDED_BY(backend_metrics_mu_);
+  PerCpu<Stats> stats_;
 };
 
 }  // namespace grpc_core
@@ -18,8 +18,61 @@
 
 #include "src/core/ext/xds/xds_resource_type.h"
 
+#include <stdint.h>
+
 namespace grpc_core {
 
+namespace {
+
+// Reads a protobuf varint from the front of *input, advancing past it.
+bool ConsumeVarint(absl::string_view* input, uint64_t* value) {
+  *value = 0;
+  for (int shift = 0; shift < 64; shift += 7) {
+    if (input->empty()) return false;
+    const uint8_t byte = static_cast<uint8_t>(input->front());
+    input->remove_prefix(1);
+    *value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+    if ((byte & 0x80) == 0) return true;
+  }
+  return false;
+}
+
+}  // namespace
+
+absl::optional<absl::string_view> XdsResourceType::PeekName(
+    absl::string_view serialized_resource) const {
+  // Walk the top-level fields.  As in a full decode, the last occurrence
+  // of the name field wins.
+  absl::optional<absl::string_view> name;
+  absl::string_view input = serialized_resource;
+  while (!input.empty()) {
+    uint64_t tag;
+    if (!ConsumeVarint(&input, &tag)) return absl::nullopt;
+    uint64_t length;
+    switch (tag & 7) {
+      case 0:  // varint
+        if (!ConsumeVarint(&input, &length)) return absl::nullopt;
+        length = 0;
+        break;
+      case 1:  // 64-bit
+        length = 8;
+        break;
+      case 2:  // length-delimited
+        if (!ConsumeVarint(&input, &length)) return absl::nullopt;
+        break;
+      case 5:  // 32-bit
+        length = 4;
+        break;
+      default:  // groups are not used by xDS
+        return absl::nullopt;
+    }
+    if (length > input.size()) return absl::nullopt;
+    if (tag == ((1 << 3) | 2)) name = input.substr(0, length);
+    input.remove_prefix(length);
+  }
+  return name;
+}
+
 bool XdsResourceType::IsType(absl::string_view resource_type,
                              bool* is_v2) const {
   if (resource_type == type_url()) return true;
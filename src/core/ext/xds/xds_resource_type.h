@@ -21,6 +21,7 @@
 
 #include "absl/status/statusor.h"
 #include "absl/strings/string_view.h"
+#include "absl/types/optional.h"
 #include "upb/def.h"
 
 #include "src/core/ext/xds/upb_utils.h"
@@ -37,6 +38,8 @@ class XdsResourceType {
   // A base type for resource data.
   // Subclasses will extend this, and their DecodeResults will be
   // downcastable to their extended type.
+  // Once decoded, resource data is never modified, so XdsClient shares
+  // a single copy among the cache and all watchers.
   struct ResourceData {
     virtual ~ResourceData() = default;
   };
@@ -64,18 +67,21 @@ class XdsResourceType {
       const XdsEncodingContext& context, absl::string_view serialized_resource,
       bool is_v2) const = 0;
 
+  // Returns the name of a serialized resource proto without decoding the
+  // rest of it, or nullopt if the name cannot be found that way, in which
+  // case the caller must use Decode().
+  // This lets XdsClient skip resources that it has no watchers for, or
+  // that are unchanged, without decoding them.  The default reads field 1,
+  // which holds the name in each of the xDS resource protos.
+  virtual absl::optional<absl::string_view> PeekName(
+      absl::string_view serialized_resource) const;
+
   // Returns true if r1 and r2 are equal.
   // Must be invoked only on resources returned by this object's Decode()
   // method.
   virtual bool ResourcesEqual(const ResourceData* r1,
                               const ResourceData* r2) const = 0;
 
-  // Returns a copy of resource.
-  // Must be invoked only on resources returned by this object's Decode()
-  // method.
-  virtual std::unique_ptr<ResourceData> CopyResource(
-      const ResourceData* resource) const = 0;
-
   // Indicates whether the resource type requires that all resources must
   // be present in every SotW response from the server.  If true, a
   // response that does not include a previously seen resource will be
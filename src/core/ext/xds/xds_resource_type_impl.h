@@ -41,15 +41,22 @@ class XdsResourceTypeImpl : public XdsResourceType {
   // XdsClient watcher that handles down-casting.
   class WatcherInterface : public XdsClient::ResourceWatcherInterface {
    public:
-    virtual void OnResourceChanged(ResourceTypeStruct listener) = 0;
+    // The resource is shared with the XdsClient's cache and other
+    // watchers, so it must not be modified.
+    virtual void OnResourceChanged(
+        std::shared_ptr<const ResourceTypeStruct> resource) = 0;
 
    private:
     // Get result from XdsClient generic watcher interface, perform
-    // down-casting, and invoke the caller's OnListenerChanged() method.
+    // down-casting, and invoke the caller's OnResourceChanged() method.
     void OnGenericResourceChanged(
-        const XdsResourceType::ResourceData* resource) override {
-      OnResourceChanged(
-          static_cast<const ResourceDataSubclass*>(resource)->resource);
+        std::shared_ptr<const XdsResourceType::ResourceData> resource)
+        override {
+      const ResourceTypeStruct* value =
+          &static_cast<const ResourceDataSubclass*>(resource.get())->resource;
+      // Share ownership of the whole ResourceDataSubclass.
+      OnResourceChanged(std::shared_ptr<const ResourceTypeStruct>(
+          std::move(resource), value));
     }
   };
 
@@ -77,14 +84,6 @@ class XdsResourceTypeImpl : public XdsResourceType {
     return static_cast<const ResourceDataSubclass*>(r1)->resource ==
            static_cast<const ResourceDataSubclass*>(r2)->resource;
   }
-
-  std::unique_ptr<ResourceData> CopyResource(
-      const ResourceData* resource) const override {
-    auto* resource_copy = new ResourceDataSubclass();
-    resource_copy->resource =
-        static_cast<const ResourceDataSubclass*>(resource)->resource;
-    return std::unique_ptr<ResourceData>(resource_copy);
-  }
 };
 
 }  // namespace grpc_core
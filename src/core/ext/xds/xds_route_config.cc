@@ -338,6 +338,34 @@ std::string XdsRouteConfigResource::ToString() const {
 
 namespace {
 
+class VirtualHostListIterator : public XdsRouting::VirtualHostListIterator {
+ public:
+  explicit VirtualHostListIterator(
+      const std::vector<XdsRouteConfigResource::VirtualHost>* virtual_hosts)
+      : virtual_hosts_(virtual_hosts) {}
+
+  size_t Size() const override { return virtual_hosts_->size(); }
+
+  const std::vector<std::string>& GetDomainsForVirtualHost(
+      size_t index) const override {
+    return (*virtual_hosts_)[index].domains;
+  }
+
+ private:
+  const std::vector<XdsRouteConfigResource::VirtualHost>* virtual_hosts_;
+};
+
+}  // namespace
+
+absl::optional<size_t> XdsRouteConfigResource::FindVirtualHostForDomain(
+    absl::string_view domain) const {
+  if (virtual_host_index != nullptr) return virtual_host_index->Find(domain);
+  return XdsRouting::FindVirtualHostForDomain(
+      VirtualHostListIterator(&virtual_hosts), domain);
+}
+
+namespace {
+
 grpc_error_handle ClusterSpecifierPluginParse(
     const XdsEncodingContext& context,
     const envoy_config_route_v3_RouteConfiguration* route_config,
@@ -1085,6 +1113,8 @@ grpc_error_handle XdsRouteConfigResource::Parse(
           std::string(unused_plugin));
     }
   }
+  rds_update->virtual_host_index = std::make_shared<XdsVirtualHostIndex>(
+      VirtualHostListIterator(&rds_update->virtual_hosts));
   return GRPC_ERROR_NONE;
 }
 
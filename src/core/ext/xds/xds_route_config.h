@@ -50,6 +50,8 @@ namespace grpc_core {
 
 bool XdsRbacEnabled();
 
+class XdsVirtualHostIndex;
+
 struct XdsRouteConfigResource {
   using TypedPerFilterConfig =
       std::map<std::string, XdsHttpFilterImpl::FilterConfig>;
@@ -188,6 +190,14 @@ struct XdsRouteConfigResource {
   std::map<std::string /*cluster_specifier_plugin_name*/,
            std::string /*LB policy config*/>
       cluster_specifier_plugin_map;
+  // Index of virtual_hosts, built by Parse().  Shared by all copies, so
+  // virtual_hosts must not be reordered once it is set.
+  std::shared_ptr<const XdsVirtualHostIndex> virtual_host_index;
+
+  // Returns the index in virtual_hosts of the virtual host to use for
+  // domain, or nullopt if none matches.
+  absl::optional<size_t> FindVirtualHostForDomain(
+      absl::string_view domain) const;
 
   bool operator==(const XdsRouteConfigResource& other) const {
     return virtual_hosts == other.virtual_hosts &&
@@ -27,8 +27,10 @@
 #include <cctype>
 #include <utility>
 
+#include "absl/memory/memory.h"
 #include "absl/status/status.h"
 #include "absl/status/statusor.h"
+#include "absl/strings/ascii.h"
 #include "absl/strings/match.h"
 #include "absl/strings/str_cat.h"
 
@@ -137,6 +139,98 @@ absl::optional<size_t> XdsRouting::FindVirtualHostForDomain(
   return target_index;
 }
 
+//
+// XdsVirtualHostIndex
+//
+
+void XdsVirtualHostIndex::Trie::Insert(absl::string_view pattern,
+                                       size_t vhost) {
+  size_t node = 0;
+  for (char c : pattern) {
+    auto& children = nodes_[node].children;
+    auto it = std::lower_bound(
+        children.begin(), children.end(), c,
+        [](const std::pair<char, size_t>& child, char key) {
+          return child.first < key;
+        });
+    if (it != children.end() && it->first == c) {
+      node = it->second;
+      continue;
+    }
+    // Add the edge first: adding the node may reallocate nodes_.
+    const size_t child = nodes_.size();
+    children.insert(it, {c, child});
+    nodes_.emplace_back();
+    node = child;
+  }
+  if (!nodes_[node].vhost.has_value()) nodes_[node].vhost = vhost;
+}
+
+absl::optional<size_t> XdsVirtualHostIndex::Trie::FindLongestProperPrefix(
+    absl::string_view key) const {
+  absl::optional<size_t> vhost;
+  size_t node = 0;
+  // The asterisk must match at least one character, so stop short of the
+  // end of key.
+  for (size_t i = 0; i < key.size(); ++i) {
+    if (nodes_[node].vhost.has_value()) vhost = nodes_[node].vhost;
+    const auto& children = nodes_[node].children;
+    auto it = std::lower_bound(
+        children.begin(), children.end(), key[i],
+        [](const std::pair<char, size_t>& child, char c) {
+          return child.first < c;
+        });
+    if (it == children.end() || it->first != key[i]) break;
+    node = it->second;
+  }
+  return vhost;
+}
+
+XdsVirtualHostIndex::XdsVirtualHostIndex(
+    const XdsRouting::VirtualHostListIterator& vhost_iterator) {
+  for (size_t i = 0; i < vhost_iterator.Size(); ++i) {
+    for (const std::string& domain_pattern :
+         vhost_iterator.GetDomainsForVirtualHost(i)) {
+      const std::string pattern = absl::AsciiStrToLower(domain_pattern);
+      switch (DomainPatternMatchType(pattern)) {
+        case EXACT_MATCH:
+          exact_.emplace(pattern, i);
+          break;
+        case SUFFIX_MATCH:
+          suffixes_.Insert(std::string(pattern.rbegin(), pattern.rend() - 1),
+                           i);
+          break;
+        case PREFIX_MATCH:
+          prefixes_.Insert(absl::string_view(pattern).substr(
+                               0, pattern.size() - 1),
+                           i);
+          break;
+        case UNIVERSE_MATCH:
+          if (!universe_.has_value()) universe_ = i;
+          break;
+        case INVALID_MATCH:
+          // This should be caught by RouteConfigParse().
+          GPR_ASSERT(false);
+      }
+    }
+  }
+}
+
+absl::optional<size_t> XdsVirtualHostIndex::Find(
+    absl::string_view domain) const {
+  // Same order as FindVirtualHostForDomain(): exact, suffix, prefix, then
+  // universe match.
+  const std::string host = absl::AsciiStrToLower(domain);
+  auto it = exact_.find(host);
+  if (it != exact_.end()) return it->second;
+  absl::optional<size_t> vhost = suffixes_.FindLongestProperPrefix(
+      std::string(host.rbegin(), host.rend()));
+  if (vhost.has_value()) return vhost;
+  vhost = prefixes_.FindLongestProperPrefix(host);
+  if (vhost.has_value()) return vhost;
+  return universe_;
+}
+
 namespace {
 
 bool HeadersMatch(const std::vector<HeaderMatcher>& header_matchers,
@@ -175,6 +269,143 @@ absl::optional<size_t> XdsRouting::GetRouteForRequest(
   return absl::nullopt;
 }
 
+//
+// XdsRouting::CompiledRouteList
+//
+
+void XdsRouting::CompiledRouteList::PathIndex::AddExact(absl::string_view path,
+                                                        size_t route) {
+  exact_[std::string(path)].push_back(route);
+}
+
+void XdsRouting::CompiledRouteList::PathIndex::AddPrefix(
+    absl::string_view prefix, size_t route) {
+  if (prefix_trie_.empty()) prefix_trie_.emplace_back();
+  size_t node = 0;
+  for (char c : prefix) {
+    auto& children = prefix_trie_[node].children;
+    auto it = std::lower_bound(
+        children.begin(), children.end(), c,
+        [](const std::pair<char, size_t>& child, char key) {
+          return child.first < key;
+        });
+    if (it != children.end() && it->first == c) {
+      node = it->second;
+      continue;
+    }
+    // Add the edge first: adding the node may reallocate prefix_trie_.
+    const size_t child = prefix_trie_.size();
+    children.insert(it, {c, child});
+    prefix_trie_.emplace_back();
+    node = child;
+  }
+  prefix_trie_[node].routes.push_back(route);
+}
+
+void XdsRouting::CompiledRouteList::PathIndex::Find(
+    absl::string_view path, RouteIndices* routes) const {
+  auto it = exact_.find(path);
+  if (it != exact_.end()) {
+    routes->insert(routes->end(), it->second.begin(), it->second.end());
+  }
+  if (prefix_trie_.empty()) return;
+  // Every node on the way down is a prefix of path.
+  size_t node = 0;
+  for (size_t i = 0;; ++i) {
+    const TrieNode& trie_node = prefix_trie_[node];
+    routes->insert(routes->end(), trie_node.routes.begin(),
+                   trie_node.routes.end());
+    if (i == path.size()) break;
+    auto child = std::lower_bound(
+        trie_node.children.begin(), trie_node.children.end(), path[i],
+        [](const std::pair<char, size_t>& child, char key) {
+          return child.first < key;
+        });
+    if (child == trie_node.children.end() || child->first != path[i]) break;
+    node = child->second;
+  }
+}
+
+XdsRouting::CompiledRouteList::CompiledRouteList(
+    const RouteListIterator& route_list_iterator) {
+  for (size_t i = 0; i < route_list_iterator.Size(); ++i) {
+    const StringMatcher& path_matcher =
+        route_list_iterator.GetMatchersForRoute(i).path_matcher;
+    PathIndex* index = path_matcher.case_sensitive() ? &case_sensitive_
+                                                     : &case_insensitive_;
+    std::string pattern = path_matcher.case_sensitive()
+                              ? path_matcher.string_matcher()
+                              : absl::AsciiStrToLower(
+                                    path_matcher.string_matcher());
+    switch (path_matcher.type()) {
+      case StringMatcher::Type::kExact:
+        index->AddExact(pattern, i);
+        break;
+      case StringMatcher::Type::kPrefix:
+        index->AddPrefix(pattern, i);
+        break;
+      case StringMatcher::Type::kSafeRegex:
+        if (regex_set_ == nullptr) {
+          regex_set_ = absl::make_unique<RE2::Set>(RE2::DefaultOptions,
+                                                   RE2::ANCHOR_BOTH);
+        }
+        if (regex_set_->Add(path_matcher.regex_matcher()->pattern(),
+                            nullptr) >= 0) {
+          regex_routes_.push_back(i);
+          break;
+        }
+        unindexed_routes_.push_back(i);
+        break;
+      default:
+        unindexed_routes_.push_back(i);
+    }
+  }
+  if (regex_set_ != nullptr && !regex_set_->Compile()) {
+    // Too big for one automaton, so match each regex separately.
+    regex_set_.reset();
+    unindexed_routes_.insert(unindexed_routes_.end(), regex_routes_.begin(),
+                             regex_routes_.end());
+    regex_routes_.clear();
+  }
+}
+
+absl::optional<size_t> XdsRouting::CompiledRouteList::GetRouteForRequest(
+    const RouteListIterator& route_list_iterator, absl::string_view path,
+    grpc_metadata_batch* initial_metadata) const {
+  // Find the routes whose path matcher matches.
+  RouteIndices routes;
+  case_sensitive_.Find(path, &routes);
+  if (!case_insensitive_.empty()) {
+    case_insensitive_.Find(absl::AsciiStrToLower(path), &routes);
+  }
+  if (regex_set_ != nullptr) {
+    std::vector<int> regexes;
+    if (regex_set_->Match(re2::StringPiece(path.data(), path.size()),
+                          &regexes)) {
+      for (int regex : regexes) routes.push_back(regex_routes_[regex]);
+    }
+  }
+  for (size_t route : unindexed_routes_) {
+    if (route_list_iterator.GetMatchersForRoute(route).path_matcher.Match(
+            path)) {
+      routes.push_back(route);
+    }
+  }
+  // Check the rest of their matchers in order, as the linear search would,
+  // so that the fractions draw the same random numbers.
+  std::sort(routes.begin(), routes.end());
+  for (size_t route : routes) {
+    const XdsRouteConfigResource::Route::Matchers& matchers =
+        route_list_iterator.GetMatchersForRoute(route);
+    if (HeadersMatch(matchers.header_matchers, initial_metadata) &&
+        (!matchers.fraction_per_million.has_value() ||
+         UnderFraction(*matchers.fraction_per_million))) {
+      return route;
+    }
+  }
+  return absl::nullopt;
+}
+
 bool XdsRouting::IsValidDomainPattern(absl::string_view domain_pattern) {
   return DomainPatternMatchType(domain_pattern) != INVALID_MATCH;
 }
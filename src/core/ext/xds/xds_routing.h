@@ -24,11 +24,16 @@
 #include <stddef.h>
 
 #include <map>
+#include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 
+#include "absl/container/flat_hash_map.h"
+#include "absl/container/inlined_vector.h"
 #include "absl/strings/string_view.h"
 #include "absl/types/optional.h"
+#include "re2/set.h"
 
 #include <grpc/impl/codegen/grpc_types.h>
 
@@ -61,6 +66,56 @@ class XdsRouting {
         size_t index) const = 0;
   };
 
+  // A route list compiled for matching requests, built once per update.
+  // Exact paths are looked up in hash tables, prefixes in tries, and all
+  // regexes are run at once with an RE2::Set, so that only the routes
+  // whose path matches have their headers and fraction checked.
+  class CompiledRouteList {
+   public:
+    CompiledRouteList() = default;
+    explicit CompiledRouteList(const RouteListIterator& route_list_iterator);
+
+    // Returns the same as XdsRouting::GetRouteForRequest() would for the
+    // route list this was compiled from, which must be passed in again.
+    absl::optional<size_t> GetRouteForRequest(
+        const RouteListIterator& route_list_iterator, absl::string_view path,
+        grpc_metadata_batch* initial_metadata) const;
+
+   private:
+    using RouteIndices = absl::InlinedVector<size_t, 16>;
+
+    // Exact paths and path prefixes of one case sensitivity.
+    class PathIndex {
+     public:
+      void AddExact(absl::string_view path, size_t route);
+      void AddPrefix(absl::string_view prefix, size_t route);
+      bool empty() const { return exact_.empty() && prefix_trie_.empty(); }
+      // Adds the routes that match path to routes.
+      void Find(absl::string_view path, RouteIndices* routes) const;
+
+     private:
+      struct TrieNode {
+        // Sorted by character.
+        std::vector<std::pair<char, size_t>> children;
+        // The routes whose prefix ends at this node.
+        std::vector<size_t> routes;
+      };
+
+      absl::flat_hash_map<std::string, std::vector<size_t>> exact_;
+      // The root is the first node, if there is one.
+      std::vector<TrieNode> prefix_trie_;
+    };
+
+    PathIndex case_sensitive_;
+    // Keyed by lower-cased path.
+    PathIndex case_insensitive_;
+    std::unique_ptr<RE2::Set> regex_set_;
+    // The route of each regex in regex_set_.
+    std::vector<size_t> regex_routes_;
+    // Routes whose path matcher is checked on every request.
+    std::vector<size_t> unindexed_routes_;
+  };
+
   // Returns the index of the selected virtual host in the list.
   static absl::optional<size_t> FindVirtualHostForDomain(
       const VirtualHostListIterator& vhost_iterator, absl::string_view domain);
@@ -101,6 +156,46 @@ class XdsRouting {
       grpc_channel_args* args);
 };
 
+// An index of the domain patterns of a list of virtual hosts, so that the
+// virtual host for a domain can be found without checking every pattern.
+// XdsRouteConfigResource::Parse() builds one for each route config.
+class XdsVirtualHostIndex {
+ public:
+  explicit XdsVirtualHostIndex(
+      const XdsRouting::VirtualHostListIterator& vhost_iterator);
+
+  // Returns the same as XdsRouting::FindVirtualHostForDomain() would for
+  // the virtual hosts this was built from.
+  absl::optional<size_t> Find(absl::string_view domain) const;
+
+ private:
+  // Holds the first virtual host with each pattern.
+  class Trie {
+   public:
+    void Insert(absl::string_view pattern, size_t vhost);
+    // Returns the virtual host of the longest pattern that is a prefix of
+    // key and shorter than it.
+    absl::optional<size_t> FindLongestProperPrefix(absl::string_view key) const;
+
+   private:
+    struct Node {
+      // Sorted by character.
+      std::vector<std::pair<char, size_t>> children;
+      absl::optional<size_t> vhost;
+    };
+
+    // The root is the first node.
+    std::vector<Node> nodes_{1};
+  };
+
+  // All patterns are lower-cased, and the asterisks dropped.
+  absl::flat_hash_map<std::string, size_t> exact_;
+  // Reversed.
+  Trie suffixes_;
+  Trie prefixes_;
+  absl::optional<size_t> universe_;
+};
+
 }  // namespace grpc_core
 
 #endif  // GRPC_CORE_EXT_XDS_XDS_ROUTING_H
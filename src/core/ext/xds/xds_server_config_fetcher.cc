@@ -148,7 +148,8 @@ class XdsServerConfigFetcher::ListenerWatcher
                   grpc_server_xds_status_notifier serving_status_notifier,
                   std::string listening_address);
 
-  void OnResourceChanged(XdsListenerResource listener) override;
+  void OnResourceChanged(
+      std::shared_ptr<const XdsListenerResource> listener) override;
 
   void OnError(absl::Status status) override;
 
@@ -278,9 +279,10 @@ class XdsServerConfigFetcher::ListenerWatcher::FilterChainMatchManager::
       : resource_name_(std::move(resource_name)),
         filter_chain_match_manager_(std::move(filter_chain_match_manager)) {}
 
-  void OnResourceChanged(XdsRouteConfigResource route_config) override {
+  void OnResourceChanged(
+      std::shared_ptr<const XdsRouteConfigResource> route_config) override {
     filter_chain_match_manager_->OnRouteConfigChanged(resource_name_,
-                                                      std::move(route_config));
+                                                      *route_config);
   }
 
   void OnError(absl::Status status) override {
@@ -338,6 +340,7 @@ class XdsServerConfigFetcher::ListenerWatcher::FilterChainMatchManager::
 
     std::vector<std::string> domains;
     std::vector<Route> routes;
+    XdsRouting::CompiledRouteList compiled_routes;
   };
 
   class VirtualHostListIterator : public XdsRouting::VirtualHostListIterator {
@@ -358,6 +361,7 @@ class XdsServerConfigFetcher::ListenerWatcher::FilterChainMatchManager::
   };
 
   std::vector<VirtualHost> virtual_hosts_;
+  std::shared_ptr<const XdsVirtualHostIndex> virtual_host_index_;
 };
 
 // An XdsServerConfigSelectorProvider implementation for when the
@@ -444,8 +448,9 @@ class XdsServerConfigFetcher::ListenerWatcher::FilterChainMatchManager::
       WeakRefCountedPtr<DynamicXdsServerConfigSelectorProvider> parent)
       : parent_(std::move(parent)) {}
 
-  void OnResourceChanged(XdsRouteConfigResource route_config) override {
-    parent_->OnRouteConfigChanged(std::move(route_config));
+  void OnResourceChanged(
+      std::shared_ptr<const XdsRouteConfigResource> route_config) override {
+    parent_->OnRouteConfigChanged(*route_config);
   }
 
   void OnError(absl::Status status) override { parent_->OnError(status); }
@@ -528,21 +533,20 @@ XdsServerConfigFetcher::ListenerWatcher::ListenerWatcher(
       listening_address_(std::move(listening_address)) {}
 
 void XdsServerConfigFetcher::ListenerWatcher::OnResourceChanged(
-    XdsListenerResource listener) {
+    std::shared_ptr<const XdsListenerResource> listener) {
   if (GRPC_TRACE_FLAG_ENABLED(grpc_xds_server_config_fetcher_trace)) {
     gpr_log(GPR_INFO,
             "[ListenerWatcher %p] Received LDS update from xds client %p: %s",
-            this, xds_client_.get(), listener.ToString().c_str());
+            this, xds_client_.get(), listener->ToString().c_str());
   }
-  if (listener.address != listening_address_) {
+  if (listener->address != listening_address_) {
     MutexLock lock(&mu_);
     OnFatalError(absl::FailedPreconditionError(
         "Address in LDS update does not match listening address"));
     return;
   }
   auto new_filter_chain_match_manager = MakeRefCounted<FilterChainMatchManager>(
-      xds_client_, std::move(listener.filter_chain_map),
-      std::move(listener.default_filter_chain));
+      xds_client_, listener->filter_chain_map, listener->default_filter_chain);
   MutexLock lock(&mu_);
   if (filter_chain_match_manager_ == nullptr ||
       !(new_filter_chain_match_manager->filter_chain_map() ==
@@ -1174,6 +1178,15 @@ XdsServerConfigFetcher::ListenerWatcher::FilterChainMatchManager::
       }
       grpc_channel_args_destroy(result.args);
     }
+    virtual_host.compiled_routes = XdsRouting::CompiledRouteList(
+        VirtualHost::RouteListIterator(&virtual_host.routes));
+  }
+  // virtual_hosts_ is in the same order as rds_update.virtual_hosts.
+  config_selector->virtual_host_index_ = rds_update.virtual_host_index;
+  if (config_selector->virtual_host_index_ == nullptr) {
+    config_selector->virtual_host_index_ =
+        std::make_shared<XdsVirtualHostIndex>(
+            VirtualHostListIterator(&config_selector->virtual_hosts_));
   }
   return config_selector;
 }
@@ -1195,8 +1208,7 @@ ServerConfigSelector::CallConfig XdsServerConfigFetcher::ListenerWatcher::
   }
   absl::string_view authority =
       metadata->get_pointer(HttpAuthorityMetadata())->as_string_view();
-  auto vhost_index = XdsRouting::FindVirtualHostForDomain(
-      VirtualHostListIterator(&virtual_hosts_), authority);
+  auto vhost_index = virtual_host_index_->Find(authority);
   if (!vhost_index.has_value()) {
     call_config.error =
         grpc_error_set_int(GRPC_ERROR_CREATE_FROM_CPP_STRING(absl::StrCat(
@@ -1206,7 +1218,7 @@ ServerConfigSelector::CallConfig XdsServerConfigFetcher::ListenerWatcher::
     return call_config;
   }
   auto& virtual_host = virtual_hosts_[vhost_index.value()];
-  auto route_index = XdsRouting::GetRouteForRequest(
+  auto route_index = virtual_host.compiled_routes.GetRouteForRequest(
       VirtualHost::RouteListIterator(&virtual_host.routes), path, metadata);
   if (route_index.has_value()) {
     auto& route = virtual_host.routes[route_index.value()];
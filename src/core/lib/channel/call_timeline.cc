@@ -0,0 +1,235 @@
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <grpc/support/port_platform.h>
+
+#include "src/core/lib/channel/call_timeline.h"
+
+#include <string.h>
+
+#include <string>
+#include <utility>
+
+#include <grpc/support/log.h>
+
+#include "src/core/lib/gpr/string.h"
+#include "src/core/lib/gpr/useful.h"
+
+namespace grpc_core {
+
+namespace {
+
+double ToMicros(gpr_timespec ts) {
+  return static_cast<double>(ts.tv_sec) * GPR_US_PER_SEC +
+         static_cast<double>(ts.tv_nsec) / GPR_NS_PER_US;
+}
+
+struct StageBounds {
+  CallTimeline::Event begin;
+  CallTimeline::Event end;
+};
+
+// The events delimiting each stage, indexed by stage.  The flow control
+// stall is accumulated separately, and has no entry.
+constexpr StageBounds kStageBounds[] = {
+    {CallTimeline::Event::kResolverQueued, CallTimeline::Event::kResolverDone},
+    {CallTimeline::Event::kLbPickQueued, CallTimeline::Event::kLbPickDone},
+    {CallTimeline::Event::kTransportQueued,
+     CallTimeline::Event::kHeadersWritten},
+    {CallTimeline::Event::kCallStart, CallTimeline::Event::kCallStart},
+    {CallTimeline::Event::kServerRequestMatched,
+     CallTimeline::Event::kServerHandlerStart},
+    {CallTimeline::Event::kServerHandlerStart,
+     CallTimeline::Event::kServerSendStatus},
+    {CallTimeline::Event::kCallStart, CallTimeline::Event::kCallEnd},
+};
+static_assert(GPR_ARRAY_SIZE(kStageBounds) == CallTimeline::kNumStages,
+              "kStageBounds must cover every stage");
+
+}  // namespace
+
+//
+// CallTimeline
+//
+
+constexpr size_t CallTimeline::kNumEvents;
+constexpr size_t CallTimeline::kNumStages;
+
+CallTimeline::CallTimeline(gpr_cycle_counter start_time) {
+  for (auto& time : events_) time.store(0, std::memory_order_relaxed);
+  events_[static_cast<size_t>(Event::kCallStart)].store(
+      start_time, std::memory_order_relaxed);
+}
+
+void CallTimeline::FlowControlStalled() {
+  if (stall_start_ == 0) stall_start_ = gpr_get_cycle_counter();
+}
+
+void CallTimeline::FlowControlResumed() {
+  if (stall_start_ == 0) return;
+  stall_cycles_.store(stall_cycles_.load(std::memory_order_relaxed) +
+                          (gpr_get_cycle_counter() - stall_start_),
+                      std::memory_order_relaxed);
+  stall_start_ = 0;
+}
+
+void CallTimeline::SetMethod(Arena* arena, absl::string_view method) {
+  char* copy = static_cast<char*>(arena->Alloc(method.size()));
+  memcpy(copy, method.data(), method.size());
+  method_ = absl::string_view(copy, method.size());
+}
+
+absl::optional<gpr_timespec> CallTimeline::StageDuration(Stage stage) const {
+  if (stage == Stage::kFlowControlStall) {
+    const gpr_cycle_counter stall_cycles =
+        stall_cycles_.load(std::memory_order_relaxed);
+    if (stall_cycles == 0) return absl::nullopt;
+    return gpr_cycle_counter_sub(stall_cycles, 0);
+  }
+  const StageBounds& bounds = kStageBounds[static_cast<size_t>(stage)];
+  const gpr_cycle_counter begin = EventTime(bounds.begin);
+  const gpr_cycle_counter end = EventTime(bounds.end);
+  if (begin == 0 || end == 0 || end < begin) return absl::nullopt;
+  return gpr_cycle_counter_sub(end, begin);
+}
+
+Json CallTimeline::ToJson() const {
+  const gpr_cycle_counter start = EventTime(Event::kCallStart);
+  Json::Object json = {
+      {"startTime",
+       gpr_format_timespec(gpr_convert_clock_type(
+           gpr_cycle_counter_to_time(start), GPR_CLOCK_REALTIME))},
+  };
+  if (!method_.empty()) json["method"] = std::string(method_);
+  Json::Array events;
+  for (size_t i = 0; i < kNumEvents; ++i) {
+    const gpr_cycle_counter time = events_[i].load(std::memory_order_relaxed);
+    if (time == 0) continue;
+    events.emplace_back(Json::Object{
+        {"event", EventName(static_cast<Event>(i))},
+        {"offsetMicros", ToMicros(gpr_cycle_counter_sub(time, start))},
+    });
+  }
+  json["event"] = std::move(events);
+  Json::Array stages;
+  for (size_t i = 0; i < kNumStages; ++i) {
+    absl::optional<gpr_timespec> duration =
+        StageDuration(static_cast<Stage>(i));
+    if (!duration.has_value()) continue;
+    stages.emplace_back(Json::Object{
+        {"stage", StageName(static_cast<Stage>(i))},
+        {"durationMicros", ToMicros(*duration)},
+    });
+  }
+  json["stage"] = std::move(stages);
+  return json;
+}
+
+const char* CallTimeline::EventName(Event event) {
+  switch (event) {
+    case Event::kCallStart:
+      return "CALL_START";
+    case Event::kResolverQueued:
+      return "RESOLVER_QUEUED";
+    case Event::kResolverDone:
+      return "RESOLVER_DONE";
+    case Event::kLbPickQueued:
+      return "LB_PICK_QUEUED";
+    case Event::kLbPickDone:
+      return "LB_PICK_DONE";
+    case Event::kTransportQueued:
+      return "TRANSPORT_QUEUED";
+    case Event::kHeadersWritten:
+      return "HEADERS_WRITTEN";
+    case Event::kServerRequestMatched:
+      return "SERVER_REQUEST_MATCHED";
+    case Event::kServerHandlerStart:
+      return "SERVER_HANDLER_START";
+    case Event::kServerSendStatus:
+      return "SERVER_SEND_STATUS";
+    case Event::kCallEnd:
+      return "CALL_END";
+  }
+  GPR_UNREACHABLE_CODE(return "UNKNOWN");
+}
+
+const char* CallTimeline::StageName(Stage stage) {
+  switch (stage) {
+    case Stage::kResolverQueue:
+      return "RESOLVER_QUEUE";
+    case Stage::kLbPickQueue:
+      return "LB_PICK_QUEUE";
+    case Stage::kTransportWriteQueue:
+      return "TRANSPORT_WRITE_QUEUE";
+    case Stage::kFlowControlStall:
+      return "FLOW_CONTROL_STALL";
+    case Stage::kServerCqWait:
+      return "SERVER_CQ_WAIT";
+    case Stage::kServerHandler:
+      return "SERVER_HANDLER";
+    case Stage::kTotal:
+      return "TOTAL";
+  }
+  GPR_UNREACHABLE_CODE(return "UNKNOWN");
+}
+
+//
+// CallTimelineStats
+//
+
+constexpr size_t CallTimelineStats::kMaxRecentCalls;
+
+CallTimelineStats::CallTimelineStats(uint32_t sample_period)
+    : sample_period_(sample_period) {
+  GPR_ASSERT(sample_period_ != 0);
+}
+
+void CallTimelineStats::Record(const CallTimeline& timeline) {
+  for (size_t i = 0; i < CallTimeline::kNumStages; ++i) {
+    absl::optional<gpr_timespec> duration =
+        timeline.StageDuration(static_cast<CallTimeline::Stage>(i));
+    if (duration.has_value()) stages_[i].Record(*duration);
+  }
+  Json json = timeline.ToJson();
+  MutexLock lock(&mu_);
+  ++sampled_calls_;
+  recent_calls_.push_back(std::move(json));
+  if (recent_calls_.size() > kMaxRecentCalls) recent_calls_.pop_front();
+}
+
+Json::Object CallTimelineStats::RenderJson() {
+  Json::Array stages;
+  for (size_t i = 0; i < CallTimeline::kNumStages; ++i) {
+    LatencyHistogram::Snapshot snapshot = stages_[i].Collect();
+    if (snapshot.Count() == 0) continue;
+    stages.emplace_back(Json::Object{
+        {"stage", CallTimeline::StageName(static_cast<CallTimeline::Stage>(i))},
+        {"count", std::to_string(snapshot.Count())},
+        {"p50Micros", snapshot.Percentile(50)},
+        {"p90Micros", snapshot.Percentile(90)},
+        {"p99Micros", snapshot.Percentile(99)},
+        {"p999Micros", snapshot.Percentile(99.9)},
+    });
+  }
+  MutexLock lock(&mu_);
+  Json::Array recent_calls(recent_calls_.begin(), recent_calls_.end());
+  return Json::Object{
+      {"samplePeriod", sample_period_},
+      {"sampledCalls", std::to_string(sampled_calls_)},
+      {"stage", std::move(stages)},
+      {"recentCall", std::move(recent_calls)},
+  };
+}
+
+}  // namespace grpc_core
@@ -0,0 +1,171 @@
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GRPC_CORE_LIB_CHANNEL_CALL_TIMELINE_H
+#define GRPC_CORE_LIB_CHANNEL_CALL_TIMELINE_H
+
+#include <grpc/support/port_platform.h>
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <atomic>
+#include <deque>
+
+#include "absl/strings/string_view.h"
+#include "absl/types/optional.h"
+
+#include <grpc/support/time.h>
+
+#include "src/core/lib/channel/context.h"
+#include "src/core/lib/debug/latency_histogram.h"
+#include "src/core/lib/gpr/time_precise.h"
+#include "src/core/lib/gprpp/per_cpu.h"
+#include "src/core/lib/gprpp/sync.h"
+#include "src/core/lib/json/json.h"
+#include "src/core/lib/resource_quota/arena.h"
+
+namespace grpc_core {
+
+// When a sampled call reached each stage of its life, from creation in the
+// surface through name resolution, the LB pick and the transport to the
+// server's handler.
+//
+// The timeline lives in the call's arena and is found through the
+// GRPC_CONTEXT_CALL_TIMELINE context slot, which is only set for sampled
+// calls, so unsampled calls pay for a null check at each stage.  Events
+// are marked from whichever thread the call happens to be on, so the
+// timestamps are atomics; only the first occurrence of each event is kept
+// (e.g. for the first LB pick of a call that is retried).
+class CallTimeline {
+ public:
+  enum class Event : uint8_t {
+    kCallStart,
+    // Client: the call waited for the resolver's first result.
+    kResolverQueued,
+    kResolverDone,
+    // Client: the call waited for the LB policy to pick a connected
+    // subchannel, including while the subchannel connects.
+    kLbPickQueued,
+    kLbPickDone,
+    // The transport was handed the initial metadata, and wrote it.
+    kTransportQueued,
+    kHeadersWritten,
+    // Server: the call was matched with a requested call, and the
+    // application took it from its completion queue.
+    kServerRequestMatched,
+    kServerHandlerStart,
+    kServerSendStatus,
+    kCallEnd,
+  };
+  static constexpr size_t kNumEvents =
+      static_cast<size_t>(Event::kCallEnd) + 1;
+
+  // The stages derived from the events, reported as durations.
+  enum class Stage : uint8_t {
+    kResolverQueue,
+    kLbPickQueue,
+    kTransportWriteQueue,
+    // Time spent with data to send but no flow control window.
+    kFlowControlStall,
+    kServerCqWait,
+    kServerHandler,
+    kTotal,
+  };
+  static constexpr size_t kNumStages = static_cast<size_t>(Stage::kTotal) + 1;
+
+  explicit CallTimeline(gpr_cycle_counter start_time);
+
+  // Returns the timeline of the call with the given context, or null if
+  // the call is not sampled.
+  static CallTimeline* FromContext(const grpc_call_context_element* context) {
+    if (context == nullptr) return nullptr;
+    return static_cast<CallTimeline*>(
+        context[GRPC_CONTEXT_CALL_TIMELINE].value);
+  }
+
+  void Mark(Event event) {
+    std::atomic<gpr_cycle_counter>& time = events_[static_cast<size_t>(event)];
+    if (time.load(std::memory_order_relaxed) == 0) {
+      time.store(gpr_get_cycle_counter(), std::memory_order_relaxed);
+    }
+  }
+
+  // Called by the transport, which serializes them, when the call has data
+  // to send but cannot because of flow control, and when it sends data.
+  void FlowControlStalled();
+  void FlowControlResumed();
+
+  // Copies method into arena.
+  void SetMethod(Arena* arena, absl::string_view method);
+  absl::string_view method() const { return method_; }
+
+  // Returns when event happened, or 0 if it did not (yet).
+  gpr_cycle_counter EventTime(Event event) const {
+    return events_[static_cast<size_t>(event)].load(std::memory_order_relaxed);
+  }
+  // Returns how long the call spent in stage, or nullopt if it did not go
+  // through it.
+  absl::optional<gpr_timespec> StageDuration(Stage stage) const;
+
+  Json ToJson() const;
+
+  static const char* EventName(Event event);
+  static const char* StageName(Stage stage);
+
+ private:
+  std::atomic<gpr_cycle_counter> events_[kNumEvents];
+  // Owned by the transport.
+  gpr_cycle_counter stall_start_ = 0;
+  std::atomic<gpr_cycle_counter> stall_cycles_{0};
+  absl::string_view method_;
+};
+
+// Per-stage latency histograms and the most recent timelines of the calls
+// sampled on a channel or server, kept by its channelz node.
+class CallTimelineStats {
+ public:
+  // How many of the most recent sampled timelines are kept.
+  static constexpr size_t kMaxRecentCalls = 32;
+
+  // One in sample_period calls is sampled, which must not be 0.
+  explicit CallTimelineStats(uint32_t sample_period);
+
+  uint32_t sample_period() const { return sample_period_; }
+
+  // Returns whether a new call should record a timeline.
+  bool ShouldSample() {
+    return per_cpu_calls_.this_cpu().fetch_add(
+               1, std::memory_order_relaxed) %
+               sample_period_ ==
+           0;
+  }
+
+  // Adds a finished call's timeline.
+  void Record(const CallTimeline& timeline);
+
+  Json::Object RenderJson();
+
+ private:
+  const uint32_t sample_period_;
+  PerCpu<std::atomic<uint32_t>> per_cpu_calls_;
+  LatencyHistogram stages_[CallTimeline::kNumStages];
+  Mutex mu_;
+  std::deque<Json> recent_calls_ ABSL_GUARDED_BY(mu_);
+  uint64_t sampled_calls_ ABSL_GUARDED_BY(mu_) = 0;
+};
+
+}  // namespace grpc_core
+
+#endif  // GRPC_CORE_LIB_CHANNEL_CALL_TIMELINE_H
@@ -35,6 +35,8 @@
 
 namespace grpc_core {
 
+class CallTimeline;
+
 // Interface for a tracer that records activities on a call. Actual attempts for
 // this call are traced with CallAttemptTracer after invoking RecordNewAttempt()
 // on the CallTracer object.
@@ -87,6 +89,9 @@ class CallTracer {
   // serves as an indication that the call stack is done with all API calls, and
   // the tracer library is free to destroy it after that.
   virtual CallAttemptTracer* StartNewAttempt(bool is_transparent_retry) = 0;
+  // Invoked with the call's timeline when a call sampled for call timelines
+  // is destroyed, before the call stack is destroyed.
+  virtual void RecordCallTimeline(const CallTimeline& /*timeline*/) {}
 };
 
 }  // namespace grpc_core
@@ -26,8 +26,11 @@
 
 #include <algorithm>
 #include <map>
+#include <tuple>
 #include <vector>
 
+#include "absl/container/flat_hash_map.h"
+#include "absl/hash/hash.h"
 #include "absl/strings/match.h"
 #include "absl/strings/str_cat.h"
 #include "absl/strings/str_format.h"
@@ -40,6 +43,7 @@
 
 #include "src/core/lib/gpr/useful.h"
 #include "src/core/lib/gprpp/match.h"
+#include "src/core/lib/gprpp/sync.h"
 
 namespace {
 
@@ -390,6 +394,103 @@ int grpc_channel_args_compare(const grpc_channel_args* a,
   return 0;
 }
 
+size_t grpc_channel_args_hash(const grpc_channel_args* args) {
+  if (args == nullptr) return absl::Hash<size_t>()(0);
+  size_t h = absl::Hash<size_t>()(args->num_args);
+  for (size_t i = 0; i < args->num_args; i++) {
+    const grpc_arg& arg = args->args[i];
+    switch (arg.type) {
+      case GRPC_ARG_STRING:
+        h = absl::Hash<std::tuple<size_t, int, absl::string_view,
+                                  absl::string_view>>()(
+            {h, arg.type, arg.key, arg.value.string});
+        break;
+      case GRPC_ARG_INTEGER:
+        h = absl::Hash<std::tuple<size_t, int, absl::string_view, int>>()(
+            {h, arg.type, arg.key, arg.value.integer});
+        break;
+      case GRPC_ARG_POINTER:
+        h = absl::Hash<std::tuple<size_t, int, absl::string_view>>()(
+            {h, arg.type, arg.key});
+        break;
+    }
+  }
+  return h;
+}
+
+namespace grpc_core {
+
+namespace {
+
+// A normalized set of args and its hash, as the key of the intern table.
+// While in the table, args is owned by the InternedChannelArgs it maps to.
+struct InternKey {
+  const grpc_channel_args* args;
+  size_t hash;
+
+  bool operator==(const InternKey& other) const {
+    return hash == other.hash &&
+           grpc_channel_args_compare(args, other.args) == 0;
+  }
+  template <typename H>
+  friend H AbslHashValue(H h, const InternKey& key) {
+    return H::combine(std::move(h), key.hash);
+  }
+};
+
+struct InternTable {
+  Mutex mu;
+  absl::flat_hash_map<InternKey, InternedChannelArgs*> map
+      ABSL_GUARDED_BY(mu);
+};
+
+InternTable* GetInternTable() {
+  static InternTable* table = new InternTable();
+  return table;
+}
+
+}  // namespace
+
+RefCountedPtr<InternedChannelArgs> InternedChannelArgs::Intern(
+    const grpc_channel_args* args) {
+  // Sort shallow copies of the args, as grpc_channel_args_normalize would,
+  // so that lookups that hit an existing instance copy nothing.
+  std::vector<grpc_arg> sorted;
+  if (args != nullptr) sorted.assign(args->args, args->args + args->num_args);
+  std::stable_sort(sorted.begin(), sorted.end(),
+                   [](const grpc_arg& a, const grpc_arg& b) {
+                     return strcmp(a.key, b.key) < 0;
+                   });
+  grpc_channel_args normalized = {sorted.size(), sorted.data()};
+  InternKey key = {&normalized, grpc_channel_args_hash(&normalized)};
+  InternTable* table = GetInternTable();
+  MutexLock lock(&table->mu);
+  auto it = table->map.find(key);
+  if (it != table->map.end()) {
+    RefCountedPtr<InternedChannelArgs> existing = it->second->RefIfNonZero();
+    if (existing != nullptr) return existing;
+    // The instance is being destroyed and will not find itself in the table
+    // once it gets the lock: replace it.
+    table->map.erase(it);
+  }
+  auto* interned = new InternedChannelArgs(
+      grpc_channel_args_copy(&normalized), key.hash);
+  table->map.emplace(InternKey{interned->args_, key.hash}, interned);
+  return RefCountedPtr<InternedChannelArgs>(interned);
+}
+
+InternedChannelArgs::~InternedChannelArgs() {
+  InternTable* table = GetInternTable();
+  {
+    MutexLock lock(&table->mu);
+    auto it = table->map.find(InternKey{args_, hash_});
+    if (it != table->map.end() && it->second == this) table->map.erase(it);
+  }
+  grpc_channel_args_destroy(args_);
+}
+
+}  // namespace grpc_core
+
 const grpc_arg* grpc_channel_args_find(const grpc_channel_args* args,
                                        const char* name) {
   if (args != nullptr) {
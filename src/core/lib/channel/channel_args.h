@@ -300,6 +300,12 @@ inline void grpc_channel_args_destroy(const grpc_channel_args* a) {
 int grpc_channel_args_compare(const grpc_channel_args* a,
                               const grpc_channel_args* b);
 
+/** Returns a hash of \a args that is consistent with
+ * \a grpc_channel_args_compare: args that compare equal hash equal. Pointer
+ * args contribute only their keys, since their vtables may consider distinct
+ * pointers equal. */
+size_t grpc_channel_args_hash(const grpc_channel_args* args);
+
 /** Returns the value of argument \a name from \a args, or NULL if not found. */
 const grpc_arg* grpc_channel_args_find(const grpc_channel_args* args,
                                        const char* name);
@@ -355,6 +361,31 @@ grpc_arg grpc_channel_arg_pointer_create(char* name, void* value,
 std::string grpc_channel_args_string(const grpc_channel_args* args);
 
 namespace grpc_core {
+
+// An immutable, normalized (see grpc_channel_args_normalize) set of channel
+// args. Equal sets intern to the same instance for as long as any reference
+// to it is held, so two instances can be compared by address, and the hash is
+// computed once, when the set is first interned.
+class InternedChannelArgs : public RefCounted<InternedChannelArgs> {
+ public:
+  // Returns the instance equal to \a args after normalization, creating it if
+  // there is none. Only copies \a args when a new instance is created.
+  static RefCountedPtr<InternedChannelArgs> Intern(
+      const grpc_channel_args* args);
+
+  ~InternedChannelArgs() override;
+
+  const grpc_channel_args* args() const { return args_; }
+  size_t hash() const { return hash_; }
+
+ private:
+  InternedChannelArgs(grpc_channel_args* args, size_t hash)
+      : args_(args), hash_(hash) {}
+
+  grpc_channel_args* const args_;
+  const size_t hash_;
+};
+
 // Ensure no duplicate channel args (with some backwards compatibility hacks).
 // Eliminate any grpc.internal.* args.
 // Return a C++ object.
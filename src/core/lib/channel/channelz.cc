@@ -26,6 +26,7 @@
 #include <atomic>
 #include <type_traits>
 
+#include "absl/memory/memory.h"
 #include "absl/status/statusor.h"
 #include "absl/strings/escaping.h"
 #include "absl/strings/strip.h"
@@ -39,6 +40,7 @@
 #include "src/core/lib/address_utils/sockaddr_utils.h"
 #include "src/core/lib/channel/channel_args.h"
 #include "src/core/lib/channel/channelz_registry.h"
+#include "src/core/lib/debug/stats_data.h"
 #include "src/core/lib/gpr/string.h"
 #include "src/core/lib/gpr/useful.h"
 #include "src/core/lib/gprpp/host_port.h"
@@ -135,17 +137,69 @@ void CallCountingHelper::PopulateCallCounts(Json::Object* json) {
   }
 }
 
+//
+// MethodLatencyStats
+//
+
+constexpr size_t MethodLatencyStats::kMaxMethods;
+constexpr char MethodLatencyStats::kOtherMethods[];
+
+MethodLatencyStats::MethodLatencyStats() {
+  tables_.push_back(absl::make_unique<Table>());
+  table_.store(tables_.back().get(), std::memory_order_release);
+}
+
+LatencyHistogram* MethodLatencyStats::GetHistogram(absl::string_view path) {
+  const Table* table = table_.load(std::memory_order_acquire);
+  auto it = table->find(path);
+  if (it != table->end()) return it->second;
+  MutexLock lock(&mu_);
+  // Another thread may have added it since.
+  table = tables_.back().get();
+  it = table->find(path);
+  if (it != table->end()) return it->second;
+  if (table->size() >= kMaxMethods) {
+    it = table->find(kOtherMethods);
+    if (it != table->end()) return it->second;
+    path = kOtherMethods;
+  }
+  histograms_.push_back(absl::make_unique<LatencyHistogram>());
+  LatencyHistogram* histogram = histograms_.back().get();
+  auto new_table = absl::make_unique<Table>(*table);
+  new_table->emplace(std::string(path), histogram);
+  tables_.push_back(std::move(new_table));
+  table_.store(tables_.back().get(), std::memory_order_release);
+  return histogram;
+}
+
+std::map<std::string, LatencyHistogram::Snapshot>
+MethodLatencyStats::Collect() {
+  std::map<std::string, LatencyHistogram::Snapshot> result;
+  for (const auto& p : *table_.load(std::memory_order_acquire)) {
+    result.emplace(p.first, p.second->Collect());
+  }
+  return result;
+}
+
 //
 // ChannelNode
 //
 
 ChannelNode::ChannelNode(std::string target, size_t channel_tracer_max_nodes,
-                         bool is_internal_channel)
+                         bool is_internal_channel, bool method_latency_stats,
+                         uint32_t call_timeline_sample_period)
     : BaseNode(is_internal_channel ? EntityType::kInternalChannel
                                    : EntityType::kTopLevelChannel,
                target),
       target_(std::move(target)),
-      trace_(channel_tracer_max_nodes) {}
+      trace_(channel_tracer_max_nodes),
+      method_latency_stats_(method_latency_stats
+                                ? absl::make_unique<MethodLatencyStats>()
+                                : nullptr),
+      call_timeline_stats_(call_timeline_sample_period != 0
+                               ? absl::make_unique<CallTimelineStats>(
+                                     call_timeline_sample_period)
+                               : nullptr) {}
 
 const char* ChannelNode::GetChannelConnectivityStateChangeString(
     grpc_connectivity_state state) {
@@ -199,6 +253,76 @@ Json ChannelNode::RenderJson() {
   return json;
 }
 
+void ChannelNode::SetCallInitialSizeSource(
+    std::function<CallInitialSizeHistograms()> source) {
+  MutexLock lock(&call_initial_size_mu_);
+  call_initial_size_source_ = std::move(source);
+}
+
+Json ChannelNode::RenderMethodLatencyJson() {
+  Json::Array methods;
+  if (method_latency_stats_ != nullptr) {
+    for (const auto& p : method_latency_stats_->Collect()) {
+      const LatencyHistogram::Snapshot& snapshot = p.second;
+      methods.emplace_back(Json::Object{
+          {"method", p.first},
+          {"count", std::to_string(snapshot.Count())},
+          {"p50Micros", snapshot.Percentile(50)},
+          {"p90Micros", snapshot.Percentile(90)},
+          {"p99Micros", snapshot.Percentile(99)},
+          {"p999Micros", snapshot.Percentile(99.9)},
+      });
+    }
+  }
+  Json::Array initial_sizes;
+  {
+    // Held while reading, so that the channel cannot be destroyed meanwhile.
+    MutexLock lock(&call_initial_size_mu_);
+    if (call_initial_size_source_ != nullptr) {
+      const int* boundaries = grpc_stats_histo_bucket_boundaries
+          [GRPC_STATS_HISTOGRAM_CALL_INITIAL_SIZE];
+      for (const auto& p : call_initial_size_source_()) {
+        uint64_t count = 0;
+        Json::Array buckets;
+        for (size_t i = 0; i < p.second.size(); ++i) {
+          if (p.second[i] == 0) continue;
+          count += p.second[i];
+          buckets.emplace_back(Json::Object{
+              {"start", boundaries[i]},
+              {"count", std::to_string(p.second[i])},
+          });
+        }
+        Json::Object method = {
+            {"method", p.first.second},
+            {"count", std::to_string(count)},
+            {"bucket", std::move(buckets)},
+        };
+        if (!p.first.first.empty()) method["host"] = p.first.first;
+        initial_sizes.emplace_back(std::move(method));
+      }
+    }
+  }
+  return Json::Object{
+      {"ref",
+       Json::Object{
+           {"channelId", std::to_string(uuid())},
+       }},
+      {"method", std::move(methods)},
+      {"callInitialSize", std::move(initial_sizes)},
+  };
+}
+
+Json ChannelNode::RenderCallTimelineJson() {
+  Json::Object json;
+  if (call_timeline_stats_ != nullptr) {
+    json = call_timeline_stats_->RenderJson();
+  }
+  json["ref"] = Json::Object{
+      {"channelId", std::to_string(uuid())},
+  };
+  return json;
+}
+
 void ChannelNode::PopulateChildRefs(Json::Object* json) {
   MutexLock lock(&child_mu_);
   if (!child_subchannels_.empty()) {
@@ -251,8 +375,14 @@ void ChannelNode::RemoveChildSubchannel(intptr_t child_uuid) {
 // ServerNode
 //
 
-ServerNode::ServerNode(size_t channel_tracer_max_nodes)
-    : BaseNode(EntityType::kServer, ""), trace_(channel_tracer_max_nodes) {}
+ServerNode::ServerNode(size_t channel_tracer_max_nodes,
+                       uint32_t call_timeline_sample_period)
+    : BaseNode(EntityType::kServer, ""),
+      trace_(channel_tracer_max_nodes),
+      call_timeline_stats_(call_timeline_sample_period != 0
+                               ? absl::make_unique<CallTimelineStats>(
+                                     call_timeline_sample_period)
+                               : nullptr) {}
 
 ServerNode::~ServerNode() {}
 
@@ -337,6 +467,17 @@ Json ServerNode::RenderJson() {
   return object;
 }
 
+Json ServerNode::RenderCallTimelineJson() {
+  Json::Object json;
+  if (call_timeline_stats_ != nullptr) {
+    json = call_timeline_stats_->RenderJson();
+  }
+  json["ref"] = Json::Object{
+      {"serverId", std::to_string(uuid())},
+  };
+  return json;
+}
+
 //
 // SocketNode::Security::Tls
 //
@@ -550,6 +691,14 @@ Json SocketNode::RenderJson() {
   if (keepalives_sent != 0) {
     data["keepAlivesSent"] = std::to_string(keepalives_sent);
   }
+  // The socket data has no field for this, so it is reported as an option.
+  int64_t buffered_bytes = buffered_bytes_.load(std::memory_order_relaxed);
+  if (buffered_bytes != 0) {
+    data["option"] = Json::Array{Json::Object{
+        {"name", "grpc.buffered_bytes"},
+        {"value", std::to_string(buffered_bytes)},
+    }};
+  }
   // Create and fill the parent object.
   Json::Object object = {
       {"ref",
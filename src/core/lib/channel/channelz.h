@@ -25,10 +25,13 @@
 
 #include <atomic>
 #include <cstdint>
+#include <functional>
 #include <map>
+#include <memory>
 #include <set>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "absl/container/inlined_vector.h"
 #include "absl/strings/string_view.h"
@@ -38,7 +41,9 @@
 #include <grpc/impl/codegen/grpc_types.h>
 #include <grpc/slice.h>
 
+#include "src/core/lib/channel/call_timeline.h"
 #include "src/core/lib/channel/channel_trace.h"
+#include "src/core/lib/debug/latency_histogram.h"
 #include "src/core/lib/gpr/time_precise.h"
 #include "src/core/lib/gprpp/ref_counted.h"
 #include "src/core/lib/gprpp/ref_counted_ptr.h"
@@ -52,6 +57,17 @@
 #define GRPC_ARG_CHANNELZ_IS_INTERNAL_CHANNEL \
   "grpc.channelz_is_internal_channel"
 
+// Channel arg key for enabling per-method call latency histograms on
+// client channels that have channelz enabled.  Defaults to false.
+#define GRPC_ARG_CHANNELZ_METHOD_LATENCY_STATS \
+  "grpc.experimental.channelz_method_latency_stats"
+
+// Channel arg key for recording a timeline of one in this many calls on
+// channels and servers that have channelz enabled.  Defaults to 0, which
+// records none.
+#define GRPC_ARG_CHANNELZ_CALL_TIMELINE_SAMPLE_PERIOD \
+  "grpc.experimental.channelz_call_timeline_sample_period"
+
 /** This is the default value for whether or not to enable channelz. If
  * GRPC_ARG_ENABLE_CHANNELZ is set, it will override this default value. */
 #define GRPC_ENABLE_CHANNELZ_DEFAULT true
@@ -175,11 +191,44 @@ class CallCountingHelper {
   size_t num_cores_ = 0;
 };
 
+// Per-method call latency histograms for a channel.
+//
+// Finding a method's histogram does not take a lock: the methods are kept
+// in an immutable table that is copied when a method is added, which is
+// rare.  Old tables are kept until destruction, since calls may still be
+// reading them.
+class MethodLatencyStats {
+ public:
+  // Methods beyond this many share a single histogram.
+  static constexpr size_t kMaxMethods = 64;
+  // The name under which the shared histogram is reported.
+  static constexpr char kOtherMethods[] = "<other>";
+
+  MethodLatencyStats();
+
+  // Returns the histogram for the method with the given path.  The
+  // histogram lives as long as this object.
+  LatencyHistogram* GetHistogram(absl::string_view path);
+
+  // Returns the histograms of all methods that have been called, by path.
+  std::map<std::string, LatencyHistogram::Snapshot> Collect();
+
+ private:
+  using Table = std::map<std::string, LatencyHistogram*, std::less<>>;
+
+  std::atomic<const Table*> table_;
+  Mutex mu_;
+  std::vector<std::unique_ptr<const Table>> tables_ ABSL_GUARDED_BY(mu_);
+  std::vector<std::unique_ptr<LatencyHistogram>> histograms_
+      ABSL_GUARDED_BY(mu_);
+};
+
 // Handles channelz bookkeeping for channels
 class ChannelNode : public BaseNode {
  public:
   ChannelNode(std::string target, size_t channel_tracer_max_nodes,
-              bool is_internal_channel);
+              bool is_internal_channel, bool method_latency_stats = false,
+              uint32_t call_timeline_sample_period = 0);
 
   static absl::string_view ChannelArgName() {
     return GRPC_ARG_CHANNELZ_CHANNEL_NODE;
@@ -205,6 +254,36 @@ class ChannelNode : public BaseNode {
   void RecordCallFailed() { call_counter_.RecordCallFailed(); }
   void RecordCallSucceeded() { call_counter_.RecordCallSucceeded(); }
 
+  // Returns null unless per-method latency stats are enabled.
+  MethodLatencyStats* method_latency_stats() const {
+    return method_latency_stats_.get();
+  }
+
+  // The call_initial_size histogram of each of the channel's registered
+  // methods, keyed by (host, method).
+  using CallInitialSizeHistograms =
+      std::map<std::pair<std::string, std::string>, std::vector<uint64_t>>;
+
+  // Sets where RenderMethodLatencyJson() reads the registered methods'
+  // call_initial_size histograms from.  The channel owns them, so it resets
+  // this when it is destroyed.
+  void SetCallInitialSizeSource(
+      std::function<CallInitialSizeHistograms()> source);
+
+  // Renders the per-method latency percentiles and call_initial_size
+  // histograms.  This is not part of channelz.proto, so it is kept out of
+  // RenderJson().
+  Json RenderMethodLatencyJson();
+
+  // Returns null unless call timelines are enabled.
+  CallTimelineStats* call_timeline_stats() const {
+    return call_timeline_stats_.get();
+  }
+
+  // Renders the per-stage latency percentiles and recent call timelines.
+  // This is not part of channelz.proto either.
+  Json RenderCallTimelineJson();
+
   void SetConnectivityState(grpc_connectivity_state state);
 
   // TODO(roth): take in a RefCountedPtr to the child channel so we can retrieve
@@ -226,6 +305,11 @@ class ChannelNode : public BaseNode {
   std::string target_;
   CallCountingHelper call_counter_;
   ChannelTrace trace_;
+  const std::unique_ptr<MethodLatencyStats> method_latency_stats_;
+  const std::unique_ptr<CallTimelineStats> call_timeline_stats_;
+  Mutex call_initial_size_mu_;
+  std::function<CallInitialSizeHistograms()> call_initial_size_source_
+      ABSL_GUARDED_BY(call_initial_size_mu_);
 
   // Least significant bit indicates whether the value is set.  Remaining
   // bits are a grpc_connectivity_state value.
@@ -239,7 +323,8 @@ class ChannelNode : public BaseNode {
 // Handles channelz bookkeeping for servers
 class ServerNode : public BaseNode {
  public:
-  explicit ServerNode(size_t channel_tracer_max_nodes);
+  explicit ServerNode(size_t channel_tracer_max_nodes,
+                      uint32_t call_timeline_sample_period = 0);
 
   ~ServerNode() override;
 
@@ -270,9 +355,18 @@ class ServerNode : public BaseNode {
   void RecordCallFailed() { call_counter_.RecordCallFailed(); }
   void RecordCallSucceeded() { call_counter_.RecordCallSucceeded(); }
 
+  // Returns null unless call timelines are enabled.
+  CallTimelineStats* call_timeline_stats() const {
+    return call_timeline_stats_.get();
+  }
+
+  // As for ChannelNode::RenderCallTimelineJson().
+  Json RenderCallTimelineJson();
+
  private:
   CallCountingHelper call_counter_;
   ChannelTrace trace_;
+  const std::unique_ptr<CallTimelineStats> call_timeline_stats_;
   Mutex child_mu_;  // Guards child maps below.
   std::map<intptr_t, RefCountedPtr<SocketNode>> child_sockets_;
   std::map<intptr_t, RefCountedPtr<ListenSocketNode>> child_listen_sockets_;
@@ -329,6 +423,11 @@ class SocketNode : public BaseNode {
   void RecordKeepaliveSent() {
     keepalives_sent_.fetch_add(1, std::memory_order_relaxed);
   }
+  // Bytes the transport holds for its streams: received but not yet read by
+  // the application, or written by the application but not yet sent.
+  void RecordBufferedBytes(int64_t buffered_bytes) {
+    buffered_bytes_.store(buffered_bytes, std::memory_order_relaxed);
+  }
 
   const std::string& remote() { return remote_; }
 
@@ -339,6 +438,7 @@ class SocketNode : public BaseNode {
   std::atomic<int64_t> messages_sent_{0};
   std::atomic<int64_t> messages_received_{0};
   std::atomic<int64_t> keepalives_sent_{0};
+  std::atomic<int64_t> buffered_bytes_{0};
   std::atomic<gpr_cycle_counter> last_local_stream_created_cycle_{0};
   std::atomic<gpr_cycle_counter> last_remote_stream_created_cycle_{0};
   std::atomic<gpr_cycle_counter> last_message_sent_cycle_{0};
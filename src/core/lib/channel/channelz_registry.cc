@@ -25,6 +25,7 @@
 #include <cstring>
 #include <utility>
 
+#include "absl/base/attributes.h"
 #include "absl/container/inlined_vector.h"
 
 #include <grpc/grpc.h>
@@ -32,9 +33,11 @@
 #include <grpc/support/string_util.h>
 
 #include "src/core/lib/channel/channelz.h"
+#include "src/core/lib/gprpp/debug_location.h"
 #include "src/core/lib/gprpp/sync.h"
 #include "src/core/lib/iomgr/exec_ctx.h"
 #include "src/core/lib/json/json.h"
+#include "src/core/lib/profiling/contention_profiler.h"
 
 namespace grpc_core {
 namespace channelz {
@@ -42,6 +45,8 @@ namespace {
 
 const int kPaginationLimit = 100;
 
+ABSL_CONST_INIT ContentionSite g_mu_contention("ChannelzRegistry::mu_");
+
 }  // anonymous namespace
 
 ChannelzRegistry* ChannelzRegistry::Default() {
@@ -50,20 +55,20 @@ ChannelzRegistry* ChannelzRegistry::Default() {
 }
 
 void ChannelzRegistry::InternalRegister(BaseNode* node) {
-  MutexLock lock(&mu_);
+  ProfiledMutexLock lock(&mu_, &g_mu_contention, DEBUG_LOCATION);
   node->uuid_ = ++uuid_generator_;
   node_map_[node->uuid_] = node;
 }
 
 void ChannelzRegistry::InternalUnregister(intptr_t uuid) {
   GPR_ASSERT(uuid >= 1);
-  MutexLock lock(&mu_);
+  ProfiledMutexLock lock(&mu_, &g_mu_contention, DEBUG_LOCATION);
   GPR_ASSERT(uuid <= uuid_generator_);
   node_map_.erase(uuid);
 }
 
 RefCountedPtr<BaseNode> ChannelzRegistry::InternalGet(intptr_t uuid) {
-  MutexLock lock(&mu_);
+  ProfiledMutexLock lock(&mu_, &g_mu_contention, DEBUG_LOCATION);
   if (uuid < 1 || uuid > uuid_generator_) {
     return nullptr;
   }
@@ -80,7 +85,7 @@ std::string ChannelzRegistry::InternalGetTopChannels(
   absl::InlinedVector<RefCountedPtr<BaseNode>, 10> top_level_channels;
   RefCountedPtr<BaseNode> node_after_pagination_limit;
   {
-    MutexLock lock(&mu_);
+    ProfiledMutexLock lock(&mu_, &g_mu_contention, DEBUG_LOCATION);
     for (auto it = node_map_.lower_bound(start_channel_id);
          it != node_map_.end(); ++it) {
       BaseNode* node = it->second;
@@ -119,7 +124,7 @@ std::string ChannelzRegistry::InternalGetServers(intptr_t start_server_id) {
   absl::InlinedVector<RefCountedPtr<BaseNode>, 10> servers;
   RefCountedPtr<BaseNode> node_after_pagination_limit;
   {
-    MutexLock lock(&mu_);
+    ProfiledMutexLock lock(&mu_, &g_mu_contention, DEBUG_LOCATION);
     for (auto it = node_map_.lower_bound(start_server_id);
          it != node_map_.end(); ++it) {
       BaseNode* node = it->second;
@@ -154,10 +159,40 @@ std::string ChannelzRegistry::InternalGetServers(intptr_t start_server_id) {
   return json.Dump();
 }
 
+std::string ChannelzRegistry::GetChannelMethodLatencies(intptr_t channel_id) {
+  RefCountedPtr<BaseNode> node = Get(channel_id);
+  if (node == nullptr ||
+      (node->type() != BaseNode::EntityType::kTopLevelChannel &&
+       node->type() != BaseNode::EntityType::kInternalChannel)) {
+    return "";
+  }
+  return static_cast<ChannelNode*>(node.get())
+      ->RenderMethodLatencyJson()
+      .Dump();
+}
+
+std::string ChannelzRegistry::GetCallTimelines(intptr_t id) {
+  RefCountedPtr<BaseNode> node = Get(id);
+  if (node == nullptr) return "";
+  switch (node->type()) {
+    case BaseNode::EntityType::kTopLevelChannel:
+    case BaseNode::EntityType::kInternalChannel:
+      return static_cast<ChannelNode*>(node.get())
+          ->RenderCallTimelineJson()
+          .Dump();
+    case BaseNode::EntityType::kServer:
+      return static_cast<ServerNode*>(node.get())
+          ->RenderCallTimelineJson()
+          .Dump();
+    default:
+      return "";
+  }
+}
+
 void ChannelzRegistry::InternalLogAllEntities() {
   absl::InlinedVector<RefCountedPtr<BaseNode>, 10> nodes;
   {
-    MutexLock lock(&mu_);
+    ProfiledMutexLock lock(&mu_, &g_mu_contention, DEBUG_LOCATION);
     for (auto& p : node_map_) {
       RefCountedPtr<BaseNode> node = p.second->RefIfNonZero();
       if (node != nullptr) {
@@ -56,6 +56,18 @@ class ChannelzRegistry {
     return Default()->InternalGetServers(start_server_id);
   }
 
+  // Returns the JSON string with the per-method call latencies and
+  // call_initial_size histograms of the channel with the given id, or an
+  // empty string if there is no such channel.  This is an extension, and is
+  // not part of channelz.proto.
+  static std::string GetChannelMethodLatencies(intptr_t channel_id);
+
+  // Returns the JSON string with the per-stage latencies and recent call
+  // timelines of the channel or server with the given id, or an empty
+  // string if there is no such channel or server.  This is an extension,
+  // and is not part of channelz.proto.
+  static std::string GetCallTimelines(intptr_t id);
+
   // Test only helper function to dump the JSON representation to std out.
   // This can aid in debugging channelz code.
   static void LogAllEntities() { Default()->InternalLogAllEntities(); }
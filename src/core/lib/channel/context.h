@@ -45,6 +45,10 @@ typedef enum {
   /// Holds a pointer to ServiceConfigCallData associated with this call.
   GRPC_CONTEXT_SERVICE_CONFIG_CALL_DATA,
 
+  /// Value is a CallTimeline, set only for calls sampled by the channel's
+  /// CallTimelineStats.
+  GRPC_CONTEXT_CALL_TIMELINE,
+
   GRPC_CONTEXT_COUNT
 } grpc_context_index;
 
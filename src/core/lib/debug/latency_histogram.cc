@@ -0,0 +1,109 @@
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <grpc/support/port_platform.h>
+
+#include "src/core/lib/debug/latency_histogram.h"
+
+namespace grpc_core {
+
+namespace {
+
+// Returns the index of the highest set bit of value, which must be non-zero.
+int HighestBit(uint64_t value) {
+  int bit = 0;
+  for (int shift = 32; shift > 0; shift >>= 1) {
+    if (value >> shift) {
+      value >>= shift;
+      bit += shift;
+    }
+  }
+  return bit;
+}
+
+}  // namespace
+
+//
+// LatencyHistogram::Snapshot
+//
+
+uint64_t LatencyHistogram::Snapshot::Count() const {
+  uint64_t count = 0;
+  for (uint64_t bucket : buckets_) count += bucket;
+  return count;
+}
+
+double LatencyHistogram::Snapshot::Percentile(double percentile) const {
+  const uint64_t count = Count();
+  if (count == 0) return 0;
+  const double rank = count * percentile / 100.0;
+  double seen = 0;
+  for (int i = 0; i < kBuckets; ++i) {
+    if (buckets_[i] == 0) continue;
+    if (seen + buckets_[i] >= rank) {
+      // Interpolate linearly within the bucket.
+      const double start = BucketStart(i);
+      const double end =
+          i + 1 < kBuckets ? BucketStart(i + 1) : 2 * BucketStart(i);
+      return start + (end - start) * (rank - seen) / buckets_[i];
+    }
+    seen += buckets_[i];
+  }
+  return BucketStart(kBuckets - 1);
+}
+
+LatencyHistogram::Snapshot& LatencyHistogram::Snapshot::operator+=(
+    const Snapshot& other) {
+  for (int i = 0; i < kBuckets; ++i) buckets_[i] += other.buckets_[i];
+  return *this;
+}
+
+//
+// LatencyHistogram
+//
+
+void LatencyHistogram::Record(gpr_timespec latency) {
+  if (latency.tv_sec < 0) return;
+  RecordMicros(static_cast<uint64_t>(latency.tv_sec) * GPR_US_PER_SEC +
+               latency.tv_nsec / GPR_NS_PER_US);
+}
+
+LatencyHistogram::Snapshot LatencyHistogram::Collect() const {
+  Snapshot snapshot;
+  for (size_t cpu = 0; cpu < per_cpu_.size(); ++cpu) {
+    const Counts& counts = per_cpu_[cpu];
+    for (int i = 0; i < kBuckets; ++i) {
+      snapshot.buckets_[i] +=
+          counts.buckets[i].load(std::memory_order_relaxed);
+    }
+  }
+  return snapshot;
+}
+
+int LatencyHistogram::BucketFor(uint64_t micros) {
+  if (micros < kSubBuckets) return static_cast<int>(micros);
+  if (micros >> kMaxBits) return kBuckets - 1;
+  // micros >> shift is in [kSubBuckets, 2 * kSubBuckets), and selects the
+  // sub-bucket within the power of two.
+  const int shift = HighestBit(micros) - kSubBucketBits;
+  return shift * kSubBuckets + static_cast<int>(micros >> shift);
+}
+
+uint64_t LatencyHistogram::BucketStart(int bucket) {
+  if (bucket < kSubBuckets) return bucket;
+  const int shift = bucket / kSubBuckets - 1;
+  return static_cast<uint64_t>(bucket % kSubBuckets + kSubBuckets) << shift;
+}
+
+}  // namespace grpc_core
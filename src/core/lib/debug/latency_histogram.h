@@ -0,0 +1,90 @@
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GRPC_CORE_LIB_DEBUG_LATENCY_HISTOGRAM_H
+#define GRPC_CORE_LIB_DEBUG_LATENCY_HISTOGRAM_H
+
+#include <grpc/support/port_platform.h>
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <atomic>
+#include <vector>
+
+#include <grpc/support/time.h>
+
+#include "src/core/lib/gprpp/per_cpu.h"
+
+namespace grpc_core {
+
+// A histogram of latencies, in microseconds.
+//
+// Buckets are log-linear, as in HDR histograms: each power of two is split
+// into kSubBuckets equal buckets, so a bucket's width is at most 1/8 of
+// its lower bound, and percentiles are accurate to about 6%.  Latencies
+// of 2^32us (about 71 minutes) or more share the last bucket.
+//
+// Record() only increments a counter for the current CPU, without locks.
+class LatencyHistogram {
+ public:
+  static constexpr int kSubBucketBits = 3;
+  static constexpr int kSubBuckets = 1 << kSubBucketBits;
+  static constexpr int kMaxBits = 32;
+  static constexpr int kBuckets =
+      kSubBuckets + (kMaxBits - kSubBucketBits) * kSubBuckets;
+
+  // Counts per bucket, merged across CPUs.
+  class Snapshot {
+   public:
+    Snapshot() : buckets_(kBuckets) {}
+
+    uint64_t Count() const;
+    // Returns the approximate latency, in microseconds, below which
+    // percentile percent of the recorded latencies fall.
+    double Percentile(double percentile) const;
+
+    const std::vector<uint64_t>& buckets() const { return buckets_; }
+
+    Snapshot& operator+=(const Snapshot& other);
+
+   private:
+    friend class LatencyHistogram;
+
+    std::vector<uint64_t> buckets_;
+  };
+
+  void RecordMicros(uint64_t micros) {
+    per_cpu_.this_cpu().buckets[BucketFor(micros)].fetch_add(
+        1, std::memory_order_relaxed);
+  }
+  void Record(gpr_timespec latency);
+
+  Snapshot Collect() const;
+
+  static int BucketFor(uint64_t micros);
+  // Returns the smallest latency, in microseconds, in bucket.
+  static uint64_t BucketStart(int bucket);
+
+ private:
+  struct Counts {
+    std::atomic<uint64_t> buckets[kBuckets];
+  };
+
+  PerCpu<Counts> per_cpu_;
+};
+
+}  // namespace grpc_core
+
+#endif  // GRPC_CORE_LIB_DEBUG_LATENCY_HISTOGRAM_H
@@ -41,6 +41,9 @@ const char* grpc_stats_counter_name[GRPC_STATS_COUNTER_COUNT] = {
     "pollset_kick_wakeup_fd",
     "pollset_kick_wakeup_cv",
     "pollset_kick_own_thread",
+    "busy_polls",
+    "busy_poll_hits",
+    "busy_poll_spins",
     "histogram_slow_lookups",
     "syscall_write",
     "syscall_read",
@@ -146,6 +149,12 @@ const char* grpc_stats_counter_doc[GRPC_STATS_COUNTER_COUNT] = {
     "polling wakeup (only valid for epoll1 right now)",
     "How many times could a polling wakeup be satisfied by keeping the waking "
     "thread awake? (only valid for epoll1 right now)",
+    "Number of times a designated poller busy polled before sleeping (only "
+    "valid for epoll1 with GRPC_EPOLL1_BUSY_POLL_US set)",
+    "How many busy polls found events before their budget ran out; the others "
+    "burned their whole budget and then slept",
+    "Number of non-blocking epoll_wait calls made while busy polling (also "
+    "counted in syscall_poll)",
     "Number of times histogram increments went through the slow (binary "
     "search) path",
     "Number of write syscalls (or equivalent - eg sendmsg) made by this "
@@ -42,6 +42,9 @@ typedef enum {
   GRPC_STATS_COUNTER_POLLSET_KICK_WAKEUP_FD,
   GRPC_STATS_COUNTER_POLLSET_KICK_WAKEUP_CV,
   GRPC_STATS_COUNTER_POLLSET_KICK_OWN_THREAD,
+  GRPC_STATS_COUNTER_BUSY_POLLS,
+  GRPC_STATS_COUNTER_BUSY_POLL_HITS,
+  GRPC_STATS_COUNTER_BUSY_POLL_SPINS,
   GRPC_STATS_COUNTER_HISTOGRAM_SLOW_LOOKUPS,
   GRPC_STATS_COUNTER_SYSCALL_WRITE,
   GRPC_STATS_COUNTER_SYSCALL_READ,
@@ -205,6 +208,12 @@ typedef enum {
   GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_POLLSET_KICK_WAKEUP_CV)
 #define GRPC_STATS_INC_POLLSET_KICK_OWN_THREAD() \
   GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_POLLSET_KICK_OWN_THREAD)
+#define GRPC_STATS_INC_BUSY_POLLS() \
+  GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_BUSY_POLLS)
+#define GRPC_STATS_INC_BUSY_POLL_HITS() \
+  GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_BUSY_POLL_HITS)
+#define GRPC_STATS_INC_BUSY_POLL_SPINS() \
+  GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_BUSY_POLL_SPINS)
 #define GRPC_STATS_INC_HISTOGRAM_SLOW_LOOKUPS() \
   GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_HISTOGRAM_SLOW_LOOKUPS)
 #define GRPC_STATS_INC_SYSCALL_WRITE() \
@@ -448,6 +457,9 @@ void grpc_stats_inc_server_cqs_checked(int x);
 #define GRPC_STATS_INC_POLLSET_KICK_WAKEUP_FD()
 #define GRPC_STATS_INC_POLLSET_KICK_WAKEUP_CV()
 #define GRPC_STATS_INC_POLLSET_KICK_OWN_THREAD()
+#define GRPC_STATS_INC_BUSY_POLLS()
+#define GRPC_STATS_INC_BUSY_POLL_HITS()
+#define GRPC_STATS_INC_BUSY_POLL_SPINS()
 #define GRPC_STATS_INC_HISTOGRAM_SLOW_LOOKUPS()
 #define GRPC_STATS_INC_SYSCALL_WRITE()
 #define GRPC_STATS_INC_SYSCALL_READ()
@@ -12,6 +12,9 @@ pollset_kicked_again_per_iteration:FLOAT,
 pollset_kick_wakeup_fd_per_iteration:FLOAT,
 pollset_kick_wakeup_cv_per_iteration:FLOAT,
 pollset_kick_own_thread_per_iteration:FLOAT,
+busy_polls_per_iteration:FLOAT,
+busy_poll_hits_per_iteration:FLOAT,
+busy_poll_spins_per_iteration:FLOAT,
 histogram_slow_lookups_per_iteration:FLOAT,
 syscall_write_per_iteration:FLOAT,
 syscall_read_per_iteration:FLOAT,
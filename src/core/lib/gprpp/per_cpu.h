@@ -0,0 +1,75 @@
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GRPC_CORE_LIB_GPRPP_PER_CPU_H
+#define GRPC_CORE_LIB_GPRPP_PER_CPU_H
+
+#include <grpc/support/port_platform.h>
+
+#include <stddef.h>
+
+#include <algorithm>
+#include <new>
+
+#include <grpc/support/alloc.h>
+#include <grpc/support/cpu.h>
+
+#include "src/core/lib/iomgr/exec_ctx.h"
+
+namespace grpc_core {
+
+// One instance of T per CPU, each on its own cache lines.
+//
+// Writers update the instance for the CPU they are running on, so that
+// counters updated on every call do not bounce between cores; readers
+// visit all of the instances and merge them.  The CPU is the one the
+// current ExecCtx started on, so an ExecCtx must exist when calling
+// this_cpu().  Since a thread may migrate, T must still be safe to use
+// from several threads at once; this only makes that rare.
+template <typename T>
+class PerCpu {
+ public:
+  PerCpu()
+      : size_(std::max(1u, gpr_cpu_num_cores())),
+        shards_(static_cast<Shard*>(
+            gpr_malloc_aligned(size_ * sizeof(Shard), GPR_CACHELINE_SIZE))) {
+    for (size_t i = 0; i < size_; ++i) new (&shards_[i]) Shard();
+  }
+
+  ~PerCpu() {
+    for (size_t i = 0; i < size_; ++i) shards_[i].~Shard();
+    gpr_free_aligned(shards_);
+  }
+
+  PerCpu(const PerCpu&) = delete;
+  PerCpu& operator=(const PerCpu&) = delete;
+
+  T& this_cpu() { return shards_[ExecCtx::Get()->starting_cpu()].value; }
+
+  size_t size() const { return size_; }
+  T& operator[](size_t cpu) { return shards_[cpu].value; }
+  const T& operator[](size_t cpu) const { return shards_[cpu].value; }
+
+ private:
+  struct alignas(GPR_CACHELINE_SIZE) Shard {
+    T value;
+  };
+
+  const size_t size_;
+  Shard* const shards_;
+};
+
+}  // namespace grpc_core
+
+#endif  // GRPC_CORE_LIB_GPRPP_PER_CPU_H
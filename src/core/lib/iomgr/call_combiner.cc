@@ -26,6 +26,7 @@
 
 #include "src/core/lib/debug/stats.h"
 #include "src/core/lib/profiling/timers.h"
+#include "src/core/lib/profiling/trace_point.h"
 
 namespace grpc_core {
 
@@ -123,6 +124,7 @@ void CallCombiner::ScheduleClosure(grpc_closure* closure,
 void CallCombiner::Start(grpc_closure* closure, grpc_error_handle error,
                          DEBUG_ARGS const char* reason) {
   GPR_TIMER_SCOPE("CallCombiner::Start", 0);
+  GRPC_TRACE_POINT_SCOPE("CallCombiner::Start");
   if (GRPC_TRACE_FLAG_ENABLED(grpc_call_combiner_trace)) {
     gpr_log(GPR_INFO,
             "==> CallCombiner::Start() [%p] closure=%p [" DEBUG_FMT_STR
@@ -162,6 +164,7 @@ void CallCombiner::Start(grpc_closure* closure, grpc_error_handle error,
 
 void CallCombiner::Stop(DEBUG_ARGS const char* reason) {
   GPR_TIMER_SCOPE("CallCombiner::Stop", 0);
+  GRPC_TRACE_POINT_SCOPE("CallCombiner::Stop");
   if (GRPC_TRACE_FLAG_ENABLED(grpc_call_combiner_trace)) {
     gpr_log(GPR_INFO, "==> CallCombiner::Stop() [%p] [" DEBUG_FMT_STR "%s]",
             this DEBUG_FMT_ARGS, reason);
@@ -24,15 +24,24 @@
 #include <inttypes.h>
 #include <string.h>
 
+#include "absl/base/attributes.h"
+
 #include <grpc/support/alloc.h>
 #include <grpc/support/log.h>
 
 #include "src/core/lib/gprpp/mpscq.h"
 #include "src/core/lib/iomgr/executor.h"
 #include "src/core/lib/iomgr/iomgr_internal.h"
+#include "src/core/lib/profiling/contention_profiler.h"
+#include "src/core/lib/profiling/trace_point.h"
 
 grpc_core::DebugOnlyTraceFlag grpc_combiner_trace(false, "combiner");
 
+// Contention on all combiners: closures waiting behind others, and how long
+// closures run.
+ABSL_CONST_INIT static grpc_core::ContentionSite g_combiner_contention(
+    "Combiner");
+
 #define GRPC_COMBINER_TRACE(fn)          \
   do {                                   \
     if (grpc_combiner_trace.enabled()) { \
@@ -124,6 +133,16 @@ static void push_first_on_exec_ctx(grpc_core::Combiner* lock) {
   }
 }
 
+// Where the closure was created, which is only known in debug builds.
+static grpc_core::DebugLocation closure_location(grpc_closure* cl) {
+#ifndef NDEBUG
+  return grpc_core::DebugLocation(cl->file_created, cl->line_created);
+#else
+  (void)cl;
+  return grpc_core::DebugLocation();
+#endif
+}
+
 static void combiner_exec(grpc_core::Combiner* lock, grpc_closure* cl,
                           grpc_error_handle error) {
   gpr_atm last = gpr_atm_full_fetch_add(&lock->state, STATE_ELEM_COUNT_LOW_BIT);
@@ -154,6 +173,17 @@ static void combiner_exec(grpc_core::Combiner* lock, grpc_closure* cl,
 #else
   cl->error_data.error = reinterpret_cast<intptr_t>(error);
 #endif
+  // Other closures are queued or running, so this one has to wait.
+  if (GPR_UNLIKELY(grpc_core::ContentionProfiler::enabled()) &&
+      (last >> 1) > 0) {
+    grpc_closure* expected = nullptr;
+    if (lock->profiled_closure.compare_exchange_strong(
+            expected, cl, std::memory_order_acquire,
+            std::memory_order_relaxed)) {
+      lock->profiled_closure_queued.store(gpr_get_cycle_counter(),
+                                          std::memory_order_relaxed);
+    }
+  }
   lock->queue.Push(cl->next_data.mpscq_node.get());
 }
 
@@ -184,6 +214,7 @@ bool grpc_combiner_continue_exec_ctx() {
   if (lock == nullptr) {
     return false;
   }
+  GRPC_TRACE_POINT_SCOPE("grpc_combiner_continue_exec_ctx");
 
   bool contended =
       gpr_atm_no_barrier_load(&lock->initiating_exec_ctx_or_null) == 0;
@@ -228,6 +259,15 @@ bool grpc_combiner_continue_exec_ctx() {
 #ifndef NDEBUG
     cl->scheduled = false;
 #endif
+    if (GPR_UNLIKELY(lock->profiled_closure.load(std::memory_order_relaxed) ==
+                     cl)) {
+      g_combiner_contention.RecordWait(
+          lock->profiled_closure_queued.load(std::memory_order_relaxed),
+          gpr_get_cycle_counter(), closure_location(cl));
+      lock->profiled_closure.store(nullptr, std::memory_order_release);
+    }
+    grpc_core::ContentionHoldScope hold(&g_combiner_contention,
+                                        closure_location(cl));
 #ifdef GRPC_ERROR_IS_ABSEIL_STATUS
     grpc_error_handle cl_err =
         grpc_core::internal::StatusMoveFromHeapPtr(cl->error_data.error);
@@ -23,9 +23,12 @@
 
 #include <stddef.h>
 
+#include <atomic>
+
 #include <grpc/support/atm.h>
 
 #include "src/core/lib/debug/trace.h"
+#include "src/core/lib/gpr/time_precise.h"
 #include "src/core/lib/iomgr/exec_ctx.h"
 
 namespace grpc_core {
@@ -51,6 +54,11 @@ class Combiner {
   grpc_closure_list final_list;
   grpc_closure offload;
   gpr_refcount refs;
+  // While the contention profiler is enabled, one closure at a time that is
+  // queued behind others is timed until it starts running.  Resetting
+  // profiled_closure releases profiled_closure_queued to the next producer.
+  std::atomic<grpc_closure*> profiled_closure{nullptr};
+  std::atomic<gpr_cycle_counter> profiled_closure_queued{0};
 };
 }  // namespace grpc_core
 
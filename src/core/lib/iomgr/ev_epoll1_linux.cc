@@ -36,6 +36,7 @@
 #include <sys/socket.h>
 #include <unistd.h>
 
+#include <algorithm>
 #include <string>
 #include <vector>
 
@@ -50,6 +51,7 @@
 #include "src/core/lib/gpr/string.h"
 #include "src/core/lib/gpr/tls.h"
 #include "src/core/lib/gpr/useful.h"
+#include "src/core/lib/gprpp/global_config.h"
 #include "src/core/lib/gprpp/manual_constructor.h"
 #include "src/core/lib/iomgr/block_annotate.h"
 #include "src/core/lib/iomgr/ev_epoll1_linux.h"
@@ -59,10 +61,25 @@
 #include "src/core/lib/iomgr/wakeup_fd_posix.h"
 #include "src/core/lib/profiling/timers.h"
 
-static grpc_wakeup_fd global_wakeup_fd;
+GPR_GLOBAL_CONFIG_DEFINE_INT32(
+    grpc_epoll1_shards, 1,
+    "Number of epoll sets the epoll1 polling engine spreads pollsets over. "
+    "Each set has a designated poller of its own, and an fd bound to a "
+    "pollset (as connections accepted on a SO_REUSEPORT listener are) is "
+    "polled only from that pollset's set. 0 uses one set per core.");
+
+GPR_GLOBAL_CONFIG_DEFINE_INT32(
+    grpc_epoll1_busy_poll_us, 0,
+    "Microseconds the designated poller of the epoll1 polling engine spins "
+    "on non-blocking epoll_wait before going to sleep in it, and the "
+    "SO_BUSY_POLL value set on its sockets. Trades CPU time for lower wakeup "
+    "latency. 0 (the default) never spins.");
+
+/* grpc_epoll1_busy_poll_us, read at init */
+static int g_busy_poll_us;
 
 /*******************************************************************************
- * Singleton epoll set related fields
+ * Epoll set related fields
  */
 
 #define MAX_EPOLL_EVENTS 100
@@ -90,7 +107,10 @@ typedef struct epoll_set {
   gpr_atm cursor;
 } epoll_set;
 
-/* The global singleton epoll set */
+/* The epoll set fds are registered in until they are bound to a pollset.
+   With a single shard this is the set that shard polls; otherwise it is
+   nested in every shard's set, and drained by whichever shard's designated
+   poller sees it become readable. */
 static epoll_set g_epoll_set;
 
 static int epoll_create_and_cloexec() {
@@ -111,24 +131,24 @@ static int epoll_create_and_cloexec() {
   return fd;
 }
 
-/* Must be called *only* once */
-static bool epoll_set_init() {
-  g_epoll_set.epfd = epoll_create_and_cloexec();
-  if (g_epoll_set.epfd < 0) {
+/* Must be called *only* once per set */
+static bool epoll_set_init(epoll_set* set) {
+  set->epfd = epoll_create_and_cloexec();
+  if (set->epfd < 0) {
     return false;
   }
 
-  gpr_log(GPR_INFO, "grpc epoll fd: %d", g_epoll_set.epfd);
-  gpr_atm_no_barrier_store(&g_epoll_set.num_events, 0);
-  gpr_atm_no_barrier_store(&g_epoll_set.cursor, 0);
+  gpr_log(GPR_INFO, "grpc epoll fd: %d", set->epfd);
+  gpr_atm_no_barrier_store(&set->num_events, 0);
+  gpr_atm_no_barrier_store(&set->cursor, 0);
   return true;
 }
 
 /* epoll_set_init() MUST be called before calling this. */
-static void epoll_set_shutdown() {
-  if (g_epoll_set.epfd >= 0) {
-    close(g_epoll_set.epfd);
-    g_epoll_set.epfd = -1;
+static void epoll_set_shutdown(epoll_set* set) {
+  if (set->epfd >= 0) {
+    close(set->epfd);
+    set->epfd = -1;
   }
 }
 
@@ -145,6 +165,10 @@ struct grpc_fork_fd_list {
 
 struct grpc_fd {
   int fd;
+  /* The epoll set fd is registered in: g_epoll_set's, or that of the shard of
+     the pollset it was bound to */
+  int epfd;
+  bool track_err;
 
   grpc_core::ManualConstructor<grpc_core::LockfreeEvent> read_closure;
   grpc_core::ManualConstructor<grpc_core::LockfreeEvent> write_closure;
@@ -207,8 +231,23 @@ typedef struct pollset_neighborhood {
   };
 } pollset_neighborhood;
 
+#define MAX_SHARDS 1024u
+
+/* A group of pollsets that poll one epoll set together, with one designated
+   poller at a time. By default there is a single shard, polling g_epoll_set
+   (see grpc_epoll1_shards). */
+typedef struct epoll_shard {
+  epoll_set* set;
+  grpc_wakeup_fd wakeup_fd;
+  /* The designated poller */
+  gpr_atm active_poller;
+  pollset_neighborhood* neighborhoods;
+  size_t num_neighborhoods;
+} epoll_shard;
+
 struct grpc_pollset {
   gpr_mu mu;
+  epoll_shard* shard;
   pollset_neighborhood* neighborhood;
   bool reassigning_neighborhood;
   grpc_pollset_worker* root_worker;
@@ -328,6 +367,19 @@ static void fork_fd_list_remove_grpc_fd(grpc_fd* fd) {
   }
 }
 
+static struct epoll_event fd_epoll_event(grpc_fd* fd) {
+  struct epoll_event ev;
+  ev.events = static_cast<uint32_t>(EPOLLIN | EPOLLOUT | EPOLLET);
+  /* Use the least significant bit of ev.data.ptr to store track_err. We expect
+   * the addresses to be word aligned. We need to store track_err to avoid
+   * synchronization issues when accessing it after receiving an event.
+   * Accessing fd would be a data race there because the fd might have been
+   * returned to the free list at that point. */
+  ev.data.ptr = reinterpret_cast<void*>(reinterpret_cast<intptr_t>(fd) |
+                                        (fd->track_err ? 1 : 0));
+  return ev;
+}
+
 static grpc_fd* fd_create(int fd, const char* name, bool track_err) {
   grpc_fd* new_fd = nullptr;
 
@@ -345,6 +397,8 @@ static grpc_fd* fd_create(int fd, const char* name, bool track_err) {
     new_fd->error_closure.Init();
   }
   new_fd->fd = fd;
+  new_fd->epfd = g_epoll_set.epfd;
+  new_fd->track_err = track_err;
   new_fd->read_closure->InitEvent();
   new_fd->write_closure->InitEvent();
   new_fd->error_closure->InitEvent();
@@ -360,16 +414,20 @@ static grpc_fd* fd_create(int fd, const char* name, bool track_err) {
   }
 #endif
 
-  struct epoll_event ev;
-  ev.events = static_cast<uint32_t>(EPOLLIN | EPOLLOUT | EPOLLET);
-  /* Use the least significant bit of ev.data.ptr to store track_err. We expect
-   * the addresses to be word aligned. We need to store track_err to avoid
-   * synchronization issues when accessing it after receiving an event.
-   * Accessing fd would be a data race there because the fd might have been
-   * returned to the free list at that point. */
-  ev.data.ptr = reinterpret_cast<void*>(reinterpret_cast<intptr_t>(new_fd) |
-                                        (track_err ? 1 : 0));
-  if (epoll_ctl(g_epoll_set.epfd, EPOLL_CTL_ADD, fd, &ev) != 0) {
+#ifdef SO_BUSY_POLL
+  /* Have the kernel busy poll the device queue of sockets too. This fails for
+     fds that are not sockets, and above net.core.busy_read without
+     CAP_NET_ADMIN: both are harmless. */
+  if (g_busy_poll_us > 0 &&
+      setsockopt(fd, SOL_SOCKET, SO_BUSY_POLL, &g_busy_poll_us,
+                 sizeof(g_busy_poll_us)) != 0 &&
+      GRPC_TRACE_FLAG_ENABLED(grpc_polling_trace)) {
+    gpr_log(GPR_INFO, "FD %d: SO_BUSY_POLL not set: %s", fd, strerror(errno));
+  }
+#endif
+
+  struct epoll_event ev = fd_epoll_event(new_fd);
+  if (epoll_ctl(new_fd->epfd, EPOLL_CTL_ADD, fd, &ev) != 0) {
     gpr_log(GPR_ERROR, "epoll_ctl failed: %s", strerror(errno));
   }
 
@@ -389,8 +447,7 @@ static void fd_shutdown_internal(grpc_fd* fd, grpc_error_handle why,
     } else {
       /* we need a phony event for earlier linux versions. */
       epoll_event phony_event;
-      if (epoll_ctl(g_epoll_set.epfd, EPOLL_CTL_DEL, fd->fd, &phony_event) !=
-          0) {
+      if (epoll_ctl(fd->epfd, EPOLL_CTL_DEL, fd->fd, &phony_event) != 0) {
         gpr_log(GPR_ERROR, "epoll_ctl failed: %s", strerror(errno));
       }
     }
@@ -466,11 +523,10 @@ static void fd_has_errors(grpc_fd* fd) { fd->error_closure->SetReady(); }
 static GPR_THREAD_LOCAL(grpc_pollset*) g_current_thread_pollset;
 static GPR_THREAD_LOCAL(grpc_pollset_worker*) g_current_thread_worker;
 
-/* The designated poller */
-static gpr_atm g_active_poller;
-
-static pollset_neighborhood* g_neighborhoods;
-static size_t g_num_neighborhoods;
+static epoll_shard* g_shards;
+static size_t g_num_shards;
+/* Shards are handed out to pollsets round robin */
+static gpr_atm g_next_shard;
 
 /* Return true if first in list */
 static bool worker_insert(grpc_pollset* pollset, grpc_pollset_worker* worker) {
@@ -509,44 +565,113 @@ static worker_remove_result worker_remove(grpc_pollset* pollset,
   }
 }
 
-static size_t choose_neighborhood(void) {
-  return static_cast<size_t>(gpr_cpu_current_cpu()) % g_num_neighborhoods;
+static pollset_neighborhood* choose_neighborhood(epoll_shard* shard) {
+  return &shard->neighborhoods[static_cast<size_t>(gpr_cpu_current_cpu()) %
+                               shard->num_neighborhoods];
 }
 
-static grpc_error_handle pollset_global_init(void) {
-  gpr_atm_no_barrier_store(&g_active_poller, 0);
-  global_wakeup_fd.read_fd = -1;
-  grpc_error_handle err = grpc_wakeup_fd_init(&global_wakeup_fd);
-  if (err != GRPC_ERROR_NONE) return err;
+static grpc_error_handle shard_init(epoll_shard* shard,
+                                    size_t num_neighborhoods) {
+  gpr_atm_no_barrier_store(&shard->active_poller, 0);
+  grpc_error_handle err = grpc_wakeup_fd_init(&shard->wakeup_fd);
+  if (err != GRPC_ERROR_NONE) {
+    shard->wakeup_fd.read_fd = -1;
+    return err;
+  }
   struct epoll_event ev;
   ev.events = static_cast<uint32_t>(EPOLLIN | EPOLLET);
-  ev.data.ptr = &global_wakeup_fd;
-  if (epoll_ctl(g_epoll_set.epfd, EPOLL_CTL_ADD, global_wakeup_fd.read_fd,
+  ev.data.ptr = &shard->wakeup_fd;
+  if (epoll_ctl(shard->set->epfd, EPOLL_CTL_ADD, shard->wakeup_fd.read_fd,
                 &ev) != 0) {
     return GRPC_OS_ERROR(errno, "epoll_ctl");
   }
-  g_num_neighborhoods =
-      grpc_core::Clamp(gpr_cpu_num_cores(), 1u, MAX_NEIGHBORHOODS);
-  g_neighborhoods = static_cast<pollset_neighborhood*>(
-      gpr_zalloc(sizeof(*g_neighborhoods) * g_num_neighborhoods));
-  for (size_t i = 0; i < g_num_neighborhoods; i++) {
-    gpr_mu_init(&g_neighborhoods[i].mu);
+  if (shard->set != &g_epoll_set) {
+    /* Edge triggered: see drain_unbound_fds() */
+    ev.data.ptr = &g_epoll_set;
+    if (epoll_ctl(shard->set->epfd, EPOLL_CTL_ADD, g_epoll_set.epfd, &ev) !=
+        0) {
+      return GRPC_OS_ERROR(errno, "epoll_ctl");
+    }
+  }
+  shard->num_neighborhoods = num_neighborhoods;
+  shard->neighborhoods = static_cast<pollset_neighborhood*>(
+      gpr_zalloc(sizeof(*shard->neighborhoods) * num_neighborhoods));
+  for (size_t i = 0; i < num_neighborhoods; i++) {
+    gpr_mu_init(&shard->neighborhoods[i].mu);
   }
   return GRPC_ERROR_NONE;
 }
 
+static void shard_shutdown(epoll_shard* shard) {
+  if (shard->wakeup_fd.read_fd != -1) grpc_wakeup_fd_destroy(&shard->wakeup_fd);
+  for (size_t i = 0; i < shard->num_neighborhoods; i++) {
+    gpr_mu_destroy(&shard->neighborhoods[i].mu);
+  }
+  gpr_free(shard->neighborhoods);
+  if (shard->set != nullptr && shard->set != &g_epoll_set) {
+    epoll_set_shutdown(shard->set);
+    gpr_free(shard->set);
+  }
+}
+
 static void pollset_global_shutdown(void) {
-  if (global_wakeup_fd.read_fd != -1) grpc_wakeup_fd_destroy(&global_wakeup_fd);
-  for (size_t i = 0; i < g_num_neighborhoods; i++) {
-    gpr_mu_destroy(&g_neighborhoods[i].mu);
+  for (size_t i = 0; i < g_num_shards; i++) {
+    shard_shutdown(&g_shards[i]);
+  }
+  gpr_free(g_shards);
+  g_shards = nullptr;
+  g_num_shards = 0;
+}
+
+static grpc_error_handle pollset_global_init(void) {
+  g_busy_poll_us = std::max(0, GPR_GLOBAL_CONFIG_GET(grpc_epoll1_busy_poll_us));
+  unsigned num_cores = gpr_cpu_num_cores();
+  int32_t num_shards = GPR_GLOBAL_CONFIG_GET(grpc_epoll1_shards);
+  if (num_shards <= 0) num_shards = num_cores;
+  g_num_shards = grpc_core::Clamp(static_cast<unsigned>(num_shards), 1u,
+                                  MAX_SHARDS);
+  g_shards = static_cast<epoll_shard*>(
+      gpr_zalloc(sizeof(*g_shards) * g_num_shards));
+  gpr_atm_no_barrier_store(&g_next_shard, 0);
+  for (size_t i = 0; i < g_num_shards; i++) {
+    g_shards[i].wakeup_fd.read_fd = -1;
+  }
+  size_t num_neighborhoods = grpc_core::Clamp(
+      static_cast<unsigned>(num_cores / g_num_shards), 1u, MAX_NEIGHBORHOODS);
+  grpc_error_handle err = GRPC_ERROR_NONE;
+  for (size_t i = 0; i < g_num_shards; i++) {
+    epoll_shard* shard = &g_shards[i];
+    if (g_num_shards == 1) {
+      shard->set = &g_epoll_set;
+    } else {
+      shard->set = static_cast<epoll_set*>(gpr_zalloc(sizeof(epoll_set)));
+      if (!epoll_set_init(shard->set)) {
+        err = GRPC_ERROR_CREATE_FROM_STATIC_STRING("epoll_create failed");
+        break;
+      }
+    }
+    err = shard_init(shard, num_neighborhoods);
+    if (err != GRPC_ERROR_NONE) break;
+  }
+  if (err != GRPC_ERROR_NONE) {
+    pollset_global_shutdown();
+    return err;
   }
-  gpr_free(g_neighborhoods);
+  if (g_num_shards > 1) {
+    gpr_log(GPR_INFO, "grpc epoll1 polling with %" PRIuPTR " shards",
+            g_num_shards);
+  }
+  return GRPC_ERROR_NONE;
 }
 
 static void pollset_init(grpc_pollset* pollset, gpr_mu** mu) {
   gpr_mu_init(&pollset->mu);
   *mu = &pollset->mu;
-  pollset->neighborhood = &g_neighborhoods[choose_neighborhood()];
+  pollset->shard =
+      &g_shards[static_cast<size_t>(
+                    gpr_atm_no_barrier_fetch_add(&g_next_shard, 1)) %
+                g_num_shards];
+  pollset->neighborhood = choose_neighborhood(pollset->shard);
   pollset->reassigning_neighborhood = false;
   pollset->root_worker = nullptr;
   pollset->kicked_without_poller = false;
@@ -606,7 +731,8 @@ static grpc_error_handle pollset_kick_all(grpc_pollset* pollset) {
         case DESIGNATED_POLLER:
           GRPC_STATS_INC_POLLSET_KICK_WAKEUP_FD();
           SET_KICK_STATE(worker, KICKED);
-          append_error(&error, grpc_wakeup_fd_wakeup(&global_wakeup_fd),
+          append_error(&error,
+                       grpc_wakeup_fd_wakeup(&pollset->shard->wakeup_fd),
                        "pollset_kick_all");
           break;
       }
@@ -651,82 +777,152 @@ static int poll_deadline_to_millis_timeout(grpc_core::Timestamp millis) {
   }
 }
 
+static void process_fd_event(const struct epoll_event* ev) {
+  void* data_ptr = ev->data.ptr;
+  grpc_fd* fd = reinterpret_cast<grpc_fd*>(
+      reinterpret_cast<intptr_t>(data_ptr) & ~static_cast<intptr_t>(1));
+  bool track_err =
+      reinterpret_cast<intptr_t>(data_ptr) & static_cast<intptr_t>(1);
+  bool cancel = (ev->events & EPOLLHUP) != 0;
+  bool error = (ev->events & EPOLLERR) != 0;
+  bool read_ev = (ev->events & (EPOLLIN | EPOLLPRI)) != 0;
+  bool write_ev = (ev->events & EPOLLOUT) != 0;
+  bool err_fallback = error && !track_err;
+
+  if (error && !err_fallback) {
+    fd_has_errors(fd);
+  }
+
+  if (read_ev || cancel || err_fallback) {
+    fd_become_readable(fd);
+  }
+
+  if (write_ev || cancel || err_fallback) {
+    fd_become_writable(fd);
+  }
+}
+
+/* Handles everything pending on g_epoll_set when it is nested in the shards'
+   sets. It is registered edge triggered there, so it is not reported again
+   until something new becomes ready in it: whichever designated poller sees
+   it must empty it. Pollers of several shards may do so at once; each event
+   is returned to only one of them. */
+static grpc_error_handle drain_unbound_fds() {
+  GPR_TIMER_SCOPE("drain_unbound_fds", 0);
+  struct epoll_event events[MAX_EPOLL_EVENTS];
+  int r;
+  do {
+    do {
+      GRPC_STATS_INC_SYSCALL_POLL();
+      r = epoll_wait(g_epoll_set.epfd, events, MAX_EPOLL_EVENTS, 0);
+    } while (r < 0 && errno == EINTR);
+    if (r < 0) return GRPC_OS_ERROR(errno, "epoll_wait");
+    GRPC_STATS_INC_POLL_EVENTS_RETURNED(r);
+    for (int i = 0; i < r; i++) {
+      process_fd_event(&events[i]);
+    }
+  } while (r == MAX_EPOLL_EVENTS);
+  return GRPC_ERROR_NONE;
+}
+
 /* Process the epoll events found by do_epoll_wait() function.
-   - g_epoll_set.cursor points to the index of the first event to be processed
+   - set->cursor points to the index of the first event to be processed
    - This function then processes up-to MAX_EPOLL_EVENTS_PER_ITERATION and
-     updates the g_epoll_set.cursor
+     updates the set->cursor
 
    NOTE ON SYNCRHONIZATION: Similar to do_epoll_wait(), this function is only
-   called by g_active_poller thread. So there is no need for synchronization
-   when accessing fields in g_epoll_set */
-static grpc_error_handle process_epoll_events(grpc_pollset* /*pollset*/) {
+   called by the shard's active_poller thread. So there is no need for
+   synchronization when accessing fields in the shard's epoll set */
+static grpc_error_handle process_epoll_events(grpc_pollset* pollset) {
   GPR_TIMER_SCOPE("process_epoll_events", 0);
 
   static const char* err_desc = "process_events";
   grpc_error_handle error = GRPC_ERROR_NONE;
-  long num_events = gpr_atm_acq_load(&g_epoll_set.num_events);
-  long cursor = gpr_atm_acq_load(&g_epoll_set.cursor);
+  epoll_shard* shard = pollset->shard;
+  epoll_set* set = shard->set;
+  long num_events = gpr_atm_acq_load(&set->num_events);
+  long cursor = gpr_atm_acq_load(&set->cursor);
   for (int idx = 0;
        (idx < MAX_EPOLL_EVENTS_HANDLED_PER_ITERATION) && cursor != num_events;
        idx++) {
     long c = cursor++;
-    struct epoll_event* ev = &g_epoll_set.events[c];
+    struct epoll_event* ev = &set->events[c];
     void* data_ptr = ev->data.ptr;
 
-    if (data_ptr == &global_wakeup_fd) {
-      append_error(&error, grpc_wakeup_fd_consume_wakeup(&global_wakeup_fd),
+    if (data_ptr == &shard->wakeup_fd) {
+      append_error(&error, grpc_wakeup_fd_consume_wakeup(&shard->wakeup_fd),
                    err_desc);
+    } else if (data_ptr == &g_epoll_set) {
+      append_error(&error, drain_unbound_fds(), err_desc);
     } else {
-      grpc_fd* fd = reinterpret_cast<grpc_fd*>(
-          reinterpret_cast<intptr_t>(data_ptr) & ~static_cast<intptr_t>(1));
-      bool track_err =
-          reinterpret_cast<intptr_t>(data_ptr) & static_cast<intptr_t>(1);
-      bool cancel = (ev->events & EPOLLHUP) != 0;
-      bool error = (ev->events & EPOLLERR) != 0;
-      bool read_ev = (ev->events & (EPOLLIN | EPOLLPRI)) != 0;
-      bool write_ev = (ev->events & EPOLLOUT) != 0;
-      bool err_fallback = error && !track_err;
-
-      if (error && !err_fallback) {
-        fd_has_errors(fd);
-      }
-
-      if (read_ev || cancel || err_fallback) {
-        fd_become_readable(fd);
-      }
-
-      if (write_ev || cancel || err_fallback) {
-        fd_become_writable(fd);
-      }
+      process_fd_event(ev);
     }
   }
-  gpr_atm_rel_store(&g_epoll_set.cursor, cursor);
+  gpr_atm_rel_store(&set->cursor, cursor);
   return error;
 }
 
-/* Do epoll_wait and store the events in g_epoll_set.events field. This does not
-   "process" any of the events yet; that is done in process_epoll_events().
-   *See process_epoll_events() function for more details.
+/* Spins on non-blocking epoll_wait for up to g_busy_poll_us (but no longer
+   than timeout milliseconds), returning as soon as anything is ready. Returns
+   0 if nothing was, in which case the caller should go on to sleep. Called
+   only by the shard's designated poller, like do_epoll_wait(). */
+static int busy_poll(epoll_set* set, int timeout) {
+  GPR_TIMER_SCOPE("busy_poll", 0);
+  GRPC_STATS_INC_BUSY_POLLS();
+  gpr_timespec now = gpr_now(GPR_CLOCK_MONOTONIC);
+  gpr_timespec until =
+      gpr_time_add(now, gpr_time_from_micros(g_busy_poll_us, GPR_TIMESPAN));
+  if (timeout > 0) {
+    until = gpr_time_min(
+        until, gpr_time_add(now, gpr_time_from_millis(timeout, GPR_TIMESPAN)));
+  }
+  do {
+    GRPC_STATS_INC_SYSCALL_POLL();
+    GRPC_STATS_INC_BUSY_POLL_SPINS();
+    int r = epoll_wait(set->epfd, set->events, MAX_EPOLL_EVENTS, 0);
+    if (r > 0) {
+      GRPC_STATS_INC_BUSY_POLL_HITS();
+      return r;
+    }
+    if (r < 0 && errno != EINTR) return r;
+  } while (gpr_time_cmp(gpr_now(GPR_CLOCK_MONOTONIC), until) < 0);
+  return 0;
+}
 
-   NOTE ON SYNCHRONIZATION: At any point of time, only the g_active_poller
-   (i.e the designated poller thread) will be calling this function. So there is
-   no need for any synchronization when accesing fields in g_epoll_set */
+/* Do epoll_wait and store the events in the shard's set->events field. This
+   does not "process" any of the events yet; that is done in
+   process_epoll_events(). *See process_epoll_events() function for more
+   details.
+
+   NOTE ON SYNCHRONIZATION: At any point of time, only the shard's
+   active_poller (i.e the designated poller thread) will be calling this
+   function. So there is no need for any synchronization when accesing fields
+   in the shard's epoll set */
 static grpc_error_handle do_epoll_wait(grpc_pollset* ps,
                                        grpc_core::Timestamp deadline) {
   GPR_TIMER_SCOPE("do_epoll_wait", 0);
+  epoll_set* set = ps->shard->set;
 
-  int r;
+  int r = 0;
   int timeout = poll_deadline_to_millis_timeout(deadline);
-  if (timeout != 0) {
-    GRPC_SCHEDULING_START_BLOCKING_REGION;
+  if (timeout != 0 && g_busy_poll_us > 0) {
+    r = busy_poll(set, timeout);
+    if (r == 0) {
+      grpc_core::ExecCtx::Get()->InvalidateNow();
+      timeout = poll_deadline_to_millis_timeout(deadline);
+    }
   }
-  do {
-    GRPC_STATS_INC_SYSCALL_POLL();
-    r = epoll_wait(g_epoll_set.epfd, g_epoll_set.events, MAX_EPOLL_EVENTS,
-                   timeout);
-  } while (r < 0 && errno == EINTR);
-  if (timeout != 0) {
-    GRPC_SCHEDULING_END_BLOCKING_REGION;
+  if (r == 0) {
+    if (timeout != 0) {
+      GRPC_SCHEDULING_START_BLOCKING_REGION;
+    }
+    do {
+      GRPC_STATS_INC_SYSCALL_POLL();
+      r = epoll_wait(set->epfd, set->events, MAX_EPOLL_EVENTS, timeout);
+    } while (r < 0 && errno == EINTR);
+    if (timeout != 0) {
+      GRPC_SCHEDULING_END_BLOCKING_REGION;
+    }
   }
 
   if (r < 0) return GRPC_OS_ERROR(errno, "epoll_wait");
@@ -737,8 +933,8 @@ static grpc_error_handle do_epoll_wait(grpc_pollset* ps,
     gpr_log(GPR_INFO, "ps: %p poll got %d events", ps, r);
   }
 
-  gpr_atm_rel_store(&g_epoll_set.num_events, r);
-  gpr_atm_rel_store(&g_epoll_set.cursor, 0);
+  gpr_atm_rel_store(&set->num_events, r);
+  gpr_atm_rel_store(&set->cursor, 0);
 
   return GRPC_ERROR_NONE;
 }
@@ -764,7 +960,7 @@ static bool begin_worker(grpc_pollset* pollset, grpc_pollset_worker* worker,
     if (!pollset->reassigning_neighborhood) {
       is_reassigning = true;
       pollset->reassigning_neighborhood = true;
-      pollset->neighborhood = &g_neighborhoods[choose_neighborhood()];
+      pollset->neighborhood = choose_neighborhood(pollset->shard);
     }
     pollset_neighborhood* neighborhood = pollset->neighborhood;
     gpr_mu_unlock(&pollset->mu);
@@ -800,7 +996,7 @@ static bool begin_worker(grpc_pollset* pollset, grpc_pollset_worker* worker,
           neighborhood->active_root = pollset->next = pollset->prev = pollset;
           /* Make this the designated poller if there isn't one already */
           if (worker->state == UNKICKED &&
-              gpr_atm_no_barrier_cas(&g_active_poller, 0,
+              gpr_atm_no_barrier_cas(&pollset->shard->active_poller, 0,
                                      reinterpret_cast<gpr_atm>(worker))) {
             SET_KICK_STATE(worker, DESIGNATED_POLLER);
           }
@@ -821,7 +1017,8 @@ static bool begin_worker(grpc_pollset* pollset, grpc_pollset_worker* worker,
   worker_insert(pollset, worker);
   pollset->begin_refs--;
   if (worker->state == UNKICKED && !pollset->kicked_without_poller) {
-    GPR_ASSERT(gpr_atm_no_barrier_load(&g_active_poller) != (gpr_atm)worker);
+    GPR_ASSERT(gpr_atm_no_barrier_load(&pollset->shard->active_poller) !=
+               (gpr_atm)worker);
     worker->initialized_cv = true;
     gpr_cv_init(&worker->cv);
     while (worker->state == UNKICKED && !pollset->shutting_down) {
@@ -868,7 +1065,7 @@ static bool begin_worker(grpc_pollset* pollset, grpc_pollset_worker* worker,
 }
 
 static bool check_neighborhood_for_available_poller(
-    pollset_neighborhood* neighborhood) {
+    epoll_shard* shard, pollset_neighborhood* neighborhood) {
   GPR_TIMER_SCOPE("check_neighborhood_for_available_poller", 0);
   bool found_worker = false;
   do {
@@ -884,7 +1081,7 @@ static bool check_neighborhood_for_available_poller(
         switch (inspect_worker->state) {
           case UNKICKED:
             if (gpr_atm_no_barrier_cas(
-                    &g_active_poller, 0,
+                    &shard->active_poller, 0,
                     reinterpret_cast<gpr_atm>(inspect_worker))) {
               if (GRPC_TRACE_FLAG_ENABLED(grpc_polling_trace)) {
                 gpr_log(GPR_INFO, " .. choose next poller to be %p",
@@ -943,14 +1140,15 @@ static void end_worker(grpc_pollset* pollset, grpc_pollset_worker* worker,
   SET_KICK_STATE(worker, KICKED);
   grpc_closure_list_move(&worker->schedule_on_end_work,
                          grpc_core::ExecCtx::Get()->closure_list());
-  if (gpr_atm_no_barrier_load(&g_active_poller) ==
+  epoll_shard* shard = pollset->shard;
+  if (gpr_atm_no_barrier_load(&shard->active_poller) ==
       reinterpret_cast<gpr_atm>(worker)) {
     if (worker->next != worker && worker->next->state == UNKICKED) {
       if (GRPC_TRACE_FLAG_ENABLED(grpc_polling_trace)) {
         gpr_log(GPR_INFO, " .. choose next poller to be peer %p", worker);
       }
       GPR_ASSERT(worker->next->initialized_cv);
-      gpr_atm_no_barrier_store(&g_active_poller, (gpr_atm)worker->next);
+      gpr_atm_no_barrier_store(&shard->active_poller, (gpr_atm)worker->next);
       SET_KICK_STATE(worker->next, DESIGNATED_POLLER);
       GRPC_STATS_INC_POLLSET_KICK_WAKEUP_CV();
       gpr_cv_signal(&worker->next->cv);
@@ -960,31 +1158,33 @@ static void end_worker(grpc_pollset* pollset, grpc_pollset_worker* worker,
         gpr_mu_lock(&pollset->mu);
       }
     } else {
-      gpr_atm_no_barrier_store(&g_active_poller, 0);
+      gpr_atm_no_barrier_store(&shard->active_poller, 0);
       size_t poller_neighborhood_idx =
-          static_cast<size_t>(pollset->neighborhood - g_neighborhoods);
+          static_cast<size_t>(pollset->neighborhood - shard->neighborhoods);
       gpr_mu_unlock(&pollset->mu);
       bool found_worker = false;
       bool scan_state[MAX_NEIGHBORHOODS];
-      for (size_t i = 0; !found_worker && i < g_num_neighborhoods; i++) {
+      for (size_t i = 0; !found_worker && i < shard->num_neighborhoods; i++) {
         pollset_neighborhood* neighborhood =
-            &g_neighborhoods[(poller_neighborhood_idx + i) %
-                             g_num_neighborhoods];
+            &shard->neighborhoods[(poller_neighborhood_idx + i) %
+                                  shard->num_neighborhoods];
         if (gpr_mu_trylock(&neighborhood->mu)) {
-          found_worker = check_neighborhood_for_available_poller(neighborhood);
+          found_worker =
+              check_neighborhood_for_available_poller(shard, neighborhood);
           gpr_mu_unlock(&neighborhood->mu);
           scan_state[i] = true;
         } else {
           scan_state[i] = false;
         }
       }
-      for (size_t i = 0; !found_worker && i < g_num_neighborhoods; i++) {
+      for (size_t i = 0; !found_worker && i < shard->num_neighborhoods; i++) {
         if (scan_state[i]) continue;
         pollset_neighborhood* neighborhood =
-            &g_neighborhoods[(poller_neighborhood_idx + i) %
-                             g_num_neighborhoods];
+            &shard->neighborhoods[(poller_neighborhood_idx + i) %
+                                  shard->num_neighborhoods];
         gpr_mu_lock(&neighborhood->mu);
-        found_worker = check_neighborhood_for_available_poller(neighborhood);
+        found_worker =
+            check_neighborhood_for_available_poller(shard, neighborhood);
         gpr_mu_unlock(&neighborhood->mu);
       }
       grpc_core::ExecCtx::Get()->Flush();
@@ -1004,7 +1204,8 @@ static void end_worker(grpc_pollset* pollset, grpc_pollset_worker* worker,
   if (EMPTIED == worker_remove(pollset, worker)) {
     pollset_maybe_finish_shutdown(pollset);
   }
-  GPR_ASSERT(gpr_atm_no_barrier_load(&g_active_poller) != (gpr_atm)worker);
+  GPR_ASSERT(gpr_atm_no_barrier_load(&shard->active_poller) !=
+             (gpr_atm)worker);
 }
 
 /* pollset->po.mu lock must be held by the caller before calling this.
@@ -1044,8 +1245,8 @@ static grpc_error_handle pollset_work(grpc_pollset* ps,
        accurately grpc_core::ExecCtx::Get()->Flush() happens in end_worker()
        AFTER selecting a designated poller). So we are not waiting long periods
        without a designated poller */
-    if (gpr_atm_acq_load(&g_epoll_set.cursor) ==
-        gpr_atm_acq_load(&g_epoll_set.num_events)) {
+    if (gpr_atm_acq_load(&ps->shard->set->cursor) ==
+        gpr_atm_acq_load(&ps->shard->set->num_events)) {
       append_error(&error, do_epoll_wait(ps, deadline), err_desc);
     }
     append_error(&error, process_epoll_events(ps), err_desc);
@@ -1115,15 +1316,15 @@ static grpc_error_handle pollset_kick(grpc_pollset* pollset,
         goto done;
       } else if (root_worker == next_worker &&  // only try and wake up a poller
                                                 // if there is no next worker
-                 root_worker ==
-                     reinterpret_cast<grpc_pollset_worker*>(
-                         gpr_atm_no_barrier_load(&g_active_poller))) {
+                 root_worker == reinterpret_cast<grpc_pollset_worker*>(
+                                    gpr_atm_no_barrier_load(
+                                        &pollset->shard->active_poller))) {
         GRPC_STATS_INC_POLLSET_KICK_WAKEUP_FD();
         if (GRPC_TRACE_FLAG_ENABLED(grpc_polling_trace)) {
           gpr_log(GPR_INFO, " .. kicked %p", root_worker);
         }
         SET_KICK_STATE(root_worker, KICKED);
-        ret_err = grpc_wakeup_fd_wakeup(&global_wakeup_fd);
+        ret_err = grpc_wakeup_fd_wakeup(&pollset->shard->wakeup_fd);
         goto done;
       } else if (next_worker->state == UNKICKED) {
         GRPC_STATS_INC_POLLSET_KICK_WAKEUP_CV();
@@ -1155,7 +1356,7 @@ static grpc_error_handle pollset_kick(grpc_pollset* pollset,
                     root_worker);
           }
           SET_KICK_STATE(next_worker, KICKED);
-          ret_err = grpc_wakeup_fd_wakeup(&global_wakeup_fd);
+          ret_err = grpc_wakeup_fd_wakeup(&pollset->shard->wakeup_fd);
           goto done;
         }
       } else {
@@ -1189,13 +1390,13 @@ static grpc_error_handle pollset_kick(grpc_pollset* pollset,
     goto done;
   } else if (specific_worker ==
              reinterpret_cast<grpc_pollset_worker*>(
-                 gpr_atm_no_barrier_load(&g_active_poller))) {
+                 gpr_atm_no_barrier_load(&pollset->shard->active_poller))) {
     GRPC_STATS_INC_POLLSET_KICK_WAKEUP_FD();
     if (GRPC_TRACE_FLAG_ENABLED(grpc_polling_trace)) {
       gpr_log(GPR_INFO, " .. kick active poller");
     }
     SET_KICK_STATE(specific_worker, KICKED);
-    ret_err = grpc_wakeup_fd_wakeup(&global_wakeup_fd);
+    ret_err = grpc_wakeup_fd_wakeup(&pollset->shard->wakeup_fd);
     goto done;
   } else if (specific_worker->initialized_cv) {
     GRPC_STATS_INC_POLLSET_KICK_WAKEUP_CV();
@@ -1219,6 +1420,27 @@ done:
 
 static void pollset_add_fd(grpc_pollset* /*pollset*/, grpc_fd* /*fd*/) {}
 
+/* Moves fd from g_epoll_set into the set of pollset's shard, so that only that
+   shard's pollers see its events from now on. */
+static void pollset_bind_fd(grpc_pollset* pollset, grpc_fd* fd) {
+  int epfd = pollset->shard->set->epfd;
+  if (fd->epfd == epfd) return;
+  /* Adding fd reports whatever it is already ready for, so nothing is lost
+     in between; at worst an event is seen in both sets. */
+  struct epoll_event ev = fd_epoll_event(fd);
+  if (epoll_ctl(epfd, EPOLL_CTL_ADD, fd->fd, &ev) != 0) {
+    gpr_log(GPR_ERROR, "epoll_ctl failed: %s", strerror(errno));
+    return;
+  }
+  epoll_event phony_event;
+  if (epoll_ctl(fd->epfd, EPOLL_CTL_DEL, fd->fd, &phony_event) != 0) {
+    gpr_log(GPR_ERROR, "epoll_ctl failed: %s", strerror(errno));
+  }
+  fd->epfd = epfd;
+}
+
+static bool pollsets_are_sharded(void) { return g_num_shards > 1; }
+
 /*******************************************************************************
  * Pollset-set Definitions
  */
@@ -1261,7 +1483,7 @@ static bool add_closure_to_background_poller(grpc_closure* /*closure*/,
 static void shutdown_engine(void) {
   fd_global_shutdown();
   pollset_global_shutdown();
-  epoll_set_shutdown();
+  epoll_set_shutdown(&g_epoll_set);
   if (grpc_core::Fork::Enabled()) {
     gpr_mu_destroy(&fork_fd_list_mu);
     grpc_core::Fork::SetResetChildPollingEngineFunc(nullptr);
@@ -1291,6 +1513,8 @@ static const grpc_event_engine_vtable vtable = {
     pollset_work,
     pollset_kick,
     pollset_add_fd,
+    pollset_bind_fd,
+    pollsets_are_sharded,
 
     pollset_set_create,
     pollset_set_destroy,
@@ -1332,7 +1556,7 @@ const grpc_event_engine_vtable* grpc_init_epoll1_linux(
     return nullptr;
   }
 
-  if (!epoll_set_init()) {
+  if (!epoll_set_init(&g_epoll_set)) {
     return nullptr;
   }
 
@@ -1340,7 +1564,7 @@ const grpc_event_engine_vtable* grpc_init_epoll1_linux(
 
   if (!GRPC_LOG_IF_ERROR("pollset_global_init", pollset_global_init())) {
     fd_global_shutdown();
-    epoll_set_shutdown();
+    epoll_set_shutdown(&g_epoll_set);
     return nullptr;
   }
 
@@ -21,10 +21,14 @@
 
 #include <grpc/support/port_platform.h>
 
+#include "src/core/lib/gprpp/global_config.h"
 #include "src/core/lib/iomgr/ev_posix.h"
 #include "src/core/lib/iomgr/port.h"
 
+GPR_GLOBAL_CONFIG_DECLARE_INT32(grpc_epoll1_shards);
+
 // a polling engine that utilizes a singleton epoll set and turnstile polling
+// (or, with grpc_epoll1_shards, one such set per shard of pollsets)
 
 const grpc_event_engine_vtable* grpc_init_epoll1_linux(bool explicit_request);
 
@@ -1348,6 +1348,8 @@ static void shutdown_engine(void) {
   }
 }
 
+static bool pollsets_are_sharded(void) { return false; }
+
 static const grpc_event_engine_vtable vtable = {
     sizeof(grpc_pollset),
     false,
@@ -1371,6 +1373,8 @@ static const grpc_event_engine_vtable vtable = {
     pollset_work,
     pollset_kick,
     pollset_add_fd,
+    pollset_add_fd,
+    pollsets_are_sharded,
 
     pollset_set_create,
     pollset_set_destroy,
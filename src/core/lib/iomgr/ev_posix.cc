@@ -245,6 +245,12 @@ bool grpc_event_engine_run_in_background(void) {
   return g_event_engine != nullptr && g_event_engine->run_in_background;
 }
 
+bool grpc_event_engine_shards_pollsets(void) {
+  return g_event_engine != nullptr &&
+         g_event_engine->pollsets_are_sharded != nullptr &&
+         g_event_engine->pollsets_are_sharded();
+}
+
 grpc_fd* grpc_fd_create(int fd, const char* name, bool track_err) {
   GRPC_POLLING_API_TRACE("fd_create(%d, %s, %d)", fd, name, track_err);
   GRPC_FD_TRACE("fd_create(%d, %s, %d)", fd, name, track_err);
@@ -334,6 +340,12 @@ void grpc_pollset_add_fd(grpc_pollset* pollset, struct grpc_fd* fd) {
   g_event_engine->pollset_add_fd(pollset, fd);
 }
 
+void grpc_pollset_bind_fd(grpc_pollset* pollset, struct grpc_fd* fd) {
+  GRPC_POLLING_API_TRACE("pollset_bind_fd(%p, %d)", pollset,
+                         grpc_fd_wrapped_fd(fd));
+  g_event_engine->pollset_bind_fd(pollset, fd);
+}
+
 void pollset_global_init() {}
 void pollset_global_shutdown() {}
 
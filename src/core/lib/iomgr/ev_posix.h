@@ -70,6 +70,8 @@ typedef struct grpc_event_engine_vtable {
   grpc_error_handle (*pollset_kick)(grpc_pollset* pollset,
                                     grpc_pollset_worker* specific_worker);
   void (*pollset_add_fd)(grpc_pollset* pollset, struct grpc_fd* fd);
+  void (*pollset_bind_fd)(grpc_pollset* pollset, struct grpc_fd* fd);
+  bool (*pollsets_are_sharded)(void);
 
   grpc_pollset_set* (*pollset_set_create)(void);
   void (*pollset_set_destroy)(grpc_pollset_set* pollset_set);
@@ -115,6 +117,13 @@ bool grpc_event_engine_can_track_errors();
  */
 bool grpc_event_engine_run_in_background();
 
+/* Returns true if the polling engine spreads pollsets over several sets of
+ * fds, so that binding an fd to a pollset (see grpc_pollset_bind_fd) keeps it
+ * away from the pollers of other pollsets. Currently only 'epoll1' with
+ * grpc_epoll1_shards > 1 does.
+ */
+bool grpc_event_engine_shards_pollsets();
+
 /* Create a wrapped file descriptor.
    Requires fd is a non-blocking file descriptor.
    \a track_err if true means that error events would be tracked separately
@@ -183,6 +192,12 @@ void grpc_fd_set_error(grpc_fd* fd);
 /* Add an fd to a pollset */
 void grpc_pollset_add_fd(grpc_pollset* pollset, struct grpc_fd* fd);
 
+/* Add an fd to a pollset, and keep it from being polled by pollers of any
+   other pollset where the engine can: epoll1 then polls fd only from the
+   shard pollset belongs to (see grpc_epoll1_shards). Binds fd to the latest
+   pollset if called more than once. */
+void grpc_pollset_bind_fd(grpc_pollset* pollset, struct grpc_fd* fd);
+
 /* pollset_set_posix functions */
 
 void grpc_pollset_set_add_fd(grpc_pollset_set* pollset_set, grpc_fd* fd);
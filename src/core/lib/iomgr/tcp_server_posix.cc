@@ -271,12 +271,17 @@ static void on_read(void* arg, grpc_error_handle err) {
     std::string name = absl::StrCat("tcp-server-connection:", addr_uri.value());
     grpc_fd* fdobj = grpc_fd_create(fd, name.c_str(), true);
 
-    read_notifier_pollset = (*(sp->server->pollsets))
-        [static_cast<size_t>(gpr_atm_no_barrier_fetch_add(
-             &sp->server->next_pollset_to_assign, 1)) %
-         sp->server->pollsets->size()];
-
-    grpc_pollset_add_fd(read_notifier_pollset, fdobj);
+    if (sp->pollset != nullptr) {
+      // Keep the connection on the pollset whose listener accepted it.
+      read_notifier_pollset = sp->pollset;
+      grpc_pollset_bind_fd(read_notifier_pollset, fdobj);
+    } else {
+      read_notifier_pollset = (*(sp->server->pollsets))
+          [static_cast<size_t>(gpr_atm_no_barrier_fetch_add(
+               &sp->server->next_pollset_to_assign, 1)) %
+           sp->server->pollsets->size()];
+      grpc_pollset_add_fd(read_notifier_pollset, fdobj);
+    }
 
     // Create acceptor.
     grpc_tcp_server_acceptor* acceptor =
@@ -400,6 +405,7 @@ static grpc_error_handle clone_port(grpc_tcp_listener* listener,
     /* sp (the new listener) is a sibling of 'listener' (the original
        listener). */
     sp->is_sibling = 1;
+    sp->pollset = nullptr;
     sp->sibling = listener->sibling;
     listener->sibling = sp;
     sp->server = listener->server;
@@ -534,8 +540,17 @@ static void tcp_server_start(grpc_tcp_server* s,
         pollsets->size() > 1) {
       GPR_ASSERT(GRPC_LOG_IF_ERROR(
           "clone_port", clone_port(sp, (unsigned)(pollsets->size() - 1))));
+      // Only keep connections on their listener's pollset when that also
+      // keeps them on its polling threads: otherwise spreading them round
+      // robin balances the pollsets better.
+      const bool bind_to_pollset = grpc_event_engine_shards_pollsets();
       for (i = 0; i < pollsets->size(); i++) {
-        grpc_pollset_add_fd((*pollsets)[i], sp->emfd);
+        if (bind_to_pollset) {
+          sp->pollset = (*pollsets)[i];
+          grpc_pollset_bind_fd(sp->pollset, sp->emfd);
+        } else {
+          grpc_pollset_add_fd((*pollsets)[i], sp->emfd);
+        }
         GRPC_CLOSURE_INIT(&sp->read_closure, on_read, sp,
                           grpc_schedule_on_exec_ctx);
         grpc_fd_notify_on_read(sp->emfd, &sp->read_closure);
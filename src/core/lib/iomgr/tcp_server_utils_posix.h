@@ -47,6 +47,11 @@ typedef struct grpc_tcp_listener {
      identified while iterating through 'next'. */
   struct grpc_tcp_listener* sibling;
   int is_sibling;
+  /* With SO_REUSEPORT each server pollset gets a listener of its own: this is
+     that pollset, which the listener and the connections it accepts are
+     bound to. Null for listeners shared by all pollsets, and unless the
+     polling engine shards pollsets. */
+  grpc_pollset* pollset;
 } grpc_tcp_listener;
 
 /* the overall server */
@@ -20,10 +20,23 @@
 
 #include "src/core/lib/iomgr/work_serializer.h"
 
+#include "absl/base/attributes.h"
+
+#include "src/core/lib/gpr/time_precise.h"
+#include "src/core/lib/profiling/contention_profiler.h"
+
 namespace grpc_core {
 
 DebugOnlyTraceFlag grpc_work_serializer_trace(false, "work_serializer");
 
+namespace {
+
+// Contention on all work serializers: callbacks that could not run inline
+// because another thread held the serializer, and how long callbacks run.
+ABSL_CONST_INIT ContentionSite g_work_serializer_contention("WorkSerializer");
+
+}  // namespace
+
 class WorkSerializer::WorkSerializerImpl : public Orphanable {
  public:
   void Run(std::function<void()> callback, const DebugLocation& location);
@@ -39,6 +52,8 @@ class WorkSerializer::WorkSerializerImpl : public Orphanable {
     MultiProducerSingleConsumerQueue::Node mpscq_node;
     const std::function<void()> callback;
     const DebugLocation location;
+    // When Run() queued the callback, if the contention profiler times it.
+    gpr_cycle_counter queued = 0;
   };
 
   // Callers of DrainQueueOwned should make sure to grab the lock on the
@@ -89,7 +104,10 @@ void WorkSerializer::WorkSerializerImpl::Run(std::function<void()> callback,
     if (GRPC_TRACE_FLAG_ENABLED(grpc_work_serializer_trace)) {
       gpr_log(GPR_INFO, "  Executing immediately");
     }
-    callback();
+    {
+      ContentionHoldScope hold(&g_work_serializer_contention, location);
+      callback();
+    }
     DrainQueueOwned();
   } else {
     // Another thread is holding the WorkSerializer, so decrement the ownership
@@ -97,6 +115,9 @@ void WorkSerializer::WorkSerializerImpl::Run(std::function<void()> callback,
     refs_.fetch_sub(MakeRefPair(1, 0), std::memory_order_acq_rel);
     CallbackWrapper* cb_wrapper =
         new CallbackWrapper(std::move(callback), location);
+    if (GPR_UNLIKELY(ContentionProfiler::enabled())) {
+      cb_wrapper->queued = gpr_get_cycle_counter();
+    }
     if (GRPC_TRACE_FLAG_ENABLED(grpc_work_serializer_trace)) {
       gpr_log(GPR_INFO, "  Scheduling on queue : item %p", cb_wrapper);
     }
@@ -202,7 +223,16 @@ void WorkSerializer::WorkSerializerImpl::DrainQueueOwned() {
               cb_wrapper, cb_wrapper->location.file(),
               cb_wrapper->location.line());
     }
-    cb_wrapper->callback();
+    if (GPR_UNLIKELY(cb_wrapper->queued != 0)) {
+      g_work_serializer_contention.RecordWait(cb_wrapper->queued,
+                                              gpr_get_cycle_counter(),
+                                              cb_wrapper->location);
+    }
+    {
+      ContentionHoldScope hold(&g_work_serializer_contention,
+                               cb_wrapper->location);
+      cb_wrapper->callback();
+    }
     delete cb_wrapper;
   }
 }
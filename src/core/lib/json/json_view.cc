@@ -0,0 +1,675 @@
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <grpc/support/port_platform.h>
+
+#include "src/core/lib/json/json_view.h"
+
+#include <string.h>
+
+#include <algorithm>
+#include <limits>
+#include <tuple>
+#include <utility>
+
+#include <grpc/support/log.h>
+
+#include "src/core/lib/gpr/useful.h"
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+namespace grpc_core {
+
+namespace {
+
+// As Json::Parse.
+constexpr size_t kMaxDepth = 255;
+
+constexpr size_t kBlockSize = 64;
+
+bool IsWhitespace(uint8_t c) {
+  return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+}
+
+bool IsOperator(uint8_t c) {
+  return c == '{' || c == '}' || c == '[' || c == ']' || c == ':' || c == ',';
+}
+
+// Bit i of each mask is set if byte i of a block is of that class.
+struct BlockMasks {
+  uint64_t backslash = 0;
+  uint64_t quote = 0;
+  uint64_t whitespace = 0;
+  uint64_t op = 0;
+};
+
+#ifdef __SSE2__
+
+uint64_t Matches(__m128i v, char c) {
+  return static_cast<uint16_t>(
+      _mm_movemask_epi8(_mm_cmpeq_epi8(v, _mm_set1_epi8(c))));
+}
+
+BlockMasks ClassifyBlock(const uint8_t* block) {
+  BlockMasks masks;
+  for (size_t i = 0; i < kBlockSize; i += 16) {
+    __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(block + i));
+    masks.backslash |= Matches(v, '\\') << i;
+    masks.quote |= Matches(v, '"') << i;
+    masks.whitespace |= (Matches(v, ' ') | Matches(v, '\t') |
+                         Matches(v, '\n') | Matches(v, '\r'))
+                        << i;
+    masks.op |= (Matches(v, '{') | Matches(v, '}') | Matches(v, '[') |
+                 Matches(v, ']') | Matches(v, ':') | Matches(v, ','))
+                << i;
+  }
+  return masks;
+}
+
+#else  // __SSE2__
+
+BlockMasks ClassifyBlock(const uint8_t* block) {
+  BlockMasks masks;
+  for (size_t i = 0; i < kBlockSize; ++i) {
+    const uint64_t bit = uint64_t{1} << i;
+    const uint8_t c = block[i];
+    if (c == '\\') masks.backslash |= bit;
+    if (c == '"') masks.quote |= bit;
+    if (IsWhitespace(c)) masks.whitespace |= bit;
+    if (IsOperator(c)) masks.op |= bit;
+  }
+  return masks;
+}
+
+#endif  // __SSE2__
+
+// Bit i of the result is the parity of bits 0 to i of x.
+uint64_t PrefixXor(uint64_t x) {
+  x ^= x << 1;
+  x ^= x << 2;
+  x ^= x << 4;
+  x ^= x << 8;
+  x ^= x << 16;
+  x ^= x << 32;
+  return x;
+}
+
+// The index of the lowest set bit of x, which must be non-zero.
+uint32_t LowestBit(uint64_t x) {
+#if defined(__GNUC__) || defined(__clang__)
+  return static_cast<uint32_t>(__builtin_ctzll(x));
+#else
+  return BitCount((x & (~x + 1)) - 1);
+#endif
+}
+
+// Whether c can be copied from a string as is.
+bool IsPlainStringByte(uint8_t c) {
+  return c >= 0x20 && c < 0x80 && c != '"' && c != '\\';
+}
+
+// Whether any of the 8 bytes loaded from p needs a closer look in a string:
+// a quote, a backslash, a control character or a non-ASCII byte.
+bool WordNeedsAttention(const char* p) {
+  constexpr uint64_t kOnes = 0x0101010101010101;
+  constexpr uint64_t kHighs = 0x8080808080808080;
+  uint64_t w;
+  memcpy(&w, p, sizeof(w));
+  const uint64_t quotes = w ^ (kOnes * '"');
+  const uint64_t backslashes = w ^ (kOnes * '\\');
+  // Per byte, the high bit of (x - 1) & ~x is set iff x is zero, and that of
+  // (x - 0x20) & ~x iff x < 0x20 (non-ASCII bytes are caught by w itself).
+  return (((quotes - kOnes) & ~quotes) |
+          ((backslashes - kOnes) & ~backslashes) | ((w - kOnes * 0x20) & ~w) |
+          w) &
+         kHighs;
+}
+
+int HexValue(uint8_t c) {
+  if (c >= '0' && c <= '9') return c - '0';
+  if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+  if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+  return -1;
+}
+
+void AppendUtf8(uint32_t c, std::string* out) {
+  if (c <= 0x7f) {
+    out->push_back(static_cast<char>(c));
+  } else if (c <= 0x7ff) {
+    out->push_back(static_cast<char>(0xc0 | (c >> 6)));
+    out->push_back(static_cast<char>(0x80 | (c & 0x3f)));
+  } else if (c <= 0xffff) {
+    out->push_back(static_cast<char>(0xe0 | (c >> 12)));
+    out->push_back(static_cast<char>(0x80 | ((c >> 6) & 0x3f)));
+    out->push_back(static_cast<char>(0x80 | (c & 0x3f)));
+  } else {
+    out->push_back(static_cast<char>(0xf0 | (c >> 18)));
+    out->push_back(static_cast<char>(0x80 | ((c >> 12) & 0x3f)));
+    out->push_back(static_cast<char>(0x80 | ((c >> 6) & 0x3f)));
+    out->push_back(static_cast<char>(0x80 | (c & 0x3f)));
+  }
+}
+
+}  // namespace
+
+class JsonDocument::Parser {
+ public:
+  Parser(absl::string_view input, JsonDocument* document)
+      : input_(input), document_(document) {}
+
+  bool Run() {
+    if (input_.size() > std::numeric_limits<uint32_t>::max()) return false;
+    if (!FindStructurals()) return false;
+    document_->nodes_.reserve(structurals_.size());
+    return ParseValues();
+  }
+
+ private:
+  struct Container {
+    uint32_t node;
+    // Where the container's children start in children_.
+    size_t first_child;
+  };
+
+  // First pass: records the offsets of the characters the second pass needs
+  // to look at. These are the operators and opening quotes outside strings,
+  // and the first character of every other run of non-whitespace outside
+  // strings: the start of a number or literal, or of invalid input.
+  bool FindStructurals() {
+    structurals_.reserve(input_.size() / 4);
+    const uint8_t* data = reinterpret_cast<const uint8_t*>(input_.data());
+    bool prev_escaped = false;
+    uint64_t prev_in_string = 0;
+    uint64_t prev_scalar = 0;
+    for (size_t base = 0; base < input_.size(); base += kBlockSize) {
+      BlockMasks masks;
+      if (input_.size() - base >= kBlockSize) {
+        masks = ClassifyBlock(data + base);
+      } else {
+        uint8_t last[kBlockSize];
+        memset(last, ' ', sizeof(last));
+        memcpy(last, data + base, input_.size() - base);
+        masks = ClassifyBlock(last);
+      }
+      // Backslashes are rare, so walk them one at a time: each one that is
+      // not itself escaped escapes the next byte.
+      uint64_t escaped = prev_escaped ? 1 : 0;
+      uint64_t backslash = masks.backslash & ~escaped;
+      prev_escaped = false;
+      while (backslash != 0) {
+        const uint32_t i = LowestBit(backslash);
+        backslash &= backslash - 1;
+        if (i == kBlockSize - 1) {
+          prev_escaped = true;
+        } else {
+          const uint64_t next = uint64_t{1} << (i + 1);
+          escaped |= next;
+          backslash &= ~next;
+        }
+      }
+      const uint64_t quote = masks.quote & ~escaped;
+      // Set from each opening quote up to, but excluding, its closing quote.
+      const uint64_t in_string = PrefixXor(quote) ^ prev_in_string;
+      prev_in_string = static_cast<uint64_t>(0) - (in_string >> 63);
+      const uint64_t scalar =
+          ~(masks.op | masks.whitespace | quote) & ~in_string;
+      const uint64_t scalar_start = scalar & ~((scalar << 1) | prev_scalar);
+      prev_scalar = scalar >> 63;
+      uint64_t structural =
+          (masks.op & ~in_string) | (quote & in_string) | scalar_start;
+      while (structural != 0) {
+        structurals_.push_back(static_cast<uint32_t>(base) +
+                               LowestBit(structural));
+        structural &= structural - 1;
+      }
+    }
+    // An unterminated string.
+    return prev_in_string == 0;
+  }
+
+  uint8_t At(size_t offset) const {
+    return static_cast<uint8_t>(input_[offset]);
+  }
+
+  // Whether a number or literal can end just before offset.
+  bool IsScalarEnd(size_t offset) const {
+    return offset == input_.size() || IsWhitespace(At(offset)) ||
+           IsOperator(At(offset)) || At(offset) == '"';
+  }
+
+  uint32_t AddNode(Json::Type type, bool unescaped, uint32_t size,
+                   uint32_t offset) {
+    const uint32_t index = static_cast<uint32_t>(document_->nodes_.size());
+    document_->nodes_.push_back({type, unescaped, size, offset});
+    return index;
+  }
+
+  // Second pass: walks the structurals, checking the grammar between them
+  // and adding a node for each value.
+  bool ParseValues() {
+    enum class Expect { kValue, kKey, kValueEnd };
+    Expect expect = Expect::kValue;
+    size_t i = 0;
+    while (true) {
+      if (expect == Expect::kValueEnd && stack_.empty()) {
+        return i == structurals_.size();
+      }
+      if (i == structurals_.size()) return false;
+      const size_t offset = structurals_[i++];
+      const uint8_t c = At(offset);
+      switch (expect) {
+        case Expect::kValue: {
+          uint32_t node;
+          if (c == '{' || c == '[') {
+            if (stack_.size() == kMaxDepth) return false;
+            const bool is_object = c == '{';
+            node = AddNode(is_object ? Json::Type::OBJECT : Json::Type::ARRAY,
+                           false, 0, 0);
+            if (!stack_.empty()) children_.push_back(node);
+            stack_.push_back({node, children_.size()});
+            if (i < structurals_.size() &&
+                At(structurals_[i]) == (is_object ? '}' : ']')) {
+              ++i;
+              if (!EndContainer()) return false;
+              expect = Expect::kValueEnd;
+            } else {
+              expect = is_object ? Expect::kKey : Expect::kValue;
+            }
+            continue;
+          }
+          if (!ParseScalar(offset, &node)) return false;
+          if (!stack_.empty()) children_.push_back(node);
+          expect = Expect::kValueEnd;
+          break;
+        }
+        case Expect::kKey: {
+          uint32_t node;
+          if (c != '"' || !ParseString(offset, &node)) return false;
+          children_.push_back(node);
+          if (i == structurals_.size() || At(structurals_[i]) != ':') {
+            return false;
+          }
+          ++i;
+          expect = Expect::kValue;
+          break;
+        }
+        case Expect::kValueEnd: {
+          const bool in_object =
+              document_->nodes_[stack_.back().node].type == Json::Type::OBJECT;
+          if (c == ',') {
+            expect = in_object ? Expect::kKey : Expect::kValue;
+          } else if (c == (in_object ? '}' : ']')) {
+            if (!EndContainer()) return false;
+          } else {
+            return false;
+          }
+          break;
+        }
+      }
+    }
+  }
+
+  // Moves the children of the innermost container from children_ to the
+  // document. Fails if an object has duplicate keys, as Json::Parse does.
+  bool EndContainer() {
+    const Container container = stack_.back();
+    stack_.pop_back();
+    Node& node = document_->nodes_[container.node];
+    const size_t num_children = children_.size() - container.first_child;
+    auto first = children_.begin() + container.first_child;
+    if (node.type == Json::Type::ARRAY) {
+      node.offset = static_cast<uint32_t>(document_->elements_.size());
+      node.size = static_cast<uint32_t>(num_children);
+      document_->elements_.insert(document_->elements_.end(), first,
+                                  children_.end());
+    } else {
+      auto& members = document_->members_;
+      const size_t begin = members.size();
+      node.offset = static_cast<uint32_t>(begin);
+      node.size = static_cast<uint32_t>(num_children / 2);
+      for (auto it = first; it != children_.end(); it += 2) {
+        members.push_back({*it, *(it + 1)});
+      }
+      const JsonDocument* document = document_;
+      auto key = [document](const Member& member) {
+        return document->Text(document->nodes_[member.key]);
+      };
+      std::sort(members.begin() + begin, members.end(),
+                [&key](const Member& a, const Member& b) {
+                  return key(a) < key(b);
+                });
+      for (size_t j = begin + 1; j < members.size(); ++j) {
+        if (key(members[j - 1]) == key(members[j])) return false;
+      }
+    }
+    children_.erase(first, children_.end());
+    return true;
+  }
+
+  bool ParseScalar(size_t offset, uint32_t* node) {
+    switch (At(offset)) {
+      case '"':
+        return ParseString(offset, node);
+      case 't':
+        return ParseLiteral(offset, "true", Json::Type::JSON_TRUE, node);
+      case 'f':
+        return ParseLiteral(offset, "false", Json::Type::JSON_FALSE, node);
+      case 'n':
+        return ParseLiteral(offset, "null", Json::Type::JSON_NULL, node);
+      default:
+        return ParseNumber(offset, node);
+    }
+  }
+
+  bool ParseLiteral(size_t offset, absl::string_view literal, Json::Type type,
+                    uint32_t* node) {
+    if (input_.substr(offset, literal.size()) != literal ||
+        !IsScalarEnd(offset + literal.size())) {
+      return false;
+    }
+    *node = AddNode(type, false, 0, 0);
+    return true;
+  }
+
+  // Strictly ECMA-404, except that, as Json::Parse, a leading 0 may not be
+  // followed by an exponent.
+  bool ParseNumber(size_t offset, uint32_t* node) {
+    size_t end = offset;
+    auto digits = [this, &end]() {
+      const size_t start = end;
+      while (end < input_.size() && At(end) >= '0' && At(end) <= '9') ++end;
+      return end - start;
+    };
+    if (end < input_.size() && At(end) == '-') ++end;
+    if (end == input_.size()) return false;
+    const bool signed_number = end != offset;
+    if (At(end) == '0') {
+      ++end;
+      if (!signed_number && end < input_.size() &&
+          (At(end) == 'e' || At(end) == 'E')) {
+        return false;
+      }
+    } else if (digits() == 0) {
+      return false;
+    }
+    if (end < input_.size() && At(end) == '.') {
+      ++end;
+      if (digits() == 0) return false;
+    }
+    if (end < input_.size() && (At(end) == 'e' || At(end) == 'E')) {
+      ++end;
+      if (end < input_.size() && (At(end) == '+' || At(end) == '-')) ++end;
+      if (digits() == 0) return false;
+    }
+    if (!IsScalarEnd(end)) return false;
+    *node = AddNode(Json::Type::NUMBER, false,
+                    static_cast<uint32_t>(end - offset),
+                    static_cast<uint32_t>(offset));
+    return true;
+  }
+
+  // Checks that the multi-byte UTF-8 sequence starting at offset is well
+  // formed, and returns its length or 0.
+  size_t Utf8SequenceLength(size_t offset) const {
+    const uint8_t c = At(offset);
+    size_t length;
+    if ((c & 0xe0) == 0xc0) {
+      length = 2;
+    } else if ((c & 0xf0) == 0xe0) {
+      length = 3;
+    } else if ((c & 0xf8) == 0xf0) {
+      length = 4;
+    } else {
+      return 0;
+    }
+    if (input_.size() - offset < length) return 0;
+    for (size_t i = 1; i < length; ++i) {
+      if ((At(offset + i) & 0xc0) != 0x80) return 0;
+    }
+    return length;
+  }
+
+  // Parses the string whose opening quote is at offset. Its text stays in the
+  // input unless it has escapes.
+  bool ParseString(size_t offset, uint32_t* node) {
+    const size_t start = offset + 1;
+    size_t end = start;
+    while (true) {
+      while (input_.size() - end >= 8 &&
+             !WordNeedsAttention(input_.data() + end)) {
+        end += 8;
+      }
+      while (end < input_.size() && IsPlainStringByte(At(end))) ++end;
+      if (end == input_.size()) return false;
+      const uint8_t c = At(end);
+      if (c == '"') {
+        *node = AddNode(Json::Type::STRING, false,
+                        static_cast<uint32_t>(end - start),
+                        static_cast<uint32_t>(start));
+        return true;
+      }
+      if (c == '\\') break;
+      if (c < 0x20) return false;
+      const size_t length = Utf8SequenceLength(end);
+      if (length == 0) return false;
+      end += length;
+    }
+    std::string& out = document_->unescaped_;
+    const size_t out_start = out.size();
+    out.append(input_.data() + start, end - start);
+    while (true) {
+      if (end == input_.size()) return false;
+      const uint8_t c = At(end);
+      if (c == '"') break;
+      if (c < 0x20) return false;
+      if (c >= 0x80) {
+        const size_t length = Utf8SequenceLength(end);
+        if (length == 0) return false;
+        out.append(input_.data() + end, length);
+        end += length;
+        continue;
+      }
+      if (c != '\\') {
+        out.push_back(static_cast<char>(c));
+        ++end;
+        continue;
+      }
+      if (++end == input_.size()) return false;
+      switch (At(end++)) {
+        case '"':
+          out.push_back('"');
+          break;
+        case '\\':
+          out.push_back('\\');
+          break;
+        case '/':
+          out.push_back('/');
+          break;
+        case 'b':
+          out.push_back('\b');
+          break;
+        case 'f':
+          out.push_back('\f');
+          break;
+        case 'n':
+          out.push_back('\n');
+          break;
+        case 'r':
+          out.push_back('\r');
+          break;
+        case 't':
+          out.push_back('\t');
+          break;
+        case 'u': {
+          uint32_t code_point;
+          if (!ParseUnicodeEscape(&end, &code_point)) return false;
+          if ((code_point & 0xfc00) == 0xdc00) return false;
+          if ((code_point & 0xfc00) == 0xd800) {
+            // A high surrogate must be followed by a low surrogate.
+            uint32_t low;
+            if (input_.substr(end, 2) != "\\u") return false;
+            end += 2;
+            if (!ParseUnicodeEscape(&end, &low) || (low & 0xfc00) != 0xdc00) {
+              return false;
+            }
+            code_point =
+                0x10000 + ((code_point - 0xd800) << 10) + (low - 0xdc00);
+          }
+          AppendUtf8(code_point, &out);
+          break;
+        }
+        default:
+          return false;
+      }
+    }
+    *node = AddNode(Json::Type::STRING, true,
+                    static_cast<uint32_t>(out.size() - out_start),
+                    static_cast<uint32_t>(out_start));
+    return true;
+  }
+
+  // Parses the four hex digits of a \u escape at *offset.
+  bool ParseUnicodeEscape(size_t* offset, uint32_t* code_point) {
+    if (input_.size() - *offset < 4) return false;
+    *code_point = 0;
+    for (size_t i = 0; i < 4; ++i) {
+      const int value = HexValue(At(*offset + i));
+      if (value < 0) return false;
+      *code_point = (*code_point << 4) | static_cast<uint32_t>(value);
+    }
+    *offset += 4;
+    return true;
+  }
+
+  absl::string_view input_;
+  JsonDocument* document_;
+  std::vector<uint32_t> structurals_;
+  std::vector<Container> stack_;
+  // The children of every container on stack_: for objects, alternately the
+  // key and value of each member.
+  std::vector<uint32_t> children_;
+};
+
+absl::optional<JsonDocument> JsonDocument::Parse(absl::string_view json_str) {
+  JsonDocument document(json_str);
+  Parser parser(json_str, &document);
+  if (!parser.Run()) return absl::nullopt;
+  return std::move(document);
+}
+
+Json::Type JsonView::type() const {
+  return document_->nodes_[node_].type;
+}
+
+absl::string_view JsonView::string_value() const {
+  const JsonDocument::Node& node = document_->nodes_[node_];
+  GPR_DEBUG_ASSERT(node.type == Json::Type::STRING ||
+                   node.type == Json::Type::NUMBER);
+  return document_->Text(node);
+}
+
+size_t JsonView::size() const {
+  const JsonDocument::Node& node = document_->nodes_[node_];
+  GPR_DEBUG_ASSERT(node.type == Json::Type::OBJECT ||
+                   node.type == Json::Type::ARRAY);
+  return node.size;
+}
+
+absl::string_view JsonView::key(size_t i) const {
+  const JsonDocument::Node& node = document_->nodes_[node_];
+  GPR_DEBUG_ASSERT(node.type == Json::Type::OBJECT && i < node.size);
+  return document_->Text(
+      document_->nodes_[document_->members_[node.offset + i].key]);
+}
+
+JsonView JsonView::value(size_t i) const {
+  const JsonDocument::Node& node = document_->nodes_[node_];
+  GPR_DEBUG_ASSERT(node.type == Json::Type::OBJECT && i < node.size);
+  return JsonView(document_, document_->members_[node.offset + i].value);
+}
+
+absl::optional<JsonView> JsonView::Find(absl::string_view key) const {
+  const JsonDocument::Node& node = document_->nodes_[node_];
+  GPR_DEBUG_ASSERT(node.type == Json::Type::OBJECT);
+  size_t lo = 0;
+  size_t hi = node.size;
+  while (lo < hi) {
+    const size_t mid = lo + (hi - lo) / 2;
+    const absl::string_view mid_key = this->key(mid);
+    if (mid_key == key) return value(mid);
+    if (mid_key < key) {
+      lo = mid + 1;
+    } else {
+      hi = mid;
+    }
+  }
+  return absl::nullopt;
+}
+
+JsonView JsonView::operator[](size_t i) const {
+  const JsonDocument::Node& node = document_->nodes_[node_];
+  GPR_DEBUG_ASSERT(node.type == Json::Type::ARRAY && i < node.size);
+  return JsonView(document_, document_->elements_[node.offset + i]);
+}
+
+Json JsonView::ToJson() const {
+  Json json;
+  CopyTo(&json);
+  return json;
+}
+
+void JsonView::CopyTo(Json* json) const {
+  // Build containers in place, as the reader does: moving Json values around
+  // costs about as much as parsing.
+  switch (type()) {
+    case Json::Type::JSON_NULL:
+      break;
+    case Json::Type::JSON_TRUE:
+      *json = true;
+      break;
+    case Json::Type::JSON_FALSE:
+      *json = false;
+      break;
+    case Json::Type::NUMBER:
+      *json = Json(std::string(string_value()), /*is_number=*/true);
+      break;
+    case Json::Type::STRING:
+      *json = std::string(string_value());
+      break;
+    case Json::Type::OBJECT: {
+      *json = Json::Object();
+      Json::Object* object = json->mutable_object();
+      // Members are already in key order, so each insertion is at the end.
+      for (size_t i = 0; i < size(); ++i) {
+        auto it = object->emplace_hint(object->end(), std::piecewise_construct,
+                                       std::forward_as_tuple(key(i)),
+                                       std::forward_as_tuple());
+        value(i).CopyTo(&it->second);
+      }
+      break;
+    }
+    case Json::Type::ARRAY: {
+      *json = Json::Array(size());
+      Json::Array* array = json->mutable_array();
+      for (size_t i = 0; i < size(); ++i) {
+        (*this)[i].CopyTo(&(*array)[i]);
+      }
+      break;
+    }
+  }
+}
+
+}  // namespace grpc_core
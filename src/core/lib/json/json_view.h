@@ -0,0 +1,121 @@
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GRPC_CORE_LIB_JSON_JSON_VIEW_H
+#define GRPC_CORE_LIB_JSON_JSON_VIEW_H
+
+#include <grpc/support/port_platform.h>
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <string>
+#include <vector>
+
+#include "absl/strings/string_view.h"
+#include "absl/types/optional.h"
+
+#include "src/core/lib/json/json.h"
+
+namespace grpc_core {
+
+class JsonDocument;
+
+// A read-only view of a value in a JsonDocument.
+// Cheap to copy, and valid for as long as the document it came from.
+class JsonView {
+ public:
+  Json::Type type() const;
+
+  // The text of a STRING (unescaped) or NUMBER value.
+  absl::string_view string_value() const;
+
+  // The number of members of an OBJECT, or elements of an ARRAY.
+  size_t size() const;
+
+  // The members of an OBJECT, ordered by key.
+  absl::string_view key(size_t i) const;
+  JsonView value(size_t i) const;
+  // Returns the member of an OBJECT with the given key, if there is one.
+  absl::optional<JsonView> Find(absl::string_view key) const;
+
+  // The elements of an ARRAY.
+  JsonView operator[](size_t i) const;
+
+  // Copies the value into a Json.
+  Json ToJson() const;
+
+ private:
+  friend class JsonDocument;
+
+  JsonView(const JsonDocument* document, uint32_t node)
+      : document_(document), node_(node) {}
+
+  void CopyTo(Json* json) const;
+
+  const JsonDocument* document_;
+  uint32_t node_;
+};
+
+// A parsed JSON document, read through JsonView.
+// Parsing takes two passes, after simdjson: the first classifies the input
+// 64 bytes at a time to find its structural characters, and the second walks
+// only those, laying the values out in a few flat arrays. Objects are stored
+// as arrays of members sorted by key. Strings without escapes are not copied:
+// the document refers into the input, which must outlive it.
+class JsonDocument {
+ public:
+  // Returns nullopt if json_str is not valid JSON. Accepts nothing that
+  // Json::Parse rejects; use that to find out what is wrong with the input.
+  static absl::optional<JsonDocument> Parse(absl::string_view json_str);
+
+  JsonView root() const { return JsonView(this, 0); }
+
+ private:
+  friend class JsonView;
+  class Parser;
+
+  struct Node {
+    Json::Type type;
+    // For STRING and NUMBER: whether the text is in unescaped_ rather than
+    // in the input.
+    bool unescaped;
+    // The length of the text, or the number of members or elements.
+    uint32_t size;
+    // Where the text, members or elements start.
+    uint32_t offset;
+  };
+
+  struct Member {
+    uint32_t key;
+    uint32_t value;
+  };
+
+  explicit JsonDocument(absl::string_view input) : input_(input) {}
+
+  absl::string_view Text(const Node& node) const {
+    const char* base = node.unescaped ? unescaped_.data() : input_.data();
+    return absl::string_view(base + node.offset, node.size);
+  }
+
+  absl::string_view input_;
+  std::vector<Node> nodes_;
+  std::vector<Member> members_;
+  std::vector<uint32_t> elements_;
+  std::string unescaped_;
+};
+
+}  // namespace grpc_core
+
+#endif  // GRPC_CORE_LIB_JSON_JSON_VIEW_H
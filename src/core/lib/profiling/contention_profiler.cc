@@ -0,0 +1,304 @@
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <grpc/support/port_platform.h>
+
+#include "src/core/lib/profiling/contention_profiler.h"
+
+#include <algorithm>
+#include <map>
+#include <utility>
+#include <vector>
+
+#include "absl/strings/str_cat.h"
+
+#include <grpc/support/time.h>
+
+#include "src/core/lib/gprpp/global_config.h"
+
+GPR_GLOBAL_CONFIG_DEFINE_INT32(
+    grpc_contention_profiler_sample_period, 0,
+    "If non-zero, contention on gRPC's hot locks is recorded for the "
+    "profiling admin service, and on average one in this many lock "
+    "acquisitions on each thread is timed until released.");
+
+namespace grpc_core {
+
+namespace {
+
+uint64_t ToNanos(gpr_cycle_counter start, gpr_cycle_counter end) {
+  if (end <= start) return 0;
+  const gpr_timespec ts = gpr_cycle_counter_sub(end, start);
+  return static_cast<uint64_t>(ts.tv_sec) * GPR_NS_PER_SEC +
+         static_cast<uint64_t>(ts.tv_nsec);
+}
+
+void Add(std::atomic<uint64_t>* counter, uint64_t value) {
+  counter->fetch_add(value, std::memory_order_relaxed);
+}
+
+uint64_t Load(const std::atomic<uint64_t>& counter) {
+  return counter.load(std::memory_order_relaxed);
+}
+
+}  // namespace
+
+//
+// ContentionSite::Histogram
+//
+
+void ContentionSite::Histogram::Record(uint64_t nanos) {
+  size_t bucket = 0;
+  while (bucket + 1 < kNumBuckets && (nanos >> (bucket + 1)) != 0) ++bucket;
+  Add(&buckets[bucket], 1);
+  Add(&total_nanos, nanos);
+}
+
+Json::Object ContentionSite::Histogram::RenderJson() const {
+  uint64_t counts[kNumBuckets];
+  uint64_t total = 0;
+  for (size_t i = 0; i < kNumBuckets; ++i) {
+    counts[i] = Load(buckets[i]);
+    total += counts[i];
+  }
+  Json::Object json = {
+      {"count", std::to_string(total)},
+      {"totalNanos", std::to_string(Load(total_nanos))},
+  };
+  if (total == 0) return json;
+  // Percentiles are reported as the upper bound of their bucket.
+  auto percentile = [&](double p) {
+    const double rank = p / 100 * static_cast<double>(total);
+    uint64_t seen = 0;
+    for (size_t i = 0; i < kNumBuckets; ++i) {
+      seen += counts[i];
+      if (static_cast<double>(seen) >= rank) {
+        return std::to_string(uint64_t{2} << i);
+      }
+    }
+    return std::to_string(uint64_t{2} << (kNumBuckets - 1));
+  };
+  json["p50Nanos"] = percentile(50);
+  json["p90Nanos"] = percentile(90);
+  json["p99Nanos"] = percentile(99);
+  json["p999Nanos"] = percentile(99.9);
+  Json::Array bucket_array;
+  for (size_t i = 0; i < kNumBuckets; ++i) {
+    if (counts[i] == 0) continue;
+    bucket_array.emplace_back(Json::Object{
+        {"lowerBoundNanos", std::to_string(i == 0 ? 0 : uint64_t{1} << i)},
+        {"count", std::to_string(counts[i])},
+    });
+  }
+  json["bucket"] = std::move(bucket_array);
+  return json;
+}
+
+void ContentionSite::Histogram::Clear() {
+  for (auto& bucket : buckets) bucket.store(0, std::memory_order_relaxed);
+  total_nanos.store(0, std::memory_order_relaxed);
+}
+
+//
+// ContentionSite
+//
+
+constexpr size_t ContentionSite::kNumBuckets;
+constexpr size_t ContentionSite::kMaxCallSites;
+
+void ContentionSite::MaybeRegister() {
+  if (GPR_LIKELY(registered_.load(std::memory_order_relaxed))) return;
+  if (registered_.exchange(true, std::memory_order_relaxed)) return;
+  ContentionProfiler::Register(this);
+}
+
+ContentionSite::CallSite* ContentionSite::FindCallSite(
+    const DebugLocation& location) {
+  const char* file = location.file();
+  const int line = location.line();
+  for (CallSite& call_site : call_sites_) {
+    uint8_t state = call_site.state.load(std::memory_order_acquire);
+    if (state == CallSite::kFree &&
+        call_site.state.compare_exchange_strong(state, CallSite::kClaiming,
+                                                std::memory_order_relaxed)) {
+      call_site.file = file;
+      call_site.line = line;
+      call_site.state.store(CallSite::kClaimed, std::memory_order_release);
+      return &call_site;
+    }
+    // A slot being claimed by another thread is skipped, which may leave
+    // two slots for the same call site; RenderJson() merges them.
+    if (state == CallSite::kClaimed && call_site.line == line &&
+        call_site.file == file) {
+      return &call_site;
+    }
+  }
+  return nullptr;
+}
+
+void ContentionSite::RecordWait(gpr_cycle_counter start, gpr_cycle_counter end,
+                                const DebugLocation& location) {
+  MaybeRegister();
+  const uint64_t nanos = ToNanos(start, end);
+  wait_.Record(nanos);
+  CallSite* call_site = FindCallSite(location);
+  if (call_site == nullptr) return;
+  Add(&call_site->waits, 1);
+  Add(&call_site->wait_nanos, nanos);
+}
+
+void ContentionSite::RecordHold(gpr_cycle_counter start, gpr_cycle_counter end,
+                                const DebugLocation& location) {
+  MaybeRegister();
+  const uint64_t nanos = ToNanos(start, end);
+  hold_.Record(nanos);
+  CallSite* call_site = FindCallSite(location);
+  if (call_site == nullptr) return;
+  Add(&call_site->holds, 1);
+  Add(&call_site->hold_nanos, nanos);
+}
+
+Json ContentionSite::RenderJson() const {
+  struct Totals {
+    uint64_t waits = 0;
+    uint64_t wait_nanos = 0;
+    uint64_t holds = 0;
+    uint64_t hold_nanos = 0;
+  };
+  std::map<std::pair<std::string, int>, Totals> by_location;
+  for (const CallSite& call_site : call_sites_) {
+    if (call_site.state.load(std::memory_order_acquire) != CallSite::kClaimed) {
+      continue;
+    }
+    Totals& totals = by_location[std::make_pair(
+        call_site.file == nullptr ? "" : call_site.file, call_site.line)];
+    totals.waits += Load(call_site.waits);
+    totals.wait_nanos += Load(call_site.wait_nanos);
+    totals.holds += Load(call_site.holds);
+    totals.hold_nanos += Load(call_site.hold_nanos);
+  }
+  std::vector<std::pair<std::string, Totals>> sorted;
+  for (const auto& p : by_location) {
+    if (p.second.waits == 0 && p.second.holds == 0) continue;
+    // Without a file, as in opt builds, all call sites share one entry.
+    sorted.emplace_back(p.first.first.empty()
+                            ? "unknown"
+                            : absl::StrCat(p.first.first, ":", p.first.second),
+                        p.second);
+  }
+  std::stable_sort(sorted.begin(), sorted.end(),
+                   [](const std::pair<std::string, Totals>& a,
+                      const std::pair<std::string, Totals>& b) {
+                     return a.second.wait_nanos > b.second.wait_nanos;
+                   });
+  Json::Array call_sites;
+  for (const auto& p : sorted) {
+    call_sites.emplace_back(Json::Object{
+        {"location", p.first},
+        {"waits", std::to_string(p.second.waits)},
+        {"waitNanos", std::to_string(p.second.wait_nanos)},
+        {"sampledHolds", std::to_string(p.second.holds)},
+        {"holdNanos", std::to_string(p.second.hold_nanos)},
+    });
+  }
+  return Json::Object{
+      {"name", name_},
+      {"wait", wait_.RenderJson()},
+      {"sampledHold", hold_.RenderJson()},
+      {"callSite", std::move(call_sites)},
+  };
+}
+
+void ContentionSite::Clear() {
+  wait_.Clear();
+  hold_.Clear();
+  // The call sites keep their slots, which are never reused.
+  for (CallSite& call_site : call_sites_) {
+    call_site.waits.store(0, std::memory_order_relaxed);
+    call_site.wait_nanos.store(0, std::memory_order_relaxed);
+    call_site.holds.store(0, std::memory_order_relaxed);
+    call_site.hold_nanos.store(0, std::memory_order_relaxed);
+  }
+}
+
+//
+// ContentionProfiler
+//
+
+std::atomic<uint32_t> ContentionProfiler::sample_period_{0};
+std::atomic<ContentionSite*> ContentionProfiler::sites_{nullptr};
+
+void ContentionProfiler::Init() {
+  SetSamplePeriod(static_cast<uint32_t>(std::max(
+      0, GPR_GLOBAL_CONFIG_GET(grpc_contention_profiler_sample_period))));
+}
+
+void ContentionProfiler::SetSamplePeriod(uint32_t period) {
+  sample_period_.store(period, std::memory_order_relaxed);
+}
+
+void ContentionProfiler::Register(ContentionSite* site) {
+  ContentionSite* head = sites_.load(std::memory_order_relaxed);
+  do {
+    site->next_.store(head, std::memory_order_relaxed);
+  } while (!sites_.compare_exchange_weak(head, site, std::memory_order_release,
+                                         std::memory_order_relaxed));
+}
+
+std::string ContentionProfiler::DumpJson() {
+  std::vector<std::pair<uint64_t, Json>> sites;
+  for (ContentionSite* site = sites_.load(std::memory_order_acquire);
+       site != nullptr; site = site->next_.load(std::memory_order_relaxed)) {
+    sites.emplace_back(Load(site->wait_.total_nanos), site->RenderJson());
+  }
+  std::stable_sort(sites.begin(), sites.end(),
+                   [](const std::pair<uint64_t, Json>& a,
+                      const std::pair<uint64_t, Json>& b) {
+                     return a.first > b.first;
+                   });
+  Json::Array site_array;
+  for (auto& site : sites) site_array.push_back(std::move(site.second));
+  return Json(Json::Object{
+                  {"samplePeriod", sample_period()},
+                  {"site", std::move(site_array)},
+              })
+      .Dump();
+}
+
+void ContentionProfiler::Clear() {
+  for (ContentionSite* site = sites_.load(std::memory_order_acquire);
+       site != nullptr; site = site->next_.load(std::memory_order_relaxed)) {
+    site->Clear();
+  }
+}
+
+//
+// ProfiledMutexLock
+//
+
+void ProfiledMutexLock::LockAndRecord() {
+  if (mu_->TryLock()) {
+    if (ContentionProfiler::ShouldSample()) {
+      hold_start_ = gpr_get_cycle_counter();
+    }
+    return;
+  }
+  const gpr_cycle_counter start = gpr_get_cycle_counter();
+  mu_->Lock();
+  const gpr_cycle_counter acquired = gpr_get_cycle_counter();
+  site_->RecordWait(start, acquired, location_);
+  if (ContentionProfiler::ShouldSample()) hold_start_ = acquired;
+}
+
+}  // namespace grpc_core
@@ -0,0 +1,215 @@
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GRPC_CORE_LIB_PROFILING_CONTENTION_PROFILER_H
+#define GRPC_CORE_LIB_PROFILING_CONTENTION_PROFILER_H
+
+#include <grpc/support/port_platform.h>
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <atomic>
+#include <string>
+
+#include "absl/base/thread_annotations.h"
+
+#include "src/core/lib/gpr/time_precise.h"
+#include "src/core/lib/gprpp/debug_location.h"
+#include "src/core/lib/gprpp/sync.h"
+#include "src/core/lib/json/json.h"
+#include "src/core/lib/profiling/sampling_countdown.h"
+
+namespace grpc_core {
+
+// A lock, or a family of locks such as every channel's data plane mutex,
+// whose contention the contention profiler reports under one name.
+//
+// Sites are constant-initialized statics (declare them ABSL_CONST_INIT),
+// so they cost nothing until the profiler is enabled; a site registers
+// itself with the profiler the first time it records anything.  Waits and
+// hold times go to log2 histograms in nanoseconds, and to a small table of
+// the call sites that waited and held, as given by DebugLocation, which
+// only carries a file and line in debug builds.
+class ContentionSite {
+ public:
+  // Bucket i counts durations in [2^i, 2^(i+1)) nanoseconds.
+  static constexpr size_t kNumBuckets = 40;
+  // Calls from further call sites are only counted in the histograms.
+  static constexpr size_t kMaxCallSites = 16;
+
+  explicit constexpr ContentionSite(const char* name) : name_(name) {}
+
+  ContentionSite(const ContentionSite&) = delete;
+  ContentionSite& operator=(const ContentionSite&) = delete;
+
+  const char* name() const { return name_; }
+
+  // Records that location waited from start to end to get the lock.
+  void RecordWait(gpr_cycle_counter start, gpr_cycle_counter end,
+                  const DebugLocation& location);
+  // Records that location held the lock from start to end.  Only sampled
+  // acquisitions are recorded.
+  void RecordHold(gpr_cycle_counter start, gpr_cycle_counter end,
+                  const DebugLocation& location);
+
+  Json RenderJson() const;
+  void Clear();
+
+ private:
+  friend class ContentionProfiler;
+
+  struct Histogram {
+    void Record(uint64_t nanos);
+    Json::Object RenderJson() const;
+    void Clear();
+
+    std::atomic<uint64_t> buckets[kNumBuckets]{};
+    std::atomic<uint64_t> total_nanos{0};
+  };
+
+  struct CallSite {
+    enum State : uint8_t { kFree, kClaiming, kClaimed };
+
+    std::atomic<uint8_t> state{kFree};
+    // Set once when the slot is claimed.
+    const char* file = nullptr;
+    int line = 0;
+    std::atomic<uint64_t> waits{0};
+    std::atomic<uint64_t> wait_nanos{0};
+    std::atomic<uint64_t> holds{0};
+    std::atomic<uint64_t> hold_nanos{0};
+  };
+
+  void MaybeRegister();
+  // Returns the slot for location, or null if the table is full.
+  CallSite* FindCallSite(const DebugLocation& location);
+
+  const char* const name_;
+  std::atomic<bool> registered_{false};
+  // Next site registered with the profiler.
+  std::atomic<ContentionSite*> next_{nullptr};
+  Histogram wait_;
+  Histogram hold_;
+  CallSite call_sites_[kMaxCallSites];
+};
+
+// Opt-in profiler for the contention on gRPC's hot locks: mutexes locked
+// with ProfiledMutexLock, combiners and work serializers.
+//
+// While enabled, every contended acquisition is timed, since it is already
+// on the slow path, and on average one in sample_period() acquisitions on
+// each thread is timed until released.  While disabled, which is the
+// default, an acquisition costs a relaxed load on top of the plain lock.
+//
+// The period comes from GRPC_CONTENTION_PROFILER_SAMPLE_PERIOD at
+// grpc_init() and can be changed at any time; 0 turns profiling off.
+class ContentionProfiler {
+ public:
+  static void Init();
+
+  static bool enabled() { return sample_period() != 0; }
+  static uint32_t sample_period() {
+    return sample_period_.load(std::memory_order_relaxed);
+  }
+  static void SetSamplePeriod(uint32_t period);
+
+  // Returns whether the hold time of the current acquisition should be
+  // recorded.
+  static bool ShouldSample() {
+    return SamplingCountdown<ContentionProfiler>::ShouldSample(sample_period());
+  }
+
+  // Returns the JSON string with the histograms of every site that has
+  // recorded anything, most waited on first.
+  static std::string DumpJson();
+  // Resets the histograms of every site.
+  static void Clear();
+
+ private:
+  friend class ContentionSite;
+
+  static void Register(ContentionSite* site);
+
+  static std::atomic<uint32_t> sample_period_;
+  static std::atomic<ContentionSite*> sites_;
+};
+
+// Like MutexLock, but reports contention on mu to site while the
+// contention profiler is enabled.
+class ABSL_SCOPED_LOCKABLE ProfiledMutexLock {
+ public:
+  ProfiledMutexLock(Mutex* mu, ContentionSite* site,
+                    const DebugLocation& location)
+      ABSL_EXCLUSIVE_LOCK_FUNCTION(mu)
+      : mu_(mu), site_(site), location_(location) {
+    if (GPR_LIKELY(!ContentionProfiler::enabled())) {
+      mu_->Lock();
+      return;
+    }
+    LockAndRecord();
+  }
+
+  ~ProfiledMutexLock() ABSL_UNLOCK_FUNCTION() {
+    if (GPR_LIKELY(hold_start_ == 0)) {
+      mu_->Unlock();
+      return;
+    }
+    const gpr_cycle_counter end = gpr_get_cycle_counter();
+    mu_->Unlock();
+    site_->RecordHold(hold_start_, end, location_);
+  }
+
+  ProfiledMutexLock(const ProfiledMutexLock&) = delete;
+  ProfiledMutexLock& operator=(const ProfiledMutexLock&) = delete;
+
+ private:
+  void LockAndRecord() ABSL_EXCLUSIVE_LOCK_FUNCTION(mu_)
+      ABSL_NO_THREAD_SAFETY_ANALYSIS;
+
+  Mutex* const mu_;
+  ContentionSite* const site_;
+  const DebugLocation location_;
+  // Set if the hold time is sampled.
+  gpr_cycle_counter hold_start_ = 0;
+};
+
+// Records how long the enclosing scope holds a lock-like construct, such as
+// a combiner running a closure, if the contention profiler samples it.
+class ContentionHoldScope {
+ public:
+  ContentionHoldScope(ContentionSite* site, const DebugLocation& location)
+      : site_(ContentionProfiler::ShouldSample() ? site : nullptr),
+        location_(location) {
+    if (GPR_UNLIKELY(site_ != nullptr)) start_ = gpr_get_cycle_counter();
+  }
+
+  ~ContentionHoldScope() {
+    if (GPR_UNLIKELY(site_ != nullptr)) {
+      site_->RecordHold(start_, gpr_get_cycle_counter(), location_);
+    }
+  }
+
+  ContentionHoldScope(const ContentionHoldScope&) = delete;
+  ContentionHoldScope& operator=(const ContentionHoldScope&) = delete;
+
+ private:
+  ContentionSite* const site_;
+  const DebugLocation location_;
+  gpr_cycle_counter start_ = 0;
+};
+
+}  // namespace grpc_core
+
+#endif  // GRPC_CORE_LIB_PROFILING_CONTENTION_PROFILER_H
@@ -0,0 +1,45 @@
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <grpc/support/port_platform.h>
+
+#include "src/core/lib/profiling/sampling_countdown.h"
+
+#include "src/core/lib/gpr/time_precise.h"
+
+namespace grpc_core {
+
+namespace {
+
+// State of this thread's xorshift generator.
+GPR_THREAD_LOCAL(uint32_t) g_rng_state;
+
+uint32_t NextRandom() {
+  uint32_t x = g_rng_state;
+  if (x == 0) x = static_cast<uint32_t>(gpr_get_cycle_counter()) | 1;
+  x ^= x << 13;
+  x ^= x >> 17;
+  x ^= x << 5;
+  g_rng_state = x;
+  return x;
+}
+
+}  // namespace
+
+uint32_t NewSamplingCountdown(uint32_t period) {
+  const uint64_t range = 2 * static_cast<uint64_t>(period) - 1;
+  return static_cast<uint32_t>(1 + NextRandom() % range);
+}
+
+}  // namespace grpc_core
@@ -0,0 +1,63 @@
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GRPC_CORE_LIB_PROFILING_SAMPLING_COUNTDOWN_H
+#define GRPC_CORE_LIB_PROFILING_SAMPLING_COUNTDOWN_H
+
+#include <grpc/support/port_platform.h>
+
+#include <stdint.h>
+
+#include "src/core/lib/gpr/tls.h"
+
+namespace grpc_core {
+
+// Returns a random countdown, uniform in [1, 2 * period - 1] and so period
+// on average.  The jitter keeps code paths producing events in a fixed
+// cycle from always being sampled at the same event.  period must be
+// non-zero.
+uint32_t NewSamplingCountdown(uint32_t period);
+
+// Picks which events of each thread a profiler samples, on average one in
+// period: the others cost a thread-local countdown.  Tag is the profiler,
+// so that each profiler counts down its own events.
+template <typename Tag>
+class SamplingCountdown {
+ public:
+  // Returns whether the current event should be sampled.  A period of 0
+  // samples nothing.
+  static bool ShouldSample(uint32_t period) {
+    if (period == 0) return false;
+    const uint32_t countdown = countdown_;
+    // A countdown drawn for a longer period than the current one is redrawn.
+    if (GPR_LIKELY(countdown > 1 && countdown / 2 < period)) {
+      countdown_ = countdown - 1;
+      return false;
+    }
+    countdown_ = NewSamplingCountdown(period);
+    return true;
+  }
+
+ private:
+  // Events left on this thread until the next sample.
+  static GPR_THREAD_LOCAL(uint32_t) countdown_;
+};
+
+template <typename Tag>
+GPR_THREAD_LOCAL(uint32_t)
+SamplingCountdown<Tag>::countdown_;
+
+}  // namespace grpc_core
+
+#endif /* GRPC_CORE_LIB_PROFILING_SAMPLING_COUNTDOWN_H */
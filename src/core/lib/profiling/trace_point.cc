@@ -0,0 +1,236 @@
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <grpc/support/port_platform.h>
+
+#include "src/core/lib/profiling/trace_point.h"
+
+#ifdef GPR_POSIX_SYNC
+#include <pthread.h>
+#endif
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+#include "absl/strings/str_cat.h"
+
+#include <grpc/support/log.h>
+#include <grpc/support/time.h>
+
+#include "src/core/lib/gprpp/global_config.h"
+#include "src/core/lib/json/json.h"
+
+GPR_GLOBAL_CONFIG_DEFINE_INT32(
+    grpc_trace_point_sample_period,
+    grpc_core::ContinuousProfiler::kDefaultSamplePeriod,
+    "On average, one in this many trace point hits on each thread is timed "
+    "and kept for the profiling admin service. 0 turns sampling off.");
+
+namespace grpc_core {
+
+// Written only by the thread that owns it, and read concurrently by
+// DumpChromeTraceJson().  The writer bumps started before overwriting a
+// sample and head after, so a reader can tell which of the samples it
+// copied may have been overwritten meanwhile.
+struct ContinuousProfiler::Ring {
+  struct Sample {
+    std::atomic<const TracePoint*> point{nullptr};
+    std::atomic<gpr_cycle_counter> start{0};
+    std::atomic<gpr_cycle_counter> end{0};
+  };
+
+  // Id of the thread owning the ring, renewed whenever the ring changes
+  // owner.
+  std::atomic<size_t> thread_id{0};
+  // Next free ring, while the ring is in free_rings_.
+  Ring* next_free = nullptr;
+  // Number of samples written; the next one goes to samples[head % kRingSize].
+  std::atomic<uint64_t> head{0};
+  std::atomic<uint64_t> started{0};
+  // Samples before this index were discarded by Clear().
+  std::atomic<uint64_t> cleared{0};
+  Sample samples[kRingSize];
+};
+
+namespace {
+
+double ToMicros(gpr_timespec ts) {
+  return static_cast<double>(ts.tv_sec) * GPR_US_PER_SEC +
+         static_cast<double>(ts.tv_nsec) / GPR_NS_PER_US;
+}
+
+}  // namespace
+
+constexpr uint32_t ContinuousProfiler::kDefaultSamplePeriod;
+constexpr size_t ContinuousProfiler::kRingSize;
+constexpr size_t ContinuousProfiler::kMaxRings;
+
+std::atomic<uint32_t> ContinuousProfiler::sample_period_{
+    ContinuousProfiler::kDefaultSamplePeriod};
+std::atomic<ContinuousProfiler::Ring*>
+    ContinuousProfiler::rings_[ContinuousProfiler::kMaxRings];
+std::atomic<size_t> ContinuousProfiler::num_rings_{0};
+gpr_spinlock ContinuousProfiler::free_rings_lock_ =
+    GPR_SPINLOCK_STATIC_INITIALIZER;
+ContinuousProfiler::Ring* ContinuousProfiler::free_rings_ = nullptr;
+std::atomic<size_t> ContinuousProfiler::next_thread_id_{0};
+GPR_THREAD_LOCAL(ContinuousProfiler::Ring*) ContinuousProfiler::ring_;
+
+void ContinuousProfiler::Init() {
+  SetSamplePeriod(static_cast<uint32_t>(
+      std::max(0, GPR_GLOBAL_CONFIG_GET(grpc_trace_point_sample_period))));
+}
+
+void ContinuousProfiler::SetSamplePeriod(uint32_t period) {
+  sample_period_.store(period, std::memory_order_relaxed);
+}
+
+ContinuousProfiler::Ring* ContinuousProfiler::GetRing() {
+  Ring* ring = ring_;
+  if (GPR_LIKELY(ring != nullptr)) return ring;
+  gpr_spinlock_lock(&free_rings_lock_);
+  ring = free_rings_;
+  if (ring != nullptr) free_rings_ = ring->next_free;
+  gpr_spinlock_unlock(&free_rings_lock_);
+  if (ring != nullptr) {
+    // Drop the samples of the previous owner, which would otherwise be
+    // reported under the new owner's thread id.
+    ring->cleared.store(ring->head.load(std::memory_order_relaxed),
+                        std::memory_order_relaxed);
+  } else {
+    if (num_rings_.load(std::memory_order_relaxed) >= kMaxRings) {
+      return nullptr;
+    }
+    const size_t index = num_rings_.fetch_add(1, std::memory_order_relaxed);
+    if (index >= kMaxRings) return nullptr;
+    ring = new Ring();
+    rings_[index].store(ring, std::memory_order_release);
+  }
+  ring->thread_id.store(next_thread_id_.fetch_add(1, std::memory_order_relaxed),
+                        std::memory_order_relaxed);
+  ring_ = ring;
+  ReleaseRingAtThreadExit(ring);
+  return ring;
+}
+
+void ContinuousProfiler::ReleaseRingAtThreadExit(Ring* ring) {
+#ifdef GPR_POSIX_SYNC
+  // GPR_THREAD_LOCAL has no exit hook: use a pthread key's destructor.
+  static const pthread_key_t key = []() {
+    pthread_key_t key;
+    GPR_ASSERT(pthread_key_create(&key, ReleaseRing) == 0);
+    return key;
+  }();
+  pthread_setspecific(key, ring);
+#else
+  (void)ring;
+#endif
+}
+
+void ContinuousProfiler::ReleaseRing(void* arg) {
+  Ring* ring = static_cast<Ring*>(arg);
+  // Anything this thread records from now on (from other thread exit hooks)
+  // goes to a new ring.
+  ring_ = nullptr;
+  gpr_spinlock_lock(&free_rings_lock_);
+  ring->next_free = free_rings_;
+  free_rings_ = ring;
+  gpr_spinlock_unlock(&free_rings_lock_);
+}
+
+void ContinuousProfiler::Record(const TracePoint* point,
+                                gpr_cycle_counter start,
+                                gpr_cycle_counter end) {
+  Ring* ring = GetRing();
+  if (ring == nullptr) return;
+  const uint64_t head = ring->head.load(std::memory_order_relaxed);
+  ring->started.store(head + 1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+  Ring::Sample& sample = ring->samples[head % kRingSize];
+  sample.point.store(point, std::memory_order_relaxed);
+  sample.start.store(start, std::memory_order_relaxed);
+  sample.end.store(end, std::memory_order_relaxed);
+  ring->head.store(head + 1, std::memory_order_release);
+}
+
+std::string ContinuousProfiler::DumpChromeTraceJson() {
+  struct Copy {
+    const TracePoint* point;
+    gpr_cycle_counter start;
+    gpr_cycle_counter end;
+  };
+  Json::Array events;
+  std::vector<std::pair<uint64_t, Copy>> copies;
+  const size_t num_rings =
+      std::min(num_rings_.load(std::memory_order_relaxed), kMaxRings);
+  for (size_t i = 0; i < num_rings; ++i) {
+    Ring* ring = rings_[i].load(std::memory_order_acquire);
+    // Still being set up by its thread.
+    if (ring == nullptr) continue;
+    const size_t thread_id = ring->thread_id.load(std::memory_order_relaxed);
+    const uint64_t head = ring->head.load(std::memory_order_acquire);
+    uint64_t begin = std::max(head - std::min<uint64_t>(head, kRingSize),
+                              ring->cleared.load(std::memory_order_relaxed));
+    copies.clear();
+    for (uint64_t index = begin; index < head; ++index) {
+      const Ring::Sample& sample = ring->samples[index % kRingSize];
+      copies.emplace_back(
+          index, Copy{sample.point.load(std::memory_order_relaxed),
+                      sample.start.load(std::memory_order_relaxed),
+                      sample.end.load(std::memory_order_relaxed)});
+    }
+    std::atomic_thread_fence(std::memory_order_acquire);
+    // The owning thread may have overwritten the oldest samples while they
+    // were being copied.
+    const uint64_t started = ring->started.load(std::memory_order_relaxed);
+    if (started > kRingSize) begin = std::max(begin, started - kRingSize);
+    for (const auto& copy : copies) {
+      if (copy.first < begin || copy.second.point == nullptr) continue;
+      const TracePoint* point = copy.second.point;
+      events.emplace_back(Json::Object{
+          {"name", point->name()},
+          {"cat", "grpc"},
+          {"ph", "X"},
+          {"ts", ToMicros(gpr_cycle_counter_to_time(copy.second.start))},
+          {"dur", ToMicros(gpr_cycle_counter_sub(copy.second.end,
+                                                 copy.second.start))},
+          {"pid", 1},
+          {"tid", thread_id},
+          {"args",
+           Json::Object{
+               {"location", absl::StrCat(point->file(), ":", point->line())},
+           }},
+      });
+    }
+  }
+  return Json(Json::Object{
+                  {"traceEvents", std::move(events)},
+                  {"displayTimeUnit", "ns"},
+              })
+      .Dump();
+}
+
+void ContinuousProfiler::Clear() {
+  const size_t num_rings =
+      std::min(num_rings_.load(std::memory_order_relaxed), kMaxRings);
+  for (size_t i = 0; i < num_rings; ++i) {
+    Ring* ring = rings_[i].load(std::memory_order_acquire);
+    if (ring == nullptr) continue;
+    ring->cleared.store(ring->head.load(std::memory_order_acquire),
+                        std::memory_order_relaxed);
+  }
+}
+
+}  // namespace grpc_core
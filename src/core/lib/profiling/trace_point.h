@@ -0,0 +1,147 @@
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GRPC_CORE_LIB_PROFILING_TRACE_POINT_H
+#define GRPC_CORE_LIB_PROFILING_TRACE_POINT_H
+
+#include <grpc/support/port_platform.h>
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <atomic>
+#include <string>
+
+#include "src/core/lib/gpr/spinlock.h"
+#include "src/core/lib/gpr/time_precise.h"
+#include "src/core/lib/gpr/tls.h"
+#include "src/core/lib/profiling/sampling_countdown.h"
+
+namespace grpc_core {
+
+// A scope in the code whose duration the continuous profiler samples.
+// Trace points are constant-initialized statics (see GRPC_TRACE_POINT_SCOPE),
+// so they need no registration at runtime.
+class TracePoint {
+ public:
+  constexpr TracePoint(const char* name, const char* file, int line)
+      : name_(name), file_(file), line_(line) {}
+
+  const char* name() const { return name_; }
+  const char* file() const { return file_; }
+  int line() const { return line_; }
+
+ private:
+  const char* const name_;
+  const char* const file_;
+  const int line_;
+};
+
+// Always-on sampling profiler for trace points.
+//
+// On average one in sample_period() trace point hits on each thread is
+// timed; the others cost a thread-local countdown.  Samples go to a
+// fixed-size ring owned by the recording thread, written without locks
+// and holding that thread's most recent kRingSize samples, and
+// DumpChromeTraceJson() merges the rings into the Chrome trace event
+// format read by chrome://tracing and Perfetto.  On POSIX platforms, the
+// ring of an exited thread is handed to the next thread that needs one,
+// and the exited thread's samples are dropped then.
+//
+// The period comes from GRPC_TRACE_POINT_SAMPLE_PERIOD at grpc_init() and
+// can be changed at any time; 0 turns sampling off.
+class ContinuousProfiler {
+ public:
+  static constexpr uint32_t kDefaultSamplePeriod = 1000;
+  static constexpr size_t kRingSize = 1024;
+  // While this many threads own rings, other threads record no samples,
+  // which bounds the memory used by rings.
+  static constexpr size_t kMaxRings = 256;
+
+  static void Init();
+
+  static uint32_t sample_period() {
+    return sample_period_.load(std::memory_order_relaxed);
+  }
+  static void SetSamplePeriod(uint32_t period);
+
+  // Returns whether the current trace point hit should be recorded.
+  static bool ShouldSample() {
+    return SamplingCountdown<ContinuousProfiler>::ShouldSample(sample_period());
+  }
+
+  static void Record(const TracePoint* point, gpr_cycle_counter start,
+                     gpr_cycle_counter end);
+
+  // Returns the samples recorded since the last Clear(), oldest first
+  // within each thread.
+  static std::string DumpChromeTraceJson();
+  static void Clear();
+
+ private:
+  struct Ring;
+
+  static Ring* GetRing();
+  // Arranges for ReleaseRing() to be called when the current thread exits.
+  static void ReleaseRingAtThreadExit(Ring* ring);
+  static void ReleaseRing(void* ring);
+
+  static std::atomic<uint32_t> sample_period_;
+  static std::atomic<Ring*> rings_[kMaxRings];
+  static std::atomic<size_t> num_rings_;
+  // Rings released by exited threads, linked through Ring::next_free.
+  static gpr_spinlock free_rings_lock_;
+  static Ring* free_rings_;
+  static std::atomic<size_t> next_thread_id_;
+  static GPR_THREAD_LOCAL(Ring*) ring_;
+};
+
+// Times the enclosing scope if ContinuousProfiler samples it.
+class TracePointScope {
+ public:
+  explicit TracePointScope(const TracePoint* point)
+      : point_(ContinuousProfiler::ShouldSample() ? point : nullptr) {
+    if (GPR_UNLIKELY(point_ != nullptr)) start_ = gpr_get_cycle_counter();
+  }
+
+  ~TracePointScope() {
+    if (GPR_UNLIKELY(point_ != nullptr)) {
+      ContinuousProfiler::Record(point_, start_, gpr_get_cycle_counter());
+    }
+  }
+
+  TracePointScope(const TracePointScope&) = delete;
+  TracePointScope& operator=(const TracePointScope&) = delete;
+
+ private:
+  const TracePoint* const point_;
+  gpr_cycle_counter start_ = 0;
+};
+
+}  // namespace grpc_core
+
+#define GRPC_TRACE_POINT_NAME_INTERNAL(prefix, line) prefix##line
+#define GRPC_TRACE_POINT_NAME(prefix, line) \
+  GRPC_TRACE_POINT_NAME_INTERNAL(prefix, line)
+
+// Declares a trace point named name covering the rest of the enclosing
+// scope.  name must be a string literal.
+#define GRPC_TRACE_POINT_SCOPE(name)                                        \
+  static constexpr ::grpc_core::TracePoint GRPC_TRACE_POINT_NAME(           \
+      grpc_trace_point_, __LINE__)(name, __FILE__, __LINE__);               \
+  ::grpc_core::TracePointScope GRPC_TRACE_POINT_NAME(grpc_trace_point_scope_, \
+                                                     __LINE__)(             \
+      &GRPC_TRACE_POINT_NAME(grpc_trace_point_, __LINE__))
+
+#endif  // GRPC_CORE_LIB_PROFILING_TRACE_POINT_H
@@ -20,19 +20,24 @@
 
 #include "src/core/lib/resource_quota/arena.h"
 
+#include <iterator>
 #include <new>
 
+#include "absl/types/optional.h"
+
 #include <grpc/support/alloc.h>
 
 #include "src/core/lib/gpr/alloc.h"
 
 namespace {
 
-void* ArenaStorage(size_t initial_size) {
+// Returns storage for an arena and an initial zone of at least *initial_size
+// bytes. *initial_size is updated to the actual size of the initial zone.
+void* ArenaStorage(size_t* initial_size) {
   static constexpr size_t base_size =
       GPR_ROUND_UP_TO_ALIGNMENT_SIZE(sizeof(grpc_core::Arena));
-  initial_size = GPR_ROUND_UP_TO_ALIGNMENT_SIZE(initial_size);
-  size_t alloc_size = base_size + initial_size;
+  *initial_size = GPR_ROUND_UP_TO_ALIGNMENT_SIZE(*initial_size);
+  size_t alloc_size = base_size + *initial_size;
   static constexpr size_t alignment =
       (GPR_CACHELINE_SIZE > GPR_MAX_ALIGNMENT &&
        GPR_CACHELINE_SIZE % GPR_MAX_ALIGNMENT == 0)
@@ -45,8 +50,10 @@ void* ArenaStorage(size_t initial_size) {
 
 namespace grpc_core {
 
-Arena::~Arena() {
-  Zone* z = last_zone_;
+Arena::~Arena() { FreeZones(); }
+
+void Arena::FreeZones() {
+  Zone* z = last_zone_.exchange(nullptr, std::memory_order_relaxed);
   while (z) {
     Zone* prev_z = z->prev;
     z->~Zone();
@@ -56,16 +63,17 @@ Arena::~Arena() {
 }
 
 Arena* Arena::Create(size_t initial_size, MemoryAllocator* memory_allocator) {
-  return new (ArenaStorage(initial_size))
-      Arena(initial_size, 0, memory_allocator);
+  void* storage = ArenaStorage(&initial_size);
+  return new (storage) Arena(initial_size, 0, memory_allocator);
 }
 
 std::pair<Arena*, void*> Arena::CreateWithAlloc(
     size_t initial_size, size_t alloc_size, MemoryAllocator* memory_allocator) {
   static constexpr size_t base_size =
       GPR_ROUND_UP_TO_ALIGNMENT_SIZE(sizeof(Arena));
-  auto* new_arena = new (ArenaStorage(initial_size))
-      Arena(initial_size, alloc_size, memory_allocator);
+  void* storage = ArenaStorage(&initial_size);
+  auto* new_arena =
+      new (storage) Arena(initial_size, alloc_size, memory_allocator);
   void* first_alloc = reinterpret_cast<char*>(new_arena) + base_size;
   return std::make_pair(new_arena, first_alloc);
 }
@@ -78,6 +86,15 @@ size_t Arena::Destroy() {
   return size;
 }
 
+size_t Arena::Reset() {
+  size_t size = total_used_.load(std::memory_order_relaxed);
+  FreeZones();
+  memory_allocator_->Release(
+      total_allocated_.exchange(0, std::memory_order_relaxed));
+  total_used_.store(0, std::memory_order_relaxed);
+  return size;
+}
+
 void* Arena::AllocZone(size_t size) {
   // If the allocation isn't able to end in the initial zone, create a new
   // zone for this allocation, and any unused space in the initial zone is
@@ -98,4 +115,91 @@ void* Arena::AllocZone(size_t size) {
   return reinterpret_cast<char*>(z) + zone_base_size;
 }
 
+ArenaPool::ArenaPool(size_t max_pooled_arenas, MemoryOwner* memory_owner)
+    : memory_owner_(memory_owner),
+      state_(MakeRefCounted<State>(max_pooled_arenas, memory_owner)) {
+  MutexLock lock(&state_->mu);
+  state_->arenas.reserve(max_pooled_arenas);
+}
+
+ArenaPool::~ArenaPool() {
+  MutexLock lock(&state_->mu);
+  state_->Drain();
+  // A reclaimer may still be posted: make sure it doesn't touch the memory
+  // owner once we're gone.
+  state_->memory_owner = nullptr;
+}
+
+std::pair<Arena*, void*> ArenaPool::CreateWithAlloc(size_t initial_size,
+                                                    size_t alloc_size) {
+  Arena* arena = nullptr;
+  // Never wait for the pool: if it's busy, creating a new arena is cheaper.
+  if (state_->mu.TryLock()) {
+    auto& arenas = state_->arenas;
+    // Prefer the most recently pooled arenas, whose memory is likely to still
+    // be in cache, and don't hand out arenas much larger than needed.
+    for (auto it = arenas.rbegin(); it != arenas.rend(); ++it) {
+      const size_t size = (*it)->initial_zone_size();
+      if (size >= initial_size && size <= 2 * initial_size) {
+        arena = *it;
+        arenas.erase(std::next(it).base());
+        memory_owner_->Release(size);
+        break;
+      }
+    }
+    state_->mu.Unlock();
+  }
+  if (arena == nullptr) {
+    return Arena::CreateWithAlloc(initial_size, alloc_size, memory_owner_);
+  }
+  return std::make_pair(arena, arena->Alloc(alloc_size));
+}
+
+size_t ArenaPool::Destroy(Arena* arena) {
+  if (state_->max_pooled_arenas == 0) return arena->Destroy();
+  bool pooled = false;
+  bool post_reclaimer = false;
+  size_t size = 0;
+  if (state_->mu.TryLock()) {
+    if (state_->arenas.size() < state_->max_pooled_arenas) {
+      size = arena->Reset();
+      // Pooled arenas are charged to the memory quota, so that they are
+      // accounted for and can be reclaimed under memory pressure.
+      memory_owner_->Reserve(arena->initial_zone_size());
+      state_->arenas.push_back(arena);
+      pooled = true;
+      post_reclaimer = !std::exchange(state_->reclaimer_posted, true);
+    }
+    state_->mu.Unlock();
+  }
+  if (!pooled) return arena->Destroy();
+  if (post_reclaimer) PostReclaimer();
+  return size;
+}
+
+size_t ArenaPool::TestOnlyPooledArenas() {
+  MutexLock lock(&state_->mu);
+  return state_->arenas.size();
+}
+
+void ArenaPool::PostReclaimer() {
+  memory_owner_->PostReclaimer(
+      ReclamationPass::kBenign,
+      [state = state_](absl::optional<ReclamationSweep> sweep) {
+        MutexLock lock(&state->mu);
+        state->reclaimer_posted = false;
+        if (sweep.has_value() && state->memory_owner != nullptr) {
+          state->Drain();
+        }
+      });
+}
+
+void ArenaPool::State::Drain() {
+  for (Arena* arena : arenas) {
+    memory_owner->Release(arena->initial_zone_size());
+    arena->Destroy();
+  }
+  arenas.clear();
+}
+
 }  // namespace grpc_core
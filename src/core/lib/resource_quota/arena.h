@@ -33,10 +33,16 @@
 #include <memory>
 #include <new>
 #include <utility>
+#include <vector>
+
+#include "absl/base/thread_annotations.h"
 
 #include <grpc/event_engine/memory_allocator.h>
 
 #include "src/core/lib/gpr/alloc.h"
+#include "src/core/lib/gprpp/ref_counted.h"
+#include "src/core/lib/gprpp/ref_counted_ptr.h"
+#include "src/core/lib/gprpp/sync.h"
 #include "src/core/lib/promise/context.h"
 #include "src/core/lib/resource_quota/memory_quota.h"
 
@@ -44,18 +50,25 @@ namespace grpc_core {
 
 class Arena {
  public:
-  // Create an arena, with \a initial_size bytes in the first allocated buffer.
+  // Create an arena, with at least \a initial_size bytes in the first allocated
+  // buffer.
   static Arena* Create(size_t initial_size, MemoryAllocator* memory_allocator);
 
-  // Create an arena, with \a initial_size bytes in the first allocated buffer,
-  // and return both a void pointer to the returned arena and a void* with the
-  // first allocation.
+  // Create an arena, with at least \a initial_size bytes in the first allocated
+  // buffer, and return both a void pointer to the returned arena and a void*
+  // with the first allocation.
   static std::pair<Arena*, void*> CreateWithAlloc(
       size_t initial_size, size_t alloc_size,
       MemoryAllocator* memory_allocator);
 
   // Destroy an arena, returning the total number of bytes allocated.
   size_t Destroy();
+  // Free everything allocated from the arena beyond its initial zone, and make
+  // the whole initial zone available for allocation again. Returns the total
+  // number of bytes allocated before the reset.
+  size_t Reset();
+  // Size of the first allocated buffer.
+  size_t initial_zone_size() const { return initial_zone_size_; }
   // Allocate \a size bytes from the arena.
   void* Alloc(size_t size) {
     static constexpr size_t base_size =
@@ -106,6 +119,7 @@ class Arena {
   ~Arena();
 
   void* AllocZone(size_t size);
+  void FreeZones();
 
   // Keep track of the total used size. We use this in our call sizing
   // hysteresis.
@@ -122,6 +136,54 @@ class Arena {
   MemoryAllocator* const memory_allocator_;
 };
 
+// A bounded pool of reset arenas, so that objects creating an arena per call
+// (channels, server connections) don't pay for a malloc and free of the
+// arena's storage on every call.
+// Pooled arenas are charged to \a memory_owner, and the pool is emptied by a
+// benign reclaimer when the owner's memory quota comes under pressure.
+class ArenaPool {
+ public:
+  ArenaPool(size_t max_pooled_arenas, MemoryOwner* memory_owner);
+  ~ArenaPool();
+
+  ArenaPool(const ArenaPool&) = delete;
+  ArenaPool& operator=(const ArenaPool&) = delete;
+
+  // Like Arena::CreateWithAlloc(), but reuses a pooled arena when one with a
+  // suitable initial zone is available.
+  std::pair<Arena*, void*> CreateWithAlloc(size_t initial_size,
+                                           size_t alloc_size);
+
+  // Like Arena::Destroy(), but returns the arena to the pool if there is room.
+  // \a arena must have been created by this pool.
+  size_t Destroy(Arena* arena);
+
+  // Number of arenas currently pooled.
+  size_t TestOnlyPooledArenas();
+
+ private:
+  // State shared with the posted reclaimer, which may outlive the pool.
+  struct State : public RefCounted<State> {
+    State(size_t max_pooled_arenas, MemoryOwner* memory_owner)
+        : max_pooled_arenas(max_pooled_arenas), memory_owner(memory_owner) {}
+
+    // Destroys all pooled arenas.
+    void Drain() ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu);
+
+    const size_t max_pooled_arenas;
+    Mutex mu;
+    // Null once the pool is destroyed.
+    MemoryOwner* memory_owner ABSL_GUARDED_BY(mu);
+    std::vector<Arena*> arenas ABSL_GUARDED_BY(mu);
+    bool reclaimer_posted ABSL_GUARDED_BY(mu) = false;
+  };
+
+  void PostReclaimer();
+
+  MemoryOwner* const memory_owner_;
+  const RefCountedPtr<State> state_;
+};
+
 // Smart pointer for arenas when the final size is not required.
 struct ScopedArenaDeleter {
   void operator()(Arena* arena) { arena->Destroy(); }
@@ -60,6 +60,29 @@ EvaluateArgs::PerChannelArgs::Address ParseEndpointUri(
 
 }  // namespace
 
+constexpr size_t EvaluateArgs::ConnectionCache::kMaxEntries;
+
+std::shared_ptr<const EvaluateArgs::ConnectionCache::Entry>
+EvaluateArgs::ConnectionCache::GetOrCreate(
+    uint64_t key, absl::FunctionRef<std::shared_ptr<const Entry>()> create) {
+  {
+    MutexLock lock(&mu_);
+    auto it = entries_.find(key);
+    if (it != entries_.end()) return it->second;
+  }
+  // Create the entry without holding the lock, so that calls for other
+  // engines are not held up.  If two calls race, the first one wins.
+  std::shared_ptr<const Entry> entry = create();
+  MutexLock lock(&mu_);
+  auto it = entries_.emplace(key, std::move(entry)).first;
+  if (entries_.size() > kMaxEntries) {
+    auto oldest = entries_.begin();
+    if (oldest == it) ++oldest;
+    entries_.erase(oldest);
+  }
+  return it->second;
+}
+
 EvaluateArgs::PerChannelArgs::PerChannelArgs(grpc_auth_context* auth_context,
                                              grpc_endpoint* endpoint) {
   if (auth_context != nullptr) {
@@ -209,4 +232,11 @@ absl::string_view EvaluateArgs::GetSubject() const {
   return channel_args_->subject;
 }
 
+EvaluateArgs::ConnectionCache* EvaluateArgs::GetConnectionCache() const {
+  if (channel_args_ == nullptr) {
+    return nullptr;
+  }
+  return channel_args_->cache.get();
+}
+
 }  // namespace grpc_core
@@ -17,10 +17,16 @@
 
 #include <grpc/support/port_platform.h>
 
+#include <stdint.h>
+
 #include <map>
+#include <memory>
 
+#include "absl/base/thread_annotations.h"
+#include "absl/functional/function_ref.h"
 #include "absl/types/optional.h"
 
+#include "src/core/lib/gprpp/sync.h"
 #include "src/core/lib/iomgr/endpoint.h"
 #include "src/core/lib/iomgr/resolve_address.h"
 #include "src/core/lib/security/context/security_context.h"
@@ -30,6 +36,35 @@ namespace grpc_core {
 
 class EvaluateArgs {
  public:
+  // Results that authorization engines derive from a connection's
+  // PerChannelArgs, so that they are computed once per connection instead
+  // of once per call.  Each engine stores one entry under a key that is
+  // unique to it.  Thread-safe.
+  class ConnectionCache {
+   public:
+    class Entry {
+     public:
+      virtual ~Entry() = default;
+    };
+
+    // Returns the entry stored under key, first storing the result of
+    // create() if there is none.
+    std::shared_ptr<const Entry> GetOrCreate(
+        uint64_t key,
+        absl::FunctionRef<std::shared_ptr<const Entry>()> create);
+
+   private:
+    // Engines are replaced when the policy changes, so a long-lived
+    // connection would otherwise collect entries for engines that no
+    // longer exist.  Keys increase with engine age, so the smallest key is
+    // evicted first.
+    static constexpr size_t kMaxEntries = 32;
+
+    Mutex mu_;
+    std::map<uint64_t, std::shared_ptr<const Entry>> entries_
+        ABSL_GUARDED_BY(mu_);
+  };
+
   // Caller is responsible for ensuring auth_context outlives PerChannelArgs
   // struct.
   struct PerChannelArgs {
@@ -51,6 +86,9 @@ class EvaluateArgs {
     absl::string_view subject;
     Address local_address;
     Address peer_address;
+    // Shared by copies, which describe the same connection.
+    std::shared_ptr<ConnectionCache> cache =
+        std::make_shared<ConnectionCache>();
   };
 
   EvaluateArgs(grpc_metadata_batch* metadata, PerChannelArgs* channel_args)
@@ -81,6 +119,8 @@ class EvaluateArgs {
   std::vector<absl::string_view> GetDnsSans() const;
   absl::string_view GetCommonName() const;
   absl::string_view GetSubject() const;
+  // Returns null if there are no per-channel args.
+  ConnectionCache* GetConnectionCache() const;
 
  private:
   grpc_metadata_batch* metadata_;
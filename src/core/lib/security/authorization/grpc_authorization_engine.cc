@@ -16,41 +16,79 @@
 
 #include "src/core/lib/security/authorization/grpc_authorization_engine.h"
 
+#include <atomic>
+#include <utility>
+
+#include "absl/memory/memory.h"
+
 namespace grpc_core {
 
-GrpcAuthorizationEngine::GrpcAuthorizationEngine(Rbac policy)
-    : action_(policy.action) {
-  for (auto& sub_policy : policy.policies) {
-    Policy policy;
-    policy.name = sub_policy.first;
-    policy.matcher = absl::make_unique<PolicyAuthorizationMatcher>(
-        std::move(sub_policy.second));
-    policies_.push_back(std::move(policy));
-  }
+namespace {
+
+uint64_t NextEngineId() {
+  static std::atomic<uint64_t> next_id{1};
+  return next_id.fetch_add(1, std::memory_order_relaxed);
 }
 
+}  // namespace
+
+class GrpcAuthorizationEngine::ConnectionCacheEntry
+    : public EvaluateArgs::ConnectionCache::Entry {
+ public:
+  explicit ConnectionCacheEntry(
+      std::unique_ptr<RbacProgram::ConnectionState> state)
+      : state_(std::move(state)) {}
+
+  const RbacProgram::ConnectionState& state() const { return *state_; }
+
+ private:
+  std::unique_ptr<RbacProgram::ConnectionState> state_;
+};
+
+GrpcAuthorizationEngine::GrpcAuthorizationEngine(Rbac::Action action)
+    : action_(action),
+      program_(absl::make_unique<RbacProgram>(
+          std::map<std::string, Rbac::Policy>())),
+      id_(NextEngineId()) {}
+
+GrpcAuthorizationEngine::GrpcAuthorizationEngine(Rbac policy)
+    : action_(policy.action),
+      program_(absl::make_unique<RbacProgram>(std::move(policy.policies))),
+      id_(NextEngineId()) {}
+
 GrpcAuthorizationEngine::GrpcAuthorizationEngine(
     GrpcAuthorizationEngine&& other) noexcept
-    : action_(other.action_), policies_(std::move(other.policies_)) {}
+    : action_(other.action_),
+      program_(std::move(other.program_)),
+      id_(other.id_) {}
 
 GrpcAuthorizationEngine& GrpcAuthorizationEngine::operator=(
     GrpcAuthorizationEngine&& other) noexcept {
   action_ = other.action_;
-  policies_ = std::move(other.policies_);
+  program_ = std::move(other.program_);
+  id_ = other.id_;
   return *this;
 }
 
 AuthorizationEngine::Decision GrpcAuthorizationEngine::Evaluate(
     const EvaluateArgs& args) const {
   Decision decision;
-  bool matches = false;
-  for (const auto& policy : policies_) {
-    if (policy.matcher->Matches(args)) {
-      matches = true;
-      decision.matching_policy_name = policy.name;
-      break;
-    }
+  const std::string* policy_name;
+  EvaluateArgs::ConnectionCache* cache = args.GetConnectionCache();
+  if (cache != nullptr) {
+    std::shared_ptr<const EvaluateArgs::ConnectionCache::Entry> entry =
+        cache->GetOrCreate(id_, [&]() {
+          return std::make_shared<const ConnectionCacheEntry>(
+              program_->EvaluateConnection(args));
+        });
+    policy_name = program_->FindMatchingPolicy(
+        args, static_cast<const ConnectionCacheEntry&>(*entry).state());
+  } else {
+    policy_name =
+        program_->FindMatchingPolicy(args, *program_->EvaluateConnection(args));
   }
+  const bool matches = policy_name != nullptr;
+  if (matches) decision.matching_policy_name = *policy_name;
   decision.type = (matches == (action_ == Rbac::Action::kAllow))
                       ? Decision::Type::kAllow
                       : Decision::Type::kDeny;
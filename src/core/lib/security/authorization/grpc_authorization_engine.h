@@ -17,9 +17,13 @@
 
 #include <grpc/support/port_platform.h>
 
+#include <stdint.h>
+
+#include <memory>
+
 #include "src/core/lib/security/authorization/authorization_engine.h"
-#include "src/core/lib/security/authorization/matchers.h"
 #include "src/core/lib/security/authorization/rbac_policy.h"
+#include "src/core/lib/security/authorization/rbac_program.h"
 
 namespace grpc_core {
 
@@ -29,10 +33,14 @@ namespace grpc_core {
 // engine type. This engine ignores condition field in RBAC config. It is the
 // caller's responsibility to provide RBAC policies that are compatible with
 // this engine.
+//
+// The policies are compiled into an RbacProgram.  Its per-connection state
+// is cached in the connection's EvaluateArgs::ConnectionCache, so rules
+// that only depend on the connection are evaluated once per connection.
 class GrpcAuthorizationEngine : public AuthorizationEngine {
  public:
   // Builds GrpcAuthorizationEngine without any policies.
-  explicit GrpcAuthorizationEngine(Rbac::Action action) : action_(action) {}
+  explicit GrpcAuthorizationEngine(Rbac::Action action);
   // Builds GrpcAuthorizationEngine with allow/deny RBAC policy.
   explicit GrpcAuthorizationEngine(Rbac policy);
 
@@ -42,19 +50,20 @@ class GrpcAuthorizationEngine : public AuthorizationEngine {
   Rbac::Action action() const { return action_; }
 
   // Required only for testing purpose.
-  size_t num_policies() const { return policies_.size(); }
+  size_t num_policies() const { return program_->num_policies(); }
 
   // Evaluates incoming request against RBAC policy and makes a decision to
   // whether allow/deny this request.
   Decision Evaluate(const EvaluateArgs& args) const override;
 
  private:
-  struct Policy {
-    std::string name;
-    std::unique_ptr<AuthorizationMatcher> matcher;
-  };
+  // The entry this engine stores in each connection's cache.
+  class ConnectionCacheEntry;
+
   Rbac::Action action_;
-  std::vector<Policy> policies_;
+  std::unique_ptr<RbacProgram> program_;
+  // Unique to this engine, for keying the connection caches.
+  uint64_t id_;
 };
 
 }  // namespace grpc_core
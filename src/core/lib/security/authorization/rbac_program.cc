@@ -0,0 +1,414 @@
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <grpc/support/port_platform.h>
+
+#include "src/core/lib/security/authorization/rbac_program.h"
+
+#include <utility>
+
+#include "absl/container/inlined_vector.h"
+#include "absl/memory/memory.h"
+#include "absl/strings/string_view.h"
+
+#include <grpc/support/log.h>
+
+namespace grpc_core {
+
+constexpr uint32_t RbacProgram::kNoSlot;
+
+//
+// RbacProgram::Compiler
+//
+
+// Appends the nodes for RBAC rules to a program.  Each Compile() method
+// returns the value of the rule if it is constant, in which case it
+// appends nothing.
+class RbacProgram::Compiler {
+ public:
+  explicit Compiler(RbacProgram* program) : program_(program) {}
+
+  absl::optional<bool> Compile(Rbac::Policy policy) {
+    Group group = BeginGroup(Op::kAnd);
+    if (AddChild(&group, Compile(std::move(policy.permissions)))) {
+      AddChild(&group, Compile(std::move(policy.principals)));
+    }
+    return EndGroup(group);
+  }
+
+  absl::optional<bool> Compile(Rbac::Permission permission) {
+    switch (permission.type) {
+      case Rbac::Permission::RuleType::kAnd:
+        return CompileGroup(Op::kAnd, std::move(permission.permissions));
+      case Rbac::Permission::RuleType::kOr:
+        return CompileGroup(Op::kOr, std::move(permission.permissions));
+      case Rbac::Permission::RuleType::kNot:
+        return CompileNot(std::move(*permission.permissions[0]));
+      case Rbac::Permission::RuleType::kAny:
+        return true;
+      case Rbac::Permission::RuleType::kHeader:
+        return AddHeader(std::move(permission.header_matcher));
+      case Rbac::Permission::RuleType::kPath:
+        return AddPath(std::move(permission.string_matcher));
+      case Rbac::Permission::RuleType::kDestIp:
+        return AddIp(IpAuthorizationMatcher::Type::kDestIp,
+                     std::move(permission.ip));
+      case Rbac::Permission::RuleType::kDestPort:
+        program_->ports_.push_back(permission.port);
+        return AddLeaf(Op::kPort, program_->ports_.size() - 1,
+                       /*connection_level=*/true);
+      case Rbac::Permission::RuleType::kMetadata:
+        // See MetadataAuthorizationMatcher.
+        return permission.invert;
+      case Rbac::Permission::RuleType::kReqServerName:
+        // See ReqServerNameAuthorizationMatcher.
+        return permission.string_matcher.Match("");
+    }
+    return false;
+  }
+
+  absl::optional<bool> Compile(Rbac::Principal principal) {
+    switch (principal.type) {
+      case Rbac::Principal::RuleType::kAnd:
+        return CompileGroup(Op::kAnd, std::move(principal.principals));
+      case Rbac::Principal::RuleType::kOr:
+        return CompileGroup(Op::kOr, std::move(principal.principals));
+      case Rbac::Principal::RuleType::kNot:
+        return CompileNot(std::move(*principal.principals[0]));
+      case Rbac::Principal::RuleType::kAny:
+        return true;
+      case Rbac::Principal::RuleType::kPrincipalName:
+        program_->authenticated_matchers_.emplace_back(
+            std::move(principal.string_matcher));
+        return AddLeaf(Op::kAuthenticated,
+                       program_->authenticated_matchers_.size() - 1,
+                       /*connection_level=*/true);
+      case Rbac::Principal::RuleType::kSourceIp:
+        return AddIp(IpAuthorizationMatcher::Type::kSourceIp,
+                     std::move(principal.ip));
+      case Rbac::Principal::RuleType::kDirectRemoteIp:
+        return AddIp(IpAuthorizationMatcher::Type::kDirectRemoteIp,
+                     std::move(principal.ip));
+      case Rbac::Principal::RuleType::kRemoteIp:
+        return AddIp(IpAuthorizationMatcher::Type::kRemoteIp,
+                     std::move(principal.ip));
+      case Rbac::Principal::RuleType::kHeader:
+        return AddHeader(std::move(principal.header_matcher));
+      case Rbac::Principal::RuleType::kPath:
+        return AddPath(std::move(principal.string_matcher.value()));
+      case Rbac::Principal::RuleType::kMetadata:
+        return principal.invert;
+    }
+    return false;
+  }
+
+ private:
+  // An And or Or node whose children are being compiled.
+  struct Group {
+    Op op;
+    size_t start;
+    size_t num_children;
+    // Set once a child decides the value of the group.
+    absl::optional<bool> value;
+  };
+
+  Group BeginGroup(Op op) {
+    Group group{op, program_->nodes_.size(), 0, absl::nullopt};
+    program_->nodes_.push_back(Node{op, false, 1, 0, 0, kNoSlot});
+    return group;
+  }
+
+  // Records the result of compiling a child.  Returns false if the child
+  // decided the value of the group, in which case the remaining children
+  // need not be compiled.
+  bool AddChild(Group* group, absl::optional<bool> child) {
+    if (!child.has_value()) {
+      ++group->num_children;
+      return true;
+    }
+    // A false child decides an And and a true child decides an Or; the
+    // other value has no effect and is dropped.
+    const bool deciding_value = group->op == Op::kOr;
+    if (*child != deciding_value) return true;
+    group->value = deciding_value;
+    return false;
+  }
+
+  absl::optional<bool> EndGroup(const Group& group) {
+    std::vector<Node>& nodes = program_->nodes_;
+    if (group.value.has_value()) {
+      nodes.resize(group.start);
+      return group.value;
+    }
+    if (group.num_children == 0) {
+      nodes.resize(group.start);
+      return group.op == Op::kAnd;
+    }
+    if (group.num_children == 1) {
+      nodes.erase(nodes.begin() + group.start);
+      return absl::nullopt;
+    }
+    bool connection_level = true;
+    for (size_t child = group.start + 1; child < nodes.size();
+         child += nodes[child].size) {
+      connection_level &= nodes[child].connection_level;
+    }
+    nodes[group.start].size = nodes.size() - group.start;
+    nodes[group.start].connection_level = connection_level;
+    return absl::nullopt;
+  }
+
+  template <typename Rule>
+  absl::optional<bool> CompileGroup(Op op,
+                                    std::vector<std::unique_ptr<Rule>> rules) {
+    Group group = BeginGroup(op);
+    for (auto& rule : rules) {
+      if (!AddChild(&group, Compile(std::move(*rule)))) break;
+    }
+    return EndGroup(group);
+  }
+
+  template <typename Rule>
+  absl::optional<bool> CompileNot(Rule rule) {
+    std::vector<Node>& nodes = program_->nodes_;
+    const size_t start = nodes.size();
+    nodes.push_back(Node{Op::kNot, false, 1, 0, 0, kNoSlot});
+    absl::optional<bool> child = Compile(std::move(rule));
+    if (child.has_value()) {
+      nodes.resize(start);
+      return !*child;
+    }
+    nodes[start].size = nodes.size() - start;
+    nodes[start].connection_level = nodes[start + 1].connection_level;
+    return absl::nullopt;
+  }
+
+  absl::optional<bool> AddLeaf(Op op, size_t matcher, bool connection_level,
+                               uint32_t header = 0) {
+    program_->nodes_.push_back(Node{op, connection_level, 1,
+                                    static_cast<uint32_t>(matcher), header,
+                                    kNoSlot});
+    return absl::nullopt;
+  }
+
+  absl::optional<bool> AddHeader(HeaderMatcher matcher) {
+    auto it = header_indexes_.find(matcher.name());
+    if (it == header_indexes_.end()) {
+      it = header_indexes_.emplace(matcher.name(), header_indexes_.size())
+               .first;
+      program_->header_names_.push_back(matcher.name());
+    }
+    program_->header_matchers_.push_back(std::move(matcher));
+    return AddLeaf(Op::kHeader, program_->header_matchers_.size() - 1,
+                   /*connection_level=*/false, it->second);
+  }
+
+  absl::optional<bool> AddPath(StringMatcher matcher) {
+    program_->path_matchers_.push_back(std::move(matcher));
+    return AddLeaf(Op::kPath, program_->path_matchers_.size() - 1,
+                   /*connection_level=*/false);
+  }
+
+  absl::optional<bool> AddIp(IpAuthorizationMatcher::Type type,
+                             Rbac::CidrRange range) {
+    program_->ip_matchers_.emplace_back(type, std::move(range));
+    return AddLeaf(Op::kIp, program_->ip_matchers_.size() - 1,
+                   /*connection_level=*/true);
+  }
+
+  RbacProgram* program_;
+  std::map<std::string, uint32_t> header_indexes_;
+};
+
+//
+// RbacProgram::CallState
+//
+
+// The values looked up so far for a call.
+class RbacProgram::CallState {
+ public:
+  CallState(const EvaluateArgs& args, size_t num_headers)
+      : args_(args), headers_(num_headers) {}
+
+  absl::optional<absl::string_view> GetHeader(uint32_t index,
+                                              const std::string& name) {
+    Header& header = headers_[index];
+    if (!header.fetched) {
+      header.value = args_.GetHeaderValue(name, &header.concatenated_value);
+      header.fetched = true;
+    }
+    return header.value;
+  }
+
+  absl::string_view GetPath() {
+    if (!path_.has_value()) path_ = args_.GetPath();
+    return *path_;
+  }
+
+ private:
+  struct Header {
+    bool fetched = false;
+    absl::optional<absl::string_view> value;
+    // May be pointed to by value, so headers_ must never be resized.
+    std::string concatenated_value;
+  };
+
+  const EvaluateArgs& args_;
+  absl::InlinedVector<Header, 4> headers_;
+  absl::optional<absl::string_view> path_;
+};
+
+//
+// RbacProgram
+//
+
+RbacProgram::RbacProgram(std::map<std::string, Rbac::Policy> policies) {
+  Compiler compiler(this);
+  for (auto& p : policies) {
+    Policy policy;
+    policy.name = p.first;
+    policy.root = nodes_.size();
+    policy.constant = compiler.Compile(std::move(p.second));
+    if (!policy.constant.has_value()) AssignSlots(policy.root);
+    policies_.push_back(std::move(policy));
+  }
+}
+
+void RbacProgram::AssignSlots(uint32_t index) {
+  Node& node = nodes_[index];
+  if (node.connection_level) {
+    node.slot = num_slots_++;
+    return;
+  }
+  for (uint32_t child = index + 1; child < index + node.size;
+       child += nodes_[child].size) {
+    AssignSlots(child);
+  }
+}
+
+std::unique_ptr<RbacProgram::ConnectionState> RbacProgram::EvaluateConnection(
+    const EvaluateArgs& args) const {
+  auto state = absl::make_unique<ConnectionState>();
+  state->slots_.resize(num_slots_);
+  for (uint32_t index = 0; index < nodes_.size();) {
+    const Node& node = nodes_[index];
+    if (node.slot == kNoSlot) {
+      ++index;
+      continue;
+    }
+    state->slots_[node.slot] =
+        Evaluate(index, args, /*state=*/nullptr, /*call=*/nullptr);
+    index += node.size;
+  }
+  for (uint32_t i = 0; i < policies_.size(); ++i) {
+    const Policy& policy = policies_[i];
+    absl::optional<bool> value = policy.constant.has_value()
+                                     ? policy.constant
+                                     : EvaluatePartially(policy.root, *state);
+    if (value == false) continue;
+    state->candidates_.push_back({i, value.has_value()});
+    // No later policy can be the first to match.
+    if (value.has_value()) break;
+  }
+  return state;
+}
+
+const std::string* RbacProgram::FindMatchingPolicy(
+    const EvaluateArgs& args, const ConnectionState& state) const {
+  CallState call(args, header_names_.size());
+  for (const auto& candidate : state.candidates_) {
+    const Policy& policy = policies_[candidate.policy];
+    if (candidate.always_matches ||
+        Evaluate(policy.root, args, &state, &call)) {
+      return &policy.name;
+    }
+  }
+  return nullptr;
+}
+
+bool RbacProgram::Evaluate(uint32_t index, const EvaluateArgs& args,
+                           const ConnectionState* state,
+                           CallState* call) const {
+  const Node& node = nodes_[index];
+  if (state != nullptr && node.slot != kNoSlot) {
+    return state->slots_[node.slot];
+  }
+  switch (node.op) {
+    case Op::kAnd:
+      for (uint32_t child = index + 1; child < index + node.size;
+           child += nodes_[child].size) {
+        if (!Evaluate(child, args, state, call)) return false;
+      }
+      return true;
+    case Op::kOr:
+      for (uint32_t child = index + 1; child < index + node.size;
+           child += nodes_[child].size) {
+        if (Evaluate(child, args, state, call)) return true;
+      }
+      return false;
+    case Op::kNot:
+      return !Evaluate(index + 1, args, state, call);
+    case Op::kHeader:
+      GPR_DEBUG_ASSERT(call != nullptr);
+      return header_matchers_[node.matcher].Match(
+          call->GetHeader(node.header, header_names_[node.header]));
+    case Op::kPath: {
+      GPR_DEBUG_ASSERT(call != nullptr);
+      absl::string_view path = call->GetPath();
+      return !path.empty() && path_matchers_[node.matcher].Match(path);
+    }
+    case Op::kIp:
+      return ip_matchers_[node.matcher].Matches(args);
+    case Op::kPort:
+      return ports_[node.matcher] == args.GetLocalPort();
+    case Op::kAuthenticated:
+      return authenticated_matchers_[node.matcher].Matches(args);
+  }
+  return false;
+}
+
+absl::optional<bool> RbacProgram::EvaluatePartially(
+    uint32_t index, const ConnectionState& state) const {
+  const Node& node = nodes_[index];
+  if (node.slot != kNoSlot) return state.slots_[node.slot];
+  switch (node.op) {
+    case Op::kAnd:
+    case Op::kOr: {
+      // A false child decides an And and a true child decides an Or.
+      const bool deciding_value = node.op == Op::kOr;
+      bool decided = true;
+      for (uint32_t child = index + 1; child < index + node.size;
+           child += nodes_[child].size) {
+        absl::optional<bool> value = EvaluatePartially(child, state);
+        if (!value.has_value()) {
+          decided = false;
+        } else if (*value == deciding_value) {
+          return deciding_value;
+        }
+      }
+      if (!decided) return absl::nullopt;
+      return !deciding_value;
+    }
+    case Op::kNot: {
+      absl::optional<bool> value = EvaluatePartially(index + 1, state);
+      if (!value.has_value()) return absl::nullopt;
+      return !*value;
+    }
+    default:
+      // Connection-level leaves have slots, so this depends on the call.
+      return absl::nullopt;
+  }
+}
+
+}  // namespace grpc_core
@@ -0,0 +1,149 @@
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GRPC_CORE_LIB_SECURITY_AUTHORIZATION_RBAC_PROGRAM_H
+#define GRPC_CORE_LIB_SECURITY_AUTHORIZATION_RBAC_PROGRAM_H
+
+#include <grpc/support/port_platform.h>
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "absl/types/optional.h"
+
+#include "src/core/lib/matchers/matchers.h"
+#include "src/core/lib/security/authorization/evaluate_args.h"
+#include "src/core/lib/security/authorization/matchers.h"
+#include "src/core/lib/security/authorization/rbac_policy.h"
+
+namespace grpc_core {
+
+// A set of RBAC policies compiled for evaluation.
+//
+// The permission and principal rules of every policy are flattened into a
+// single array of nodes in pre-order.  An And, Or or Not node is followed
+// by its children, and every node records the size of its subtree, so
+// short-circuiting skips a subtree in one step.  Rules whose value is
+// known up front (any, metadata, requested server name) are folded away.
+//
+// Rules that depend only on the connection (addresses, port and peer
+// identity) are evaluated once per connection by EvaluateConnection().
+// Its result holds the value of each such subtree, and also the policies
+// that can still match on that connection, so that FindMatchingPolicy()
+// skips the others and only evaluates per-call rules (headers and path)
+// for the rest.  Each header is looked up at most once per call, however
+// many rules refer to it.
+class RbacProgram {
+ public:
+  class ConnectionState : public EvaluateArgs::ConnectionCache::Entry {
+   private:
+    friend class RbacProgram;
+
+    struct Candidate {
+      uint32_t policy;
+      // Whether the policy matches every call on this connection.
+      bool always_matches;
+    };
+
+    // The value of each connection-level subtree, indexed by slot.
+    std::vector<bool> slots_;
+    // The policies that may match, in order.
+    std::vector<Candidate> candidates_;
+  };
+
+  explicit RbacProgram(std::map<std::string, Rbac::Policy> policies);
+
+  size_t num_policies() const { return policies_.size(); }
+
+  // Evaluates the connection-level rules for the connection in args.
+  std::unique_ptr<ConnectionState> EvaluateConnection(
+      const EvaluateArgs& args) const;
+
+  // Returns the name of the first policy that matches the call in args,
+  // or null if there is none.  state must come from EvaluateConnection()
+  // for the same connection.
+  const std::string* FindMatchingPolicy(const EvaluateArgs& args,
+                                        const ConnectionState& state) const;
+
+ private:
+  class Compiler;
+  class CallState;
+
+  enum class Op : uint8_t {
+    kAnd,
+    kOr,
+    kNot,
+    kHeader,
+    kPath,
+    kIp,
+    kPort,
+    kAuthenticated,
+  };
+
+  static constexpr uint32_t kNoSlot = UINT32_MAX;
+
+  struct Node {
+    Op op;
+    // Whether the subtree depends only on the connection.
+    bool connection_level;
+    // Number of nodes in the subtree, including this one.
+    uint32_t size;
+    // Index into the array of matchers for op.
+    uint32_t matcher;
+    // For kHeader, the index of the header name.
+    uint32_t header;
+    // For the roots of connection-level subtrees, the index of their value
+    // in ConnectionState::slots_.
+    uint32_t slot;
+  };
+
+  struct Policy {
+    std::string name;
+    // Set if the policy's value does not depend on the call or connection.
+    absl::optional<bool> constant;
+    uint32_t root;
+  };
+
+  // Evaluates the subtree at index, using the connection-level values in
+  // state if it is non-null.
+  bool Evaluate(uint32_t index, const EvaluateArgs& args,
+                const ConnectionState* state, CallState* call) const;
+  // Evaluates the subtree at index as far as the connection-level values
+  // in state allow; returns nullopt if it depends on the call.
+  absl::optional<bool> EvaluatePartially(uint32_t index,
+                                         const ConnectionState& state) const;
+  // Assigns slots to the connection-level subtrees under index.
+  void AssignSlots(uint32_t index);
+
+  std::vector<Node> nodes_;
+  std::vector<Policy> policies_;
+  std::vector<HeaderMatcher> header_matchers_;
+  // Header names, deduplicated.
+  std::vector<std::string> header_names_;
+  std::vector<StringMatcher> path_matchers_;
+  std::vector<IpAuthorizationMatcher> ip_matchers_;
+  std::vector<int> ports_;
+  std::vector<AuthenticatedAuthorizationMatcher> authenticated_matchers_;
+  // Number of connection-level subtrees.
+  uint32_t num_slots_ = 0;
+};
+
+}  // namespace grpc_core
+
+#endif  // GRPC_CORE_LIB_SECURITY_AUTHORIZATION_RBAC_PROGRAM_H
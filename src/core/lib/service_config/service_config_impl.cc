@@ -23,7 +23,10 @@
 #include <map>
 #include <string>
 #include <utility>
+#include <vector>
 
+#include "absl/base/thread_annotations.h"
+#include "absl/container/flat_hash_map.h"
 #include "absl/memory/memory.h"
 #include "absl/strings/str_cat.h"
 
@@ -31,6 +34,7 @@
 
 #include "src/core/lib/config/core_configuration.h"
 #include "src/core/lib/gprpp/memory.h"
+#include "src/core/lib/gprpp/sync.h"
 #include "src/core/lib/json/json.h"
 #include "src/core/lib/service_config/service_config_parser.h"
 #include "src/core/lib/slice/slice_internal.h"
@@ -38,14 +42,87 @@
 
 namespace grpc_core {
 
+namespace {
+
+struct ServiceConfigCacheKey {
+  absl::string_view json_string;
+  const InternedChannelArgs* args;
+
+  bool operator==(const ServiceConfigCacheKey& other) const {
+    return args == other.args && json_string == other.json_string;
+  }
+
+  template <typename H>
+  friend H AbslHashValue(H h, const ServiceConfigCacheKey& key) {
+    return H::combine(std::move(h), key.json_string, key.args);
+  }
+};
+
+// The service configs created by ServiceConfigImpl::Create() that are still
+// alive. Resolvers keep returning the same config, often to many channels
+// at once, so most updates are served from here without parsing. Entries do
+// not hold refs: a service config removes itself when it is destroyed.
+struct ServiceConfigCache {
+  Mutex mu;
+  absl::flat_hash_map<ServiceConfigCacheKey, ServiceConfigImpl*> map
+      ABSL_GUARDED_BY(mu);
+};
+
+ServiceConfigCache* GetServiceConfigCache() {
+  static ServiceConfigCache* cache = new ServiceConfigCache();
+  return cache;
+}
+
+}  // namespace
+
 RefCountedPtr<ServiceConfig> ServiceConfigImpl::Create(
     const grpc_channel_args* args, absl::string_view json_string,
     grpc_error_handle* error) {
   GPR_DEBUG_ASSERT(error != nullptr);
+  // Pointer args, such as the channelz node of the channel, identify the
+  // channel rather than configure it, and would keep any two channels from
+  // sharing a config.  Service configs are parsed without them.
+  std::vector<grpc_arg> config_args;
+  if (args != nullptr) {
+    for (size_t i = 0; i < args->num_args; ++i) {
+      if (args->args[i].type != GRPC_ARG_POINTER) {
+        config_args.push_back(args->args[i]);
+      }
+    }
+  }
+  grpc_channel_args config_channel_args = {config_args.size(),
+                                           config_args.data()};
+  RefCountedPtr<InternedChannelArgs> interned_args =
+      InternedChannelArgs::Intern(&config_channel_args);
+  ServiceConfigCache* cache = GetServiceConfigCache();
+  {
+    MutexLock lock(&cache->mu);
+    auto it = cache->map.find({json_string, interned_args.get()});
+    if (it != cache->map.end()) {
+      RefCountedPtr<ServiceConfig> existing = it->second->RefIfNonZero();
+      if (existing != nullptr) return existing;
+    }
+  }
   Json json = Json::Parse(json_string, error);
   if (*error != GRPC_ERROR_NONE) return nullptr;
-  return MakeRefCounted<ServiceConfigImpl>(args, std::string(json_string),
-                                           std::move(json), error);
+  auto service_config = MakeRefCounted<ServiceConfigImpl>(
+      interned_args->args(), std::string(json_string), std::move(json), error);
+  // Only valid service configs are shared.
+  if (*error != GRPC_ERROR_NONE) return service_config;
+  ServiceConfigCacheKey key = {service_config->json_string_,
+                               interned_args.get()};
+  service_config->cache_args_ = std::move(interned_args);
+  MutexLock lock(&cache->mu);
+  auto it = cache->map.find(key);
+  if (it != cache->map.end()) {
+    // Another thread got here first, and its copy wins if it is still alive.
+    // Otherwise it is being destroyed, and will not find itself in the map.
+    RefCountedPtr<ServiceConfig> existing = it->second->RefIfNonZero();
+    if (existing != nullptr) return existing;
+    cache->map.erase(it);
+  }
+  cache->map.emplace(key, service_config.get());
+  return service_config;
 }
 
 ServiceConfigImpl::ServiceConfigImpl(const grpc_channel_args* args,
@@ -73,6 +150,12 @@ ServiceConfigImpl::ServiceConfigImpl(const grpc_channel_args* args,
 }
 
 ServiceConfigImpl::~ServiceConfigImpl() {
+  if (cache_args_ != nullptr) {
+    ServiceConfigCache* cache = GetServiceConfigCache();
+    MutexLock lock(&cache->mu);
+    auto it = cache->map.find({json_string_, cache_args_.get()});
+    if (it != cache->map.end() && it->second == this) cache->map.erase(it);
+  }
   for (auto& p : parsed_method_configs_map_) {
     grpc_slice_unref_internal(p.first);
   }
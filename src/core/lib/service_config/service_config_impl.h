@@ -33,6 +33,7 @@
 #include <grpc/slice.h>
 #include <grpc/support/log.h>
 
+#include "src/core/lib/channel/channel_args.h"
 #include "src/core/lib/gprpp/ref_counted_ptr.h"
 #include "src/core/lib/iomgr/error.h"
 #include "src/core/lib/json/json.h"
@@ -70,6 +71,10 @@ class ServiceConfigImpl final : public ServiceConfig {
  public:
   /// Creates a new service config from parsing \a json_string.
   /// Returns null on parse error.
+  /// Service configs are shared: while one parsed from the same JSON with
+  /// the same channel args is still alive, it is returned instead.  Pointer
+  /// channel args are not passed to the parsers, so that configs are shared
+  /// across channels.
   static RefCountedPtr<ServiceConfig> Create(const grpc_channel_args* args,
                                              absl::string_view json_string,
                                              grpc_error_handle* error);
@@ -108,6 +113,9 @@ class ServiceConfigImpl final : public ServiceConfig {
 
   std::string json_string_;
   Json json_;
+  // The args this was parsed with, if it was created by Create() and can be
+  // found in the cache of live service configs.
+  RefCountedPtr<InternedChannelArgs> cache_args_;
 
   std::vector<std::unique_ptr<ServiceConfigParser::ParsedConfig>>
       parsed_global_configs_;
@@ -49,6 +49,8 @@
 #include <grpc/support/log.h>
 #include <grpc/support/string_util.h>
 
+#include "src/core/lib/channel/call_timeline.h"
+#include "src/core/lib/channel/call_tracer.h"
 #include "src/core/lib/channel/channel_stack.h"
 #include "src/core/lib/channel/channelz.h"
 #include "src/core/lib/channel/context.h"
@@ -318,6 +320,10 @@ class FilterStackCall final : public Call {
       : Call(arena, args.server_transport_data == nullptr, args.send_deadline),
         cq_(args.cq),
         channel_(args.channel->Ref()),
+        call_size_estimator_(args.call_size_estimator != nullptr
+                                 ? args.call_size_estimator
+                                 : args.channel->call_size_estimator()),
+        latency_histogram_(args.latency_histogram),
         stream_op_payload_(context_) {}
 
   static void ReleaseCall(void* call, grpc_error_handle);
@@ -349,6 +355,15 @@ class FilterStackCall final : public Call {
   grpc_completion_queue* cq_;
   grpc_polling_entity pollent_;
   RefCountedPtr<Channel> channel_;
+  // Owned by channel_ (either the channel itself or one of its registered
+  // calls), so it outlives this call.
+  CallSizeEstimator* call_size_estimator_;
+  // Owned by the channel's channelz node, if set.
+  LatencyHistogram* latency_histogram_;
+  // Set if the call is sampled by its channel's or server's channelz node,
+  // which owns timeline_stats_.
+  CallTimelineStats* timeline_stats_ = nullptr;
+  CallTimeline* call_timeline_ = nullptr;
   gpr_cycle_counter start_time_ = gpr_get_cycle_counter();
 
   /** has grpc_call_unref been called */
@@ -534,14 +549,18 @@ grpc_error_handle FilterStackCall::Create(grpc_call_create_args* args,
   FilterStackCall* call;
   grpc_error_handle error = GRPC_ERROR_NONE;
   grpc_channel_stack* channel_stack = channel->channel_stack();
-  size_t initial_size = channel->CallSizeEstimate();
+  CallSizeEstimator* call_size_estimator =
+      args->call_size_estimator != nullptr ? args->call_size_estimator
+                                           : channel->call_size_estimator();
+  size_t initial_size = call_size_estimator->CallSizeEstimate();
   GRPC_STATS_INC_CALL_INITIAL_SIZE(initial_size);
+  call_size_estimator->RecordInitialSize(initial_size);
   size_t call_alloc_size =
       GPR_ROUND_UP_TO_ALIGNMENT_SIZE(sizeof(FilterStackCall)) +
       channel_stack->call_stack_size;
 
-  std::pair<Arena*, void*> arena_with_call = Arena::CreateWithAlloc(
-      initial_size, call_alloc_size, channel->allocator());
+  std::pair<Arena*, void*> arena_with_call =
+      channel->arena_pool()->CreateWithAlloc(initial_size, call_alloc_size);
   arena = arena_with_call.first;
   call = new (arena_with_call.second) FilterStackCall(arena, *args);
   GPR_DEBUG_ASSERT(FromC(call->c_ptr()) == call);
@@ -554,6 +573,13 @@ grpc_error_handle FilterStackCall::Create(grpc_call_create_args* args,
     call->final_op_.client.error_string = nullptr;
     GRPC_STATS_INC_CLIENT_CALLS_CREATED();
     path = grpc_slice_ref_internal(args->path->c_slice());
+    channelz::ChannelNode* channelz_channel = channel->channelz_node();
+    if (call->latency_histogram_ == nullptr && channelz_channel != nullptr &&
+        channelz_channel->method_latency_stats() != nullptr) {
+      call->latency_histogram_ =
+          channelz_channel->method_latency_stats()->GetHistogram(
+              StringViewFromSlice(path));
+    }
     call->send_initial_metadata_.Set(HttpPathMetadata(),
                                      std::move(*args->path));
     if (args->authority.has_value()) {
@@ -565,6 +591,25 @@ grpc_error_handle FilterStackCall::Create(grpc_call_create_args* args,
     call->final_op_.server.cancelled = nullptr;
     call->final_op_.server.core_server = args->server;
   }
+  CallTimelineStats* timeline_stats = nullptr;
+  if (call->is_client()) {
+    channelz::ChannelNode* channelz_channel = channel->channelz_node();
+    if (channelz_channel != nullptr) {
+      timeline_stats = channelz_channel->call_timeline_stats();
+    }
+  } else if (args->server != nullptr &&
+             args->server->channelz_node() != nullptr) {
+    timeline_stats = args->server->channelz_node()->call_timeline_stats();
+  }
+  // Set before the call stack is initialized, so that filters see it.
+  if (timeline_stats != nullptr && timeline_stats->ShouldSample()) {
+    call->timeline_stats_ = timeline_stats;
+    call->call_timeline_ = arena->New<CallTimeline>(call->start_time_);
+    if (call->is_client()) {
+      call->call_timeline_->SetMethod(arena, StringViewFromSlice(path));
+    }
+    call->context_[GRPC_CONTEXT_CALL_TIMELINE].value = call->call_timeline_;
+  }
 
   Call* parent = Call::FromC(args->parent);
   if (parent != nullptr) {
@@ -638,9 +683,11 @@ void FilterStackCall::SetCompletionQueue(grpc_completion_queue* cq) {
 void FilterStackCall::ReleaseCall(void* call, grpc_error_handle /*error*/) {
   auto* c = static_cast<FilterStackCall*>(call);
   RefCountedPtr<Channel> channel = std::move(c->channel_);
+  CallSizeEstimator* call_size_estimator = c->call_size_estimator_;
   Arena* arena = c->arena();
   c->~FilterStackCall();
-  channel->UpdateCallSizeEstimate(arena->Destroy());
+  call_size_estimator->UpdateCallSizeEstimate(
+      channel->arena_pool()->Destroy(arena));
 }
 
 void FilterStackCall::DestroyCall(void* call, grpc_error_handle /*error*/) {
@@ -664,6 +711,18 @@ void FilterStackCall::DestroyCall(void* call, grpc_error_handle /*error*/) {
   c->status_error_.set(GRPC_ERROR_NONE);
   c->final_info_.stats.latency =
       gpr_cycle_counter_sub(gpr_get_cycle_counter(), c->start_time_);
+  if (c->latency_histogram_ != nullptr) {
+    c->latency_histogram_->Record(c->final_info_.stats.latency);
+  }
+  if (c->call_timeline_ != nullptr) {
+    c->call_timeline_->Mark(CallTimeline::Event::kCallEnd);
+    auto* call_tracer =
+        static_cast<CallTracer*>(c->context_[GRPC_CONTEXT_CALL_TRACER].value);
+    if (call_tracer != nullptr) {
+      call_tracer->RecordCallTimeline(*c->call_timeline_);
+    }
+    c->timeline_stats_->Record(*c->call_timeline_);
+  }
   grpc_call_stack_destroy(c->call_stack(), &c->final_info_,
                           GRPC_CLOSURE_INIT(&c->release_call_, ReleaseCall, c,
                                             grpc_schedule_on_exec_ctx));
@@ -1500,6 +1559,9 @@ grpc_call_error FilterStackCall::StartBatch(const grpc_op* ops, size_t nops,
         }
         stream_op->send_trailing_metadata = true;
         sent_final_op_ = true;
+        if (call_timeline_ != nullptr) {
+          call_timeline_->Mark(CallTimeline::Event::kServerSendStatus);
+        }
 
         if (!PrepareApplicationMetadata(
                 op->data.send_status_from_server.trailing_metadata_count,
@@ -33,6 +33,7 @@
 
 #include "src/core/lib/channel/channel_fwd.h"
 #include "src/core/lib/channel/context.h"
+#include "src/core/lib/debug/latency_histogram.h"
 #include "src/core/lib/debug/trace.h"
 #include "src/core/lib/gprpp/ref_counted_ptr.h"
 #include "src/core/lib/gprpp/time.h"
@@ -65,6 +66,14 @@ typedef struct grpc_call_create_args {
   absl::optional<grpc_core::Slice> authority;
 
   grpc_core::Timestamp send_deadline;
+
+  /* if not NULL, used in lieu of the channel's call size estimator to size the
+     call arena (set for calls to registered methods) */
+  grpc_core::CallSizeEstimator* call_size_estimator = nullptr;
+
+  /* if not NULL, the histogram to record the call's latency in, so that it
+     need not be looked up by path (set for calls to registered methods) */
+  grpc_core::LatencyHistogram* latency_histogram = nullptr;
 } grpc_call_create_args;
 
 /* Create a new call based on \a args.
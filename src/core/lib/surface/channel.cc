@@ -21,12 +21,14 @@
 #include "src/core/lib/surface/channel.h"
 
 #include <inttypes.h>
+#include <limits.h>
 #include <string.h>
 
 #include <algorithm>
 #include <atomic>
 #include <functional>
 #include <memory>
+#include <tuple>
 
 #include "absl/status/status.h"
 
@@ -67,12 +69,16 @@ Channel::Channel(bool is_client, std::string target, ChannelArgs channel_args,
                  RefCountedPtr<grpc_channel_stack> channel_stack)
     : is_client_(is_client),
       compression_options_(compression_options),
-      call_size_estimate_(channel_stack->call_stack_size +
-                          grpc_call_get_initial_size_estimate()),
+      call_size_estimator_(channel_stack->call_stack_size +
+                           grpc_call_get_initial_size_estimate()),
       channelz_node_(channel_args.GetObjectRef<channelz::ChannelNode>()),
       allocator_(channel_args.GetObject<ResourceQuota>()
                      ->memory_quota()
                      ->CreateMemoryOwner(target)),
+      arena_pool_(
+          std::max(0, channel_args.GetInt(GRPC_ARG_CALL_ARENA_POOL_SIZE)
+                          .value_or(16)),
+          &allocator_),
       target_(std::move(target)),
       channel_stack_(std::move(channel_stack)) {
   // We need to make sure that grpc_shutdown() does not shut things down
@@ -101,6 +107,16 @@ Channel::Channel(bool is_client, std::string target, ChannelArgs channel_args,
     }
     grpc_shutdown();
   };
+  if (channelz_node_ != nullptr) {
+    channelz_node_->SetCallInitialSizeSource(
+        [this]() { return RegisteredCallInitialSizeHistograms(); });
+  }
+}
+
+Channel::~Channel() {
+  if (channelz_node_ != nullptr) {
+    channelz_node_->SetCallInitialSizeSource(nullptr);
+  }
 }
 
 absl::StatusOr<RefCountedPtr<Channel>> Channel::CreateWithBuilder(
@@ -180,11 +196,17 @@ void CreateChannelzNode(ChannelStackBuilder* builder) {
              .value_or(GRPC_MAX_CHANNEL_TRACE_EVENT_MEMORY_PER_NODE_DEFAULT));
   const bool is_internal_channel =
       args.GetBool(GRPC_ARG_CHANNELZ_IS_INTERNAL_CHANNEL).value_or(false);
+  const bool method_latency_stats =
+      args.GetBool(GRPC_ARG_CHANNELZ_METHOD_LATENCY_STATS).value_or(false);
+  const uint32_t call_timeline_sample_period = std::max(
+      0,
+      args.GetInt(GRPC_ARG_CHANNELZ_CALL_TIMELINE_SAMPLE_PERIOD).value_or(0));
   // Create the channelz node.
   std::string target(builder->target());
   RefCountedPtr<channelz::ChannelNode> channelz_node =
       MakeRefCounted<channelz::ChannelNode>(
-          target.c_str(), channel_tracer_max_memory, is_internal_channel);
+          target.c_str(), channel_tracer_max_memory, is_internal_channel,
+          method_latency_stats, call_timeline_sample_period);
   channelz_node->AddTraceEvent(
       channelz::ChannelTrace::Severity::Info,
       grpc_slice_from_static_string("Channel created"));
@@ -233,7 +255,7 @@ absl::StatusOr<RefCountedPtr<Channel>> Channel::Create(
   return CreateWithBuilder(&builder);
 }
 
-void Channel::UpdateCallSizeEstimate(size_t size) {
+void CallSizeEstimator::UpdateCallSizeEstimate(size_t size) {
   size_t cur = call_size_estimate_.load(std::memory_order_relaxed);
   if (cur < size) {
     // size grew: update estimate
@@ -251,6 +273,28 @@ void Channel::UpdateCallSizeEstimate(size_t size) {
   }
 }
 
+void CallSizeEstimator::RecordInitialSize(size_t size) {
+#if defined(GRPC_COLLECT_STATS) || !defined(NDEBUG)
+  int bucket = grpc_stats_histo_find_bucket_slow(
+      static_cast<int>(std::min<size_t>(size, INT_MAX)),
+      grpc_stats_histo_bucket_boundaries
+          [GRPC_STATS_HISTOGRAM_CALL_INITIAL_SIZE],
+      GRPC_STATS_HISTOGRAM_CALL_INITIAL_SIZE_BUCKETS);
+  initial_size_histogram_[bucket].fetch_add(1, std::memory_order_relaxed);
+#else
+  (void)size;
+#endif
+}
+
+std::vector<uint64_t> CallSizeEstimator::InitialSizeHistogram() const {
+  std::vector<uint64_t> histogram;
+  histogram.reserve(GRPC_STATS_HISTOGRAM_CALL_INITIAL_SIZE_BUCKETS);
+  for (const auto& bucket : initial_size_histogram_) {
+    histogram.push_back(bucket.load(std::memory_order_relaxed));
+  }
+  return histogram;
+}
+
 }  // namespace grpc_core
 
 char* grpc_channel_get_target(grpc_channel* channel) {
@@ -286,7 +330,9 @@ static grpc_call* grpc_channel_create_call_internal(
     grpc_channel* c_channel, grpc_call* parent_call, uint32_t propagation_mask,
     grpc_completion_queue* cq, grpc_pollset_set* pollset_set_alternative,
     grpc_core::Slice path, absl::optional<grpc_core::Slice> authority,
-    grpc_core::Timestamp deadline) {
+    grpc_core::Timestamp deadline,
+    grpc_core::CallSizeEstimator* call_size_estimator,
+    grpc_core::LatencyHistogram* latency_histogram) {
   auto channel = grpc_core::Channel::FromC(c_channel)->Ref();
   GPR_ASSERT(channel->is_client());
   GPR_ASSERT(!(cq != nullptr && pollset_set_alternative != nullptr));
@@ -302,6 +348,8 @@ static grpc_call* grpc_channel_create_call_internal(
   args.path = std::move(path);
   args.authority = std::move(authority);
   args.send_deadline = deadline;
+  args.call_size_estimator = call_size_estimator;
+  args.latency_histogram = latency_histogram;
 
   grpc_call* call;
   GRPC_LOG_IF_ERROR("call_create", grpc_call_create(&args, &call));
@@ -323,7 +371,7 @@ grpc_call* grpc_channel_create_call(grpc_channel* channel,
       host != nullptr
           ? absl::optional<grpc_core::Slice>(grpc_slice_ref_internal(*host))
           : absl::nullopt,
-      grpc_core::Timestamp::FromTimespecRoundUp(deadline));
+      grpc_core::Timestamp::FromTimespecRoundUp(deadline), nullptr, nullptr);
 
   return call;
 }
@@ -339,25 +387,20 @@ grpc_call* grpc_channel_create_pollset_set_call(
       host != nullptr
           ? absl::optional<grpc_core::Slice>(grpc_slice_ref_internal(*host))
           : absl::nullopt,
-      deadline);
+      deadline, nullptr, nullptr);
 }
 
 namespace grpc_core {
 
-RegisteredCall::RegisteredCall(const char* method_arg, const char* host_arg) {
+RegisteredCall::RegisteredCall(const char* method_arg, const char* host_arg,
+                               size_t initial_size_estimate)
+    : call_size_estimator(initial_size_estimate) {
   path = Slice::FromCopiedString(method_arg);
   if (host_arg != nullptr && host_arg[0] != 0) {
     authority = Slice::FromCopiedString(host_arg);
   }
 }
 
-RegisteredCall::RegisteredCall(const RegisteredCall& other)
-    : path(other.path.Ref()) {
-  if (other.authority.has_value()) {
-    authority = other.authority->Ref();
-  }
-}
-
 RegisteredCall::~RegisteredCall() {}
 
 }  // namespace grpc_core
@@ -384,9 +427,30 @@ RegisteredCall* Channel::RegisterCall(const char* method, const char* host) {
   if (rc_posn != registration_table_.map.end()) {
     return &rc_posn->second;
   }
-  auto insertion_result = registration_table_.map.insert(
-      {std::move(key), RegisteredCall(method, host)});
-  return &insertion_result.first->second;
+  auto insertion_result = registration_table_.map.emplace(
+      std::piecewise_construct, std::forward_as_tuple(std::move(key)),
+      std::forward_as_tuple(method, host,
+                            channel_stack_->call_stack_size +
+                                grpc_call_get_initial_size_estimate()));
+  RegisteredCall* rc = &insertion_result.first->second;
+  if (channelz_node_ != nullptr &&
+      channelz_node_->method_latency_stats() != nullptr) {
+    rc->latency_histogram =
+        channelz_node_->method_latency_stats()->GetHistogram(
+            rc->path.as_string_view());
+  }
+  return rc;
+}
+
+std::map<std::pair<std::string, std::string>, std::vector<uint64_t>>
+Channel::RegisteredCallInitialSizeHistograms() {
+  std::map<std::pair<std::string, std::string>, std::vector<uint64_t>> result;
+  MutexLock lock(&registration_table_.mu);
+  for (const auto& p : registration_table_.map) {
+    result.emplace(p.first,
+                   p.second.call_size_estimator.InitialSizeHistogram());
+  }
+  return result;
 }
 
 }  // namespace grpc_core
@@ -417,7 +481,8 @@ grpc_call* grpc_channel_create_registered_call(
       rc->authority.has_value()
           ? absl::optional<grpc_core::Slice>(rc->authority->Ref())
           : absl::nullopt,
-      grpc_core::Timestamp::FromTimespecRoundUp(deadline));
+      grpc_core::Timestamp::FromTimespecRoundUp(deadline),
+      &rc->call_size_estimator, rc->latency_histogram);
 
   return call;
 }
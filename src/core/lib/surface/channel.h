@@ -28,6 +28,7 @@
 #include <map>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "absl/base/thread_annotations.h"
 #include "absl/status/statusor.h"
@@ -44,6 +45,8 @@
 #include "src/core/lib/channel/channel_stack.h"  // IWYU pragma: keep
 #include "src/core/lib/channel/channel_stack_builder.h"
 #include "src/core/lib/channel/channelz.h"
+#include "src/core/lib/debug/latency_histogram.h"
+#include "src/core/lib/debug/stats_data.h"
 #include "src/core/lib/gprpp/cpp_impl_of.h"
 #include "src/core/lib/gprpp/debug_location.h"
 #include "src/core/lib/gprpp/ref_counted.h"
@@ -51,11 +54,16 @@
 #include "src/core/lib/gprpp/sync.h"
 #include "src/core/lib/gprpp/time.h"
 #include "src/core/lib/iomgr/iomgr_fwd.h"
+#include "src/core/lib/resource_quota/arena.h"
 #include "src/core/lib/resource_quota/memory_quota.h"
 #include "src/core/lib/slice/slice.h"
 #include "src/core/lib/surface/channel_stack_type.h"
 #include "src/core/lib/transport/transport_fwd.h"
 
+/// Maximum number of reset call arenas a channel keeps around for reuse by
+/// future calls. Defaults to 16; 0 disables arena pooling.
+#define GRPC_ARG_CALL_ARENA_POOL_SIZE "grpc.experimental.call_arena_pool_size"
+
 /** The same as grpc_channel_destroy, but doesn't create an ExecCtx, and so
  * is safe to use from within core. */
 void grpc_channel_destroy_internal(grpc_channel* channel);
@@ -84,12 +92,62 @@ void grpc_channel_update_call_size_estimate(grpc_channel* channel, size_t size);
 
 namespace grpc_core {
 
+// Tracks the arena size needed by calls as a decaying high-water mark: the
+// estimate grows immediately when a call needs more memory than predicted, and
+// shrinks slowly as calls turn out to need less. Calls created with the
+// estimate as their initial arena size rarely need to grow the arena.
+class CallSizeEstimator {
+ public:
+  explicit CallSizeEstimator(size_t initial_estimate)
+      : call_size_estimate_(initial_estimate) {}
+
+  CallSizeEstimator(const CallSizeEstimator&) = delete;
+  CallSizeEstimator& operator=(const CallSizeEstimator&) = delete;
+
+  size_t CallSizeEstimate() const {
+    // We round up our current estimate to the NEXT value of kRoundUpSize.
+    // This ensures:
+    //  1. a consistent size allocation when our estimate is drifting slowly
+    //     (which is common) - which tends to help most allocators reuse memory
+    //  2. a small amount of allowed growth over the estimate without hitting
+    //     the arena size doubling case, reducing overall memory usage
+    static constexpr size_t kRoundUpSize = 256;
+    return (call_size_estimate_.load(std::memory_order_relaxed) +
+            2 * kRoundUpSize) &
+           ~(kRoundUpSize - 1);
+  }
+
+  void UpdateCallSizeEstimate(size_t size);
+
+  // Records the initial arena size chosen for a call sized by this estimator.
+  // Like the global call_initial_size histogram, this is only collected in
+  // builds with stats enabled.
+  void RecordInitialSize(size_t size);
+
+  // Returns the call_initial_size histogram for calls sized by this
+  // estimator, with the same buckets as the global histogram.
+  std::vector<uint64_t> InitialSizeHistogram() const;
+
+ private:
+  std::atomic<size_t> call_size_estimate_;
+  std::atomic<uint64_t>
+      initial_size_histogram_[GRPC_STATS_HISTOGRAM_CALL_INITIAL_SIZE_BUCKETS] =
+          {};
+};
+
 struct RegisteredCall {
   Slice path;
   absl::optional<Slice> authority;
-
-  explicit RegisteredCall(const char* method_arg, const char* host_arg);
-  RegisteredCall(const RegisteredCall& other);
+  // Calls to the same method tend to need similar amounts of memory, so each
+  // registered method keeps its own estimate rather than sharing the
+  // channel-wide one.
+  CallSizeEstimator call_size_estimator;
+  // The method's latency histogram, if the channel records them.
+  LatencyHistogram* latency_histogram = nullptr;
+
+  RegisteredCall(const char* method_arg, const char* host_arg,
+                 size_t initial_size_estimate);
+  RegisteredCall(const RegisteredCall&) = delete;
   RegisteredCall& operator=(const RegisteredCall&) = delete;
 
   ~RegisteredCall();
@@ -116,6 +174,8 @@ class Channel : public RefCounted<Channel>,
   static absl::StatusOr<RefCountedPtr<Channel>> CreateWithBuilder(
       ChannelStackBuilder* builder);
 
+  ~Channel() override;
+
   grpc_channel_stack* channel_stack() const { return channel_stack_.get(); }
 
   grpc_compression_options compression_options() const {
@@ -124,22 +184,17 @@ class Channel : public RefCounted<Channel>,
 
   channelz::ChannelNode* channelz_node() const { return channelz_node_.get(); }
 
-  size_t CallSizeEstimate() {
-    // We round up our current estimate to the NEXT value of kRoundUpSize.
-    // This ensures:
-    //  1. a consistent size allocation when our estimate is drifting slowly
-    //     (which is common) - which tends to help most allocators reuse memory
-    //  2. a small amount of allowed growth over the estimate without hitting
-    //     the arena size doubling case, reducing overall memory usage
-    static constexpr size_t kRoundUpSize = 256;
-    return (call_size_estimate_.load(std::memory_order_relaxed) +
-            2 * kRoundUpSize) &
-           ~(kRoundUpSize - 1);
+  // Estimator used to size calls that were not created via a registered
+  // method.
+  CallSizeEstimator* call_size_estimator() { return &call_size_estimator_; }
+  size_t CallSizeEstimate() { return call_size_estimator_.CallSizeEstimate(); }
+  void UpdateCallSizeEstimate(size_t size) {
+    call_size_estimator_.UpdateCallSizeEstimate(size);
   }
 
-  void UpdateCallSizeEstimate(size_t size);
   absl::string_view target() const { return target_; }
   MemoryAllocator* allocator() { return &allocator_; }
+  ArenaPool* arena_pool() { return &arena_pool_; }
   bool is_client() const { return is_client_; }
   RegisteredCall* RegisterCall(const char* method, const char* host);
 
@@ -153,6 +208,12 @@ class Channel : public RefCounted<Channel>,
     return registration_table_.method_registration_attempts;
   }
 
+  // Returns the call_initial_size histogram of each registered method, keyed
+  // by (host, method).  These are also rendered in the channelz node's
+  // per-method JSON.
+  std::map<std::pair<std::string, std::string>, std::vector<uint64_t>>
+  RegisteredCallInitialSizeHistograms();
+
  private:
   Channel(bool is_client, std::string target, ChannelArgs channel_args,
           grpc_compression_options compression_options,
@@ -160,10 +221,12 @@ class Channel : public RefCounted<Channel>,
 
   const bool is_client_;
   const grpc_compression_options compression_options_;
-  std::atomic<size_t> call_size_estimate_;
+  CallSizeEstimator call_size_estimator_;
   CallRegistrationTable registration_table_;
   RefCountedPtr<channelz::ChannelNode> channelz_node_;
-  MemoryAllocator allocator_;
+  MemoryOwner allocator_;
+  // Must be destroyed before allocator_, which pooled arenas are charged to.
+  ArenaPool arena_pool_;
   std::string target_;
   const RefCountedPtr<grpc_channel_stack> channel_stack_;
 };
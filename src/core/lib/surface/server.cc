@@ -30,6 +30,7 @@
 #include <utility>
 #include <vector>
 
+#include "absl/base/attributes.h"
 #include "absl/memory/memory.h"
 #include "absl/status/status.h"
 #include "absl/types/optional.h"
@@ -40,6 +41,7 @@
 #include <grpc/support/log.h>
 #include <grpc/support/time.h>
 
+#include "src/core/lib/channel/call_timeline.h"
 #include "src/core/lib/channel/channel_args.h"
 #include "src/core/lib/channel/channel_args_preconditioning.h"
 #include "src/core/lib/channel/channel_trace.h"
@@ -51,6 +53,7 @@
 #include "src/core/lib/gprpp/mpscq.h"
 #include "src/core/lib/iomgr/exec_ctx.h"
 #include "src/core/lib/iomgr/pollset_set.h"
+#include "src/core/lib/profiling/contention_profiler.h"
 #include "src/core/lib/slice/slice_internal.h"
 #include "src/core/lib/slice/slice_refcount.h"
 #include "src/core/lib/surface/api_trace.h"
@@ -65,6 +68,13 @@ namespace grpc_core {
 
 TraceFlag grpc_server_channel_trace(false, "server_channel");
 
+namespace {
+
+// Contention on the call mutexes of all servers.
+ABSL_CONST_INIT ContentionSite g_mu_call_contention("Server::mu_call_");
+
+}  // namespace
+
 //
 // Server::RequestedCall
 //
@@ -244,7 +254,8 @@ class Server::RealRequestMatcher : public RequestMatcherInterface {
       auto pop_next_pending = [this, request_queue_index] {
         PendingCall pending_call;
         {
-          MutexLock lock(&server_->mu_call_);
+          ProfiledMutexLock lock(&server_->mu_call_, &g_mu_call_contention,
+                                 DEBUG_LOCATION);
           if (!pending_.empty()) {
             pending_call.rc = reinterpret_cast<RequestedCall*>(
                 requests_per_cq_[request_queue_index].Pop());
@@ -292,7 +303,8 @@ class Server::RealRequestMatcher : public RequestMatcherInterface {
     size_t cq_idx = 0;
     size_t loop_count;
     {
-      MutexLock lock(&server_->mu_call_);
+      ProfiledMutexLock lock(&server_->mu_call_, &g_mu_call_contention,
+                             DEBUG_LOCATION);
       for (loop_count = 0; loop_count < requests_per_cq_.size(); loop_count++) {
         cq_idx =
             (start_request_queue_index + loop_count) % requests_per_cq_.size();
@@ -527,8 +539,11 @@ RefCountedPtr<channelz::ServerNode> CreateChannelzNode(ChannelArgs args) {
     size_t channel_tracer_max_memory = std::max(
         0, args.GetInt(GRPC_ARG_MAX_CHANNEL_TRACE_EVENT_MEMORY_PER_NODE)
                .value_or(GRPC_MAX_CHANNEL_TRACE_EVENT_MEMORY_PER_NODE_DEFAULT));
-    channelz_node =
-        MakeRefCounted<channelz::ServerNode>(channel_tracer_max_memory);
+    const uint32_t call_timeline_sample_period = std::max(
+        0,
+        args.GetInt(GRPC_ARG_CHANNELZ_CALL_TIMELINE_SAMPLE_PERIOD).value_or(0));
+    channelz_node = MakeRefCounted<channelz::ServerNode>(
+        channel_tracer_max_memory, call_timeline_sample_period);
     channelz_node->AddTraceEvent(
         channelz::ChannelTrace::Severity::Info,
         grpc_slice_from_static_string("Server created"));
@@ -700,7 +715,16 @@ Server::RegisteredMethod* Server::RegisterMethod(
 }
 
 void Server::DoneRequestEvent(void* req, grpc_cq_completion* /*c*/) {
-  delete static_cast<RequestedCall*>(req);
+  auto* rc = static_cast<RequestedCall*>(req);
+  // The application has just taken the new call from its completion queue.
+  if (*rc->call != nullptr) {
+    auto* timeline = static_cast<CallTimeline*>(
+        grpc_call_context_get(*rc->call, GRPC_CONTEXT_CALL_TIMELINE));
+    if (timeline != nullptr) {
+      timeline->Mark(CallTimeline::Event::kServerHandlerStart);
+    }
+  }
+  delete rc;
 }
 
 void Server::FailCall(size_t cq_idx, RequestedCall* rc,
@@ -719,7 +743,7 @@ void Server::MaybeFinishShutdown() {
     return;
   }
   {
-    MutexLock lock(&mu_call_);
+    ProfiledMutexLock lock(&mu_call_, &g_mu_call_contention, DEBUG_LOCATION);
     KillPendingWorkLocked(
         GRPC_ERROR_CREATE_FROM_STATIC_STRING("Server Shutdown"));
   }
@@ -818,7 +842,8 @@ void Server::ShutdownAndNotify(grpc_completion_queue* cq, void* tag) {
     broadcaster.FillChannelsLocked(GetChannelsLocked());
     // Collect all unregistered then registered calls.
     {
-      MutexLock lock(&mu_call_);
+      ProfiledMutexLock lock(&mu_call_, &g_mu_call_contention,
+                             DEBUG_LOCATION);
       KillPendingWorkLocked(
           GRPC_ERROR_CREATE_FROM_STATIC_STRING("Server Shutdown"));
     }
@@ -1239,6 +1264,14 @@ void Server::CallData::Start(grpc_call_element* elem) {
 void Server::CallData::Publish(size_t cq_idx, RequestedCall* rc) {
   grpc_call_set_completion_queue(call_, rc->cq_bound_to_call);
   *rc->call = call_;
+  auto* timeline = static_cast<CallTimeline*>(
+      grpc_call_context_get(call_, GRPC_CONTEXT_CALL_TIMELINE));
+  if (timeline != nullptr) {
+    timeline->Mark(CallTimeline::Event::kServerRequestMatched);
+    if (path_.has_value()) {
+      timeline->SetMethod(grpc_call_get_arena(call_), path_->as_string_view());
+    }
+  }
   cq_new_ = server_->cqs_[cq_idx];
   std::swap(*rc->initial_metadata, initial_metadata_);
   switch (rc->type) {
@@ -31,16 +31,54 @@ grpc_core::TraceFlag grpc_bdp_estimator_trace(false, "bdp_estimator");
 
 namespace grpc_core {
 
+namespace {
+// The estimate never drops below its initial value.
+constexpr int64_t kMinEstimate = 65536;
+// Bandwidth must grow by this factor per ping to stay in startup...
+constexpr double kStartupGrowthTarget = 1.25;
+// ... for this many pings in a row.
+constexpr int kStartupFullBandwidthCount = 3;
+// How long a minimum round trip time sample stays valid.
+constexpr int kMinRttWindowSeconds = 10;
+}  // namespace
+
 BdpEstimator::BdpEstimator(const char* name)
     : ping_state_(PingState::UNSCHEDULED),
       accumulator_(0),
-      estimate_(65536),
+      estimate_(kMinEstimate),
       ping_start_time_(gpr_time_0(GPR_CLOCK_MONOTONIC)),
       inter_ping_delay_(Duration::Milliseconds(100)),  // start at 100ms
       stable_estimate_count_(0),
       bw_est_(0),
+      min_rtt_stamp_(gpr_time_0(GPR_CLOCK_MONOTONIC)),
       name_(name) {}
 
+void BdpEstimator::UpdateModel(double bw, double rtt, gpr_timespec now) {
+  bw_samples_[next_bw_sample_] = bw;
+  next_bw_sample_ = (next_bw_sample_ + 1) % kBandwidthFilterLength;
+  max_bw_ =
+      *std::max_element(bw_samples_, bw_samples_ + kBandwidthFilterLength);
+  if (min_rtt_ == 0 || rtt <= min_rtt_ ||
+      gpr_time_cmp(gpr_time_sub(now, min_rtt_stamp_),
+                   gpr_time_from_seconds(kMinRttWindowSeconds,
+                                         GPR_TIMESPAN)) > 0) {
+    min_rtt_ = rtt;
+    min_rtt_stamp_ = now;
+  }
+  if (!in_startup_) return;
+  if (max_bw_ >= full_bw_ * kStartupGrowthTarget) {
+    full_bw_ = max_bw_;
+    full_bw_count_ = 0;
+  } else if (++full_bw_count_ >= kStartupFullBandwidthCount) {
+    in_startup_ = false;
+    if (GRPC_TRACE_FLAG_ENABLED(grpc_bdp_estimator_trace)) {
+      gpr_log(GPR_INFO,
+              "bdp[%s]:startup done max_bw=%lfMbs min_rtt=%lfms", name_,
+              max_bw_ / 125000.0, min_rtt_ * 1000.0);
+    }
+  }
+}
+
 Timestamp BdpEstimator::CompletePing() {
   gpr_timespec now = gpr_now(GPR_CLOCK_MONOTONIC);
   gpr_timespec dt_ts = gpr_time_sub(now, ping_start_time_);
@@ -56,13 +94,32 @@ Timestamp BdpEstimator::CompletePing() {
             bw_est_ / 125000.0);
   }
   GPR_ASSERT(ping_state_ == PingState::STARTED);
-  if (accumulator_ > 2 * estimate_ / 3 && bw > bw_est_) {
+  if (dt > 0) UpdateModel(bw, dt, now);
+  bool estimate_increased = false;
+  if (!in_startup_) {
+    // Past startup, follow the model. Flow control windows are sized at
+    // twice the estimate, which leaves room for the bandwidth samples (and so
+    // the estimate) to grow should the link get faster.
+    const int64_t model_estimate = std::max(
+        kMinEstimate, static_cast<int64_t>(max_bw_ * min_rtt_));
+    estimate_increased = model_estimate > estimate_ * kStartupGrowthTarget;
+    if (model_estimate != estimate_ &&
+        GRPC_TRACE_FLAG_ENABLED(grpc_bdp_estimator_trace)) {
+      gpr_log(GPR_INFO, "bdp[%s]: estimate updated to %" PRId64, name_,
+              model_estimate);
+    }
+    estimate_ = model_estimate;
+    bw_est_ = max_bw_;
+  } else if (accumulator_ > 2 * estimate_ / 3 && bw > bw_est_) {
     estimate_ = std::max(accumulator_, estimate_ * 2);
     bw_est_ = bw;
+    estimate_increased = true;
     if (GRPC_TRACE_FLAG_ENABLED(grpc_bdp_estimator_trace)) {
       gpr_log(GPR_INFO, "bdp[%s]: estimate increased to %" PRId64, name_,
               estimate_);
     }
+  }
+  if (estimate_increased) {
     inter_ping_delay_ /= 2;  // if the ping estimate changes,
                              // exponentially get faster at probing
   } else if (inter_ping_delay_ < Duration::Seconds(10)) {
@@ -41,6 +41,12 @@ class BdpEstimator {
 
   int64_t EstimateBdp() const { return estimate_; }
   double EstimateBandwidth() const { return bw_est_; }
+  // Minimum recently observed ping round trip time, in seconds (or zero if
+  // none has been observed yet).
+  double EstimateMinRtt() const { return min_rtt_; }
+  // True while the estimator is still searching for the available bandwidth,
+  // during which the estimate grows exponentially.
+  bool in_startup() const { return in_startup_; }
 
   void AddIncomingBytes(int64_t num_bytes) { accumulator_ += num_bytes; }
 
@@ -78,6 +84,13 @@ class BdpEstimator {
  private:
   enum class PingState { UNSCHEDULED, SCHEDULED, STARTED };
 
+  // Number of ping rounds over which the maximum bandwidth is taken.
+  static constexpr int kBandwidthFilterLength = 10;
+
+  // Feed a bandwidth (bytes/second) and round trip time (seconds) sample
+  // into the model.
+  void UpdateModel(double bw, double rtt, gpr_timespec now);
+
   PingState ping_state_;
   int64_t accumulator_;
   int64_t estimate_;
@@ -86,6 +99,20 @@ class BdpEstimator {
   Duration inter_ping_delay_;
   int stable_estimate_count_;
   double bw_est_;
+  // The link model, after BBR: bottleneck bandwidth is estimated as the
+  // maximum bandwidth of the last kBandwidthFilterLength pings, and the round
+  // trip time as the minimum ping time seen in the last few seconds. Their
+  // product is the BDP.
+  double bw_samples_[kBandwidthFilterLength] = {};
+  int next_bw_sample_ = 0;
+  double max_bw_ = 0;
+  double min_rtt_ = 0;
+  gpr_timespec min_rtt_stamp_;
+  // Startup ends once the maximum bandwidth has failed to grow by a
+  // meaningful amount for a few pings.
+  bool in_startup_ = true;
+  double full_bw_ = 0;
+  int full_bw_count_ = 0;
   const char* name_;
 };
 
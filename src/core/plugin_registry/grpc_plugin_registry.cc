@@ -46,8 +46,14 @@ void grpc_lb_policy_round_robin_shutdown(void);
 void grpc_resolver_dns_ares_init(void);
 void grpc_resolver_dns_ares_shutdown(void);
 namespace grpc_core {
+void GrpcLbPolicyDeterministicSubsettingInit(void);
+void GrpcLbPolicyDeterministicSubsettingShutdown(void);
+void GrpcLbPolicyLeastRequestInit(void);
+void GrpcLbPolicyLeastRequestShutdown(void);
 void GrpcLbPolicyRingHashInit(void);
 void GrpcLbPolicyRingHashShutdown(void);
+void GrpcLbPolicyWeightedRoundRobinInit(void);
+void GrpcLbPolicyWeightedRoundRobinShutdown(void);
 #ifndef GRPC_NO_RLS
 void RlsLbPluginInit();
 void RlsLbPluginShutdown();
@@ -72,8 +78,14 @@ void grpc_register_built_in_plugins(void) {
                        grpc_lb_policy_pick_first_shutdown);
   grpc_register_plugin(grpc_lb_policy_round_robin_init,
                        grpc_lb_policy_round_robin_shutdown);
+  grpc_register_plugin(grpc_core::GrpcLbPolicyDeterministicSubsettingInit,
+                       grpc_core::GrpcLbPolicyDeterministicSubsettingShutdown);
+  grpc_register_plugin(grpc_core::GrpcLbPolicyLeastRequestInit,
+                       grpc_core::GrpcLbPolicyLeastRequestShutdown);
   grpc_register_plugin(grpc_core::GrpcLbPolicyRingHashInit,
                        grpc_core::GrpcLbPolicyRingHashShutdown);
+  grpc_register_plugin(grpc_core::GrpcLbPolicyWeightedRoundRobinInit,
+                       grpc_core::GrpcLbPolicyWeightedRoundRobinShutdown);
   grpc_register_plugin(grpc_resolver_dns_ares_init,
                        grpc_resolver_dns_ares_shutdown);
   grpc_register_extra_plugins();
@@ -102,6 +114,7 @@ extern void RegisterNativeDnsResolver(CoreConfiguration::Builder* builder);
 extern void RegisterAresDnsResolver(CoreConfiguration::Builder* builder);
 extern void RegisterSockaddrResolver(CoreConfiguration::Builder* builder);
 extern void RegisterFakeResolver(CoreConfiguration::Builder* builder);
+extern void RegisterFusedFilters(CoreConfiguration::Builder* builder);
 #ifdef GPR_SUPPORT_BINDER_TRANSPORT
 extern void RegisterBinderResolver(CoreConfiguration::Builder* builder);
 #endif
@@ -135,6 +148,8 @@ void BuildCoreConfiguration(CoreConfiguration::Builder* builder) {
   RegisterSecurityFilters(builder);
   RegisterExtraFilters(builder);
   RegisterBuiltins(builder);
+  // Rewrites the stacks built by everything above, so must come last.
+  RegisterFusedFilters(builder);
 }
 
 }  // namespace grpc_core
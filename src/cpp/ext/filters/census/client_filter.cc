@@ -29,7 +29,6 @@
 #include <vector>
 
 #include "absl/status/status.h"
-#include "absl/strings/str_cat.h"
 #include "absl/strings/string_view.h"
 #include "absl/time/clock.h"
 #include "absl/time/time.h"
@@ -96,10 +95,11 @@ void CensusClientCallData::StartTransportStreamOpBatch(
 namespace {
 
 CensusContext CreateCensusContextForCallAttempt(
-    absl::string_view method, const CensusContext& parent_context) {
+    grpc_core::Arena* arena, absl::string_view method,
+    const CensusContext& parent_context) {
   GPR_DEBUG_ASSERT(parent_context.Context().IsValid());
-  return CensusContext(absl::StrCat("Attempt.", method), &parent_context.Span(),
-                       parent_context.tags());
+  return CensusContext(ArenaSpanName(arena, "Attempt.", method),
+                       &parent_context.Span(), parent_context.tags());
 }
 
 }  // namespace
@@ -109,8 +109,8 @@ OpenCensusCallTracer::OpenCensusCallAttemptTracer::OpenCensusCallAttemptTracer(
     bool is_transparent_retry, bool arena_allocated)
     : parent_(parent),
       arena_allocated_(arena_allocated),
-      context_(CreateCensusContextForCallAttempt(parent_->method_,
-                                                 parent_->context_)),
+      context_(CreateCensusContextForCallAttempt(
+          parent_->arena_, parent_->method_, parent_->context_)),
       start_time_(absl::Now()) {
   context_.AddSpanAttribute("previous-rpc-attempts", attempt_num);
   context_.AddSpanAttribute("transparent-retry", is_transparent_retry);
@@ -168,21 +168,10 @@ void OpenCensusCallTracer::OpenCensusCallAttemptTracer::
   if (recv_trailing_metadata == nullptr || transport_stream_stats == nullptr) {
     return;
   }
-  uint64_t elapsed_time = 0;
-  FilterTrailingMetadata(recv_trailing_metadata, &elapsed_time);
-  std::vector<std::pair<opencensus::tags::TagKey, std::string>> tags =
-      context_.tags().tags();
-  tags.emplace_back(ClientMethodTagKey(), std::string(parent_->method_));
-  std::string final_status = absl::StatusCodeToString(status_code_);
-  tags.emplace_back(ClientStatusTagKey(), final_status);
-  ::opencensus::stats::Record(
-      {{RpcClientSentBytesPerRpc(),
-        static_cast<double>(transport_stream_stats->outgoing.data_bytes)},
-       {RpcClientReceivedBytesPerRpc(),
-        static_cast<double>(transport_stream_stats->incoming.data_bytes)},
-       {RpcClientServerLatency(),
-        ToDoubleMilliseconds(absl::Nanoseconds(elapsed_time))}},
-      tags);
+  FilterTrailingMetadata(recv_trailing_metadata, &server_elapsed_time_);
+  has_transport_stats_ = true;
+  sent_bytes_ = transport_stream_stats->outgoing.data_bytes;
+  recv_bytes_ = transport_stream_stats->incoming.data_bytes;
 }
 
 void OpenCensusCallTracer::OpenCensusCallAttemptTracer::RecordCancel(
@@ -194,15 +183,33 @@ void OpenCensusCallTracer::OpenCensusCallAttemptTracer::RecordCancel(
 void OpenCensusCallTracer::OpenCensusCallAttemptTracer::RecordEnd(
     const gpr_timespec& /*latency*/) {
   double latency_ms = absl::ToDoubleMilliseconds(absl::Now() - start_time_);
-  std::vector<std::pair<opencensus::tags::TagKey, std::string>> tags =
-      context_.tags().tags();
+  // Build the tags once and record all of the attempt's measures together:
+  // each Record() call converts the tags into a TagMap and takes the stats
+  // recorder's lock.
+  const auto& context_tags = context_.tags().tags();
+  std::vector<std::pair<opencensus::tags::TagKey, std::string>> tags;
+  tags.reserve(context_tags.size() + 2);
+  tags.insert(tags.end(), context_tags.begin(), context_tags.end());
   tags.emplace_back(ClientMethodTagKey(), std::string(parent_->method_));
-  tags.emplace_back(ClientStatusTagKey(), StatusCodeToString(status_code_));
-  ::opencensus::stats::Record(
-      {{RpcClientRoundtripLatency(), latency_ms},
-       {RpcClientSentMessagesPerRpc(), sent_message_count_},
-       {RpcClientReceivedMessagesPerRpc(), recv_message_count_}},
-      tags);
+  tags.emplace_back(ClientStatusTagKey(),
+                    std::string(StatusCodeToString(status_code_)));
+  if (has_transport_stats_) {
+    ::opencensus::stats::Record(
+        {{RpcClientRoundtripLatency(), latency_ms},
+         {RpcClientSentMessagesPerRpc(), sent_message_count_},
+         {RpcClientReceivedMessagesPerRpc(), recv_message_count_},
+         {RpcClientSentBytesPerRpc(), static_cast<double>(sent_bytes_)},
+         {RpcClientReceivedBytesPerRpc(), static_cast<double>(recv_bytes_)},
+         {RpcClientServerLatency(),
+          ToDoubleMilliseconds(absl::Nanoseconds(server_elapsed_time_))}},
+        std::move(tags));
+  } else {
+    ::opencensus::stats::Record(
+        {{RpcClientRoundtripLatency(), latency_ms},
+         {RpcClientSentMessagesPerRpc(), sent_message_count_},
+         {RpcClientReceivedMessagesPerRpc(), recv_message_count_}},
+        std::move(tags));
+  }
   if (status_code_ != absl::StatusCode::kOk) {
     context_.Span().SetStatus(opencensus::trace::StatusCode(status_code_),
                               StatusCodeToString(status_code_));
@@ -243,7 +250,7 @@ OpenCensusCallTracer::~OpenCensusCallTracer() {
 void OpenCensusCallTracer::GenerateContext() {
   auto* parent_context = reinterpret_cast<CensusContext*>(
       call_context_[GRPC_CONTEXT_TRACING].value);
-  GenerateClientContext(absl::StrCat("Sent.", method_), &context_,
+  GenerateClientContext(ArenaSpanName(arena_, "Sent.", method_), &context_,
                         (parent_context == nullptr) ? nullptr : parent_context);
 }
 
@@ -20,6 +20,8 @@
 
 #include "src/cpp/ext/filters/census/context.h"
 
+#include <string.h>
+
 #include <new>
 
 #include "opencensus/tags/context_util.h"
@@ -73,6 +75,16 @@ void GenerateClientContext(absl::string_view method, CensusContext* ctxt,
   new (ctxt) CensusContext(method, tags);
 }
 
+absl::string_view ArenaSpanName(grpc_core::Arena* arena,
+                                absl::string_view prefix,
+                                absl::string_view method) {
+  const size_t len = prefix.size() + method.size();
+  char* name = static_cast<char*>(arena->Alloc(len));
+  memcpy(name, prefix.data(), prefix.size());
+  memcpy(name + prefix.size(), method.data(), method.size());
+  return absl::string_view(name, len);
+}
+
 size_t TraceContextSerialize(const ::opencensus::trace::SpanContext& context,
                              char* tracing_buf, size_t tracing_buf_size) {
   if (tracing_buf_size <
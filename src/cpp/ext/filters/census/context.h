@@ -36,6 +36,7 @@
 #include <grpc/status.h>
 
 #include "src/core/lib/channel/channel_stack.h"
+#include "src/core/lib/resource_quota/arena.h"
 #include "src/core/lib/slice/slice.h"
 
 namespace grpc {
@@ -107,6 +108,12 @@ void GenerateServerContext(absl::string_view tracing, absl::string_view method,
 void GenerateClientContext(absl::string_view method, CensusContext* ctxt,
                            CensusContext* parent_ctx);
 
+// Returns prefix followed by method, e.g. "Sent.pkg.Service/Method", copied
+// into the call arena so that naming a span needs no heap allocation.
+absl::string_view ArenaSpanName(grpc_core::Arena* arena,
+                                absl::string_view prefix,
+                                absl::string_view method);
+
 // Returns the incoming data size from the grpc call final info.
 uint64_t GetIncomingDataSize(const grpc_call_final_info* final_info);
 
@@ -85,6 +85,12 @@ class OpenCensusCallTracer : public grpc_core::CallTracer {
     // Number of messages in this RPC.
     uint64_t recv_message_count_ = 0;
     uint64_t sent_message_count_ = 0;
+    // Set from the trailing metadata and recorded along with the rest of the
+    // attempt's measures in RecordEnd().
+    bool has_transport_stats_ = false;
+    uint64_t sent_bytes_ = 0;
+    uint64_t recv_bytes_ = 0;
+    uint64_t server_elapsed_time_ = 0;
     // End status code
     absl::StatusCode status_code_;
   };
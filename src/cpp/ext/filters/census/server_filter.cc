@@ -22,7 +22,6 @@
 
 #include <utility>
 
-#include "absl/strings/str_cat.h"
 #include "absl/strings/string_view.h"
 #include "absl/time/clock.h"
 #include "absl/time/time.h"
@@ -101,7 +100,8 @@ void CensusServerCallData::OnDoneRecvInitialMetadataCb(
     FilterInitialMetadata(initial_metadata, &sml);
     calld->path_ = std::move(sml.path);
     calld->method_ = GetMethod(calld->path_);
-    calld->qualified_method_ = absl::StrCat("Recv.", calld->method_);
+    calld->qualified_method_ =
+        ArenaSpanName(calld->arena_, "Recv.", calld->method_);
     GenerateServerContext(sml.tracing_slice.as_string_view(),
                           calld->qualified_method_, &calld->context_);
     grpc_census_call_set_context(
@@ -148,6 +148,7 @@ void CensusServerCallData::StartTransportStreamOpBatch(
 grpc_error_handle CensusServerCallData::Init(
     grpc_call_element* elem, const grpc_call_element_args* args) {
   start_time_ = absl::Now();
+  arena_ = args->arena;
   gc_ =
       grpc_call_from_top_element(grpc_call_stack_element(args->call_stack, 0));
   GRPC_CLOSURE_INIT(&on_done_recv_initial_metadata_,
@@ -38,6 +38,7 @@
 #include "src/core/lib/channel/channel_stack.h"
 #include "src/core/lib/iomgr/closure.h"
 #include "src/core/lib/iomgr/error.h"
+#include "src/core/lib/resource_quota/arena.h"
 #include "src/core/lib/slice/slice.h"
 #include "src/core/lib/slice/slice_buffer.h"
 #include "src/core/lib/transport/metadata_batch.h"
@@ -86,7 +87,9 @@ class CensusServerCallData : public CallData {
   CensusContext context_;
   // server method
   absl::string_view method_;
-  std::string qualified_method_;
+  // Span name, allocated on arena_.
+  absl::string_view qualified_method_;
+  grpc_core::Arena* arena_ = nullptr;
   grpc_core::Slice path_;
   // Pointer to the grpc_call element
   grpc_call* gc_;
@@ -24,6 +24,7 @@
 // TODO(lidiz) build a real registration system that can pull in services
 // automatically with minimum amount of code.
 #include "src/cpp/server/channelz/channelz_service.h"
+#include "src/cpp/server/profiling/profiling_service.h"
 #if !defined(GRPC_NO_XDS) && !defined(DISABLED_XDS_PROTO_IN_CC)
 #include "src/cpp/server/csds/csds.h"
 #endif  // GRPC_NO_XDS or DISABLED_XDS_PROTO_IN_CC
@@ -32,6 +33,7 @@ namespace grpc {
 namespace {
 
 auto* g_channelz_service = new ChannelzService();
+auto* g_profiling_service = new ProfilingService();
 #if !defined(GRPC_NO_XDS) && !defined(DISABLED_XDS_PROTO_IN_CC)
 auto* g_csds = new xds::experimental::ClientStatusDiscoveryService();
 #endif  // GRPC_NO_XDS or DISABLED_XDS_PROTO_IN_CC
@@ -40,6 +42,7 @@ auto* g_csds = new xds::experimental::ClientStatusDiscoveryService();
 
 void AddAdminServices(ServerBuilder* builder) {
   builder->RegisterService(g_channelz_service);
+  builder->RegisterService(g_profiling_service);
 #if !defined(GRPC_NO_XDS) && !defined(DISABLED_XDS_PROTO_IN_CC)
   builder->RegisterService(g_csds);
 #endif  // GRPC_NO_XDS or DISABLED_XDS_PROTO_IN_CC
@@ -0,0 +1,86 @@
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <grpc/support/port_platform.h>
+
+#include "src/cpp/server/profiling/profiling_service.h"
+
+#include <string>
+#include <utility>
+
+#include "src/core/lib/channel/channelz_registry.h"
+#include "src/core/lib/profiling/contention_profiler.h"
+#include "src/core/lib/profiling/trace_point.h"
+
+namespace grpc {
+
+Status ProfilingService::GetTracePoints(
+    ServerContext* /*unused*/,
+    const profiling::v1alpha::GetTracePointsRequest* request,
+    profiling::v1alpha::GetTracePointsResponse* response) {
+  response->set_chrome_trace_json(
+      grpc_core::ContinuousProfiler::DumpChromeTraceJson());
+  if (request->clear()) grpc_core::ContinuousProfiler::Clear();
+  if (request->has_sample_period()) {
+    grpc_core::ContinuousProfiler::SetSamplePeriod(
+        request->sample_period().value());
+  }
+  response->set_sample_period(grpc_core::ContinuousProfiler::sample_period());
+  return Status::OK;
+}
+
+Status ProfilingService::GetCallTimelines(
+    ServerContext* /*unused*/,
+    const profiling::v1alpha::GetCallTimelinesRequest* request,
+    profiling::v1alpha::GetCallTimelinesResponse* response) {
+  std::string json = grpc_core::channelz::ChannelzRegistry::GetCallTimelines(
+      request->channelz_id());
+  if (json.empty()) {
+    return Status(StatusCode::NOT_FOUND,
+                  "No channel or server with the given channelz id");
+  }
+  response->set_call_timelines_json(std::move(json));
+  return Status::OK;
+}
+
+Status ProfilingService::GetMethodLatencies(
+    ServerContext* /*unused*/,
+    const profiling::v1alpha::GetMethodLatenciesRequest* request,
+    profiling::v1alpha::GetMethodLatenciesResponse* response) {
+  std::string json =
+      grpc_core::channelz::ChannelzRegistry::GetChannelMethodLatencies(
+          request->channelz_id());
+  if (json.empty()) {
+    return Status(StatusCode::NOT_FOUND,
+                  "No channel with the given channelz id");
+  }
+  response->set_method_latencies_json(std::move(json));
+  return Status::OK;
+}
+
+Status ProfilingService::GetContention(
+    ServerContext* /*unused*/,
+    const profiling::v1alpha::GetContentionRequest* request,
+    profiling::v1alpha::GetContentionResponse* response) {
+  response->set_contention_json(grpc_core::ContentionProfiler::DumpJson());
+  if (request->clear()) grpc_core::ContentionProfiler::Clear();
+  if (request->has_sample_period()) {
+    grpc_core::ContentionProfiler::SetSamplePeriod(
+        request->sample_period().value());
+  }
+  response->set_sample_period(grpc_core::ContentionProfiler::sample_period());
+  return Status::OK;
+}
+
+}  // namespace grpc
@@ -0,0 +1,54 @@
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GRPC_INTERNAL_CPP_SERVER_PROFILING_SERVICE_H
+#define GRPC_INTERNAL_CPP_SERVER_PROFILING_SERVICE_H
+
+#include <grpc/support/port_platform.h>
+
+#include <grpcpp/grpcpp.h>
+#include <grpcpp/support/status.h>
+
+#include "src/proto/grpc/profiling/v1alpha/profiling.grpc.pb.h"
+#include "src/proto/grpc/profiling/v1alpha/profiling.pb.h"
+
+namespace grpc {
+
+class ProfilingService final : public profiling::v1alpha::Profiling::Service {
+ private:
+  // implementation of GetTracePoints rpc
+  Status GetTracePoints(
+      ServerContext* unused,
+      const profiling::v1alpha::GetTracePointsRequest* request,
+      profiling::v1alpha::GetTracePointsResponse* response) override;
+  // implementation of GetCallTimelines rpc
+  Status GetCallTimelines(
+      ServerContext* unused,
+      const profiling::v1alpha::GetCallTimelinesRequest* request,
+      profiling::v1alpha::GetCallTimelinesResponse* response) override;
+  // implementation of GetMethodLatencies rpc
+  Status GetMethodLatencies(
+      ServerContext* unused,
+      const profiling::v1alpha::GetMethodLatenciesRequest* request,
+      profiling::v1alpha::GetMethodLatenciesResponse* response) override;
+  // implementation of GetContention rpc
+  Status GetContention(
+      ServerContext* unused,
+      const profiling::v1alpha::GetContentionRequest* request,
+      profiling::v1alpha::GetContentionResponse* response) override;
+};
+
+}  // namespace grpc
+
+#endif  // GRPC_INTERNAL_CPP_SERVER_PROFILING_SERVICE_H
@@ -38,6 +38,7 @@ CORE_SOURCE_FILES = [
     'src/core/ext/filters/client_channel/lb_policy/grpclb/grpclb_balancer_addresses.cc',
     'src/core/ext/filters/client_channel/lb_policy/grpclb/grpclb_client_stats.cc',
     'src/core/ext/filters/client_channel/lb_policy/grpclb/load_balancer_api.cc',
+    'src/core/ext/filters/client_channel/lb_policy/least_request/least_request.cc',
     'src/core/ext/filters/client_channel/lb_policy/oob_backend_metric.cc',
     'src/core/ext/filters/client_channel/lb_policy/outlier_detection/outlier_detection.cc',
     'src/core/ext/filters/client_channel/lb_policy/pick_first/pick_first.cc',
@@ -45,6 +46,10 @@ CORE_SOURCE_FILES = [
     'src/core/ext/filters/client_channel/lb_policy/ring_hash/ring_hash.cc',
     'src/core/ext/filters/client_channel/lb_policy/rls/rls.cc',
     'src/core/ext/filters/client_channel/lb_policy/round_robin/round_robin.cc',
+    'src/core/ext/filters/client_channel/lb_policy/subsetting/deterministic_subset.cc',
+    'src/core/ext/filters/client_channel/lb_policy/subsetting/deterministic_subsetting.cc',
+    'src/core/ext/filters/client_channel/lb_policy/weighted_round_robin/static_stride_scheduler.cc',
+    'src/core/ext/filters/client_channel/lb_policy/weighted_round_robin/weighted_round_robin.cc',
     'src/core/ext/filters/client_channel/lb_policy/weighted_target/weighted_target.cc',
     'src/core/ext/filters/client_channel/lb_policy/xds/cds.cc',
     'src/core/ext/filters/client_channel/lb_policy/xds/xds_cluster_impl.cc',
@@ -78,6 +83,7 @@ CORE_SOURCE_FILES = [
     'src/core/ext/filters/deadline/deadline_filter.cc',
     'src/core/ext/filters/fault_injection/fault_injection_filter.cc',
     'src/core/ext/filters/fault_injection/service_config_parser.cc',
+    'src/core/ext/filters/fused/fused_filters.cc',
     'src/core/ext/filters/http/client/http_client_filter.cc',
     'src/core/ext/filters/http/client_authority_filter.cc',
     'src/core/ext/filters/http/http_filters_plugin.cc',
@@ -419,6 +425,7 @@ CORE_SOURCE_FILES = [
     'src/core/lib/address_utils/parse_address.cc',
     'src/core/lib/address_utils/sockaddr_utils.cc',
     'src/core/lib/backoff/backoff.cc',
+    'src/core/lib/channel/call_timeline.cc',
     'src/core/lib/channel/channel_args.cc',
     'src/core/lib/channel/channel_args_preconditioning.cc',
     'src/core/lib/channel/channel_stack.cc',
@@ -434,6 +441,7 @@ CORE_SOURCE_FILES = [
     'src/core/lib/compression/compression_internal.cc',
     'src/core/lib/compression/message_compress.cc',
     'src/core/lib/config/core_configuration.cc',
+    'src/core/lib/debug/latency_histogram.cc',
     'src/core/lib/debug/stats.cc',
     'src/core/lib/debug/stats_data.cc',
     'src/core/lib/debug/trace.cc',
@@ -571,10 +579,14 @@ CORE_SOURCE_FILES = [
     'src/core/lib/iomgr/work_serializer.cc',
     'src/core/lib/json/json_reader.cc',
     'src/core/lib/json/json_util.cc',
+    'src/core/lib/json/json_view.cc',
     'src/core/lib/json/json_writer.cc',
     'src/core/lib/matchers/matchers.cc',
     'src/core/lib/profiling/basic_timers.cc',
+    'src/core/lib/profiling/contention_profiler.cc',
+    'src/core/lib/profiling/sampling_countdown.cc',
     'src/core/lib/profiling/stap_timers.cc',
+    'src/core/lib/profiling/trace_point.cc',
     'src/core/lib/promise/activity.cc',
     'src/core/lib/promise/sleep.cc',
     'src/core/lib/resolver/resolver.cc',
@@ -592,6 +604,7 @@ CORE_SOURCE_FILES = [
     'src/core/lib/security/authorization/grpc_server_authz_filter.cc',
     'src/core/lib/security/authorization/matchers.cc',
     'src/core/lib/security/authorization/rbac_policy.cc',
+    'src/core/lib/security/authorization/rbac_program.cc',
     'src/core/lib/security/context/security_context.cc',
     'src/core/lib/security/credentials/alts/alts_credentials.cc',
     'src/core/lib/security/credentials/alts/check_gcp_environment.cc',
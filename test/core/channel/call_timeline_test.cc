@@ -0,0 +1,175 @@
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "src/core/lib/channel/call_timeline.h"
+
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include <grpc/grpc.h>
+
+#include "src/core/lib/channel/channelz.h"
+#include "src/core/lib/channel/channelz_registry.h"
+#include "src/core/lib/gprpp/ref_counted_ptr.h"
+#include "src/core/lib/iomgr/exec_ctx.h"
+#include "src/core/lib/resource_quota/resource_quota.h"
+#include "test/core/util/test_config.h"
+
+namespace grpc_core {
+namespace testing {
+namespace {
+
+using Event = CallTimeline::Event;
+using Stage = CallTimeline::Stage;
+
+int64_t ToMillis(gpr_timespec ts) { return gpr_time_to_millis(ts); }
+
+TEST(CallTimelineTest, StagesNeedBothEvents) {
+  CallTimeline timeline(gpr_get_cycle_counter());
+  EXPECT_FALSE(timeline.StageDuration(Stage::kLbPickQueue).has_value());
+  timeline.Mark(Event::kLbPickQueued);
+  EXPECT_FALSE(timeline.StageDuration(Stage::kLbPickQueue).has_value());
+  gpr_sleep_until(grpc_timeout_milliseconds_to_deadline(10));
+  timeline.Mark(Event::kLbPickDone);
+  absl::optional<gpr_timespec> duration =
+      timeline.StageDuration(Stage::kLbPickQueue);
+  ASSERT_TRUE(duration.has_value());
+  EXPECT_GE(ToMillis(*duration), 9);
+  EXPECT_FALSE(timeline.StageDuration(Stage::kResolverQueue).has_value());
+  EXPECT_FALSE(timeline.StageDuration(Stage::kTotal).has_value());
+  timeline.Mark(Event::kCallEnd);
+  EXPECT_TRUE(timeline.StageDuration(Stage::kTotal).has_value());
+}
+
+TEST(CallTimelineTest, KeepsFirstOccurrence) {
+  CallTimeline timeline(gpr_get_cycle_counter());
+  EXPECT_EQ(timeline.EventTime(Event::kLbPickQueued), 0);
+  timeline.Mark(Event::kLbPickQueued);
+  const gpr_cycle_counter first = timeline.EventTime(Event::kLbPickQueued);
+  EXPECT_NE(first, 0);
+  gpr_sleep_until(grpc_timeout_milliseconds_to_deadline(1));
+  timeline.Mark(Event::kLbPickQueued);
+  EXPECT_EQ(timeline.EventTime(Event::kLbPickQueued), first);
+}
+
+TEST(CallTimelineTest, AccumulatesFlowControlStalls) {
+  CallTimeline timeline(gpr_get_cycle_counter());
+  timeline.FlowControlResumed();
+  EXPECT_FALSE(timeline.StageDuration(Stage::kFlowControlStall).has_value());
+  for (int i = 0; i < 2; ++i) {
+    timeline.FlowControlStalled();
+    gpr_sleep_until(grpc_timeout_milliseconds_to_deadline(10));
+    // Still stalled; the stall started at the first call.
+    timeline.FlowControlStalled();
+    timeline.FlowControlResumed();
+    gpr_sleep_until(grpc_timeout_milliseconds_to_deadline(10));
+  }
+  absl::optional<gpr_timespec> stalled =
+      timeline.StageDuration(Stage::kFlowControlStall);
+  ASSERT_TRUE(stalled.has_value());
+  EXPECT_GE(ToMillis(*stalled), 19);
+  EXPECT_LT(ToMillis(*stalled), 40);
+}
+
+TEST(CallTimelineTest, RendersJson) {
+  MemoryAllocator memory_allocator(
+      ResourceQuota::Default()->memory_quota()->CreateMemoryAllocator("test"));
+  auto arena = MakeScopedArena(1024, &memory_allocator);
+  CallTimeline timeline(gpr_get_cycle_counter());
+  timeline.SetMethod(arena.get(), "/svc/Method");
+  timeline.Mark(Event::kTransportQueued);
+  timeline.Mark(Event::kHeadersWritten);
+  Json json = timeline.ToJson();
+  ASSERT_EQ(json.type(), Json::Type::OBJECT);
+  const Json::Object& object = json.object_value();
+  EXPECT_EQ(object.at("method").string_value(), "/svc/Method");
+  const Json::Array& events = object.at("event").array_value();
+  ASSERT_EQ(events.size(), 3);
+  EXPECT_EQ(events[0].object_value().at("event").string_value(), "CALL_START");
+  EXPECT_EQ(events[2].object_value().at("event").string_value(),
+            "HEADERS_WRITTEN");
+  const Json::Array& stages = object.at("stage").array_value();
+  ASSERT_EQ(stages.size(), 1);
+  EXPECT_EQ(stages[0].object_value().at("stage").string_value(),
+            "TRANSPORT_WRITE_QUEUE");
+}
+
+TEST(CallTimelineStatsTest, SamplesOneInPeriod) {
+  ExecCtx exec_ctx;
+  CallTimelineStats stats(4);
+  int sampled = 0;
+  for (int i = 0; i < 400; ++i) {
+    if (stats.ShouldSample()) ++sampled;
+  }
+  EXPECT_EQ(sampled, 100);
+}
+
+TEST(CallTimelineStatsTest, KeepsMostRecentCalls) {
+  ExecCtx exec_ctx;
+  CallTimelineStats stats(1);
+  const size_t kCalls = CallTimelineStats::kMaxRecentCalls + 8;
+  for (size_t i = 0; i < kCalls; ++i) {
+    CallTimeline timeline(gpr_get_cycle_counter());
+    timeline.Mark(Event::kCallEnd);
+    stats.Record(timeline);
+  }
+  Json::Object json = stats.RenderJson();
+  EXPECT_EQ(json["sampledCalls"].string_value(), std::to_string(kCalls));
+  EXPECT_EQ(json["recentCall"].array_value().size(),
+            CallTimelineStats::kMaxRecentCalls);
+  const Json::Array& stages = json["stage"].array_value();
+  ASSERT_EQ(stages.size(), 1);
+  EXPECT_EQ(stages[0].object_value().at("stage").string_value(), "TOTAL");
+  EXPECT_EQ(stages[0].object_value().at("count").string_value(),
+            std::to_string(kCalls));
+}
+
+TEST(CallTimelineStatsTest, ExportedThroughChannelz) {
+  ExecCtx exec_ctx;
+  auto channel = MakeRefCounted<channelz::ChannelNode>(
+      "test", 0, false, false, /*call_timeline_sample_period=*/1);
+  ASSERT_NE(channel->call_timeline_stats(), nullptr);
+  CallTimeline timeline(gpr_get_cycle_counter());
+  timeline.Mark(Event::kCallEnd);
+  channel->call_timeline_stats()->Record(timeline);
+  grpc_error_handle error = GRPC_ERROR_NONE;
+  Json json = Json::Parse(
+      channelz::ChannelzRegistry::GetCallTimelines(channel->uuid()), &error);
+  ASSERT_EQ(error, GRPC_ERROR_NONE) << grpc_error_std_string(error);
+  EXPECT_EQ(json.object_value().at("sampledCalls").string_value(), "1");
+  EXPECT_EQ(json.object_value()
+                .at("ref")
+                .object_value()
+                .at("channelId")
+                .string_value(),
+            std::to_string(channel->uuid()));
+  auto server = MakeRefCounted<channelz::ServerNode>(0);
+  EXPECT_EQ(server->call_timeline_stats(), nullptr);
+  EXPECT_NE(channelz::ChannelzRegistry::GetCallTimelines(server->uuid()), "");
+  EXPECT_EQ(channelz::ChannelzRegistry::GetCallTimelines(-1), "");
+}
+
+}  // namespace
+}  // namespace testing
+}  // namespace grpc_core
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(&argc, argv);
+  ::testing::InitGoogleTest(&argc, argv);
+  grpc_init();
+  int ret = RUN_ALL_TESTS();
+  grpc_shutdown();
+  return ret;
+}
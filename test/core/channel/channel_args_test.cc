@@ -20,6 +20,8 @@
 
 #include <string.h>
 
+#include <string>
+
 #include <gtest/gtest.h>
 
 #include <grpc/grpc_security.h>
@@ -126,6 +128,76 @@ TEST(ChannelArgsTest, ToAndFromC) {
   gpr_free(ptr);
 }
 
+TEST(InternedChannelArgsTest, EqualArgsShareInstance) {
+  grpc_arg ab[] = {
+      grpc_channel_arg_integer_create(const_cast<char*>("a"), 1),
+      grpc_channel_arg_string_create(const_cast<char*>("b"),
+                                     const_cast<char*>("x")),
+  };
+  // Same args in a different order, in separately allocated strings.
+  std::string b_key = "b";
+  std::string b_value = "x";
+  grpc_arg ba[] = {
+      grpc_channel_arg_string_create(&b_key[0], &b_value[0]),
+      grpc_channel_arg_integer_create(const_cast<char*>("a"), 1),
+  };
+  grpc_channel_args ab_args = {GPR_ARRAY_SIZE(ab), ab};
+  grpc_channel_args ba_args = {GPR_ARRAY_SIZE(ba), ba};
+  auto first = InternedChannelArgs::Intern(&ab_args);
+  auto second = InternedChannelArgs::Intern(&ba_args);
+  EXPECT_EQ(first, second);
+  // The interned copy is normalized.
+  ASSERT_EQ(first->args()->num_args, 2u);
+  EXPECT_STREQ(first->args()->args[0].key, "a");
+  EXPECT_STREQ(first->args()->args[1].key, "b");
+}
+
+TEST(InternedChannelArgsTest, DifferentArgsDoNotShareInstance) {
+  grpc_arg one = grpc_channel_arg_integer_create(const_cast<char*>("a"), 1);
+  grpc_arg two = grpc_channel_arg_integer_create(const_cast<char*>("a"), 2);
+  grpc_channel_args one_args = {1, &one};
+  grpc_channel_args two_args = {1, &two};
+  grpc_channel_args empty_args = {0, nullptr};
+  auto a = InternedChannelArgs::Intern(&one_args);
+  auto b = InternedChannelArgs::Intern(&two_args);
+  auto c = InternedChannelArgs::Intern(&empty_args);
+  EXPECT_NE(a, b);
+  EXPECT_NE(a, c);
+  EXPECT_NE(b, c);
+  EXPECT_EQ(grpc_channel_args_hash(a->args()), a->hash());
+}
+
+TEST(InternedChannelArgsTest, PointerArgsUseVtableCompare) {
+  // Distinct pointers the vtable considers equal intern together.
+  static const grpc_arg_pointer_vtable always_equal_vtable = {
+      // copy
+      [](void* p) { return p; },
+      // destroy
+      [](void*) {},
+      // cmp
+      [](void*, void*) { return 0; },
+  };
+  int x;
+  int y;
+  grpc_arg px = grpc_channel_arg_pointer_create(const_cast<char*>("p"), &x,
+                                                &always_equal_vtable);
+  grpc_arg py = grpc_channel_arg_pointer_create(const_cast<char*>("p"), &y,
+                                                &always_equal_vtable);
+  grpc_channel_args x_args = {1, &px};
+  grpc_channel_args y_args = {1, &py};
+  EXPECT_EQ(InternedChannelArgs::Intern(&x_args),
+            InternedChannelArgs::Intern(&y_args));
+}
+
+TEST(InternedChannelArgsTest, ReleasedInstanceIsRecreated) {
+  grpc_arg arg = grpc_channel_arg_integer_create(const_cast<char*>("a"), 3);
+  grpc_channel_args args = {1, &arg};
+  InternedChannelArgs::Intern(&args).reset();
+  auto interned = InternedChannelArgs::Intern(&args);
+  ASSERT_EQ(interned->args()->num_args, 1u);
+  EXPECT_EQ(interned->args()->args[0].value.integer, 3);
+}
+
 }  // namespace grpc_core
 
 TEST(GrpcChannelArgsTest, Create) {
@@ -531,6 +531,21 @@ TEST(ChannelzServerTest, BasicServerAPIFunctionality) {
   ValidateServer(channelz_server, {3, 3, 3});
 }
 
+TEST(ChannelzSocketTest, BufferedBytesRenderedAsOption) {
+  auto socket = MakeRefCounted<SocketNode>(
+      "ipv4:127.0.0.1:1234", "ipv4:127.0.0.1:5678", "test", nullptr);
+  Json json = socket->RenderJson();
+  EXPECT_EQ(json.object_value().at("data").object_value().count("option"), 0);
+  socket->RecordBufferedBytes(65536);
+  json = socket->RenderJson();
+  const Json::Array& options =
+      json.object_value().at("data").object_value().at("option").array_value();
+  ASSERT_EQ(options.size(), 1);
+  EXPECT_EQ(options[0].object_value().at("name").string_value(),
+            "grpc.buffered_bytes");
+  EXPECT_EQ(options[0].object_value().at("value").string_value(), "65536");
+}
+
 TEST_F(ChannelzRegistryBasedTest, BasicGetServersTest) {
   ExecCtx exec_ctx;
   ServerFixture server;
@@ -0,0 +1,242 @@
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "src/core/ext/filters/fused/fused_filter.h"
+
+#include <stdint.h>
+#include <string.h>
+
+#include <string>
+#include <vector>
+
+#include "absl/strings/str_join.h"
+#include "gtest/gtest.h"
+
+#include <grpc/grpc.h>
+#include <grpc/grpc_security.h>
+
+#include "src/core/lib/channel/channel_stack_builder_impl.h"
+#include "src/core/lib/config/core_configuration.h"
+#include "src/core/lib/gpr/useful.h"
+#include "src/core/lib/gprpp/host_port.h"
+#include "src/core/lib/iomgr/exec_ctx.h"
+#include "src/core/lib/surface/channel_init.h"
+#include "src/core/lib/transport/transport_impl.h"
+#include "test/core/end2end/cq_verifier.h"
+#include "test/core/util/port.h"
+#include "test/core/util/test_config.h"
+
+namespace grpc_core {
+namespace testing {
+namespace {
+
+// Returns the names of the filters CoreConfiguration puts in a stack of the
+// given type over an http transport.
+std::string StackFilters(grpc_channel_stack_type type, ChannelArgs args) {
+  ChannelStackBuilderImpl builder("test", type);
+  grpc_transport_vtable fake_transport_vtable;
+  memset(&fake_transport_vtable, 0, sizeof(grpc_transport_vtable));
+  fake_transport_vtable.name = "chttp2";
+  grpc_transport fake_transport = {&fake_transport_vtable};
+  builder.SetTarget("foo.test.google.fr")
+      .SetChannelArgs(args)
+      .SetTransport(&fake_transport);
+  {
+    ExecCtx exec_ctx;
+    EXPECT_TRUE(CoreConfiguration::Get().channel_init().CreateStack(&builder));
+  }
+  std::vector<std::string> names;
+  for (const auto* filter : *builder.mutable_stack()) {
+    names.push_back(filter->name);
+  }
+  return absl::StrJoin(names, ", ");
+}
+
+ChannelArgs MinimalArgs() {
+  return ChannelArgs().Set(GRPC_ARG_MINIMAL_STACK, true);
+}
+
+ChannelArgs UncompressedMaxAgeArgs() {
+  return ChannelArgs()
+      .Set(GRPC_ARG_ENABLE_PER_MESSAGE_COMPRESSION, false)
+      .Set(GRPC_ARG_ENABLE_PER_MESSAGE_DECOMPRESSION, false)
+      .Set(GRPC_ARG_MAX_CONNECTION_AGE_MS, 60000);
+}
+
+TEST(FusedFilterTest, StacksUnchangedByDefault) {
+  EXPECT_EQ(StackFilters(GRPC_CLIENT_SUBCHANNEL, MinimalArgs()),
+            "authority, http-client, connected");
+  EXPECT_EQ(StackFilters(GRPC_SERVER_CHANNEL, UncompressedMaxAgeArgs()),
+            "server, message_size, deadline, http-server, max_age, connected");
+}
+
+TEST(FusedFilterTest, FusesMinimalClientStack) {
+  auto args = MinimalArgs().Set(GRPC_ARG_FUSE_FILTERS, true);
+  EXPECT_EQ(StackFilters(GRPC_CLIENT_SUBCHANNEL, args),
+            "authority+http-client, connected");
+  EXPECT_EQ(StackFilters(GRPC_CLIENT_DIRECT_CHANNEL, args),
+            "authority+http-client, connected");
+}
+
+TEST(FusedFilterTest, FusesServerStack) {
+  auto args = UncompressedMaxAgeArgs().Set(GRPC_ARG_FUSE_FILTERS, true);
+  EXPECT_EQ(StackFilters(GRPC_SERVER_CHANNEL, args),
+            "server, message_size, deadline, http-server+max_age, connected");
+}
+
+TEST(FusedFilterTest, LeavesUnknownCombinationsAlone) {
+  // message_size separates authority from http-client in the full stack.
+  auto args = ChannelArgs().Set(GRPC_ARG_FUSE_FILTERS, true);
+  EXPECT_EQ(StackFilters(GRPC_CLIENT_SUBCHANNEL, args),
+            "authority, message_size, http-client, message_decompress, "
+            "message_compress, connected");
+}
+
+void* Tag(intptr_t t) { return reinterpret_cast<void*>(t); }
+
+// Runs a call between a client and server whose stacks are both fused, to
+// check that every filter in the fused sequence still does its job: the
+// server rejects requests without the headers that http-client adds, and only
+// sees the default authority if the authority filter ran.
+TEST(FusedFilterTest, CallThroughFusedStacks) {
+  grpc_completion_queue* cq = grpc_completion_queue_create_for_next(nullptr);
+  cq_verifier* cqv = cq_verifier_create(cq);
+  std::string addr = JoinHostPort("localhost", grpc_pick_unused_port_or_die());
+
+  grpc_arg server_args[] = {
+      grpc_channel_arg_integer_create(
+          const_cast<char*>(GRPC_ARG_FUSE_FILTERS), 1),
+      grpc_channel_arg_integer_create(
+          const_cast<char*>(GRPC_ARG_ENABLE_PER_MESSAGE_COMPRESSION), 0),
+      grpc_channel_arg_integer_create(
+          const_cast<char*>(GRPC_ARG_ENABLE_PER_MESSAGE_DECOMPRESSION), 0),
+      grpc_channel_arg_integer_create(
+          const_cast<char*>(GRPC_ARG_MAX_CONNECTION_AGE_MS), 60000),
+  };
+  grpc_channel_args server_channel_args = {GPR_ARRAY_SIZE(server_args),
+                                           server_args};
+  grpc_server* server = grpc_server_create(&server_channel_args, nullptr);
+  grpc_server_register_completion_queue(server, cq, nullptr);
+  grpc_server_credentials* server_creds =
+      grpc_insecure_server_credentials_create();
+  ASSERT_NE(grpc_server_add_http2_port(server, addr.c_str(), server_creds), 0);
+  grpc_server_credentials_release(server_creds);
+  grpc_server_start(server);
+
+  grpc_arg client_args[] = {
+      grpc_channel_arg_integer_create(
+          const_cast<char*>(GRPC_ARG_FUSE_FILTERS), 1),
+      grpc_channel_arg_integer_create(
+          const_cast<char*>(GRPC_ARG_MINIMAL_STACK), 1),
+      grpc_channel_arg_string_create(
+          const_cast<char*>(GRPC_ARG_DEFAULT_AUTHORITY),
+          const_cast<char*>("fused.test")),
+  };
+  grpc_channel_args client_channel_args = {GPR_ARRAY_SIZE(client_args),
+                                           client_args};
+  grpc_channel_credentials* creds = grpc_insecure_credentials_create();
+  grpc_channel* client =
+      grpc_channel_create(addr.c_str(), creds, &client_channel_args);
+  grpc_channel_credentials_release(creds);
+
+  grpc_call* c = grpc_channel_create_call(
+      client, nullptr, GRPC_PROPAGATE_DEFAULTS, cq,
+      grpc_slice_from_static_string("/foo"), nullptr,
+      grpc_timeout_seconds_to_deadline(30), nullptr);
+  ASSERT_NE(c, nullptr);
+  grpc_metadata_array initial_metadata_recv;
+  grpc_metadata_array trailing_metadata_recv;
+  grpc_metadata_array_init(&initial_metadata_recv);
+  grpc_metadata_array_init(&trailing_metadata_recv);
+  grpc_status_code status;
+  grpc_slice details;
+  grpc_op ops[4];
+  memset(ops, 0, sizeof(ops));
+  ops[0].op = GRPC_OP_SEND_INITIAL_METADATA;
+  ops[0].flags = GRPC_INITIAL_METADATA_WAIT_FOR_READY;
+  ops[1].op = GRPC_OP_SEND_CLOSE_FROM_CLIENT;
+  ops[2].op = GRPC_OP_RECV_INITIAL_METADATA;
+  ops[2].data.recv_initial_metadata.recv_initial_metadata =
+      &initial_metadata_recv;
+  ops[3].op = GRPC_OP_RECV_STATUS_ON_CLIENT;
+  ops[3].data.recv_status_on_client.trailing_metadata = &trailing_metadata_recv;
+  ops[3].data.recv_status_on_client.status = &status;
+  ops[3].data.recv_status_on_client.status_details = &details;
+  ASSERT_EQ(grpc_call_start_batch(c, ops, 4, Tag(1), nullptr), GRPC_CALL_OK);
+
+  grpc_call* s;
+  grpc_call_details call_details;
+  grpc_metadata_array request_metadata_recv;
+  grpc_call_details_init(&call_details);
+  grpc_metadata_array_init(&request_metadata_recv);
+  ASSERT_EQ(grpc_server_request_call(server, &s, &call_details,
+                                     &request_metadata_recv, cq, cq, Tag(101)),
+            GRPC_CALL_OK);
+  CQ_EXPECT_COMPLETION(cqv, Tag(101), 1);
+  cq_verify(cqv);
+  EXPECT_EQ(grpc_slice_str_cmp(call_details.host, "fused.test"), 0);
+  EXPECT_EQ(grpc_slice_str_cmp(call_details.method, "/foo"), 0);
+
+  int was_cancelled = 2;
+  grpc_slice status_details = grpc_slice_from_static_string("xyz");
+  memset(ops, 0, sizeof(ops));
+  ops[0].op = GRPC_OP_SEND_INITIAL_METADATA;
+  ops[1].op = GRPC_OP_SEND_STATUS_FROM_SERVER;
+  ops[1].data.send_status_from_server.status = GRPC_STATUS_UNIMPLEMENTED;
+  ops[1].data.send_status_from_server.status_details = &status_details;
+  ops[2].op = GRPC_OP_RECV_CLOSE_ON_SERVER;
+  ops[2].data.recv_close_on_server.cancelled = &was_cancelled;
+  ASSERT_EQ(grpc_call_start_batch(s, ops, 3, Tag(102), nullptr),
+            GRPC_CALL_OK);
+  CQ_EXPECT_COMPLETION(cqv, Tag(102), 1);
+  CQ_EXPECT_COMPLETION(cqv, Tag(1), 1);
+  cq_verify(cqv);
+
+  EXPECT_EQ(status, GRPC_STATUS_UNIMPLEMENTED);
+  EXPECT_EQ(grpc_slice_str_cmp(details, "xyz"), 0);
+  EXPECT_EQ(was_cancelled, 0);
+
+  grpc_slice_unref(details);
+  grpc_metadata_array_destroy(&initial_metadata_recv);
+  grpc_metadata_array_destroy(&trailing_metadata_recv);
+  grpc_metadata_array_destroy(&request_metadata_recv);
+  grpc_call_details_destroy(&call_details);
+  grpc_call_unref(c);
+  grpc_call_unref(s);
+  grpc_channel_destroy(client);
+  grpc_server_shutdown_and_notify(server, cq, Tag(1000));
+  CQ_EXPECT_COMPLETION(cqv, Tag(1000), 1);
+  cq_verify(cqv);
+  grpc_server_destroy(server);
+  cq_verifier_destroy(cqv);
+  grpc_completion_queue_shutdown(cq);
+  while (grpc_completion_queue_next(cq, gpr_inf_future(GPR_CLOCK_REALTIME),
+                                    nullptr)
+             .type != GRPC_QUEUE_SHUTDOWN) {
+  }
+  grpc_completion_queue_destroy(cq);
+}
+
+}  // namespace
+}  // namespace testing
+}  // namespace grpc_core
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(&argc, argv);
+  ::testing::InitGoogleTest(&argc, argv);
+  grpc_init();
+  int ret = RUN_ALL_TESTS();
+  grpc_shutdown();
+  return ret;
+}
@@ -0,0 +1,143 @@
+//
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include "src/core/ext/filters/client_channel/lb_policy/subsetting/deterministic_subset.h"
+
+#include <inttypes.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <algorithm>
+#include <random>
+#include <set>
+#include <vector>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <grpc/support/log.h>
+
+#include "test/core/util/test_config.h"
+
+namespace grpc_core {
+namespace testing {
+namespace {
+
+// The result of simulating a fleet of clients connecting to their subsets.
+struct Simulation {
+  size_t total_connections = 0;
+  size_t min_per_backend = 0;
+  size_t max_per_backend = 0;
+};
+
+Simulation Simulate(const std::vector<uint64_t>& client_indexes,
+                    size_t num_backends, size_t subset_size) {
+  std::vector<size_t> per_backend(num_backends);
+  Simulation simulation;
+  for (uint64_t client_index : client_indexes) {
+    for (size_t backend :
+         DeterministicSubset(num_backends, subset_size, client_index)) {
+      ++per_backend[backend];
+      ++simulation.total_connections;
+    }
+  }
+  auto minmax = std::minmax_element(per_backend.begin(), per_backend.end());
+  simulation.min_per_backend = *minmax.first;
+  simulation.max_per_backend = *minmax.second;
+  gpr_log(GPR_INFO,
+          "%" PRIuPTR " clients, %" PRIuPTR " backends, subset size %" PRIuPTR
+          ": %" PRIuPTR " connections, %" PRIuPTR "-%" PRIuPTR " per backend",
+          client_indexes.size(), num_backends, subset_size,
+          simulation.total_connections, simulation.min_per_backend,
+          simulation.max_per_backend);
+  return simulation;
+}
+
+std::vector<uint64_t> ConsecutiveIndexes(size_t num_clients) {
+  std::vector<uint64_t> indexes(num_clients);
+  for (size_t i = 0; i < num_clients; ++i) indexes[i] = i;
+  return indexes;
+}
+
+TEST(DeterministicSubsetTest, ReturnsAllBackendsIfFewerThanSubsetSize) {
+  EXPECT_THAT(DeterministicSubset(3, 5, 7), ::testing::ElementsAre(0, 1, 2));
+  EXPECT_THAT(DeterministicSubset(3, 3, 7), ::testing::ElementsAre(0, 1, 2));
+}
+
+TEST(DeterministicSubsetTest, ReturnsDistinctBackends) {
+  for (uint64_t client_index = 0; client_index < 100; ++client_index) {
+    std::vector<size_t> subset = DeterministicSubset(50, 10, client_index);
+    ASSERT_EQ(subset.size(), 10);
+    EXPECT_EQ(std::set<size_t>(subset.begin(), subset.end()).size(), 10);
+    for (size_t backend : subset) EXPECT_LT(backend, 50);
+  }
+}
+
+TEST(DeterministicSubsetTest, IsDeterministic) {
+  for (uint64_t client_index : {0, 1, 12345, 1 << 30}) {
+    EXPECT_EQ(DeterministicSubset(1000, 20, client_index),
+              DeterministicSubset(1000, 20, client_index));
+  }
+}
+
+TEST(DeterministicSubsetTest, ClientsInOneRoundGetDisjointSubsets) {
+  std::set<size_t> seen;
+  for (uint64_t client_index = 0; client_index < 5; ++client_index) {
+    for (size_t backend : DeterministicSubset(50, 10, client_index)) {
+      EXPECT_TRUE(seen.insert(backend).second) << backend;
+    }
+  }
+  EXPECT_EQ(seen.size(), 50);
+}
+
+TEST(DeterministicSubsetTest, LargeFleetWithConsecutiveIndexes) {
+  // Without subsetting, this would be 5000 * 2000 = 10M connections.
+  Simulation simulation = Simulate(ConsecutiveIndexes(5000), 2000, 20);
+  EXPECT_EQ(simulation.total_connections, 5000 * 20);
+  EXPECT_EQ(simulation.min_per_backend, 50);
+  EXPECT_EQ(simulation.max_per_backend, 50);
+}
+
+TEST(DeterministicSubsetTest, LargeFleetWithUnevenBackendCount) {
+  // 2013 backends make 100 subsets of 20 per round, leaving 13 out of each
+  // round, but not the same 13 each time.
+  Simulation simulation = Simulate(ConsecutiveIndexes(5000), 2013, 20);
+  EXPECT_EQ(simulation.total_connections, 5000 * 20);
+  EXPECT_GE(simulation.min_per_backend, 40);
+  EXPECT_LE(simulation.max_per_backend, 50);
+}
+
+TEST(DeterministicSubsetTest, LargeFleetWithRandomIndexes) {
+  // Clients that do not know their index pick one at random, which is
+  // only balanced in expectation.
+  std::mt19937_64 rng(42);
+  std::vector<uint64_t> indexes(5000);
+  for (uint64_t& index : indexes) index = rng();
+  Simulation simulation = Simulate(indexes, 2000, 20);
+  EXPECT_EQ(simulation.total_connections, 5000 * 20);
+  EXPECT_GE(simulation.min_per_backend, 20);
+  EXPECT_LE(simulation.max_per_backend, 85);
+}
+
+}  // namespace
+}  // namespace testing
+}  // namespace grpc_core
+
+int main(int argc, char** argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  grpc::testing::TestEnvironment env(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -24,12 +24,19 @@
 #include "absl/strings/str_cat.h"
 
 #include <grpc/grpc.h>
+#include <grpc/grpc_security.h>
 
 #include "src/core/ext/filters/client_channel/resolver_result_parsing.h"
 #include "src/core/ext/filters/client_channel/retry_service_config.h"
 #include "src/core/ext/filters/message_size/message_size_filter.h"
+#include "src/core/lib/channel/channelz.h"
 #include "src/core/lib/gpr/string.h"
+#include "src/core/lib/gprpp/orphanable.h"
+#include "src/core/lib/gprpp/sync.h"
 #include "src/core/lib/gprpp/time.h"
+#include "src/core/lib/resolver/resolver.h"
+#include "src/core/lib/resolver/resolver_factory.h"
+#include "src/core/lib/resolver/resolver_registry.h"
 #include "src/core/lib/service_config/service_config_impl.h"
 #include "src/core/lib/service_config/service_config_parser.h"
 #include "test/core/util/port.h"
@@ -445,6 +452,157 @@ TEST_F(ServiceConfigTest, Parser2ErrorInvalidValue) {
   GRPC_ERROR_UNREF(error);
 }
 
+TEST_F(ServiceConfigTest, SharesIdenticalServiceConfigs) {
+  grpc_arg arg = grpc_channel_arg_integer_create(
+      const_cast<char*>(GRPC_ARG_DISABLE_PARSING), 1);
+  grpc_channel_args args = {1, &arg};
+  grpc_error_handle error = GRPC_ERROR_NONE;
+  auto svc_cfg = ServiceConfigImpl::Create(nullptr, "{\"global_param\":5}",
+                                           &error);
+  ASSERT_EQ(error, GRPC_ERROR_NONE) << grpc_error_std_string(error);
+  auto same = ServiceConfigImpl::Create(nullptr, "{\"global_param\":5}",
+                                        &error);
+  ASSERT_EQ(error, GRPC_ERROR_NONE) << grpc_error_std_string(error);
+  EXPECT_EQ(same.get(), svc_cfg.get());
+  auto other_json = ServiceConfigImpl::Create(
+      nullptr, "{\"global_param\":6}", &error);
+  ASSERT_EQ(error, GRPC_ERROR_NONE) << grpc_error_std_string(error);
+  EXPECT_NE(other_json.get(), svc_cfg.get());
+  auto other_args =
+      ServiceConfigImpl::Create(&args, "{\"global_param\":5}", &error);
+  ASSERT_EQ(error, GRPC_ERROR_NONE) << grpc_error_std_string(error);
+  EXPECT_NE(other_args.get(), svc_cfg.get());
+  EXPECT_EQ(other_args->GetGlobalParsedConfig(0), nullptr);
+  // Once released, a service config is parsed again.
+  svc_cfg.reset();
+  same.reset();
+  svc_cfg = ServiceConfigImpl::Create(nullptr, "{\"global_param\":5}",
+                                      &error);
+  ASSERT_EQ(error, GRPC_ERROR_NONE) << grpc_error_std_string(error);
+  EXPECT_EQ((static_cast<TestParsedConfig1*>(svc_cfg->GetGlobalParsedConfig(0)))
+                ->value(),
+            5);
+}
+
+TEST_F(ServiceConfigTest, DoesNotShareInvalidServiceConfigs) {
+  const char* test_json = "{\"global_param\":-5}";
+  grpc_error_handle error = GRPC_ERROR_NONE;
+  auto svc_cfg = ServiceConfigImpl::Create(nullptr, test_json, &error);
+  EXPECT_NE(error, GRPC_ERROR_NONE);
+  GRPC_ERROR_UNREF(error);
+  // The invalid config still alive must not be handed out in place of an
+  // error.
+  error = GRPC_ERROR_NONE;
+  auto again = ServiceConfigImpl::Create(nullptr, test_json, &error);
+  EXPECT_THAT(
+      grpc_error_std_string(error),
+      ::testing::ContainsRegex(TestParser1::InvalidValueErrorMessage()));
+  GRPC_ERROR_UNREF(error);
+}
+
+// The service configs created by ServiceConfigCapturingResolver.
+struct CapturedServiceConfigs {
+  Mutex mu;
+  std::vector<RefCountedPtr<ServiceConfig>> service_configs
+      ABSL_GUARDED_BY(mu);
+  // Whether every config was created from channel args that identified
+  // their channel through its channelz node.
+  bool all_args_had_channelz_node ABSL_GUARDED_BY(mu) = true;
+};
+
+CapturedServiceConfigs* GetCapturedServiceConfigs() {
+  static CapturedServiceConfigs* captured = new CapturedServiceConfigs();
+  return captured;
+}
+
+// Creates a service config from the channel args it is given, as a resolver
+// would when returning a result, and keeps it for the test to inspect.
+class ServiceConfigCapturingResolver : public Resolver {
+ public:
+  explicit ServiceConfigCapturingResolver(const grpc_channel_args* args)
+      : args_(grpc_channel_args_copy(args)) {}
+  ~ServiceConfigCapturingResolver() override {
+    grpc_channel_args_destroy(args_);
+  }
+
+  void StartLocked() override {
+    grpc_error_handle error = GRPC_ERROR_NONE;
+    auto service_config = ServiceConfigImpl::Create(
+        args_, "{\"loadBalancingConfig\": [{\"round_robin\": {}}]}", &error);
+    GPR_ASSERT(error == GRPC_ERROR_NONE);
+    CapturedServiceConfigs* captured = GetCapturedServiceConfigs();
+    MutexLock lock(&captured->mu);
+    captured->service_configs.push_back(std::move(service_config));
+    if (grpc_channel_args_find(args_, GRPC_ARG_CHANNELZ_CHANNEL_NODE) ==
+        nullptr) {
+      captured->all_args_had_channelz_node = false;
+    }
+  }
+
+  void ShutdownLocked() override {}
+
+ private:
+  grpc_channel_args* args_;
+};
+
+class ServiceConfigCapturingResolverFactory : public ResolverFactory {
+ public:
+  absl::string_view scheme() const override { return "capture"; }
+
+  bool IsValidUri(const URI& /*uri*/) const override { return true; }
+
+  OrphanablePtr<Resolver> CreateResolver(ResolverArgs args) const override {
+    return MakeOrphanable<ServiceConfigCapturingResolver>(args.args);
+  }
+};
+
+class ServiceConfigSharingTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    CoreConfiguration::Reset();
+    CoreConfiguration::BuildSpecialConfiguration(
+        [](CoreConfiguration::Builder* builder) {
+          BuildCoreConfiguration(builder);
+          builder->resolver_registry()->RegisterResolverFactory(
+              absl::make_unique<ServiceConfigCapturingResolverFactory>());
+        });
+  }
+
+  void TearDown() override { CoreConfiguration::Reset(); }
+};
+
+TEST_F(ServiceConfigSharingTest, SharesServiceConfigsAcrossChannels) {
+  grpc_channel_credentials* creds = grpc_insecure_credentials_create();
+  grpc_channel* channels[2];
+  for (grpc_channel*& channel : channels) {
+    channel = grpc_channel_create("capture:///server", creds, nullptr);
+    // Leaving IDLE creates the channel's resolver.
+    grpc_channel_check_connectivity_state(channel, /*try_to_connect=*/1);
+  }
+  grpc_channel_credentials_release(creds);
+  CapturedServiceConfigs* captured = GetCapturedServiceConfigs();
+  std::vector<RefCountedPtr<ServiceConfig>> service_configs;
+  bool all_args_had_channelz_node = false;
+  const gpr_timespec deadline = grpc_timeout_seconds_to_deadline(10);
+  while (gpr_time_cmp(gpr_now(GPR_CLOCK_MONOTONIC), deadline) < 0) {
+    {
+      MutexLock lock(&captured->mu);
+      if (captured->service_configs.size() == 2) {
+        service_configs = std::move(captured->service_configs);
+        all_args_had_channelz_node = captured->all_args_had_channelz_node;
+        break;
+      }
+    }
+    gpr_sleep_until(grpc_timeout_milliseconds_to_deadline(10));
+  }
+  for (grpc_channel* channel : channels) grpc_channel_destroy(channel);
+  ASSERT_EQ(service_configs.size(), 2);
+  // Each channel passed its resolver args with its own channelz node, which
+  // must not keep the channels from sharing the config.
+  EXPECT_TRUE(all_args_had_channelz_node);
+  EXPECT_EQ(service_configs[0].get(), service_configs[1].get());
+}
+
 TEST(ServiceConfigParserTest, DoubleRegistration) {
   CoreConfiguration::Reset();
   ASSERT_DEATH_IF_SUPPORTED(
@@ -0,0 +1,128 @@
+//
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include "src/core/ext/filters/client_channel/lb_policy/weighted_round_robin/static_stride_scheduler.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include "test/core/util/test_config.h"
+
+namespace grpc_core {
+namespace testing {
+namespace {
+
+// Returns how many times each backend is picked in num_picks picks.
+std::vector<size_t> CountPicks(StaticStrideScheduler* scheduler,
+                               size_t num_backends, size_t num_picks) {
+  std::vector<size_t> counts(num_backends);
+  for (size_t i = 0; i < num_picks; ++i) {
+    ++counts[scheduler->Pick()];
+  }
+  return counts;
+}
+
+TEST(StaticStrideSchedulerTest, TooFewWeights) {
+  EXPECT_EQ(StaticStrideScheduler::Make({}, 0), nullptr);
+  EXPECT_EQ(StaticStrideScheduler::Make({5}, 0), nullptr);
+  EXPECT_EQ(StaticStrideScheduler::Make({0, 0, 0}, 0), nullptr);
+}
+
+TEST(StaticStrideSchedulerTest, HeaviestGetsMaxWeight) {
+  auto scheduler = StaticStrideScheduler::Make({1, 2, 4}, 0);
+  ASSERT_NE(scheduler, nullptr);
+  EXPECT_THAT(scheduler->weights(),
+              ::testing::ElementsAre(16384, 32768,
+                                     StaticStrideScheduler::kMaxWeight));
+}
+
+TEST(StaticStrideSchedulerTest, UnknownWeightsGetMean) {
+  auto scheduler = StaticStrideScheduler::Make({0, 1, 3, -1}, 0);
+  ASSERT_NE(scheduler, nullptr);
+  EXPECT_THAT(scheduler->weights(),
+              ::testing::ElementsAre(43690, 21845,
+                                     StaticStrideScheduler::kMaxWeight, 43690));
+}
+
+TEST(StaticStrideSchedulerTest, TinyWeightsAreClamped) {
+  auto scheduler = StaticStrideScheduler::Make({1e-6f, 1}, 0);
+  ASSERT_NE(scheduler, nullptr);
+  // The mean is about 0.5, so the tiny weight is raised to 0.005.
+  EXPECT_NEAR(scheduler->weights()[0],
+              StaticStrideScheduler::kMaxWeight * 0.005, 1);
+}
+
+TEST(StaticStrideSchedulerTest, PicksInProportionToWeights) {
+  const std::vector<float> weights = {1, 2, 3, 4};
+  for (uint32_t initial_sequence : {0u, 12345u, UINT32_MAX - 1000u}) {
+    auto scheduler = StaticStrideScheduler::Make(weights, initial_sequence);
+    ASSERT_NE(scheduler, nullptr);
+    const std::vector<size_t> counts =
+        CountPicks(scheduler.get(), weights.size(), 100000);
+    for (size_t i = 0; i < weights.size(); ++i) {
+      EXPECT_NEAR(counts[i], 10000 * weights[i], 100)
+          << "backend " << i << " initial_sequence " << initial_sequence;
+    }
+  }
+}
+
+TEST(StaticStrideSchedulerTest, EqualWeightsPickInTurn) {
+  auto scheduler = StaticStrideScheduler::Make({7, 7, 7}, 0);
+  ASSERT_NE(scheduler, nullptr);
+  for (size_t i = 0; i < 30; ++i) {
+    EXPECT_EQ(scheduler->Pick(), i % 3);
+  }
+}
+
+TEST(StaticStrideSchedulerTest, ConcurrentPicks) {
+  const std::vector<float> weights = {1, 1, 2};
+  auto scheduler = StaticStrideScheduler::Make(weights, 0);
+  ASSERT_NE(scheduler, nullptr);
+  constexpr size_t kNumThreads = 4;
+  constexpr size_t kPicksPerThread = 40000;
+  std::vector<std::vector<size_t>> counts(kNumThreads);
+  std::vector<std::thread> threads;
+  for (size_t t = 0; t < kNumThreads; ++t) {
+    threads.emplace_back([&, t]() {
+      counts[t] = CountPicks(scheduler.get(), weights.size(), kPicksPerThread);
+    });
+  }
+  for (auto& thread : threads) thread.join();
+  std::vector<size_t> totals(weights.size());
+  for (const auto& thread_counts : counts) {
+    for (size_t i = 0; i < weights.size(); ++i) totals[i] += thread_counts[i];
+  }
+  EXPECT_NEAR(totals[0], kNumThreads * kPicksPerThread / 4, 200);
+  EXPECT_NEAR(totals[1], kNumThreads * kPicksPerThread / 4, 200);
+  EXPECT_NEAR(totals[2], kNumThreads * kPicksPerThread / 2, 200);
+}
+
+}  // namespace
+}  // namespace testing
+}  // namespace grpc_core
+
+int main(int argc, char** argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  grpc::testing::TestEnvironment env(&argc, argv);
+  return RUN_ALL_TESTS();
+}
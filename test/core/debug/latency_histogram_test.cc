@@ -0,0 +1,139 @@
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "src/core/lib/debug/latency_histogram.h"
+
+#include <stdint.h>
+
+#include <algorithm>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <grpc/grpc.h>
+
+#include "src/core/lib/channel/channelz.h"
+#include "src/core/lib/iomgr/exec_ctx.h"
+#include "test/core/util/test_config.h"
+
+namespace grpc_core {
+namespace testing {
+namespace {
+
+TEST(LatencyHistogramTest, BucketsCoverAllLatencies) {
+  EXPECT_EQ(LatencyHistogram::BucketFor(0), 0);
+  EXPECT_EQ(LatencyHistogram::BucketStart(0), 0);
+  for (int i = 0; i + 1 < LatencyHistogram::kBuckets; ++i) {
+    const uint64_t start = LatencyHistogram::BucketStart(i);
+    const uint64_t end = LatencyHistogram::BucketStart(i + 1);
+    ASSERT_LT(start, end) << i;
+    EXPECT_EQ(LatencyHistogram::BucketFor(start), i);
+    EXPECT_EQ(LatencyHistogram::BucketFor(end - 1), i);
+    // Buckets are at most 1/8 as wide as their lower bound.
+    EXPECT_LE((end - start) * LatencyHistogram::kSubBuckets,
+              std::max<uint64_t>(start, LatencyHistogram::kSubBuckets))
+        << i;
+  }
+  EXPECT_EQ(LatencyHistogram::BucketFor(uint64_t(1) << 32),
+            LatencyHistogram::kBuckets - 1);
+  EXPECT_EQ(LatencyHistogram::BucketFor(UINT64_MAX),
+            LatencyHistogram::kBuckets - 1);
+}
+
+TEST(LatencyHistogramTest, Percentiles) {
+  ExecCtx exec_ctx;
+  LatencyHistogram histogram;
+  for (uint64_t micros = 1; micros <= 10000; ++micros) {
+    histogram.RecordMicros(micros);
+  }
+  LatencyHistogram::Snapshot snapshot = histogram.Collect();
+  EXPECT_EQ(snapshot.Count(), 10000);
+  EXPECT_NEAR(snapshot.Percentile(50), 5000, 5000 * 0.07);
+  EXPECT_NEAR(snapshot.Percentile(90), 9000, 9000 * 0.07);
+  EXPECT_NEAR(snapshot.Percentile(99), 9900, 9900 * 0.07);
+  EXPECT_EQ(LatencyHistogram::Snapshot().Percentile(99), 0);
+}
+
+TEST(LatencyHistogramTest, RecordsTimespecs) {
+  ExecCtx exec_ctx;
+  LatencyHistogram histogram;
+  histogram.Record(gpr_time_from_millis(3, GPR_TIMESPAN));
+  histogram.Record(gpr_time_from_seconds(2, GPR_TIMESPAN));
+  LatencyHistogram::Snapshot snapshot = histogram.Collect();
+  EXPECT_EQ(snapshot.Count(), 2);
+  EXPECT_EQ(snapshot.buckets()[LatencyHistogram::BucketFor(3000)], 1);
+  EXPECT_EQ(snapshot.buckets()[LatencyHistogram::BucketFor(2000000)], 1);
+}
+
+TEST(LatencyHistogramTest, MergesConcurrentRecords) {
+  constexpr int kThreads = 8;
+  constexpr int kRecordsPerThread = 10000;
+  LatencyHistogram histogram;
+  std::vector<std::thread> threads;
+  for (int i = 0; i < kThreads; ++i) {
+    threads.emplace_back([&histogram, i]() {
+      ExecCtx exec_ctx;
+      for (int j = 0; j < kRecordsPerThread; ++j) {
+        histogram.RecordMicros(100 * (i + 1));
+      }
+    });
+  }
+  for (auto& thread : threads) thread.join();
+  LatencyHistogram::Snapshot snapshot = histogram.Collect();
+  EXPECT_EQ(snapshot.Count(), kThreads * kRecordsPerThread);
+  for (int i = 0; i < kThreads; ++i) {
+    EXPECT_EQ(snapshot.buckets()[LatencyHistogram::BucketFor(100 * (i + 1))],
+              kRecordsPerThread);
+  }
+}
+
+TEST(MethodLatencyStatsTest, OneHistogramPerMethod) {
+  channelz::MethodLatencyStats stats;
+  LatencyHistogram* foo = stats.GetHistogram("/svc/Foo");
+  LatencyHistogram* bar = stats.GetHistogram("/svc/Bar");
+  EXPECT_NE(foo, bar);
+  EXPECT_EQ(stats.GetHistogram("/svc/Foo"), foo);
+  auto snapshots = stats.Collect();
+  ASSERT_EQ(snapshots.size(), 2);
+  EXPECT_EQ(snapshots.count("/svc/Foo"), 1);
+  EXPECT_EQ(snapshots.count("/svc/Bar"), 1);
+}
+
+TEST(MethodLatencyStatsTest, MethodsBeyondLimitShareAHistogram) {
+  channelz::MethodLatencyStats stats;
+  for (size_t i = 0; i < channelz::MethodLatencyStats::kMaxMethods; ++i) {
+    stats.GetHistogram("/svc/Method" + std::to_string(i));
+  }
+  LatencyHistogram* other = stats.GetHistogram("/svc/Extra1");
+  EXPECT_EQ(stats.GetHistogram("/svc/Extra2"), other);
+  EXPECT_NE(stats.GetHistogram("/svc/Method0"), other);
+  auto snapshots = stats.Collect();
+  EXPECT_EQ(snapshots.size(), channelz::MethodLatencyStats::kMaxMethods + 1);
+  EXPECT_EQ(snapshots.count(channelz::MethodLatencyStats::kOtherMethods), 1);
+}
+
+}  // namespace
+}  // namespace testing
+}  // namespace grpc_core
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(&argc, argv);
+  ::testing::InitGoogleTest(&argc, argv);
+  grpc_init();
+  int ret = RUN_ALL_TESTS();
+  grpc_shutdown();
+  return ret;
+}
@@ -0,0 +1,90 @@
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "src/core/lib/gprpp/per_cpu.h"
+
+#include <stdint.h>
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <grpc/grpc.h>
+#include <grpc/support/cpu.h>
+
+#include "test/core/util/test_config.h"
+
+namespace grpc_core {
+namespace testing {
+
+TEST(PerCpuTest, OneShardPerCore) {
+  PerCpu<int> per_cpu;
+  EXPECT_EQ(per_cpu.size(), std::max(1u, gpr_cpu_num_cores()));
+  for (size_t cpu = 0; cpu < per_cpu.size(); ++cpu) {
+    EXPECT_EQ(per_cpu[cpu], 0);
+  }
+}
+
+TEST(PerCpuTest, ShardsAreOnSeparateCacheLines) {
+  PerCpu<int> per_cpu;
+  for (size_t cpu = 0; cpu < per_cpu.size(); ++cpu) {
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(&per_cpu[cpu]) % GPR_CACHELINE_SIZE,
+              0);
+  }
+}
+
+TEST(PerCpuTest, ThisCpuIsOneOfTheShards) {
+  ExecCtx exec_ctx;
+  PerCpu<int> per_cpu;
+  per_cpu.this_cpu() = 1;
+  int sum = 0;
+  for (size_t cpu = 0; cpu < per_cpu.size(); ++cpu) sum += per_cpu[cpu];
+  EXPECT_EQ(sum, 1);
+}
+
+TEST(PerCpuTest, ConcurrentUpdatesAreMerged) {
+  constexpr int kThreads = 8;
+  constexpr int kIncrementsPerThread = 10000;
+  PerCpu<std::atomic<int64_t>> per_cpu;
+  std::vector<std::thread> threads;
+  for (int i = 0; i < kThreads; ++i) {
+    threads.emplace_back([&per_cpu]() {
+      for (int j = 0; j < kIncrementsPerThread; ++j) {
+        ExecCtx exec_ctx;
+        per_cpu.this_cpu().fetch_add(1, std::memory_order_relaxed);
+      }
+    });
+  }
+  for (auto& thread : threads) thread.join();
+  int64_t sum = 0;
+  for (size_t cpu = 0; cpu < per_cpu.size(); ++cpu) {
+    sum += per_cpu[cpu].load(std::memory_order_relaxed);
+  }
+  EXPECT_EQ(sum, kThreads * kIncrementsPerThread);
+}
+
+}  // namespace testing
+}  // namespace grpc_core
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(&argc, argv);
+  ::testing::InitGoogleTest(&argc, argv);
+  grpc_init();
+  int ret = RUN_ALL_TESTS();
+  grpc_shutdown();
+  return ret;
+}
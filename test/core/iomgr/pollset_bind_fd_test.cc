@@ -0,0 +1,189 @@
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "src/core/lib/iomgr/port.h"
+
+// This test won't work except with the epoll1 engine available
+#ifdef GRPC_LINUX_EPOLL
+
+#include <fcntl.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <grpc/grpc.h>
+#include <grpc/support/alloc.h>
+#include <grpc/support/log.h>
+#include <grpc/support/sync.h>
+
+#include "src/core/lib/iomgr/ev_epoll1_linux.h"
+#include "src/core/lib/iomgr/ev_posix.h"
+#include "src/core/lib/iomgr/exec_ctx.h"
+#include "src/core/lib/iomgr/pollset.h"
+#include "test/core/util/test_config.h"
+
+namespace {
+
+struct test_pollset {
+  grpc_pollset* pollset;
+  gpr_mu* mu;
+};
+
+struct test_fd {
+  grpc_fd* fd;
+  int peer;
+  bool readable;
+  grpc_closure on_readable;
+};
+
+void create_pollset(test_pollset* ps) {
+  ps->pollset = static_cast<grpc_pollset*>(gpr_zalloc(grpc_pollset_size()));
+  grpc_pollset_init(ps->pollset, &ps->mu);
+}
+
+void destroy_pollset(void* p, grpc_error_handle /*error*/) {
+  grpc_pollset_destroy(static_cast<grpc_pollset*>(p));
+}
+
+void shutdown_pollset(test_pollset* ps) {
+  grpc_closure destroyed;
+  GRPC_CLOSURE_INIT(&destroyed, destroy_pollset, ps->pollset,
+                    grpc_schedule_on_exec_ctx);
+  gpr_mu_lock(ps->mu);
+  grpc_pollset_shutdown(ps->pollset, &destroyed);
+  gpr_mu_unlock(ps->mu);
+  grpc_core::ExecCtx::Get()->Flush();
+  gpr_free(ps->pollset);
+}
+
+void on_readable(void* arg, grpc_error_handle /*error*/) {
+  static_cast<test_fd*>(arg)->readable = true;
+}
+
+// Wraps one end of a socketpair, waiting for it to become readable.
+void create_fd(test_fd* tfd) {
+  int sv[2];
+  GPR_ASSERT(socketpair(AF_UNIX, SOCK_STREAM, 0, sv) == 0);
+  GPR_ASSERT(fcntl(sv[0], F_SETFL, O_NONBLOCK) == 0);
+  tfd->fd = grpc_fd_create(sv[0], "pollset_bind_fd_test", false);
+  tfd->peer = sv[1];
+  tfd->readable = false;
+  GRPC_CLOSURE_INIT(&tfd->on_readable, on_readable, tfd,
+                    grpc_schedule_on_exec_ctx);
+  grpc_fd_notify_on_read(tfd->fd, &tfd->on_readable);
+}
+
+void destroy_fd(test_fd* tfd) {
+  grpc_fd_orphan(tfd->fd, nullptr, nullptr, "pollset_bind_fd_test");
+  close(tfd->peer);
+  grpc_core::ExecCtx::Get()->Flush();
+}
+
+void make_readable(test_fd* tfd) {
+  GPR_ASSERT(write(tfd->peer, "x", 1) == 1);
+}
+
+// Polls ps until tfd is readable or timeout passes.
+void poll_for(test_pollset* ps, test_fd* tfd, grpc_core::Duration timeout) {
+  grpc_core::Timestamp deadline = grpc_core::ExecCtx::Get()->Now() + timeout;
+  while (!tfd->readable && grpc_core::ExecCtx::Get()->Now() < deadline) {
+    gpr_mu_lock(ps->mu);
+    GRPC_LOG_IF_ERROR("pollset_work",
+                      grpc_pollset_work(ps->pollset, nullptr, deadline));
+    gpr_mu_unlock(ps->mu);
+    grpc_core::ExecCtx::Get()->Flush();
+    grpc_core::ExecCtx::Get()->InvalidateNow();
+  }
+}
+
+// Pollsets are spread over two shards: a and b, created one after the
+// other, land on different ones.
+void test_unbound_fd_polled_by_any_shard(test_pollset* a, test_pollset* b) {
+  gpr_log(GPR_INFO, "test_unbound_fd_polled_by_any_shard");
+  test_fd tfd;
+  create_fd(&tfd);
+  make_readable(&tfd);
+  poll_for(b, &tfd, grpc_core::Duration::Seconds(5));
+  GPR_ASSERT(tfd.readable);
+  destroy_fd(&tfd);
+
+  create_fd(&tfd);
+  make_readable(&tfd);
+  poll_for(a, &tfd, grpc_core::Duration::Seconds(5));
+  GPR_ASSERT(tfd.readable);
+  destroy_fd(&tfd);
+}
+
+void test_bound_fd_polled_by_its_shard_only(test_pollset* a,
+                                            test_pollset* b) {
+  gpr_log(GPR_INFO, "test_bound_fd_polled_by_its_shard_only");
+  test_fd tfd;
+  create_fd(&tfd);
+  grpc_pollset_bind_fd(a->pollset, tfd.fd);
+  make_readable(&tfd);
+  poll_for(b, &tfd, grpc_core::Duration::Milliseconds(200));
+  GPR_ASSERT(!tfd.readable);
+  poll_for(a, &tfd, grpc_core::Duration::Seconds(5));
+  GPR_ASSERT(tfd.readable);
+  destroy_fd(&tfd);
+}
+
+void test_bind_after_readable(test_pollset* a, test_pollset* b) {
+  gpr_log(GPR_INFO, "test_bind_after_readable");
+  test_fd tfd;
+  create_fd(&tfd);
+  // Moving an fd that is already readable must not lose the event.
+  make_readable(&tfd);
+  grpc_pollset_bind_fd(b->pollset, tfd.fd);
+  poll_for(a, &tfd, grpc_core::Duration::Milliseconds(200));
+  GPR_ASSERT(!tfd.readable);
+  poll_for(b, &tfd, grpc_core::Duration::Seconds(5));
+  GPR_ASSERT(tfd.readable);
+  destroy_fd(&tfd);
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(&argc, argv);
+  GPR_GLOBAL_CONFIG_SET(grpc_poll_strategy, "epoll1");
+  GPR_GLOBAL_CONFIG_SET(grpc_epoll1_shards, 2);
+  grpc_init();
+  if (strcmp(grpc_get_poll_strategy_name(), "epoll1") != 0) {
+    gpr_log(GPR_INFO, "epoll1 unavailable, skipping");
+    grpc_shutdown();
+    return 0;
+  }
+  GPR_ASSERT(grpc_event_engine_shards_pollsets());
+  {
+    grpc_core::ExecCtx exec_ctx;
+    test_pollset a;
+    test_pollset b;
+    create_pollset(&a);
+    create_pollset(&b);
+    test_unbound_fd_polled_by_any_shard(&a, &b);
+    test_bound_fd_polled_by_its_shard_only(&a, &b);
+    test_bind_after_readable(&a, &b);
+    shutdown_pollset(&a);
+    shutdown_pollset(&b);
+  }
+  grpc_shutdown();
+  return 0;
+}
+
+#else /* GRPC_LINUX_EPOLL */
+
+int main(int /*argc*/, char** /*argv*/) { return 0; }
+
+#endif /* GRPC_LINUX_EPOLL */
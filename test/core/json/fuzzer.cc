@@ -24,14 +24,22 @@
 #include <grpc/support/log.h>
 
 #include "src/core/lib/json/json.h"
+#include "src/core/lib/json/json_view.h"
 
 bool squelch = true;
 bool leak_check = true;
 
 extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size) {
   grpc_error_handle error = GRPC_ERROR_NONE;
-  auto json = grpc_core::Json::Parse(
-      absl::string_view(reinterpret_cast<const char*>(data), size), &error);
+  absl::string_view text(reinterpret_cast<const char*>(data), size);
+  auto json = grpc_core::Json::Parse(text, &error);
+  // JsonDocument accepts no input that the reader rejects, and reads the
+  // same values.
+  auto document = grpc_core::JsonDocument::Parse(text);
+  if (document.has_value()) {
+    GPR_ASSERT(error == GRPC_ERROR_NONE);
+    GPR_ASSERT(document->root().ToJson() == json);
+  }
   if (error == GRPC_ERROR_NONE) {
     auto text2 = json.Dump();
     auto json2 = grpc_core::Json::Parse(text2, &error);
@@ -0,0 +1,152 @@
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "src/core/lib/json/json_view.h"
+
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include "absl/strings/str_cat.h"
+
+#include "src/core/lib/json/json.h"
+#include "test/core/util/test_config.h"
+
+namespace grpc_core {
+namespace testing {
+namespace {
+
+// Checks that JsonDocument reads json_str exactly as Json::Parse does.
+void ExpectSameAsJsonParse(absl::string_view json_str) {
+  grpc_error_handle error = GRPC_ERROR_NONE;
+  Json expected = Json::Parse(json_str, &error);
+  ASSERT_EQ(error, GRPC_ERROR_NONE) << json_str;
+  absl::optional<JsonDocument> document = JsonDocument::Parse(json_str);
+  ASSERT_TRUE(document.has_value()) << json_str;
+  EXPECT_EQ(document->root().ToJson(), expected) << json_str;
+}
+
+void ExpectParseFailure(absl::string_view json_str) {
+  EXPECT_FALSE(JsonDocument::Parse(json_str).has_value()) << json_str;
+}
+
+TEST(JsonViewTest, Scalars) {
+  auto document = JsonDocument::Parse(
+      "[null, true, false, -1.5e+3, \"foo\", \"a\\nb\\u00e9\\ud834\\udd1e\"]");
+  ASSERT_TRUE(document.has_value());
+  JsonView root = document->root();
+  ASSERT_EQ(root.type(), Json::Type::ARRAY);
+  ASSERT_EQ(root.size(), 6);
+  EXPECT_EQ(root[0].type(), Json::Type::JSON_NULL);
+  EXPECT_EQ(root[1].type(), Json::Type::JSON_TRUE);
+  EXPECT_EQ(root[2].type(), Json::Type::JSON_FALSE);
+  EXPECT_EQ(root[3].type(), Json::Type::NUMBER);
+  EXPECT_EQ(root[3].string_value(), "-1.5e+3");
+  EXPECT_EQ(root[4].type(), Json::Type::STRING);
+  EXPECT_EQ(root[4].string_value(), "foo");
+  EXPECT_EQ(root[5].string_value(), "a\nb\xc3\xa9\xf0\x9d\x84\x9e");
+}
+
+TEST(JsonViewTest, ObjectMembersAreSortedByKey) {
+  auto document =
+      JsonDocument::Parse("{\"b\": 1, \"a\": [true], \"c\": {}, \"\": 2}");
+  ASSERT_TRUE(document.has_value());
+  JsonView root = document->root();
+  ASSERT_EQ(root.type(), Json::Type::OBJECT);
+  ASSERT_EQ(root.size(), 4);
+  EXPECT_EQ(root.key(0), "");
+  EXPECT_EQ(root.key(1), "a");
+  EXPECT_EQ(root.key(2), "b");
+  EXPECT_EQ(root.key(3), "c");
+  EXPECT_EQ(root.value(2).string_value(), "1");
+  auto a = root.Find("a");
+  ASSERT_TRUE(a.has_value());
+  ASSERT_EQ(a->size(), 1);
+  EXPECT_EQ((*a)[0].type(), Json::Type::JSON_TRUE);
+  auto c = root.Find("c");
+  ASSERT_TRUE(c.has_value());
+  EXPECT_EQ(c->type(), Json::Type::OBJECT);
+  EXPECT_EQ(c->size(), 0);
+  EXPECT_FALSE(root.Find("d").has_value());
+  EXPECT_FALSE(root.Find("aa").has_value());
+}
+
+TEST(JsonViewTest, SameAsJsonParse) {
+  ExpectSameAsJsonParse("0");
+  ExpectSameAsJsonParse(" \t\r\n\"\" ");
+  ExpectSameAsJsonParse("[[], {}, [{}], {\"x\": []}]");
+  ExpectSameAsJsonParse("[0, -0, 0.5, 1e10, 1E-10, -12.34e+56]");
+  ExpectSameAsJsonParse("{\"\\u0001\\\"\\\\\\/\\b\\f\\r\\t\": \"\\u00ff\"}");
+  ExpectSameAsJsonParse(
+      "{\"methodConfig\": [{\"name\": [{\"service\": \"foo\"}], "
+      "\"retryPolicy\": {\"maxAttempts\": 3, \"initialBackoff\": \"1s\", "
+      "\"retryableStatusCodes\": [\"UNAVAILABLE\"]}}]}");
+}
+
+// Moves quotes and backslashes across the 64-byte blocks the input is
+// classified in.
+TEST(JsonViewTest, StringsAcrossBlocks) {
+  for (size_t padding = 0; padding < 130; ++padding) {
+    const std::string pad(padding, ' ');
+    ExpectSameAsJsonParse(absl::StrCat(pad, "\"", pad, "\""));
+    ExpectSameAsJsonParse(absl::StrCat("[", pad, "\"\\\\\", \"\\\"", pad,
+                                       "\\\\\\\"\", ", pad, "1]"));
+    ExpectSameAsJsonParse(
+        absl::StrCat("{\"", pad, "\\\\\": \"x", pad, "\\u00e9[{,:}]\"}"));
+  }
+}
+
+TEST(JsonViewTest, InvalidInput) {
+  ExpectParseFailure("");
+  ExpectParseFailure("nul");
+  ExpectParseFailure("nulll");
+  ExpectParseFailure("{\"foo\": bar}");
+  ExpectParseFailure("0,0");
+  ExpectParseFailure("{}}");
+  ExpectParseFailure("[[]");
+  ExpectParseFailure("[1,2,]");
+  ExpectParseFailure("{\"a\": 1, }");
+  ExpectParseFailure("{\"a\" 1}");
+  ExpectParseFailure("[\"x\": 0]");
+  ExpectParseFailure("{\"a\": 1, \"a\": 2}");
+  ExpectParseFailure("\"\\x\"");
+  ExpectParseFailure("\"\t\"");
+  ExpectParseFailure("\"\\ud834\"");
+  ExpectParseFailure("\"\\udd1e\"");
+  ExpectParseFailure("\"\xc3\"");
+  ExpectParseFailure("\"\xff\"");
+  ExpectParseFailure("01");
+  ExpectParseFailure("1.");
+  ExpectParseFailure("1e");
+  ExpectParseFailure("-");
+  ExpectParseFailure("\"unterminated");
+}
+
+TEST(JsonViewTest, DepthLimit) {
+  EXPECT_TRUE(JsonDocument::Parse(absl::StrCat(std::string(255, '['),
+                                               std::string(255, ']')))
+                  .has_value());
+  ExpectParseFailure(
+      absl::StrCat(std::string(256, '['), std::string(256, ']')));
+}
+
+}  // namespace
+}  // namespace testing
+}  // namespace grpc_core
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(&argc, argv);
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,173 @@
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "src/core/lib/profiling/contention_profiler.h"
+
+#include <stdlib.h>
+
+#include <atomic>
+#include <string>
+#include <thread>
+
+#include "absl/base/attributes.h"
+
+#include <gtest/gtest.h>
+
+#include <grpc/grpc.h>
+#include <grpc/support/time.h>
+
+#include "src/core/lib/gprpp/debug_location.h"
+#include "src/core/lib/gprpp/sync.h"
+#include "src/core/lib/json/json.h"
+#include "test/core/util/test_config.h"
+
+namespace grpc_core {
+namespace testing {
+namespace {
+
+ABSL_CONST_INIT ContentionSite g_site("contention_profiler_test");
+
+// Returns the dumped JSON for g_site, or null if it is not in the dump.
+Json DumpedSite() {
+  grpc_error_handle error = GRPC_ERROR_NONE;
+  Json dump = Json::Parse(ContentionProfiler::DumpJson(), &error);
+  EXPECT_EQ(error, GRPC_ERROR_NONE) << grpc_error_std_string(error);
+  for (const Json& site : dump.object_value().at("site").array_value()) {
+    if (site.object_value().at("name").string_value() == g_site.name()) {
+      return site;
+    }
+  }
+  return Json();
+}
+
+uint64_t Count(const Json& site, const char* histogram) {
+  return strtoull(site.object_value()
+                      .at(histogram)
+                      .object_value()
+                      .at("count")
+                      .string_value()
+                      .c_str(),
+                  nullptr, 10);
+}
+
+class ContentionProfilerTest : public ::testing::Test {
+ protected:
+  void TearDown() override {
+    ContentionProfiler::SetSamplePeriod(0);
+    ContentionProfiler::Clear();
+  }
+};
+
+TEST_F(ContentionProfilerTest, RecordsNothingWhenDisabled) {
+  ContentionProfiler::SetSamplePeriod(0);
+  Mutex mu;
+  for (int i = 0; i < 10; ++i) {
+    ProfiledMutexLock lock(&mu, &g_site, DEBUG_LOCATION);
+  }
+  Json site = DumpedSite();
+  if (site.type() == Json::Type::JSON_NULL) return;
+  EXPECT_EQ(Count(site, "wait"), 0);
+  EXPECT_EQ(Count(site, "sampledHold"), 0);
+}
+
+TEST_F(ContentionProfilerTest, RecordsContendedWaits) {
+  ContentionProfiler::SetSamplePeriod(1000);
+  Mutex mu;
+  std::atomic<bool> locked{false};
+  std::thread holder([&mu, &locked] {
+    MutexLock lock(&mu);
+    locked.store(true);
+    gpr_sleep_until(grpc_timeout_milliseconds_to_deadline(50));
+  });
+  while (!locked.load()) std::this_thread::yield();
+  { ProfiledMutexLock lock(&mu, &g_site, DEBUG_LOCATION); }
+  holder.join();
+  Json site = DumpedSite();
+  ASSERT_EQ(site.type(), Json::Type::OBJECT);
+  EXPECT_EQ(Count(site, "wait"), 1);
+  const Json::Object& wait = site.object_value().at("wait").object_value();
+  EXPECT_GE(strtoull(wait.at("totalNanos").string_value().c_str(), nullptr, 10),
+            10 * GPR_NS_PER_MS);
+  EXPECT_GE(strtoull(wait.at("p50Nanos").string_value().c_str(), nullptr, 10),
+            10 * GPR_NS_PER_MS);
+  const Json::Array& call_sites =
+      site.object_value().at("callSite").array_value();
+  ASSERT_EQ(call_sites.size(), 1);
+  EXPECT_EQ(call_sites[0].object_value().at("waits").string_value(), "1");
+#ifndef NDEBUG
+  EXPECT_NE(call_sites[0].object_value().at("location").string_value().find(
+                "contention_profiler_test.cc"),
+            std::string::npos);
+#endif
+}
+
+TEST_F(ContentionProfilerTest, SamplesHoldTimes) {
+  // With a period of 1, every acquisition is sampled.
+  ContentionProfiler::SetSamplePeriod(1);
+  Mutex mu;
+  for (int i = 0; i < 10; ++i) {
+    ProfiledMutexLock lock(&mu, &g_site, DEBUG_LOCATION);
+  }
+  {
+    ContentionHoldScope hold(&g_site, DEBUG_LOCATION);
+    gpr_sleep_until(grpc_timeout_milliseconds_to_deadline(10));
+  }
+  Json site = DumpedSite();
+  ASSERT_EQ(site.type(), Json::Type::OBJECT);
+  EXPECT_EQ(Count(site, "wait"), 0);
+  EXPECT_EQ(Count(site, "sampledHold"), 11);
+  const Json::Object& hold =
+      site.object_value().at("sampledHold").object_value();
+  EXPECT_GE(strtoull(hold.at("totalNanos").string_value().c_str(), nullptr, 10),
+            9 * GPR_NS_PER_MS);
+#ifndef NDEBUG
+  EXPECT_EQ(site.object_value().at("callSite").array_value().size(), 2);
+#endif
+}
+
+TEST_F(ContentionProfilerTest, SamplesOneInPeriodOnAverage) {
+  ContentionProfiler::SetSamplePeriod(10);
+  Mutex mu;
+  for (int i = 0; i < 10000; ++i) {
+    ProfiledMutexLock lock(&mu, &g_site, DEBUG_LOCATION);
+  }
+  Json site = DumpedSite();
+  ASSERT_EQ(site.type(), Json::Type::OBJECT);
+  EXPECT_GT(Count(site, "sampledHold"), 500);
+  EXPECT_LT(Count(site, "sampledHold"), 2000);
+}
+
+TEST_F(ContentionProfilerTest, ClearResetsHistograms) {
+  ContentionProfiler::SetSamplePeriod(1);
+  Mutex mu;
+  { ProfiledMutexLock lock(&mu, &g_site, DEBUG_LOCATION); }
+  ASSERT_EQ(Count(DumpedSite(), "sampledHold"), 1);
+  ContentionProfiler::Clear();
+  Json site = DumpedSite();
+  EXPECT_EQ(Count(site, "sampledHold"), 0);
+  EXPECT_TRUE(site.object_value().at("callSite").array_value().empty());
+}
+
+}  // namespace
+}  // namespace testing
+}  // namespace grpc_core
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(&argc, argv);
+  ::testing::InitGoogleTest(&argc, argv);
+  grpc_init();
+  int ret = RUN_ALL_TESTS();
+  grpc_shutdown();
+  return ret;
+}
@@ -0,0 +1,75 @@
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "src/core/lib/profiling/sampling_countdown.h"
+
+#include <gtest/gtest.h>
+
+#include "test/core/util/test_config.h"
+
+namespace grpc_core {
+namespace testing {
+namespace {
+
+struct TagA {};
+struct TagB {};
+
+TEST(SamplingCountdownTest, PeriodZeroSamplesNothing) {
+  for (int i = 0; i < 1000; i++) {
+    EXPECT_FALSE(SamplingCountdown<TagA>::ShouldSample(0));
+  }
+}
+
+TEST(SamplingCountdownTest, PeriodOneSamplesEverything) {
+  for (int i = 0; i < 1000; i++) {
+    EXPECT_TRUE(SamplingCountdown<TagA>::ShouldSample(1));
+  }
+}
+
+TEST(SamplingCountdownTest, SamplesOneInPeriodOnAverage) {
+  constexpr int kPeriod = 10;
+  constexpr int kEvents = 100000;
+  int samples = 0;
+  for (int i = 0; i < kEvents; i++) {
+    if (SamplingCountdown<TagA>::ShouldSample(kPeriod)) samples++;
+  }
+  EXPECT_GT(samples, kEvents / kPeriod * 9 / 10);
+  EXPECT_LT(samples, kEvents / kPeriod * 11 / 10);
+}
+
+TEST(SamplingCountdownTest, RedrawsCountdownWhenPeriodShrinks) {
+  // Leaves a countdown drawn for a long period.
+  SamplingCountdown<TagA>::ShouldSample(1);
+  SamplingCountdown<TagA>::ShouldSample(1000000);
+  EXPECT_TRUE(SamplingCountdown<TagA>::ShouldSample(1));
+}
+
+TEST(SamplingCountdownTest, TagsCountDownSeparately) {
+  SamplingCountdown<TagA>::ShouldSample(1);
+  SamplingCountdown<TagA>::ShouldSample(1000000);
+  for (int i = 0; i < 1000; i++) {
+    EXPECT_TRUE(SamplingCountdown<TagB>::ShouldSample(1));
+  }
+  EXPECT_FALSE(SamplingCountdown<TagA>::ShouldSample(1000000));
+}
+
+}  // namespace
+}  // namespace testing
+}  // namespace grpc_core
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(&argc, argv);
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,145 @@
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "src/core/lib/profiling/trace_point.h"
+
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <grpc/grpc.h>
+
+#include "src/core/lib/json/json.h"
+#include "test/core/util/test_config.h"
+
+namespace grpc_core {
+namespace testing {
+namespace {
+
+void HitTracePoint() { GRPC_TRACE_POINT_SCOPE("trace_point_test"); }
+
+// Returns the events for HitTracePoint() in the dumped trace.
+std::vector<Json> DumpedEvents() {
+  grpc_error_handle error = GRPC_ERROR_NONE;
+  Json trace = Json::Parse(ContinuousProfiler::DumpChromeTraceJson(), &error);
+  EXPECT_EQ(error, GRPC_ERROR_NONE) << grpc_error_std_string(error);
+  std::vector<Json> events;
+  for (const Json& event :
+       trace.object_value().at("traceEvents").array_value()) {
+    if (event.object_value().at("name").string_value() ==
+        "trace_point_test") {
+      events.push_back(event);
+    }
+  }
+  return events;
+}
+
+class TracePointTest : public ::testing::Test {
+ protected:
+  void TearDown() override {
+    ContinuousProfiler::SetSamplePeriod(
+        ContinuousProfiler::kDefaultSamplePeriod);
+  }
+};
+
+TEST_F(TracePointTest, RecordsNothingWhenDisabled) {
+  ContinuousProfiler::SetSamplePeriod(0);
+  ContinuousProfiler::Clear();
+  for (int i = 0; i < 1000; ++i) HitTracePoint();
+  EXPECT_TRUE(DumpedEvents().empty());
+}
+
+TEST_F(TracePointTest, PeriodOneRecordsEveryHit) {
+  ContinuousProfiler::SetSamplePeriod(1);
+  ContinuousProfiler::Clear();
+  for (int i = 0; i < 10; ++i) HitTracePoint();
+  std::vector<Json> events = DumpedEvents();
+  ASSERT_EQ(events.size(), 10);
+  const Json::Object& event = events[0].object_value();
+  EXPECT_EQ(event.at("ph").string_value(), "X");
+  EXPECT_NE(event.at("args").object_value().at("location").string_value().find(
+                "trace_point_test.cc:"),
+            std::string::npos);
+}
+
+TEST_F(TracePointTest, SamplesAboutOneHitPerPeriod) {
+  ContinuousProfiler::SetSamplePeriod(10);
+  ContinuousProfiler::Clear();
+  for (int i = 0; i < 5000; ++i) HitTracePoint();
+  const size_t samples = DumpedEvents().size();
+  EXPECT_GE(samples, 250);
+  EXPECT_LE(samples, 750);
+}
+
+TEST_F(TracePointTest, KeepsMostRecentSamples) {
+  ContinuousProfiler::SetSamplePeriod(1);
+  ContinuousProfiler::Clear();
+  for (size_t i = 0; i < 3 * ContinuousProfiler::kRingSize; ++i) {
+    HitTracePoint();
+  }
+  EXPECT_EQ(DumpedEvents().size(), ContinuousProfiler::kRingSize);
+}
+
+TEST_F(TracePointTest, EachThreadRecordsIntoItsOwnRing) {
+  constexpr int kThreads = 4;
+  constexpr int kHitsPerThread = 100;
+  ContinuousProfiler::SetSamplePeriod(1);
+  ContinuousProfiler::Clear();
+  std::vector<std::thread> threads;
+  for (int i = 0; i < kThreads; ++i) {
+    threads.emplace_back([]() {
+      for (int j = 0; j < kHitsPerThread; ++j) HitTracePoint();
+    });
+  }
+  for (auto& thread : threads) thread.join();
+  std::vector<Json> events = DumpedEvents();
+  EXPECT_EQ(events.size(), kThreads * kHitsPerThread);
+  std::set<std::string> thread_ids;
+  for (const Json& event : events) {
+    thread_ids.insert(event.object_value().at("tid").string_value());
+  }
+  EXPECT_EQ(thread_ids.size(), kThreads);
+}
+
+#ifdef GPR_POSIX_SYNC
+TEST_F(TracePointTest, KeepsRecordingAsThreadsComeAndGo) {
+  ContinuousProfiler::SetSamplePeriod(1);
+  // Many more threads than there are rings, though never more than one
+  // at a time.
+  for (size_t i = 0; i < 4 * ContinuousProfiler::kMaxRings; ++i) {
+    std::thread([]() { HitTracePoint(); }).join();
+  }
+  ContinuousProfiler::Clear();
+  std::thread([]() {
+    for (int i = 0; i < 10; ++i) HitTracePoint();
+  }).join();
+  EXPECT_EQ(DumpedEvents().size(), 10);
+}
+#endif  // GPR_POSIX_SYNC
+
+}  // namespace
+}  // namespace testing
+}  // namespace grpc_core
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(&argc, argv);
+  ::testing::InitGoogleTest(&argc, argv);
+  grpc_init();
+  int ret = RUN_ALL_TESTS();
+  grpc_shutdown();
+  return ret;
+}
@@ -0,0 +1,118 @@
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <string.h>
+
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "src/core/lib/iomgr/exec_ctx.h"
+#include "src/core/lib/resource_quota/arena.h"
+#include "src/core/lib/resource_quota/memory_quota.h"
+
+namespace grpc_core {
+namespace testing {
+
+TEST(ArenaPoolTest, NoOp) {
+  MemoryQuota memory_quota("foo");
+  auto memory_owner = memory_quota.CreateMemoryOwner("bar");
+  ArenaPool pool(4, &memory_owner);
+  EXPECT_EQ(pool.TestOnlyPooledArenas(), 0);
+}
+
+TEST(ArenaPoolTest, ReusesArenas) {
+  ExecCtx exec_ctx;
+  MemoryQuota memory_quota("foo");
+  auto memory_owner = memory_quota.CreateMemoryOwner("bar");
+  ArenaPool pool(4, &memory_owner);
+  auto first = pool.CreateWithAlloc(1024, 64);
+  memset(first.second, 1, 64);
+  // Grow the arena beyond its initial zone: the reset must free that memory.
+  memset(first.first->Alloc(4096), 1, 4096);
+  EXPECT_GE(pool.Destroy(first.first), 64 + 4096);
+  EXPECT_EQ(pool.TestOnlyPooledArenas(), 1);
+  auto second = pool.CreateWithAlloc(1024, 64);
+  EXPECT_EQ(second.first, first.first);
+  EXPECT_EQ(second.second, first.second);
+  EXPECT_EQ(pool.TestOnlyPooledArenas(), 0);
+  // The whole initial zone must be available again.
+  memset(second.first->Alloc(900), 1, 900);
+  pool.Destroy(second.first);
+}
+
+TEST(ArenaPoolTest, DoesNotHandOutMuchLargerArenas) {
+  ExecCtx exec_ctx;
+  MemoryQuota memory_quota("foo");
+  auto memory_owner = memory_quota.CreateMemoryOwner("bar");
+  ArenaPool pool(4, &memory_owner);
+  Arena* large = pool.CreateWithAlloc(64 * 1024, 64).first;
+  pool.Destroy(large);
+  Arena* small = pool.CreateWithAlloc(256, 64).first;
+  EXPECT_NE(small, large);
+  EXPECT_EQ(pool.TestOnlyPooledArenas(), 1);
+  pool.Destroy(small);
+  EXPECT_EQ(pool.TestOnlyPooledArenas(), 2);
+}
+
+TEST(ArenaPoolTest, BoundedSize) {
+  ExecCtx exec_ctx;
+  MemoryQuota memory_quota("foo");
+  auto memory_owner = memory_quota.CreateMemoryOwner("bar");
+  ArenaPool pool(2, &memory_owner);
+  std::vector<Arena*> arenas;
+  for (int i = 0; i < 5; i++) {
+    arenas.push_back(pool.CreateWithAlloc(1024, 64).first);
+  }
+  for (Arena* arena : arenas) pool.Destroy(arena);
+  EXPECT_EQ(pool.TestOnlyPooledArenas(), 2);
+}
+
+TEST(ArenaPoolTest, ZeroSizeDisablesPooling) {
+  ExecCtx exec_ctx;
+  MemoryQuota memory_quota("foo");
+  auto memory_owner = memory_quota.CreateMemoryOwner("bar");
+  ArenaPool pool(0, &memory_owner);
+  pool.Destroy(pool.CreateWithAlloc(1024, 64).first);
+  EXPECT_EQ(pool.TestOnlyPooledArenas(), 0);
+}
+
+TEST(ArenaPoolTest, DrainedUnderMemoryPressure) {
+  ExecCtx exec_ctx;
+  MemoryQuota memory_quota("foo");
+  auto memory_owner = memory_quota.CreateMemoryOwner("bar");
+  ArenaPool pool(4, &memory_owner);
+  pool.Destroy(pool.CreateWithAlloc(1024, 64).first);
+  EXPECT_EQ(pool.TestOnlyPooledArenas(), 1);
+  exec_ctx.Flush();
+  // Shrink the quota below what's already used: the benign reclaimer posted
+  // by the pool should empty it.
+  memory_quota.SetSize(1);
+  memory_owner.Reserve(4096);
+  exec_ctx.Flush();
+  EXPECT_EQ(pool.TestOnlyPooledArenas(), 0);
+  memory_owner.Release(4096);
+}
+
+}  // namespace testing
+}  // namespace grpc_core
+
+// Hook needed to run ExecCtx outside of iomgr.
+void grpc_set_default_iomgr_platform() {}
+
+int main(int argc, char** argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  gpr_log_verbosity_init();
+  return RUN_ALL_TESTS();
+}
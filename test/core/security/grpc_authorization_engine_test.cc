@@ -19,8 +19,26 @@
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
+#include <grpc/grpc_security_constants.h>
+
+#include "test/core/util/evaluate_args_test_util.h"
+
 namespace grpc_core {
 
+namespace {
+
+Rbac::Permission MakeHeaderPermission(const char* name, const char* value) {
+  return Rbac::Permission::MakeHeaderPermission(
+      HeaderMatcher::Create(name, HeaderMatcher::Type::kExact, value).value());
+}
+
+Rbac::Principal MakeAuthenticatedPrincipal(const char* name) {
+  return Rbac::Principal::MakeAuthenticatedPrincipal(
+      StringMatcher::Create(StringMatcher::Type::kExact, name).value());
+}
+
+}  // namespace
+
 TEST(GrpcAuthorizationEngineTest, AllowEngineWithMatchingPolicy) {
   Rbac::Policy policy1(
       Rbac::Permission::MakeNotPermission(
@@ -103,6 +121,113 @@ TEST(GrpcAuthorizationEngineTest, DenyEngineWithEmptyPolicies) {
   EXPECT_TRUE(decision.matching_policy_name.empty());
 }
 
+TEST(GrpcAuthorizationEngineTest, ReevaluatesCallRulesOnCachedConnection) {
+  std::map<std::string, Rbac::Policy> policies;
+  policies["policy1"] =
+      Rbac::Policy(MakeHeaderPermission("x-tenant", "a"),
+                   MakeAuthenticatedPrincipal("spiffe://foo.abc"));
+  GrpcAuthorizationEngine engine(
+      Rbac(Rbac::Action::kAllow, std::move(policies)));
+  EvaluateArgsTestUtil util;
+  util.AddPropertyToAuthContext(GRPC_TRANSPORT_SECURITY_TYPE_PROPERTY_NAME,
+                                GRPC_TLS_TRANSPORT_SECURITY_TYPE);
+  util.AddPropertyToAuthContext(GRPC_PEER_URI_PROPERTY_NAME,
+                                "spiffe://foo.abc");
+  EvaluateArgs args = util.MakeEvaluateArgs();
+  EXPECT_EQ(engine.Evaluate(args).type,
+            AuthorizationEngine::Decision::Type::kDeny);
+  // The connection's state is now cached, but the header is still checked
+  // on every call.
+  util.AddPairToMetadata("x-tenant", "a");
+  AuthorizationEngine::Decision decision = engine.Evaluate(args);
+  EXPECT_EQ(decision.type, AuthorizationEngine::Decision::Type::kAllow);
+  EXPECT_EQ(decision.matching_policy_name, "policy1");
+}
+
+TEST(GrpcAuthorizationEngineTest, SkipsPolicyForNonMatchingConnection) {
+  std::map<std::string, Rbac::Policy> policies;
+  policies["policy1"] =
+      Rbac::Policy(MakeHeaderPermission("x-tenant", "a"),
+                   MakeAuthenticatedPrincipal("spiffe://foo.abc"));
+  GrpcAuthorizationEngine engine(
+      Rbac(Rbac::Action::kAllow, std::move(policies)));
+  EvaluateArgsTestUtil util;
+  util.AddPropertyToAuthContext(GRPC_TRANSPORT_SECURITY_TYPE_PROPERTY_NAME,
+                                GRPC_TLS_TRANSPORT_SECURITY_TYPE);
+  util.AddPropertyToAuthContext(GRPC_PEER_URI_PROPERTY_NAME,
+                                "spiffe://bar.abc");
+  util.AddPairToMetadata("x-tenant", "a");
+  EvaluateArgs args = util.MakeEvaluateArgs();
+  EXPECT_EQ(engine.Evaluate(args).type,
+            AuthorizationEngine::Decision::Type::kDeny);
+  EXPECT_EQ(engine.Evaluate(args).type,
+            AuthorizationEngine::Decision::Type::kDeny);
+}
+
+TEST(GrpcAuthorizationEngineTest, FirstMatchingPolicyWinsAfterAlwaysMatching) {
+  std::map<std::string, Rbac::Policy> policies;
+  policies["policy1"] = Rbac::Policy(MakeHeaderPermission("x-tenant", "a"),
+                                     Rbac::Principal::MakeAnyPrincipal());
+  policies["policy2"] = Rbac::Policy(Rbac::Permission::MakeAnyPermission(),
+                                     Rbac::Principal::MakeAnyPrincipal());
+  GrpcAuthorizationEngine engine(
+      Rbac(Rbac::Action::kDeny, std::move(policies)));
+  EvaluateArgsTestUtil util;
+  EvaluateArgs args = util.MakeEvaluateArgs();
+  EXPECT_EQ(engine.Evaluate(args).matching_policy_name, "policy2");
+  util.AddPairToMetadata("x-tenant", "a");
+  EXPECT_EQ(engine.Evaluate(args).matching_policy_name, "policy1");
+}
+
+TEST(GrpcAuthorizationEngineTest, FoldsConstantRules) {
+  // Metadata never matches unless inverted, and the requested server name
+  // is always empty.
+  std::vector<std::unique_ptr<Rbac::Permission>> permissions;
+  permissions.push_back(absl::make_unique<Rbac::Permission>(
+      Rbac::Permission::MakeMetadataPermission(/*invert=*/false)));
+  permissions.push_back(absl::make_unique<Rbac::Permission>(
+      Rbac::Permission::MakeReqServerNamePermission(
+          StringMatcher::Create(StringMatcher::Type::kExact, "").value())));
+  std::map<std::string, Rbac::Policy> policies;
+  policies["policy1"] = Rbac::Policy(
+      Rbac::Permission::MakeOrPermission(std::move(permissions)),
+      Rbac::Principal::MakeNotPrincipal(
+          Rbac::Principal::MakeMetadataPrincipal(/*invert=*/false)));
+  GrpcAuthorizationEngine engine(
+      Rbac(Rbac::Action::kAllow, std::move(policies)));
+  AuthorizationEngine::Decision decision =
+      engine.Evaluate(EvaluateArgs(nullptr, nullptr));
+  EXPECT_EQ(decision.type, AuthorizationEngine::Decision::Type::kAllow);
+  EXPECT_EQ(decision.matching_policy_name, "policy1");
+}
+
+TEST(GrpcAuthorizationEngineTest, EnginesShareConnectionCache) {
+  std::map<std::string, Rbac::Policy> allow_policies;
+  allow_policies["allow"] =
+      Rbac::Policy(Rbac::Permission::MakeAnyPermission(),
+                   MakeAuthenticatedPrincipal("spiffe://foo.abc"));
+  GrpcAuthorizationEngine allow_engine(
+      Rbac(Rbac::Action::kAllow, std::move(allow_policies)));
+  std::map<std::string, Rbac::Policy> deny_policies;
+  deny_policies["deny"] =
+      Rbac::Policy(Rbac::Permission::MakeAnyPermission(),
+                   MakeAuthenticatedPrincipal("spiffe://bar.abc"));
+  GrpcAuthorizationEngine deny_engine(
+      Rbac(Rbac::Action::kDeny, std::move(deny_policies)));
+  EvaluateArgsTestUtil util;
+  util.AddPropertyToAuthContext(GRPC_TRANSPORT_SECURITY_TYPE_PROPERTY_NAME,
+                                GRPC_TLS_TRANSPORT_SECURITY_TYPE);
+  util.AddPropertyToAuthContext(GRPC_PEER_URI_PROPERTY_NAME,
+                                "spiffe://foo.abc");
+  EvaluateArgs args = util.MakeEvaluateArgs();
+  for (int i = 0; i < 2; ++i) {
+    EXPECT_EQ(deny_engine.Evaluate(args).type,
+              AuthorizationEngine::Decision::Type::kAllow);
+    EXPECT_EQ(allow_engine.Evaluate(args).type,
+              AuthorizationEngine::Decision::Type::kAllow);
+  }
+}
+
 }  // namespace grpc_core
 
 int main(int argc, char** argv) {
@@ -0,0 +1,155 @@
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <stdint.h>
+
+#include <numeric>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <grpc/grpc.h>
+#include <grpc/grpc_security.h>
+
+#include "src/core/lib/channel/channelz.h"
+#include "src/core/lib/json/json.h"
+#include "src/core/lib/surface/channel.h"
+#include "test/core/util/test_config.h"
+
+namespace grpc_core {
+namespace testing {
+namespace {
+
+uint64_t HistogramCount(const std::vector<uint64_t>& histogram) {
+  return std::accumulate(histogram.begin(), histogram.end(), uint64_t{0});
+}
+
+void ShutdownAndDrain(grpc_completion_queue* cq) {
+  grpc_completion_queue_shutdown(cq);
+  while (grpc_completion_queue_next(cq, gpr_inf_future(GPR_CLOCK_REALTIME),
+                                    nullptr)
+             .type != GRPC_QUEUE_SHUTDOWN) {
+  }
+  grpc_completion_queue_destroy(cq);
+}
+
+TEST(CallSizeEstimatorTest, GrowsImmediately) {
+  CallSizeEstimator estimator(1024);
+  size_t before = estimator.CallSizeEstimate();
+  // The update uses a weak compare-exchange, which may spuriously fail once.
+  estimator.UpdateCallSizeEstimate(8192);
+  estimator.UpdateCallSizeEstimate(8192);
+  EXPECT_GT(estimator.CallSizeEstimate(), before);
+  EXPECT_GE(estimator.CallSizeEstimate(), 8192);
+}
+
+TEST(CallSizeEstimatorTest, DecaysSlowly) {
+  CallSizeEstimator estimator(8192);
+  size_t high_water_mark = estimator.CallSizeEstimate();
+  // A single small call should barely move the estimate...
+  estimator.UpdateCallSizeEstimate(256);
+  EXPECT_GE(estimator.CallSizeEstimate(), high_water_mark - 256);
+  // ... but a long run of small calls should bring it down.
+  for (int i = 0; i < 10000; i++) {
+    estimator.UpdateCallSizeEstimate(256);
+  }
+  EXPECT_LT(estimator.CallSizeEstimate(), 2048);
+  EXPECT_GE(estimator.CallSizeEstimate(), 256);
+}
+
+TEST(CallSizeEstimatorTest, EstimateIsRounded) {
+  CallSizeEstimator estimator(1000);
+  EXPECT_EQ(estimator.CallSizeEstimate() % 256, 0);
+  EXPECT_GT(estimator.CallSizeEstimate(), 1000);
+}
+
+TEST(CallSizeEstimatorTest, RegisteredMethodsAreTrackedSeparately) {
+  grpc_channel_credentials* creds = grpc_insecure_credentials_create();
+  grpc_channel* channel = grpc_channel_create("localhost:1", creds, nullptr);
+  grpc_channel_credentials_release(creds);
+  grpc_completion_queue* cq = grpc_completion_queue_create_for_next(nullptr);
+  void* small = grpc_channel_register_call(channel, "/svc/Small", nullptr,
+                                           nullptr);
+  void* large = grpc_channel_register_call(channel, "/svc/Large", nullptr,
+                                           nullptr);
+  CallSizeEstimator& small_estimator =
+      static_cast<RegisteredCall*>(small)->call_size_estimator;
+  CallSizeEstimator& large_estimator =
+      static_cast<RegisteredCall*>(large)->call_size_estimator;
+  ASSERT_NE(&small_estimator, &large_estimator);
+  // The update uses a weak compare-exchange, which may spuriously fail once.
+  large_estimator.UpdateCallSizeEstimate(65536);
+  large_estimator.UpdateCallSizeEstimate(65536);
+  for (int i = 0; i < 3; i++) {
+    grpc_call_unref(grpc_channel_create_registered_call(
+        channel, nullptr, GRPC_PROPAGATE_DEFAULTS, cq, small,
+        gpr_inf_future(GPR_CLOCK_REALTIME), nullptr));
+  }
+  grpc_call_unref(grpc_channel_create_registered_call(
+      channel, nullptr, GRPC_PROPAGATE_DEFAULTS, cq, large,
+      gpr_inf_future(GPR_CLOCK_REALTIME), nullptr));
+  EXPECT_GE(large_estimator.CallSizeEstimate(), 65536);
+  EXPECT_LT(small_estimator.CallSizeEstimate(), 65536);
+  auto histograms =
+      Channel::FromC(channel)->RegisteredCallInitialSizeHistograms();
+  ASSERT_EQ(histograms.size(), 2);
+#if defined(GRPC_COLLECT_STATS) || !defined(NDEBUG)
+  EXPECT_EQ(HistogramCount(histograms[{"", "/svc/Small"}]), 3);
+  EXPECT_EQ(HistogramCount(histograms[{"", "/svc/Large"}]), 1);
+#endif
+  grpc_channel_destroy(channel);
+  ShutdownAndDrain(cq);
+}
+
+TEST(CallSizeEstimatorTest, InitialSizesAreRenderedInChannelz) {
+  grpc_channel_credentials* creds = grpc_insecure_credentials_create();
+  grpc_channel* channel = grpc_channel_create("localhost:1", creds, nullptr);
+  grpc_channel_credentials_release(creds);
+  grpc_completion_queue* cq = grpc_completion_queue_create_for_next(nullptr);
+  void* method = grpc_channel_register_call(channel, "/svc/Method",
+                                            "example.com", nullptr);
+  for (int i = 0; i < 2; i++) {
+    grpc_call_unref(grpc_channel_create_registered_call(
+        channel, nullptr, GRPC_PROPAGATE_DEFAULTS, cq, method,
+        gpr_inf_future(GPR_CLOCK_REALTIME), nullptr));
+  }
+  channelz::ChannelNode* node = grpc_channel_get_channelz_node(channel);
+  ASSERT_NE(node, nullptr);
+  Json json = node->RenderMethodLatencyJson();
+  const Json::Array& methods =
+      json.object_value().at("callInitialSize").array_value();
+  ASSERT_EQ(methods.size(), 1);
+  const Json::Object& rendered = methods[0].object_value();
+  EXPECT_EQ(rendered.at("method").string_value(), "/svc/Method");
+  EXPECT_EQ(rendered.at("host").string_value(), "example.com");
+#if defined(GRPC_COLLECT_STATS) || !defined(NDEBUG)
+  EXPECT_EQ(rendered.at("count").string_value(), "2");
+  EXPECT_FALSE(rendered.at("bucket").array_value().empty());
+#endif
+  grpc_channel_destroy(channel);
+  ShutdownAndDrain(cq);
+}
+
+}  // namespace
+}  // namespace testing
+}  // namespace grpc_core
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(&argc, argv);
+  ::testing::InitGoogleTest(&argc, argv);
+  grpc_init();
+  int ret = RUN_ALL_TESTS();
+  grpc_shutdown();
+  return ret;
+}
@@ -20,6 +20,8 @@
 
 #include <limits.h>
 
+#include <algorithm>
+
 #include <gtest/gtest.h>
 
 #include <grpc/grpc.h>
@@ -54,6 +56,11 @@ void inc_time(void) {
   MutexLock lock(&mu_);
   g_clock += 30;
 }
+
+void advance_time(int seconds) {
+  MutexLock lock(&mu_);
+  g_clock += seconds;
+}
 }  // namespace
 
 TEST(BdpEstimatorTest, NoOp) { BdpEstimator est("test"); }
@@ -142,6 +149,48 @@ INSTANTIATE_TEST_SUITE_P(TooManyNames, BdpEstimatorRandomTest,
                          ::testing::Values(3, 4, 6, 9, 13, 19, 28, 42, 63, 94,
                                            141, 211, 316, 474, 711));
 
+namespace {
+// Simulate a ping over a link with the given bandwidth (bytes/second) and a
+// one second round trip time, where the peer sends as much as the flow control
+// window (twice the estimate) allows.
+void AddLinkSample(BdpEstimator* estimator, int64_t link_bandwidth) {
+  ExecCtx exec_ctx;
+  estimator->SchedulePing();
+  estimator->StartPing();
+  estimator->AddIncomingBytes(
+      std::min(link_bandwidth, 2 * estimator->EstimateBdp()));
+  advance_time(1);
+  ExecCtx::Get()->InvalidateNow();
+  estimator->CompletePing();
+}
+}  // namespace
+
+TEST(BdpEstimatorTest, ConvergesToLinkBdp) {
+  BdpEstimator est("test");
+  const int64_t kBandwidth = 1 << 20;
+  for (int i = 0; i < 10; i++) AddLinkSample(&est, kBandwidth);
+  EXPECT_FALSE(est.in_startup());
+  EXPECT_DOUBLE_EQ(est.EstimateMinRtt(), 1.0);
+  EXPECT_EQ(est.EstimateBdp(), kBandwidth);
+  // Once converged, the estimate stays put.
+  for (int i = 0; i < 20; i++) {
+    AddLinkSample(&est, kBandwidth);
+    EXPECT_EQ(est.EstimateBdp(), kBandwidth);
+  }
+}
+
+TEST(BdpEstimatorTest, TracksLinkChanges) {
+  BdpEstimator est("test");
+  for (int i = 0; i < 10; i++) AddLinkSample(&est, 1 << 20);
+  ASSERT_EQ(est.EstimateBdp(), 1 << 20);
+  // A faster link is picked up within a few pings...
+  for (int i = 0; i < 3; i++) AddLinkSample(&est, 4 << 20);
+  EXPECT_EQ(est.EstimateBdp(), 4 << 20);
+  // ... and a slower one once the faster samples age out.
+  for (int i = 0; i < 12; i++) AddLinkSample(&est, 256 << 10);
+  EXPECT_EQ(est.EstimateBdp(), 256 << 10);
+}
+
 }  // namespace testing
 }  // namespace grpc_core
 
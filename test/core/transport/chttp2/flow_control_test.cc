@@ -14,9 +14,13 @@
 
 #include "src/core/ext/transport/chttp2/transport/flow_control.h"
 
+#include <random>
+#include <vector>
+
 #include <gtest/gtest.h>
 
 #include "src/core/lib/iomgr/exec_ctx.h"
+#include "src/core/lib/resource_quota/memory_quota.h"
 #include "src/core/lib/resource_quota/resource_quota.h"
 
 namespace grpc_core {
@@ -106,6 +110,155 @@ TEST(FlowControl, NoUpdateWithoutReader) {
   EXPECT_GT(sfc.MaybeSendUpdate(), 0);
 }
 
+constexpr size_t kQuotaSize = 64 * 1024 * 1024;
+// The window advertised while memory is plentiful.
+constexpr int64_t kGenerousWindow = 1 << 22;
+
+// Gives a transport its own memory quota, and fills that quota to a given
+// level of pressure.
+class FlowControlMemoryPressureTest : public ::testing::Test {
+ protected:
+  FlowControlMemoryPressureTest() { quota_.SetSize(kQuotaSize); }
+  ~FlowControlMemoryPressureTest() override { hog_.Release(hogged_); }
+
+  void SetPressure(double pressure) {
+    hog_.Release(hogged_);
+    hogged_ = static_cast<size_t>(pressure * kQuotaSize);
+    if (hogged_ != 0) hog_.Reserve(hogged_);
+  }
+
+  // Tracks the initial window the transport asks its peer to use.
+  void Apply(const FlowControlAction& action) {
+    if (action.send_initial_window_update() !=
+        FlowControlAction::Urgency::NO_ACTION_NEEDED) {
+      window_ = action.initial_window_size();
+    }
+  }
+
+  ExecCtx exec_ctx_;
+  MemoryQuota quota_{"test"};
+  MemoryOwner owner_ = quota_.CreateMemoryOwner("transport");
+  MemoryAllocator hog_ = quota_.CreateMemoryAllocator("hog");
+  size_t hogged_ = 0;
+  int64_t window_ = kDefaultWindow;
+};
+
+TEST_F(FlowControlMemoryPressureTest, WindowShrinksGraduallyWithPressure) {
+  TransportFlowControl tfc("test", true, &owner_);
+  Apply(tfc.PeriodicUpdate());
+  EXPECT_EQ(window_, kGenerousWindow);
+  std::vector<int64_t> windows;
+  for (int i = 1; i <= 20; i++) {
+    SetPressure(i * 0.05);
+    Apply(tfc.MemoryPressureUpdate());
+    windows.push_back(window_);
+  }
+  for (size_t i = 1; i < windows.size(); i++) {
+    EXPECT_LE(windows[i], windows[i - 1]) << "at step " << i;
+  }
+  // Windows step down over several updates rather than falling off a cliff...
+  int distinct_windows = 0;
+  for (size_t i = 0; i < windows.size(); i++) {
+    if (windows[i] > kMinInitialWindowSize && windows[i] < kGenerousWindow &&
+        (i == 0 || windows[i] != windows[i - 1])) {
+      distinct_windows++;
+    }
+  }
+  EXPECT_GE(distinct_windows, 4);
+  // ... and bottom out once the quota is exhausted.
+  EXPECT_EQ(windows.back(), kMinInitialWindowSize);
+}
+
+TEST_F(FlowControlMemoryPressureTest, WindowRecoversWhenPressureDrops) {
+  TransportFlowControl tfc("test", true, &owner_);
+  Apply(tfc.PeriodicUpdate());
+  SetPressure(0.9);
+  Apply(tfc.MemoryPressureUpdate());
+  EXPECT_LT(window_, kGenerousWindow / 16);
+  SetPressure(0);
+  Apply(tfc.MemoryPressureUpdate());
+  EXPECT_EQ(window_, kGenerousWindow);
+}
+
+TEST_F(FlowControlMemoryPressureTest, SmallPressureChangesAreIgnored) {
+  TransportFlowControl tfc("test", true, &owner_);
+  Apply(tfc.PeriodicUpdate());
+  SetPressure(0.01);
+  EXPECT_EQ(tfc.MemoryPressureUpdate().send_initial_window_update(),
+            FlowControlAction::Urgency::NO_ACTION_NEEDED);
+}
+
+TEST_F(FlowControlMemoryPressureTest, NoWindowChangesWithoutBdpProbe) {
+  TransportFlowControl tfc("test", false, &owner_);
+  SetPressure(0.9);
+  Apply(tfc.MemoryPressureUpdate());
+  EXPECT_EQ(window_, kDefaultWindow);
+}
+
+TEST_F(FlowControlMemoryPressureTest, RandomPressureStress) {
+  TransportFlowControl tfc("test", true, &owner_);
+  std::vector<std::unique_ptr<StreamFlowControl>> streams;
+  for (int i = 0; i < 8; i++) {
+    streams.emplace_back(new StreamFlowControl(&tfc));
+  }
+  std::mt19937 rng(42);
+  std::uniform_real_distribution<double> pressure_dist(0.0, 1.0);
+  for (int i = 0; i < 1000; i++) {
+    SetPressure(pressure_dist(rng));
+    // Alternate the cheap per-read update with the full periodic one.
+    const bool periodic = rng() % 4 == 0;
+    Apply(periodic ? tfc.PeriodicUpdate() : tfc.MemoryPressureUpdate());
+    for (auto& sfc : streams) {
+      EXPECT_EQ(sfc->RecvData(1), absl::OkStatus());
+      sfc->UpdateProgress(1);
+      sfc->MaybeSendUpdate();
+    }
+    tfc.MaybeSendUpdate(false);
+    ASSERT_GE(window_, kMinInitialWindowSize);
+    ASSERT_LE(window_, kMaxInitialWindowSize);
+    if (!periodic) continue;
+    // A periodic update always lands within the hysteresis of its target.
+    double pressure = owner_.InstantaneousPressure();
+    if (pressure < 0.2) {
+      EXPECT_GT(window_, kGenerousWindow * 4 / 5) << "pressure " << pressure;
+    } else if (pressure >= 1.0) {
+      EXPECT_LT(window_, kMinInitialWindowSize * 5 / 4)
+          << "pressure " << pressure;
+    }
+  }
+}
+
+TEST(Pacer, DisabledByDefault) {
+  Pacer pacer;
+  EXPECT_FALSE(pacer.enabled());
+}
+
+TEST(Pacer, ReleasesDataAtRate) {
+  Pacer pacer;
+  pacer.SetRate(10000000);
+  ASSERT_TRUE(pacer.enabled());
+  const Timestamp start = Timestamp::FromMillisecondsAfterProcessEpoch(1000);
+  // Starts with a full burst: 10ms worth of data.
+  pacer.Refill(start);
+  EXPECT_EQ(pacer.credit(), 100000);
+  pacer.SentData(100000);
+  EXPECT_EQ(pacer.credit(), 0);
+  // A default sized frame takes 1.6384ms to accumulate.
+  EXPECT_EQ(pacer.NextSendTime(), start + Duration::Milliseconds(2));
+  pacer.Refill(start + Duration::Milliseconds(5));
+  EXPECT_EQ(pacer.credit(), 50000);
+  // Credit never exceeds a burst.
+  pacer.Refill(start + Duration::Seconds(5));
+  EXPECT_EQ(pacer.credit(), 100000);
+}
+
+TEST(Pacer, BurstIsAtLeastAFrame) {
+  Pacer pacer;
+  pacer.SetRate(1000);
+  pacer.Refill(Timestamp::FromMillisecondsAfterProcessEpoch(1000));
+  EXPECT_EQ(pacer.credit(), kDefaultFrameSize);
+}
+
 }  // namespace chttp2
 }  // namespace grpc_core
 
@@ -215,6 +215,65 @@ static void test_basic_headers() {
          "b", "c");
 }
 
+static void verify_request_headers(const char* expected, const char* path) {
+  verify_params params = {
+      false,
+      false,
+  };
+  verify(params, expected, 6, ":path", path, ":authority", "b", ":method",
+         "POST", ":scheme", "http", "content-type", "application/grpc", "te",
+         "trailers");
+}
+
+static void test_cached_request_prefix() {
+  // First request: everything is new, and gets added to the table.
+  verify_request_headers(
+      "000046 0104 deadbeef"
+      " 40 05 3a70617468 02 2f61"
+      " 40 0a 3a617574686f72697479 01 62"
+      " 83 86"
+      " 40 0c 636f6e74656e742d74797065 10 6170706c69636174696f6e2f67727063"
+      " 40 02 7465 08 747261696c657273",
+      "/a");
+  // Then the same fields encode as references into the table, both when
+  // encoded field by field and when copied from the cached prefix.
+  verify_request_headers("000006 0104 deadbeef c1 c0 83 86 bf be", "/a");
+  verify_request_headers("000006 0104 deadbeef c1 c0 83 86 bf be", "/a");
+  // A new path is added to the table, shifting the other references.
+  verify_request_headers(
+      "00000f 0104 deadbeef 40 05 3a70617468 02 2f63 c1 83 86 c0 bf", "/c");
+  // ... so the cached prefix must not be reused.
+  verify_request_headers("000006 0104 deadbeef c2 c1 83 86 c0 bf", "/a");
+  verify_request_headers("000006 0104 deadbeef c2 c1 83 86 c0 bf", "/a");
+  verify_request_headers("000006 0104 deadbeef be c1 83 86 c0 bf", "/c");
+}
+
+static void test_cached_request_prefix_interleaved() {
+  verify_request_headers(
+      "000046 0104 deadbeef"
+      " 40 05 3a70617468 02 2f61"
+      " 40 0a 3a617574686f72697479 01 62"
+      " 83 86"
+      " 40 0c 636f6e74656e742d74797065 10 6170706c69636174696f6e2f67727063"
+      " 40 02 7465 08 747261696c657273",
+      "/a");
+  verify_request_headers(
+      "00000f 0104 deadbeef 40 05 3a70617468 02 2f63 c1 83 86 c0 bf", "/c");
+  // Requests to different methods each replay their own cached prefix.
+  for (int i = 0; i < 3; i++) {
+    verify_request_headers("000006 0104 deadbeef c2 c1 83 86 c0 bf", "/a");
+    verify_request_headers("000006 0104 deadbeef be c1 83 86 c0 bf", "/c");
+  }
+  // A new method shifts the references of all the cached prefixes.
+  verify_request_headers(
+      "00000f 0104 deadbeef 40 05 3a70617468 02 2f64 c2 83 86 c1 c0", "/d");
+  for (int i = 0; i < 3; i++) {
+    verify_request_headers("000006 0104 deadbeef c3 c2 83 86 c1 c0", "/a");
+    verify_request_headers("000006 0104 deadbeef bf c2 83 86 c1 c0", "/c");
+    verify_request_headers("000006 0104 deadbeef be c2 83 86 c1 c0", "/d");
+  }
+}
+
 static void verify_continuation_headers(const char* key, const char* value,
                                         bool is_eof) {
   auto arena = grpc_core::MakeScopedArena(1024, g_memory_allocator);
@@ -262,6 +321,8 @@ int main(int argc, char** argv) {
   grpc_init();
   TEST(test_basic_headers);
   TEST(test_continuation_headers);
+  TEST(test_cached_request_prefix);
+  TEST(test_cached_request_prefix_interleaved);
   grpc_shutdown();
   return g_failure;
 }
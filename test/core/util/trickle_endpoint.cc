@@ -0,0 +1,263 @@
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "test/core/util/trickle_endpoint.h"
+
+#include <limits.h>
+#include <math.h>
+#include <stdint.h>
+
+#include <algorithm>
+#include <deque>
+#include <utility>
+
+#include <grpc/support/log.h>
+#include <grpc/support/sync.h>
+
+#include "src/core/lib/iomgr/closure.h"
+#include "src/core/lib/iomgr/exec_ctx.h"
+#include "src/core/lib/iomgr/timer.h"
+#include "src/core/lib/slice/slice_buffer.h"
+
+namespace {
+
+struct trickle_endpoint {
+  grpc_endpoint base;
+  grpc_endpoint* wrapped;
+  double bytes_per_ms;
+  grpc_core::Duration delay;
+
+  gpr_mu mu;
+  // One for the endpoint itself, plus one per armed timer or wrapped write.
+  int refs = 1;
+  bool shutdown = false;
+
+  // When the link will have finished sending everything written so far.
+  grpc_core::Timestamp link_free_at = grpc_core::Timestamp::InfPast();
+
+  // The caller's write, completed once the link has sent it.
+  grpc_closure* write_cb = nullptr;
+  grpc_timer sent_timer;
+  grpc_closure on_sent;
+
+  // Data sent on the link and waiting out the delay, oldest first.
+  std::deque<std::pair<grpc_core::Timestamp, grpc_core::SliceBuffer>>
+      in_flight;
+  bool have_deliver_timer = false;
+  grpc_timer deliver_timer;
+  grpc_closure on_deliver;
+
+  // Data that has crossed the link, waiting to be written to the wrapped
+  // endpoint, and the data currently being written to it.
+  grpc_core::SliceBuffer arrived;
+  grpc_core::SliceBuffer writing;
+  bool wrapped_write_pending = false;
+  grpc_closure on_wrapped_write_done;
+};
+
+void te_unref(trickle_endpoint* te) {
+  gpr_mu_lock(&te->mu);
+  bool last = --te->refs == 0;
+  gpr_mu_unlock(&te->mu);
+  if (last) {
+    grpc_endpoint_destroy(te->wrapped);
+    gpr_mu_destroy(&te->mu);
+    delete te;
+  }
+}
+
+void cancel_timers_locked(trickle_endpoint* te) {
+  if (te->write_cb != nullptr) grpc_timer_cancel(&te->sent_timer);
+  if (te->have_deliver_timer) grpc_timer_cancel(&te->deliver_timer);
+}
+
+void arm_deliver_timer_locked(trickle_endpoint* te) {
+  te->have_deliver_timer = true;
+  ++te->refs;
+  grpc_timer_init(&te->deliver_timer, te->in_flight.front().first,
+                  &te->on_deliver);
+}
+
+void maybe_write_wrapped_locked(trickle_endpoint* te) {
+  if (te->wrapped_write_pending || te->arrived.Length() == 0) return;
+  te->wrapped_write_pending = true;
+  ++te->refs;
+  te->writing.Swap(&te->arrived);
+  grpc_endpoint_write(te->wrapped, te->writing.c_slice_buffer(),
+                      &te->on_wrapped_write_done, nullptr, INT_MAX);
+}
+
+void te_on_sent(void* arg, grpc_error_handle /*error*/) {
+  trickle_endpoint* te = static_cast<trickle_endpoint*>(arg);
+  gpr_mu_lock(&te->mu);
+  grpc_closure* cb = te->write_cb;
+  te->write_cb = nullptr;
+  bool shutdown = te->shutdown;
+  gpr_mu_unlock(&te->mu);
+  grpc_core::ExecCtx::Run(
+      DEBUG_LOCATION, cb,
+      shutdown ? GRPC_ERROR_CREATE_FROM_STATIC_STRING("Endpoint shutdown")
+               : GRPC_ERROR_NONE);
+  te_unref(te);
+}
+
+void te_on_deliver(void* arg, grpc_error_handle /*error*/) {
+  trickle_endpoint* te = static_cast<trickle_endpoint*>(arg);
+  gpr_mu_lock(&te->mu);
+  te->have_deliver_timer = false;
+  if (!te->shutdown) {
+    grpc_core::Timestamp now = grpc_core::ExecCtx::Get()->Now();
+    while (!te->in_flight.empty() && te->in_flight.front().first <= now) {
+      grpc_slice_buffer_move_into(
+          te->in_flight.front().second.c_slice_buffer(),
+          te->arrived.c_slice_buffer());
+      te->in_flight.pop_front();
+    }
+    if (!te->in_flight.empty()) arm_deliver_timer_locked(te);
+    maybe_write_wrapped_locked(te);
+  }
+  gpr_mu_unlock(&te->mu);
+  te_unref(te);
+}
+
+void te_on_wrapped_write_done(void* arg, grpc_error_handle error) {
+  trickle_endpoint* te = static_cast<trickle_endpoint*>(arg);
+  gpr_mu_lock(&te->mu);
+  te->wrapped_write_pending = false;
+  te->writing.Clear();
+  if (error == GRPC_ERROR_NONE && !te->shutdown) {
+    maybe_write_wrapped_locked(te);
+  }
+  gpr_mu_unlock(&te->mu);
+  te_unref(te);
+}
+
+void te_read(grpc_endpoint* ep, grpc_slice_buffer* slices, grpc_closure* cb,
+             bool urgent, int min_progress_size) {
+  trickle_endpoint* te = reinterpret_cast<trickle_endpoint*>(ep);
+  grpc_endpoint_read(te->wrapped, slices, cb, urgent, min_progress_size);
+}
+
+void te_write(grpc_endpoint* ep, grpc_slice_buffer* slices, grpc_closure* cb,
+              void* /*arg*/, int /*max_frame_size*/) {
+  trickle_endpoint* te = reinterpret_cast<trickle_endpoint*>(ep);
+  gpr_mu_lock(&te->mu);
+  if (te->shutdown) {
+    grpc_core::ExecCtx::Run(
+        DEBUG_LOCATION, cb,
+        GRPC_ERROR_CREATE_FROM_STATIC_STRING("Endpoint already shutdown"));
+    gpr_mu_unlock(&te->mu);
+    return;
+  }
+  GPR_ASSERT(te->write_cb == nullptr);
+  // The link serializes writes: this one starts once everything before it
+  // has been sent, and arrives one delay after its last byte has been sent.
+  te->link_free_at =
+      std::max(te->link_free_at, grpc_core::ExecCtx::Get()->Now()) +
+      grpc_core::Duration::Milliseconds(static_cast<int64_t>(
+          ceil(static_cast<double>(slices->length) / te->bytes_per_ms)));
+  grpc_core::SliceBuffer segment;
+  grpc_slice_buffer_swap(slices, segment.c_slice_buffer());
+  te->in_flight.emplace_back(te->link_free_at + te->delay, std::move(segment));
+  te->write_cb = cb;
+  ++te->refs;
+  grpc_timer_init(&te->sent_timer, te->link_free_at, &te->on_sent);
+  if (!te->have_deliver_timer) arm_deliver_timer_locked(te);
+  gpr_mu_unlock(&te->mu);
+}
+
+void te_add_to_pollset(grpc_endpoint* ep, grpc_pollset* pollset) {
+  trickle_endpoint* te = reinterpret_cast<trickle_endpoint*>(ep);
+  grpc_endpoint_add_to_pollset(te->wrapped, pollset);
+}
+
+void te_add_to_pollset_set(grpc_endpoint* ep, grpc_pollset_set* pollset_set) {
+  trickle_endpoint* te = reinterpret_cast<trickle_endpoint*>(ep);
+  grpc_endpoint_add_to_pollset_set(te->wrapped, pollset_set);
+}
+
+void te_delete_from_pollset_set(grpc_endpoint* ep,
+                                grpc_pollset_set* pollset_set) {
+  trickle_endpoint* te = reinterpret_cast<trickle_endpoint*>(ep);
+  grpc_endpoint_delete_from_pollset_set(te->wrapped, pollset_set);
+}
+
+void te_shutdown(grpc_endpoint* ep, grpc_error_handle why) {
+  trickle_endpoint* te = reinterpret_cast<trickle_endpoint*>(ep);
+  gpr_mu_lock(&te->mu);
+  te->shutdown = true;
+  cancel_timers_locked(te);
+  gpr_mu_unlock(&te->mu);
+  grpc_endpoint_shutdown(te->wrapped, why);
+}
+
+void te_destroy(grpc_endpoint* ep) {
+  trickle_endpoint* te = reinterpret_cast<trickle_endpoint*>(ep);
+  gpr_mu_lock(&te->mu);
+  te->shutdown = true;
+  cancel_timers_locked(te);
+  gpr_mu_unlock(&te->mu);
+  te_unref(te);
+}
+
+absl::string_view te_get_peer(grpc_endpoint* ep) {
+  trickle_endpoint* te = reinterpret_cast<trickle_endpoint*>(ep);
+  return grpc_endpoint_get_peer(te->wrapped);
+}
+
+absl::string_view te_get_local_address(grpc_endpoint* ep) {
+  trickle_endpoint* te = reinterpret_cast<trickle_endpoint*>(ep);
+  return grpc_endpoint_get_local_address(te->wrapped);
+}
+
+int te_get_fd(grpc_endpoint* ep) {
+  trickle_endpoint* te = reinterpret_cast<trickle_endpoint*>(ep);
+  return grpc_endpoint_get_fd(te->wrapped);
+}
+
+bool te_can_track_err(grpc_endpoint* /*ep*/) { return false; }
+
+const grpc_endpoint_vtable vtable = {
+    te_read,
+    te_write,
+    te_add_to_pollset,
+    te_add_to_pollset_set,
+    te_delete_from_pollset_set,
+    te_shutdown,
+    te_destroy,
+    te_get_peer,
+    te_get_local_address,
+    te_get_fd,
+    te_can_track_err,
+};
+
+}  // namespace
+
+grpc_endpoint* grpc_trickle_endpoint_create(grpc_endpoint* wrap,
+                                            double bytes_per_second,
+                                            grpc_core::Duration delay) {
+  GPR_ASSERT(bytes_per_second > 0);
+  trickle_endpoint* te = new trickle_endpoint();
+  te->base.vtable = &vtable;
+  te->wrapped = wrap;
+  te->bytes_per_ms = bytes_per_second / 1000;
+  te->delay = delay;
+  gpr_mu_init(&te->mu);
+  GRPC_CLOSURE_INIT(&te->on_sent, te_on_sent, te, grpc_schedule_on_exec_ctx);
+  GRPC_CLOSURE_INIT(&te->on_deliver, te_on_deliver, te,
+                    grpc_schedule_on_exec_ctx);
+  GRPC_CLOSURE_INIT(&te->on_wrapped_write_done, te_on_wrapped_write_done, te,
+                    grpc_schedule_on_exec_ctx);
+  return &te->base;
+}
@@ -0,0 +1,30 @@
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GRPC_TEST_CORE_UTIL_TRICKLE_ENDPOINT_H
+#define GRPC_TEST_CORE_UTIL_TRICKLE_ENDPOINT_H
+
+#include "src/core/lib/gprpp/time.h"
+#include "src/core/lib/iomgr/endpoint.h"
+
+/* Wraps \a wrap in an endpoint that emulates a link with the given bandwidth
+   and one way delay for everything written to it: a write completes once the
+   link has had time to send it, and reaches \a wrap \a delay after that.
+   Reads are passed straight through, so wrapping both halves of an endpoint
+   pair emulates the link in both directions. Takes ownership of \a wrap. */
+grpc_endpoint* grpc_trickle_endpoint_create(grpc_endpoint* wrap,
+                                            double bytes_per_second,
+                                            grpc_core::Duration delay);
+
+#endif  // GRPC_TEST_CORE_UTIL_TRICKLE_ENDPOINT_H
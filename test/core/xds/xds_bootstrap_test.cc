@@ -193,6 +193,44 @@ TEST(XdsBootstrapTest, ValidWithoutNode) {
   EXPECT_EQ(bootstrap.node(), nullptr);
 }
 
+TEST(XdsBootstrapTest, DeltaServerFeature) {
+  const char* json_str =
+      "{"
+      "  \"xds_servers\": ["
+      "    {"
+      "      \"server_uri\": \"fake:///lb\","
+      "      \"channel_creds\": [{\"type\": \"fake\"}],"
+      "      \"server_features\": [\"xds_delta\", \"xds_v3\"]"
+      "    }"
+      "  ],"
+      "  \"authorities\": {"
+      "    \"xds.example.com\": {"
+      "      \"xds_servers\": ["
+      "        {"
+      "          \"server_uri\": \"fake:///xds_server\","
+      "          \"channel_creds\": [{\"type\": \"fake\"}],"
+      "          \"server_features\": [\"xds_delta\"]"
+      "        }"
+      "      ]"
+      "    }"
+      "  }"
+      "}";
+  grpc_error_handle error = GRPC_ERROR_NONE;
+  Json json = Json::Parse(json_str, &error);
+  ASSERT_EQ(error, GRPC_ERROR_NONE) << grpc_error_std_string(error);
+  XdsBootstrap bootstrap(std::move(json), &error);
+  ASSERT_EQ(error, GRPC_ERROR_NONE) << grpc_error_std_string(error);
+  EXPECT_TRUE(bootstrap.server().ShouldUseV3());
+  EXPECT_TRUE(bootstrap.server().ShouldUseDelta());
+  // Delta ADS requires v3.
+  const XdsBootstrap::Authority* authority =
+      bootstrap.LookupAuthority("xds.example.com");
+  ASSERT_NE(authority, nullptr);
+  ASSERT_EQ(authority->xds_servers.size(), 1);
+  EXPECT_FALSE(authority->xds_servers[0].ShouldUseV3());
+  EXPECT_FALSE(authority->xds_servers[0].ShouldUseDelta());
+}
+
 TEST(XdsBootstrapTest, InsecureCreds) {
   const char* json_str =
       "{"
@@ -0,0 +1,116 @@
+//
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include "src/core/ext/xds/xds_resource_type.h"
+
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include "absl/types/optional.h"
+
+#include "src/core/ext/xds/xds_cluster.h"
+#include "src/core/ext/xds/xds_endpoint.h"
+#include "src/core/ext/xds/xds_listener.h"
+#include "src/core/ext/xds/xds_route_config.h"
+#include "src/proto/grpc/testing/xds/v3/cluster.grpc.pb.h"
+#include "src/proto/grpc/testing/xds/v3/endpoint.grpc.pb.h"
+#include "src/proto/grpc/testing/xds/v3/listener.grpc.pb.h"
+#include "src/proto/grpc/testing/xds/v3/route.grpc.pb.h"
+#include "test/core/util/test_config.h"
+
+namespace grpc_core {
+namespace testing {
+namespace {
+
+using ::envoy::config::cluster::v3::Cluster;
+using ::envoy::config::endpoint::v3::ClusterLoadAssignment;
+using ::envoy::config::listener::v3::Listener;
+using ::envoy::config::route::v3::RouteConfiguration;
+
+TEST(PeekNameTest, ReadsNameOfEachResourceType) {
+  Listener listener;
+  listener.set_name("listener");
+  listener.mutable_address()->mutable_socket_address()->set_port_value(443);
+  EXPECT_EQ(XdsListenerResourceType::Get()->PeekName(
+                listener.SerializeAsString()),
+            "listener");
+  RouteConfiguration route_config;
+  route_config.set_name("route_config");
+  route_config.add_virtual_hosts()->add_domains("*");
+  EXPECT_EQ(XdsRouteConfigResourceType::Get()->PeekName(
+                route_config.SerializeAsString()),
+            "route_config");
+  Cluster cluster;
+  cluster.set_name("cluster");
+  cluster.set_type(Cluster::EDS);
+  cluster.mutable_eds_cluster_config()->mutable_eds_config()->mutable_self();
+  EXPECT_EQ(
+      XdsClusterResourceType::Get()->PeekName(cluster.SerializeAsString()),
+      "cluster");
+  ClusterLoadAssignment endpoints;
+  endpoints.set_cluster_name("endpoints");
+  endpoints.add_endpoints()->mutable_locality()->set_region("region");
+  EXPECT_EQ(XdsEndpointResourceType::Get()->PeekName(
+                endpoints.SerializeAsString()),
+            "endpoints");
+}
+
+TEST(PeekNameTest, LastNameWins) {
+  Cluster first;
+  first.set_name("first");
+  first.set_type(Cluster::EDS);
+  Cluster second;
+  second.set_name("second");
+  std::string serialized =
+      first.SerializeAsString() + second.SerializeAsString();
+  Cluster merged;
+  ASSERT_TRUE(merged.ParseFromString(serialized));
+  EXPECT_EQ(XdsClusterResourceType::Get()->PeekName(serialized),
+            merged.name());
+}
+
+TEST(PeekNameTest, NoName) {
+  Cluster cluster;
+  cluster.set_type(Cluster::EDS);
+  EXPECT_EQ(
+      XdsClusterResourceType::Get()->PeekName(cluster.SerializeAsString()),
+      absl::nullopt);
+}
+
+TEST(PeekNameTest, MalformedInput) {
+  Cluster cluster;
+  cluster.set_name("cluster");
+  std::string serialized = cluster.SerializeAsString();
+  serialized.pop_back();
+  EXPECT_EQ(XdsClusterResourceType::Get()->PeekName(serialized),
+            absl::nullopt);
+  // A start-group tag for field 2.
+  EXPECT_EQ(XdsClusterResourceType::Get()->PeekName("\x13"), absl::nullopt);
+  // A varint that never ends.
+  EXPECT_EQ(XdsClusterResourceType::Get()->PeekName("\x08\xff"),
+            absl::nullopt);
+}
+
+}  // namespace
+}  // namespace testing
+}  // namespace grpc_core
+
+int main(int argc, char** argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  grpc::testing::TestEnvironment env(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,280 @@
+//
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include "src/core/ext/xds/xds_routing.h"
+
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "absl/strings/str_cat.h"
+
+#include "src/core/lib/resource_quota/arena.h"
+#include "src/core/lib/resource_quota/resource_quota.h"
+#include "src/core/lib/transport/metadata_batch.h"
+#include "test/core/util/test_config.h"
+
+namespace grpc_core {
+namespace testing {
+namespace {
+
+using Matchers = XdsRouteConfigResource::Route::Matchers;
+
+class MatchersListIterator : public XdsRouting::RouteListIterator {
+ public:
+  explicit MatchersListIterator(const std::vector<Matchers>* routes)
+      : routes_(routes) {}
+
+  size_t Size() const override { return routes_->size(); }
+
+  const Matchers& GetMatchersForRoute(size_t index) const override {
+    return (*routes_)[index];
+  }
+
+ private:
+  const std::vector<Matchers>* routes_;
+};
+
+class CompiledRouteListTest : public ::testing::Test {
+ protected:
+  void AddRoute(StringMatcher::Type type, absl::string_view path,
+                bool case_sensitive = true,
+                std::vector<HeaderMatcher> header_matchers = {}) {
+    auto path_matcher = StringMatcher::Create(type, path, case_sensitive);
+    ASSERT_TRUE(path_matcher.ok()) << path_matcher.status();
+    Matchers matchers;
+    matchers.path_matcher = std::move(*path_matcher);
+    matchers.header_matchers = std::move(header_matchers);
+    routes_.push_back(std::move(matchers));
+  }
+
+  void AddHeader(absl::string_view key, absl::string_view value) {
+    metadata_.Append(key, Slice::FromCopiedString(value),
+                     [](absl::string_view, const Slice&) { abort(); });
+  }
+
+  // Returns the route chosen for path, checking that the compiled route
+  // list agrees with the linear search.
+  absl::optional<size_t> GetRoute(absl::string_view path) {
+    MatchersListIterator iterator(&routes_);
+    XdsRouting::CompiledRouteList compiled(iterator);
+    absl::optional<size_t> expected =
+        XdsRouting::GetRouteForRequest(iterator, path, &metadata_);
+    absl::optional<size_t> actual =
+        compiled.GetRouteForRequest(iterator, path, &metadata_);
+    EXPECT_EQ(actual, expected) << path;
+    return actual;
+  }
+
+  MemoryAllocator allocator_ =
+      ResourceQuota::Default()->memory_quota()->CreateMemoryAllocator(
+          "CompiledRouteListTest");
+  ScopedArenaPtr arena_ = MakeScopedArena(1024, &allocator_);
+  grpc_metadata_batch metadata_{arena_.get()};
+  std::vector<Matchers> routes_;
+};
+
+TEST_F(CompiledRouteListTest, FirstMatchingRouteWins) {
+  AddRoute(StringMatcher::Type::kExact, "/pkg.Service/Method");
+  AddRoute(StringMatcher::Type::kPrefix, "/pkg.Service/");
+  AddRoute(StringMatcher::Type::kPrefix, "/pkg.");
+  AddRoute(StringMatcher::Type::kSafeRegex, "/pkg\\.Other/.*");
+  AddRoute(StringMatcher::Type::kSuffix, "/Last");
+  AddRoute(StringMatcher::Type::kPrefix, "");
+  EXPECT_EQ(GetRoute("/pkg.Service/Method"), 0);
+  EXPECT_EQ(GetRoute("/pkg.Service/Method2"), 1);
+  EXPECT_EQ(GetRoute("/pkg.Other/Method"), 2);
+  EXPECT_EQ(GetRoute("/other.Other/Last"), 4);
+  EXPECT_EQ(GetRoute("/other.Service/Method"), 5);
+  EXPECT_EQ(GetRoute(""), 5);
+}
+
+TEST_F(CompiledRouteListTest, NoMatch) {
+  AddRoute(StringMatcher::Type::kExact, "/pkg.Service/Method");
+  AddRoute(StringMatcher::Type::kPrefix, "/pkg.Service/Method/");
+  AddRoute(StringMatcher::Type::kSafeRegex, "/pkg\\.Service/M");
+  EXPECT_EQ(GetRoute("/pkg.Service/Method2"), absl::nullopt);
+  EXPECT_EQ(GetRoute("/pkg.Service/"), absl::nullopt);
+  EXPECT_EQ(GetRoute(""), absl::nullopt);
+}
+
+TEST_F(CompiledRouteListTest, CaseInsensitive) {
+  AddRoute(StringMatcher::Type::kExact, "/PKG.Service/method",
+           /*case_sensitive=*/false);
+  AddRoute(StringMatcher::Type::kPrefix, "/Pkg.Service/",
+           /*case_sensitive=*/false);
+  AddRoute(StringMatcher::Type::kPrefix, "/pkg.");
+  EXPECT_EQ(GetRoute("/pkg.service/METHOD"), 0);
+  EXPECT_EQ(GetRoute("/PKG.SERVICE/Other"), 1);
+  EXPECT_EQ(GetRoute("/pkg.Other/Other"), 2);
+  EXPECT_EQ(GetRoute("/PKG.Other/Other"), absl::nullopt);
+}
+
+TEST_F(CompiledRouteListTest, HeadersCheckedInRouteOrder) {
+  auto header_matcher =
+      HeaderMatcher::Create("x-route", HeaderMatcher::Type::kExact, "canary");
+  ASSERT_TRUE(header_matcher.ok());
+  AddRoute(StringMatcher::Type::kSafeRegex, "/pkg\\.Service/.*",
+           /*case_sensitive=*/true, {*header_matcher});
+  AddRoute(StringMatcher::Type::kPrefix, "/pkg.Service/",
+           /*case_sensitive=*/true, {*header_matcher});
+  AddRoute(StringMatcher::Type::kExact, "/pkg.Service/Method");
+  EXPECT_EQ(GetRoute("/pkg.Service/Method"), 2);
+  AddHeader("x-route", "canary");
+  EXPECT_EQ(GetRoute("/pkg.Service/Method"), 0);
+}
+
+TEST_F(CompiledRouteListTest, ManyRoutes) {
+  for (int i = 0; i < 200; ++i) {
+    switch (i % 4) {
+      case 0:
+        AddRoute(StringMatcher::Type::kExact,
+                 absl::StrCat("/svc", i / 4, ".Service/Method"));
+        break;
+      case 1:
+        AddRoute(StringMatcher::Type::kPrefix,
+                 absl::StrCat("/svc", i / 8, "."));
+        break;
+      case 2:
+        AddRoute(StringMatcher::Type::kSafeRegex,
+                 absl::StrCat("/svc", i / 4, "\\.Service/M.*"));
+        break;
+      case 3:
+        AddRoute(StringMatcher::Type::kSuffix, absl::StrCat("/Method", i));
+        break;
+    }
+  }
+  for (int i = 0; i < 60; ++i) {
+    GetRoute(absl::StrCat("/svc", i, ".Service/Method"));
+    GetRoute(absl::StrCat("/svc", i, ".Service/Mystery"));
+    GetRoute(absl::StrCat("/svc", i, ".Other/Method", i));
+    GetRoute(absl::StrCat("/svc", i));
+  }
+}
+
+class DomainsListIterator : public XdsRouting::VirtualHostListIterator {
+ public:
+  explicit DomainsListIterator(
+      const std::vector<std::vector<std::string>>* virtual_hosts)
+      : virtual_hosts_(virtual_hosts) {}
+
+  size_t Size() const override { return virtual_hosts_->size(); }
+
+  const std::vector<std::string>& GetDomainsForVirtualHost(
+      size_t index) const override {
+    return (*virtual_hosts_)[index];
+  }
+
+ private:
+  const std::vector<std::vector<std::string>>* virtual_hosts_;
+};
+
+// Returns the virtual host chosen for domain, checking that the index
+// agrees with the linear search.
+absl::optional<size_t> FindVirtualHost(
+    const std::vector<std::vector<std::string>>& virtual_hosts,
+    absl::string_view domain) {
+  DomainsListIterator iterator(&virtual_hosts);
+  XdsVirtualHostIndex index(iterator);
+  absl::optional<size_t> expected =
+      XdsRouting::FindVirtualHostForDomain(iterator, domain);
+  absl::optional<size_t> actual = index.Find(domain);
+  EXPECT_EQ(actual, expected) << domain;
+  return actual;
+}
+
+TEST(XdsVirtualHostIndexTest, MatchTypesInOrder) {
+  std::vector<std::vector<std::string>> virtual_hosts = {
+      {"*"},
+      {"foo.*", "bar.example.com"},
+      {"*.example.com"},
+      {"foo.example.com"},
+  };
+  EXPECT_EQ(FindVirtualHost(virtual_hosts, "foo.example.com"), 3);
+  EXPECT_EQ(FindVirtualHost(virtual_hosts, "bar.example.com"), 1);
+  EXPECT_EQ(FindVirtualHost(virtual_hosts, "baz.example.com"), 2);
+  EXPECT_EQ(FindVirtualHost(virtual_hosts, "foo.example.org"), 1);
+  EXPECT_EQ(FindVirtualHost(virtual_hosts, "baz.example.org"), 0);
+}
+
+TEST(XdsVirtualHostIndexTest, LongestMatchWinsThenFirst) {
+  std::vector<std::vector<std::string>> virtual_hosts = {
+      {"*.com", "a.*"},
+      {"*.example.com", "a.b.*"},
+      {"*.example.com", "a.b.*"},
+  };
+  EXPECT_EQ(FindVirtualHost(virtual_hosts, "www.example.com"), 1);
+  EXPECT_EQ(FindVirtualHost(virtual_hosts, "www.other.com"), 0);
+  EXPECT_EQ(FindVirtualHost(virtual_hosts, "a.b.c"), 1);
+  EXPECT_EQ(FindVirtualHost(virtual_hosts, "a.c"), 0);
+}
+
+TEST(XdsVirtualHostIndexTest, WildcardMatchesAtLeastOneCharacter) {
+  std::vector<std::vector<std::string>> virtual_hosts = {
+      {"*.example.com"},
+      {"example.*"},
+  };
+  EXPECT_EQ(FindVirtualHost(virtual_hosts, ".example.com"), absl::nullopt);
+  EXPECT_EQ(FindVirtualHost(virtual_hosts, "x.example.com"), 0);
+  EXPECT_EQ(FindVirtualHost(virtual_hosts, "example."), absl::nullopt);
+  EXPECT_EQ(FindVirtualHost(virtual_hosts, "example.x"), 1);
+}
+
+TEST(XdsVirtualHostIndexTest, CaseInsensitive) {
+  std::vector<std::vector<std::string>> virtual_hosts = {
+      {"Foo.Example.com"},
+      {"*.EXAMPLE.com"},
+      {"BAR.*"},
+  };
+  EXPECT_EQ(FindVirtualHost(virtual_hosts, "foo.example.COM"), 0);
+  EXPECT_EQ(FindVirtualHost(virtual_hosts, "baz.Example.com"), 1);
+  EXPECT_EQ(FindVirtualHost(virtual_hosts, "bar.example.org"), 2);
+  EXPECT_EQ(FindVirtualHost(virtual_hosts, "baz.example.org"), absl::nullopt);
+}
+
+TEST(XdsVirtualHostIndexTest, ManyVirtualHosts) {
+  std::vector<std::vector<std::string>> virtual_hosts;
+  for (int i = 0; i < 300; ++i) {
+    switch (i % 3) {
+      case 0:
+        virtual_hosts.push_back({absl::StrCat("svc", i, ".example.com"),
+                                 absl::StrCat("svc", i, ".example.com:443")});
+        break;
+      case 1:
+        virtual_hosts.push_back({absl::StrCat("*.", i % 7, ".example.com")});
+        break;
+      case 2:
+        virtual_hosts.push_back({absl::StrCat("svc", i % 11, ".*")});
+        break;
+    }
+  }
+  for (int i = 0; i < 300; ++i) {
+    FindVirtualHost(virtual_hosts, absl::StrCat("svc", i, ".example.com"));
+    FindVirtualHost(virtual_hosts, absl::StrCat("x.", i % 9, ".example.com"));
+    FindVirtualHost(virtual_hosts, absl::StrCat("svc", i, ".example.org"));
+  }
+}
+
+}  // namespace
+}  // namespace testing
+}  // namespace grpc_core
+
+int main(int argc, char** argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  grpc::testing::TestEnvironment env(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -25,6 +25,8 @@
 #include <grpcpp/ext/proto_server_reflection_plugin.h>
 #include <grpcpp/grpcpp.h>
 
+#include "src/proto/grpc/channelz/channelz.grpc.pb.h"
+#include "src/proto/grpc/profiling/v1alpha/profiling.grpc.pb.h"
 #include "src/proto/grpc/reflection/v1alpha/reflection.grpc.pb.h"
 #include "test/core/util/port.h"
 #include "test/core/util/test_config.h"
@@ -35,17 +37,19 @@ namespace testing {
 class AdminServicesTest : public ::testing::Test {
  public:
   void SetUp() override {
-    std::string address =
-        absl::StrCat("localhost:", grpc_pick_unused_port_or_die());
+    address_ = absl::StrCat("localhost:", grpc_pick_unused_port_or_die());
     // Create admin server
     grpc::reflection::InitProtoReflectionServerBuilderPlugin();
     ServerBuilder builder;
-    builder.AddListeningPort(address, InsecureServerCredentials());
+    builder.AddListeningPort(address_, InsecureServerCredentials());
+    builder.AddChannelArgument(
+        "grpc.experimental.channelz_call_timeline_sample_period", 1);
     grpc::AddAdminServices(&builder);
     server_ = builder.BuildAndStart();
     // Create channel
-    auto reflection_stub = reflection::v1alpha::ServerReflection::NewStub(
-        CreateChannel(address, InsecureChannelCredentials()));
+    channel_ = CreateChannel(address_, InsecureChannelCredentials());
+    auto reflection_stub =
+        reflection::v1alpha::ServerReflection::NewStub(channel_);
     stream_ = reflection_stub->ServerReflectionInfo(&reflection_ctx_);
   }
 
@@ -62,8 +66,13 @@ class AdminServicesTest : public ::testing::Test {
     return services;
   }
 
+  const std::string& address() const { return address_; }
+  const std::shared_ptr<Channel>& channel() const { return channel_; }
+
  private:
+  std::string address_;
   std::unique_ptr<Server> server_;
+  std::shared_ptr<Channel> channel_;
   ClientContext reflection_ctx_;
   std::shared_ptr<
       ClientReaderWriter<reflection::v1alpha::ServerReflectionRequest,
@@ -78,6 +87,7 @@ TEST_F(AdminServicesTest, ValidateRegisteredServices) {
       GetServiceList(),
       ::testing::AllOf(
           ::testing::Contains("grpc.channelz.v1.Channelz"),
+          ::testing::Contains("grpc.profiling.v1alpha.Profiling"),
           ::testing::Contains("grpc.reflection.v1alpha.ServerReflection")));
 #if defined(GRPC_NO_XDS) || defined(DISABLED_XDS_PROTO_IN_CC)
   EXPECT_THAT(GetServiceList(),
@@ -90,6 +100,135 @@ TEST_F(AdminServicesTest, ValidateRegisteredServices) {
 #endif  // GRPC_NO_XDS or DISABLED_XDS_PROTO_IN_CC
 }
 
+TEST_F(AdminServicesTest, ProfilingReturnsTracePoints) {
+  auto stub = profiling::v1alpha::Profiling::NewStub(channel());
+  profiling::v1alpha::GetTracePointsRequest request;
+  profiling::v1alpha::GetTracePointsResponse response;
+  request.set_clear(true);
+  request.mutable_sample_period()->set_value(1);
+  {
+    ClientContext context;
+    ASSERT_TRUE(stub->GetTracePoints(&context, request, &response).ok());
+  }
+  EXPECT_EQ(response.sample_period(), 1);
+  // The previous RPC went through the transport's trace points, which
+  // sampled every hit.
+  request.clear_sample_period();
+  {
+    ClientContext context;
+    ASSERT_TRUE(stub->GetTracePoints(&context, request, &response).ok());
+  }
+  EXPECT_THAT(response.chrome_trace_json(),
+              ::testing::HasSubstr("\"name\":\"grpc_chttp2_begin_write\""));
+}
+
+TEST_F(AdminServicesTest, ProfilingReturnsContention) {
+  auto stub = profiling::v1alpha::Profiling::NewStub(channel());
+  profiling::v1alpha::GetContentionRequest request;
+  profiling::v1alpha::GetContentionResponse response;
+  request.set_clear(true);
+  request.mutable_sample_period()->set_value(1);
+  {
+    ClientContext context;
+    ASSERT_TRUE(stub->GetContention(&context, request, &response).ok());
+  }
+  EXPECT_EQ(response.sample_period(), 1);
+  // The previous RPC ran closures on the transport's combiner, whose hold
+  // times were all sampled.
+  request.mutable_sample_period()->set_value(0);
+  {
+    ClientContext context;
+    ASSERT_TRUE(stub->GetContention(&context, request, &response).ok());
+  }
+  EXPECT_EQ(response.sample_period(), 0);
+  EXPECT_THAT(response.contention_json(),
+              ::testing::HasSubstr("\"name\":\"Combiner\""));
+}
+
+TEST_F(AdminServicesTest, ProfilingReturnsServerCallTimelines) {
+  auto channelz_stub = channelz::v1::Channelz::NewStub(channel());
+  channelz::v1::GetServersRequest servers_request;
+  channelz::v1::GetServersResponse servers_response;
+  {
+    ClientContext context;
+    ASSERT_TRUE(
+        channelz_stub->GetServers(&context, servers_request, &servers_response)
+            .ok());
+  }
+  ASSERT_EQ(servers_response.server_size(), 1);
+  auto stub = profiling::v1alpha::Profiling::NewStub(channel());
+  profiling::v1alpha::GetCallTimelinesRequest request;
+  profiling::v1alpha::GetCallTimelinesResponse response;
+  request.set_channelz_id(servers_response.server(0).ref().server_id());
+  // Calls are only recorded once the server has destroyed them, which may
+  // happen after the client sees them finish.
+  const gpr_timespec deadline = grpc_timeout_seconds_to_deadline(10);
+  do {
+    ClientContext context;
+    ASSERT_TRUE(stub->GetCallTimelines(&context, request, &response).ok());
+    if (response.call_timelines_json().find("SERVER_HANDLER_START") !=
+        std::string::npos) {
+      break;
+    }
+    gpr_sleep_until(grpc_timeout_milliseconds_to_deadline(10));
+  } while (gpr_time_cmp(gpr_now(GPR_CLOCK_MONOTONIC), deadline) < 0);
+  EXPECT_THAT(response.call_timelines_json(),
+              ::testing::AllOf(
+                  ::testing::HasSubstr("\"samplePeriod\":1"),
+                  ::testing::HasSubstr("\"method\":\"/grpc.channelz.v1."
+                                       "Channelz/GetServers\""),
+                  ::testing::HasSubstr("\"stage\":\"SERVER_HANDLER\"")));
+  request.set_channelz_id(-1);
+  ClientContext context;
+  EXPECT_EQ(stub->GetCallTimelines(&context, request, &response).error_code(),
+            StatusCode::NOT_FOUND);
+}
+
+TEST_F(AdminServicesTest, ProfilingReturnsClientMethodLatencies) {
+  ChannelArguments args;
+  args.SetInt("grpc.experimental.channelz_method_latency_stats", 1);
+  auto channelz_stub = channelz::v1::Channelz::NewStub(CreateCustomChannel(
+      address(), InsecureChannelCredentials(), args));
+  channelz::v1::GetTopChannelsRequest channels_request;
+  channelz::v1::GetTopChannelsResponse channels_response;
+  {
+    ClientContext context;
+    ASSERT_TRUE(channelz_stub
+                    ->GetTopChannels(&context, channels_request,
+                                     &channels_response)
+                    .ok());
+  }
+  // The call above is recorded by the channel it went through, which is
+  // the only one with method latency stats.  That channel also reports the
+  // call_initial_size histogram of the registered GetTopChannels method.
+  auto stub = profiling::v1alpha::Profiling::NewStub(channel());
+  profiling::v1alpha::GetMethodLatenciesRequest request;
+  profiling::v1alpha::GetMethodLatenciesResponse response;
+  int channels_with_latencies = 0;
+  for (const auto& top_channel : channels_response.channel()) {
+    request.set_channelz_id(top_channel.ref().channel_id());
+    ClientContext context;
+    ASSERT_TRUE(stub->GetMethodLatencies(&context, request, &response).ok());
+    if (response.method_latencies_json().find("\"p99Micros\"") !=
+        std::string::npos) {
+      EXPECT_THAT(
+          response.method_latencies_json(),
+          ::testing::AllOf(
+              ::testing::HasSubstr(
+                  "\"method\":\"/grpc.channelz.v1.Channelz/GetTopChannels\""),
+              ::testing::HasSubstr("\"count\":\"1\""),
+              ::testing::HasSubstr("\"callInitialSize\":[{")));
+      ++channels_with_latencies;
+    }
+  }
+  EXPECT_EQ(channels_with_latencies, 1);
+  request.set_channelz_id(-1);
+  ClientContext context;
+  EXPECT_EQ(
+      stub->GetMethodLatencies(&context, request, &response).error_code(),
+      StatusCode::NOT_FOUND);
+}
+
 }  // namespace testing
 }  // namespace grpc
 
@@ -13,6 +13,7 @@
 // limitations under the License.
 
 #include <algorithm>
+#include <cmath>
 #include <deque>
 #include <memory>
 #include <mutex>
@@ -47,6 +48,7 @@
 
 #include "src/core/ext/filters/client_channel/backup_poller.h"
 #include "src/core/ext/filters/client_channel/global_subchannel_pool.h"
+#include "src/core/ext/filters/client_channel/lb_policy/subsetting/deterministic_subset.h"
 #include "src/core/ext/filters/client_channel/resolver/fake/fake_resolver.h"
 #include "src/core/lib/address_utils/parse_address.h"
 #include "src/core/lib/address_utils/sockaddr_utils.h"
@@ -89,17 +91,25 @@ class MyTestServiceImpl : public TestServiceImpl {
  public:
   Status Echo(ServerContext* context, const EchoRequest* request,
               EchoResponse* response) override {
+    int delay_ms;
     {
       grpc::internal::MutexLock lock(&mu_);
       ++request_count_;
+      delay_ms = echo_delay_ms_;
     }
     AddClient(context->peer());
+    if (delay_ms > 0) {
+      gpr_sleep_until(grpc_timeout_milliseconds_to_deadline(delay_ms));
+    }
     if (request->has_param() && request->param().has_backend_metrics()) {
       load_report_ = request->param().backend_metrics();
       auto* recorder = context->ExperimentalGetCallMetricRecorder();
       EXPECT_NE(recorder, nullptr);
       recorder->RecordCpuUtilizationMetric(load_report_.cpu_utilization())
           .RecordMemoryUtilizationMetric(load_report_.mem_utilization());
+      if (load_report_.rps() != 0) {
+        recorder->RecordQpsMetric(load_report_.rps());
+      }
       for (const auto& p : load_report_.request_cost()) {
         recorder->RecordRequestCostMetric(p.first, p.second);
       }
@@ -120,6 +130,12 @@ class MyTestServiceImpl : public TestServiceImpl {
     request_count_ = 0;
   }
 
+  // Makes every subsequent Echo take at least delay_ms.
+  void set_echo_delay_ms(int delay_ms) {
+    grpc::internal::MutexLock lock(&mu_);
+    echo_delay_ms_ = delay_ms;
+  }
+
   std::set<std::string> clients() {
     grpc::internal::MutexLock lock(&clients_mu_);
     return clients_;
@@ -133,6 +149,7 @@ class MyTestServiceImpl : public TestServiceImpl {
 
   grpc::internal::Mutex mu_;
   int request_count_ = 0;
+  int echo_delay_ms_ = 0;
   grpc::internal::Mutex clients_mu_;
   std::set<std::string> clients_;
   // For strings storage.
@@ -2233,6 +2250,9 @@ xds::data::orca::v3::OrcaLoadReport BackendMetricDataToOrcaLoadReport(
   xds::data::orca::v3::OrcaLoadReport load_report;
   load_report.set_cpu_utilization(backend_metric_data.cpu_utilization);
   load_report.set_mem_utilization(backend_metric_data.mem_utilization);
+  if (backend_metric_data.qps > 0) {
+    load_report.set_rps(static_cast<uint64_t>(backend_metric_data.qps));
+  }
   for (const auto& p : backend_metric_data.request_cost) {
     std::string name(p.first);
     (*load_report.mutable_request_cost())[name] = p.second;
@@ -2664,6 +2684,236 @@ TEST_F(OobBackendMetricTest, Basic) {
   }
 }
 
+//
+// tests weighted_round_robin LB policy
+//
+
+class WeightedRoundRobinTest : public ClientLbEnd2endTest {
+ protected:
+  static constexpr char kServiceConfig[] =
+      "{\"loadBalancingConfig\": [{\"weighted_round_robin_experimental\": {"
+      "\"enableOobLoadReport\": true, \"oobReportingPeriod\": \"0.1s\", "
+      "\"blackoutPeriod\": \"0s\", \"weightUpdatePeriod\": \"0.1s\"}}]}";
+
+  // Sends rounds of RPCs until the servers' shares of a round are within
+  // 10% of their shares of expected_weights.
+  void WaitForWeightedDistribution(
+      const grpc_core::DebugLocation& location,
+      const std::unique_ptr<grpc::testing::EchoTestService::Stub>& stub,
+      const std::vector<size_t>& expected_weights,
+      absl::Duration timeout = absl::Seconds(30)) {
+    ASSERT_EQ(expected_weights.size(), servers_.size());
+    size_t total_weight = 0;
+    for (size_t weight : expected_weights) total_weight += weight;
+    const size_t num_rpcs = total_weight * 50;
+    auto deadline = absl::Now() + (timeout * grpc_test_slowdown_factor());
+    while (true) {
+      ResetCounters();
+      for (size_t i = 0; i < num_rpcs; ++i) CheckRpcSendOk(location, stub);
+      bool matched = true;
+      std::vector<std::string> counts;
+      for (size_t i = 0; i < servers_.size(); ++i) {
+        const double expected =
+            1.0 * num_rpcs * expected_weights[i] / total_weight;
+        const int actual = servers_[i]->service_.request_count();
+        if (std::abs(actual - expected) > expected * 0.1) matched = false;
+        counts.push_back(absl::StrCat(actual));
+      }
+      gpr_log(GPR_INFO, "request counts: %s",
+              absl::StrJoin(counts, ", ").c_str());
+      if (matched) break;
+      ASSERT_LT(absl::Now(), deadline)
+          << "at " << location.file() << ":" << location.line();
+    }
+    ResetCounters();
+  }
+};
+
+constexpr char WeightedRoundRobinTest::kServiceConfig[];
+
+TEST_F(WeightedRoundRobinTest, OobReportsSetWeights) {
+  StartServers(3);
+  // Weights are qps / cpu_utilization, which gives 1000, 500 and 250.
+  const double kCpuUtilization[] = {0.1, 0.2, 0.4};
+  for (size_t i = 0; i < servers_.size(); ++i) {
+    servers_[i]->orca_service_.SetQps(100);
+    servers_[i]->orca_service_.SetCpuUtilization(kCpuUtilization[i]);
+  }
+  auto response_generator = BuildResolverResponseGenerator();
+  auto channel = BuildChannel("", response_generator);
+  auto stub = BuildStub(channel);
+  response_generator.SetNextResolution(GetServersPorts(), kServiceConfig);
+  WaitForServers(DEBUG_LOCATION, stub);
+  EXPECT_EQ("weighted_round_robin_experimental",
+            channel->GetLoadBalancingPolicyName());
+  WaitForWeightedDistribution(DEBUG_LOCATION, stub, {4, 2, 1});
+}
+
+TEST_F(WeightedRoundRobinTest, WeightsSurviveResolverUpdates) {
+  // Long enough that a restarted blackout period would be noticed.
+  const char* kServiceConfigWithBlackout =
+      "{\"loadBalancingConfig\": [{\"weighted_round_robin_experimental\": {"
+      "\"enableOobLoadReport\": true, \"oobReportingPeriod\": \"0.1s\", "
+      "\"blackoutPeriod\": \"5s\", \"weightUpdatePeriod\": \"0.1s\"}}]}";
+  StartServers(3);
+  const double kCpuUtilization[] = {0.1, 0.2, 0.4};
+  for (size_t i = 0; i < servers_.size(); ++i) {
+    servers_[i]->orca_service_.SetQps(100);
+    servers_[i]->orca_service_.SetCpuUtilization(kCpuUtilization[i]);
+  }
+  auto response_generator = BuildResolverResponseGenerator();
+  auto channel = BuildChannel("", response_generator);
+  auto stub = BuildStub(channel);
+  response_generator.SetNextResolution(GetServersPorts(),
+                                       kServiceConfigWithBlackout);
+  WaitForServers(DEBUG_LOCATION, stub);
+  WaitForWeightedDistribution(DEBUG_LOCATION, stub, {4, 2, 1});
+  // The same backends again.  Their subchannels are already READY, so
+  // their weights must stay in use rather than going through another
+  // blackout period, during which they would all get the same share.
+  response_generator.SetNextResolution(GetServersPorts(),
+                                       kServiceConfigWithBlackout);
+  WaitForWeightedDistribution(DEBUG_LOCATION, stub, {4, 2, 1},
+                              absl::Seconds(2));
+}
+
+TEST_F(WeightedRoundRobinTest, RoundRobinWithoutReports) {
+  StartServers(3);
+  auto response_generator = BuildResolverResponseGenerator();
+  auto channel = BuildChannel("", response_generator);
+  auto stub = BuildStub(channel);
+  response_generator.SetNextResolution(GetServersPorts(), kServiceConfig);
+  WaitForServers(DEBUG_LOCATION, stub);
+  WaitForWeightedDistribution(DEBUG_LOCATION, stub, {1, 1, 1});
+}
+
+//
+// tests least_request LB policy
+//
+
+class LeastRequestTest : public ClientLbEnd2endTest {
+ protected:
+  static constexpr char kServiceConfig[] =
+      "{\"loadBalancingConfig\": [{\"least_request_experimental\": {"
+      "\"choiceCount\": 2}}]}";
+
+  // Sends rpcs_per_thread RPCs back to back from each of num_threads
+  // threads, and returns the 99th percentile latency in milliseconds.
+  int64_t SendConcurrentRpcs(
+      const std::unique_ptr<grpc::testing::EchoTestService::Stub>& stub,
+      size_t num_threads, size_t rpcs_per_thread) {
+    std::vector<int64_t> latencies_ms(num_threads * rpcs_per_thread);
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < num_threads; ++t) {
+      threads.emplace_back([&, t]() {
+        for (size_t i = 0; i < rpcs_per_thread; ++i) {
+          const gpr_timespec t0 = gpr_now(GPR_CLOCK_MONOTONIC);
+          Status status = SendRpc(stub, nullptr, /*timeout_ms=*/10000);
+          EXPECT_TRUE(status.ok()) << status.error_message();
+          const gpr_timespec t1 = gpr_now(GPR_CLOCK_MONOTONIC);
+          latencies_ms[t * rpcs_per_thread + i] =
+              grpc_core::Duration::FromTimespec(gpr_time_sub(t1, t0))
+                  .millis();
+        }
+      });
+    }
+    for (auto& thread : threads) thread.join();
+    std::sort(latencies_ms.begin(), latencies_ms.end());
+    return latencies_ms[latencies_ms.size() * 99 / 100];
+  }
+};
+
+constexpr char LeastRequestTest::kServiceConfig[];
+
+TEST_F(LeastRequestTest, AvoidsSlowBackend) {
+  constexpr size_t kNumThreads = 8;
+  constexpr size_t kRpcsPerThread = 100;
+  const int kSlowDelayMs = 200 * grpc_test_slowdown_factor();
+  StartServers(4);
+  servers_[0]->service_.set_echo_delay_ms(kSlowDelayMs);
+  // Baseline: round_robin gives the slow backend a quarter of the RPCs, so
+  // more than 1% of them are slow.
+  auto rr_response_generator = BuildResolverResponseGenerator();
+  auto rr_channel = BuildChannel("round_robin", rr_response_generator);
+  auto rr_stub = BuildStub(rr_channel);
+  rr_response_generator.SetNextResolution(GetServersPorts());
+  WaitForServers(DEBUG_LOCATION, rr_stub);
+  const int64_t rr_p99_ms =
+      SendConcurrentRpcs(rr_stub, kNumThreads, kRpcsPerThread);
+  const int rr_slow_count = servers_[0]->service_.request_count();
+  ResetCounters();
+  // least_request only sends the slow backend as many RPCs as it can keep
+  // outstanding, which is a small fraction of the total.
+  auto lr_response_generator = BuildResolverResponseGenerator();
+  auto lr_channel = BuildChannel("", lr_response_generator);
+  auto lr_stub = BuildStub(lr_channel);
+  lr_response_generator.SetNextResolution(GetServersPorts(), kServiceConfig);
+  WaitForServers(DEBUG_LOCATION, lr_stub);
+  EXPECT_EQ("least_request_experimental",
+            lr_channel->GetLoadBalancingPolicyName());
+  ResetCounters();
+  const int64_t lr_p99_ms =
+      SendConcurrentRpcs(lr_stub, kNumThreads, kRpcsPerThread);
+  const int lr_slow_count = servers_[0]->service_.request_count();
+  gpr_log(GPR_INFO,
+          "p99 latency: round_robin %" PRId64 "ms (%d slow RPCs), "
+          "least_request %" PRId64 "ms (%d slow RPCs)",
+          rr_p99_ms, rr_slow_count, lr_p99_ms, lr_slow_count);
+  EXPECT_GE(rr_p99_ms, kSlowDelayMs);
+  EXPECT_LT(lr_p99_ms, kSlowDelayMs);
+  EXPECT_LT(lr_slow_count, rr_slow_count / 4);
+}
+
+//
+// tests deterministic_subsetting LB policy
+//
+
+class DeterministicSubsettingTest : public ClientLbEnd2endTest {
+ protected:
+  static constexpr char kServiceConfig[] =
+      "{\"loadBalancingConfig\": [{\"deterministic_subsetting_experimental\": "
+      "{\"subsetSize\": 2, \"childPolicy\": [{\"round_robin\": {}}]}}]}";
+
+  // Returns the indexes of the servers that have received RPCs.
+  std::set<size_t> UsedServers() {
+    std::set<size_t> used;
+    for (size_t i = 0; i < servers_.size(); ++i) {
+      if (servers_[i]->service_.request_count() > 0) used.insert(i);
+    }
+    return used;
+  }
+};
+
+constexpr char DeterministicSubsettingTest::kServiceConfig[];
+
+TEST_F(DeterministicSubsettingTest, ClientsInOneRoundUseDisjointSubsets) {
+  StartServers(4);
+  std::set<size_t> all_used;
+  for (int client_index = 0; client_index < 2; ++client_index) {
+    ResetCounters();
+    ChannelArguments args;
+    args.SetInt(GRPC_ARG_SUBSETTING_CLIENT_INDEX, client_index);
+    auto response_generator = BuildResolverResponseGenerator();
+    auto channel = BuildChannel("", response_generator, args);
+    auto stub = BuildStub(channel);
+    response_generator.SetNextResolution(GetServersPorts(), kServiceConfig);
+    // Send RPCs until round_robin has spread them over the whole subset.
+    const gpr_timespec deadline = grpc_timeout_seconds_to_deadline(5);
+    while (UsedServers().size() < 2 &&
+           gpr_time_cmp(gpr_now(GPR_CLOCK_MONOTONIC), deadline) < 0) {
+      CheckRpcSendOk(DEBUG_LOCATION, stub, /*wait_for_ready=*/true);
+    }
+    for (size_t i = 0; i < 10; ++i) CheckRpcSendOk(DEBUG_LOCATION, stub);
+    std::set<size_t> used = UsedServers();
+    EXPECT_EQ(used.size(), 2) << "client " << client_index;
+    for (size_t i : used) {
+      EXPECT_TRUE(all_used.insert(i).second)
+          << "server " << i << " is in both clients' subsets";
+    }
+  }
+  EXPECT_EQ(all_used.size(), 4);
+}
+
 }  // namespace
 }  // namespace testing
 }  // namespace grpc
@@ -217,6 +217,89 @@ TEST_P(XdsClientTest, XdsStreamErrorPropagation) {
               ::testing::HasSubstr("(node ID:xds_end2end_test)"));
 }
 
+//
+// XdsDeltaTest - tests for the incremental (delta) variant of ADS
+//
+
+using XdsDeltaTest = XdsEnd2endTest;
+
+INSTANTIATE_TEST_SUITE_P(
+    XdsTest, XdsDeltaTest,
+    ::testing::Values(XdsTestType().set_use_delta(),
+                      XdsTestType().set_use_delta().set_enable_rds_testing()),
+    &XdsTestType::Name);
+
+TEST_P(XdsDeltaTest, Vanilla) {
+  CreateAndStartBackends(1);
+  EdsResourceArgs args({{"locality0", CreateEndpointsForBackends()}});
+  balancer_->ads_service()->SetEdsResource(BuildEdsResource(args));
+  CheckRpcSendOk(DEBUG_LOCATION, 10);
+  EXPECT_TRUE(balancer_->ads_service()->seen_delta_client());
+  auto response_state = balancer_->ads_service()->eds_response_state();
+  ASSERT_TRUE(response_state.has_value());
+  EXPECT_EQ(response_state->state, AdsServiceImpl::ResponseState::ACKED);
+}
+
+// Tests that updating one resource sends only that resource, even for
+// resource types whose state-of-the-world responses carry every resource.
+TEST_P(XdsDeltaTest, UpdateSendsOnlyChangedResource) {
+  CreateAndStartBackends(2);
+  EdsResourceArgs args({{"locality0", CreateEndpointsForBackends(0, 1)}});
+  balancer_->ads_service()->SetEdsResource(BuildEdsResource(args));
+  WaitForAllBackends(DEBUG_LOCATION, 0, 1);
+  const size_t resources_sent =
+      balancer_->ads_service()->delta_resources_sent();
+  args = EdsResourceArgs({{"locality0", CreateEndpointsForBackends(1, 2)}});
+  balancer_->ads_service()->SetEdsResource(BuildEdsResource(args));
+  WaitForAllBackends(DEBUG_LOCATION, 1, 2);
+  EXPECT_EQ(balancer_->ads_service()->delta_resources_sent(),
+            resources_sent + 1);
+  // Now add a second cluster without referencing it: nothing is sent,
+  // since the client is not subscribed to it.
+  Cluster new_cluster = default_cluster_;
+  new_cluster.set_name("new_cluster_name");
+  balancer_->ads_service()->SetCdsResource(new_cluster);
+  CheckRpcSendOk(DEBUG_LOCATION, 10);
+  EXPECT_EQ(balancer_->ads_service()->delta_resources_sent(),
+            resources_sent + 1);
+}
+
+TEST_P(XdsDeltaTest, RemovedResourceDoesNotExist) {
+  CreateAndStartBackends(1);
+  EdsResourceArgs args({{"locality0", CreateEndpointsForBackends()}});
+  balancer_->ads_service()->SetEdsResource(BuildEdsResource(args));
+  CheckRpcSendOk(DEBUG_LOCATION);
+  balancer_->ads_service()->UnsetResource(kCdsTypeUrl, kDefaultClusterName);
+  // Wait for RPCs to start failing.
+  do {
+  } while (SendRpc(RpcOptions(), nullptr).ok());
+  CheckRpcSendFailure(DEBUG_LOCATION,
+                      CheckRpcSendFailureOptions().set_times(10));
+  // Restoring the resource restores service.
+  balancer_->ads_service()->SetCdsResource(default_cluster_);
+  WaitForAllBackends(DEBUG_LOCATION);
+}
+
+// Tests that after the ADS stream restarts, resources the client already
+// has are not sent again.
+TEST_P(XdsDeltaTest, CachedResourcesNotResentAfterStreamRestart) {
+  CreateAndStartBackends(2);
+  EdsResourceArgs args({{"locality0", CreateEndpointsForBackends(0, 1)}});
+  balancer_->ads_service()->SetEdsResource(BuildEdsResource(args));
+  WaitForAllBackends(DEBUG_LOCATION, 0, 1);
+  const size_t resources_sent =
+      balancer_->ads_service()->delta_resources_sent();
+  balancer_->Shutdown();
+  // Update the EDS resource while the client is disconnected.
+  args = EdsResourceArgs({{"locality0", CreateEndpointsForBackends(1, 2)}});
+  balancer_->ads_service()->SetEdsResource(BuildEdsResource(args));
+  balancer_->Start();
+  WaitForAllBackends(DEBUG_LOCATION, 1, 2);
+  // Only the resource that changed was sent on the new stream.
+  EXPECT_EQ(balancer_->ads_service()->delta_resources_sent(),
+            resources_sent + 1);
+}
+
 //
 // GlobalXdsClientTest - tests that need to run with a global XdsClient
 // (this is the default in production)
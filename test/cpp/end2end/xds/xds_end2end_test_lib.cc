@@ -335,9 +335,13 @@ std::string XdsEnd2endTest::BootstrapBuilder::MakeXdsServersText(
       "          \"server_features\": [<SERVER_FEATURES>]\n"
       "        }\n"
       "      ]";
-  return absl::StrReplaceAll(
-      kXdsServerTemplate, {{"<SERVER_URI>", server_uri},
-                           {"<SERVER_FEATURES>", (v2_ ? "" : "\"xds_v3\"")}});
+  std::string server_features;
+  if (!v2_) {
+    server_features = delta_ ? "\"xds_v3\", \"xds_delta\"" : "\"xds_v3\"";
+  }
+  return absl::StrReplaceAll(kXdsServerTemplate,
+                             {{"<SERVER_URI>", server_uri},
+                              {"<SERVER_FEATURES>", server_features}});
 }
 
 std::string XdsEnd2endTest::BootstrapBuilder::MakeNodeText() {
@@ -742,6 +746,7 @@ void XdsEnd2endTest::InitClient(BootstrapBuilder builder,
   // Initialize XdsClient state.
   builder.SetDefaultServer(absl::StrCat("localhost:", balancer_->port()));
   if (GetParam().use_v2()) builder.SetV2();
+  if (GetParam().use_delta()) builder.SetDelta();
   bootstrap_ = builder.Build();
   if (GetParam().bootstrap_source() == XdsTestType::kBootstrapFromEnvVar) {
     gpr_setenv("GRPC_XDS_BOOTSTRAP_CONFIG", bootstrap_.c_str());
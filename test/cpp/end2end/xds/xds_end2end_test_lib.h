@@ -79,6 +79,11 @@ class XdsTestType {
     return *this;
   }
 
+  XdsTestType& set_use_delta() {
+    use_delta_ = true;
+    return *this;
+  }
+
   XdsTestType& set_use_xds_credentials() {
     use_xds_credentials_ = true;
     return *this;
@@ -107,6 +112,7 @@ class XdsTestType {
   bool enable_load_reporting() const { return enable_load_reporting_; }
   bool enable_rds_testing() const { return enable_rds_testing_; }
   bool use_v2() const { return use_v2_; }
+  bool use_delta() const { return use_delta_; }
   bool use_xds_credentials() const { return use_xds_credentials_; }
   bool use_csds_streaming() const { return use_csds_streaming_; }
   HttpFilterConfigLocation filter_config_setup() const {
@@ -119,6 +125,7 @@ class XdsTestType {
 
   std::string AsString() const {
     std::string retval = use_v2_ ? "V2" : "V3";
+    if (use_delta_) retval += "Delta";
     if (enable_load_reporting_) retval += "WithLoadReporting";
     if (enable_rds_testing_) retval += "Rds";
     if (use_xds_credentials_) retval += "XdsCreds";
@@ -148,6 +155,7 @@ class XdsTestType {
   bool enable_load_reporting_ = false;
   bool enable_rds_testing_ = false;
   bool use_v2_ = false;
+  bool use_delta_ = false;
   bool use_xds_credentials_ = false;
   bool use_csds_streaming_ = false;
   HttpFilterConfigLocation filter_config_setup_ = kHttpFilterConfigInListener;
@@ -402,6 +410,10 @@ class XdsEnd2endTest : public ::testing::TestWithParam<XdsTestType> {
       v2_ = true;
       return *this;
     }
+    BootstrapBuilder& SetDelta() {
+      delta_ = true;
+      return *this;
+    }
     BootstrapBuilder& SetDefaultServer(const std::string& server) {
       top_server_ = server;
       return *this;
@@ -450,6 +462,7 @@ class XdsEnd2endTest : public ::testing::TestWithParam<XdsTestType> {
     std::string MakeAuthorityText();
 
     bool v2_ = false;
+    bool delta_ = false;
     std::string top_server_;
     std::string client_default_listener_resource_name_template_;
     std::map<std::string /*key*/, PluginInfo> plugins_;
@@ -17,6 +17,8 @@
 #include "test/cpp/end2end/xds/xds_server.h"
 
 #include <deque>
+#include <functional>
+#include <map>
 #include <set>
 #include <string>
 #include <thread>
@@ -157,6 +159,262 @@ void AdsServiceImpl::Shutdown() {
   gpr_log(GPR_INFO, "ADS[%p]: shut down", this);
 }
 
+//
+// AdsServiceImpl::V3RpcService
+//
+
+Status AdsServiceImpl::V3RpcService::DeltaAggregatedResources(
+    ServerContext* context, DeltaStream* stream) {
+  gpr_log(GPR_INFO, "ADS[%p]: DeltaAggregatedResources starts", this);
+  {
+    grpc_core::MutexLock lock(&parent_->ads_mu_);
+    if (parent_->forced_ads_failure_.has_value()) {
+      gpr_log(GPR_INFO,
+              "ADS[%p]: DeltaAggregatedResources forcing early failure "
+              "with status code: %d, message: %s",
+              this, parent_->forced_ads_failure_.value().error_code(),
+              parent_->forced_ads_failure_.value().error_message().c_str());
+      return parent_->forced_ads_failure_.value();
+    }
+  }
+  parent_->AddClient(context->peer());
+  parent_->seen_v3_client_ = true;
+  parent_->seen_delta_client_ = true;
+  // Take a reference of the AdsServiceImpl object, which will go
+  // out of scope when this request handler returns.  This ensures
+  // that the parent won't be destroyed until this stream is complete.
+  std::shared_ptr<AdsServiceImpl> ads_service_impl =
+      parent_->shared_from_this();
+  // Resources (type/name pairs) that have changed since the client
+  // subscribed to them.
+  UpdateQueue update_queue;
+  // Resources that the client is subscribed to keyed by resource type url.
+  SubscriptionMap subscription_map;
+  // Sent state for each resource type.
+  std::map<std::string /*type_url*/, DeltaSentState> sent_state_map;
+  // Spawn a thread to read requests from the stream.
+  // Requests will be delivered to this thread in a queue.
+  std::deque<DeltaDiscoveryRequest> requests;
+  bool stream_closed = false;
+  std::thread reader(std::bind(&V3RpcService::DeltaBlockingRead, this, stream,
+                               &requests, &stream_closed));
+  // Main loop to process requests and updates.
+  while (true) {
+    // Boolean to keep track if the loop received any work to do: a
+    // request or an update; regardless whether a response was actually
+    // sent out.
+    bool did_work = false;
+    absl::optional<DeltaDiscoveryResponse> response;
+    {
+      grpc_core::MutexLock lock(&parent_->ads_mu_);
+      // If the stream has been closed or our parent is being shut
+      // down, stop immediately.
+      if (stream_closed || parent_->ads_done_) break;
+      // Otherwise, see if there's a request to read from the queue.
+      if (!requests.empty()) {
+        DeltaDiscoveryRequest request = std::move(requests.front());
+        requests.pop_front();
+        did_work = true;
+        gpr_log(GPR_INFO,
+                "ADS[%p]: Received delta request for type %s with content %s",
+                this, request.type_url().c_str(),
+                request.DebugString().c_str());
+        ProcessDeltaRequest(request, &update_queue, &subscription_map,
+                            &sent_state_map[request.type_url()], &response);
+      }
+      // Then see if there's an update to send.
+      if (!response.has_value() && !update_queue.empty()) {
+        const std::string resource_type =
+            std::move(update_queue.front().first);
+        const std::string resource_name =
+            std::move(update_queue.front().second);
+        update_queue.pop_front();
+        did_work = true;
+        ProcessDeltaUpdate(resource_type, resource_name, &subscription_map,
+                           &sent_state_map[resource_type], &response);
+      }
+    }
+    if (response.has_value()) {
+      gpr_log(GPR_INFO, "ADS[%p]: Sending delta response: %s", this,
+              response->DebugString().c_str());
+      parent_->delta_resources_sent_ += response->resources_size();
+      stream->Write(response.value());
+    }
+    // If we didn't find anything to do, delay before the next loop
+    // iteration; otherwise, check whether we should exit and then
+    // immediately continue.
+    gpr_sleep_until(grpc_timeout_milliseconds_to_deadline(did_work ? 0 : 10));
+  }
+  // Done with main loop.  Clean up before returning.
+  // Join reader thread.
+  reader.join();
+  // Clean up any subscriptions that were still active when the call
+  // finished.
+  {
+    grpc_core::MutexLock lock(&parent_->ads_mu_);
+    for (auto& p : subscription_map) {
+      const std::string& type_url = p.first;
+      ResourceNameMap& resource_name_map =
+          parent_->resource_map_[type_url].resource_name_map;
+      for (auto& q : p.second) {
+        resource_name_map[q.first].subscriptions.erase(&q.second);
+      }
+    }
+  }
+  gpr_log(GPR_INFO, "ADS[%p]: DeltaAggregatedResources done", this);
+  parent_->RemoveClient(context->peer());
+  return Status::OK;
+}
+
+void AdsServiceImpl::V3RpcService::ProcessDeltaRequest(
+    const DeltaDiscoveryRequest& request, UpdateQueue* update_queue,
+    SubscriptionMap* subscription_map, DeltaSentState* sent_state,
+    absl::optional<DeltaDiscoveryResponse>* response) {
+  NoopMutexLock mu(parent_->ads_mu_);
+  const std::string& resource_type = request.type_url();
+  // Check for ACK or NACK.  Unlike in state-of-the-world ADS, requests
+  // that change subscriptions are processed whatever their nonce.
+  if (!request.response_nonce().empty()) {
+    ResponseState response_state;
+    if (!request.has_error_detail()) {
+      response_state.state = ResponseState::ACKED;
+      gpr_log(GPR_INFO, "ADS[%p]: client ACKed resource_type=%s nonce=%s",
+              this, resource_type.c_str(), request.response_nonce().c_str());
+    } else {
+      response_state.state = ResponseState::NACKED;
+      EXPECT_EQ(request.error_detail().code(), GRPC_STATUS_INVALID_ARGUMENT);
+      response_state.error_message = request.error_detail().message();
+      gpr_log(GPR_INFO, "ADS[%p]: client NACKed resource_type=%s nonce=%s: %s",
+              this, resource_type.c_str(), request.response_nonce().c_str(),
+              response_state.error_message.c_str());
+    }
+    parent_->resource_type_response_state_[resource_type].emplace_back(
+        std::move(response_state));
+  }
+  // Ignore resource types as requested by tests.
+  if (parent_->resource_types_to_ignore_.find(resource_type) !=
+      parent_->resource_types_to_ignore_.end()) {
+    return;
+  }
+  // Record the resources the client already has.
+  for (const auto& p : request.initial_resource_versions()) {
+    int version;
+    GPR_ASSERT(absl::SimpleAtoi(p.second, &version));
+    sent_state->resource_versions[p.first] = version;
+  }
+  auto& subscription_name_map = (*subscription_map)[resource_type];
+  auto& resource_name_map =
+      parent_->resource_map_[resource_type].resource_name_map;
+  for (const std::string& resource_name : request.resource_names_subscribe()) {
+    auto& resource_state = resource_name_map[resource_name];
+    parent_->MaybeSubscribe(resource_type, resource_name,
+                            &subscription_name_map[resource_name],
+                            &resource_state, update_queue);
+    MaybeAddToDeltaResponse(resource_type, resource_name, resource_state,
+                            sent_state, response);
+  }
+  for (const std::string& resource_name :
+       request.resource_names_unsubscribe()) {
+    auto it = subscription_name_map.find(resource_name);
+    if (it == subscription_name_map.end()) continue;
+    gpr_log(GPR_INFO, "ADS[%p]: Unsubscribe to type=%s name=%s state=%p", this,
+            resource_type.c_str(), resource_name.c_str(), &it->second);
+    auto resource_it = resource_name_map.find(resource_name);
+    GPR_ASSERT(resource_it != resource_name_map.end());
+    resource_it->second.subscriptions.erase(&it->second);
+    if (resource_it->second.subscriptions.empty() &&
+        !resource_it->second.resource.has_value()) {
+      resource_name_map.erase(resource_it);
+    }
+    subscription_name_map.erase(it);
+    sent_state->resource_versions.erase(resource_name);
+  }
+  if (response->has_value()) {
+    (*response)->set_nonce(std::to_string(++sent_state->nonce));
+  }
+}
+
+void AdsServiceImpl::V3RpcService::ProcessDeltaUpdate(
+    const std::string& resource_type, const std::string& resource_name,
+    SubscriptionMap* subscription_map, DeltaSentState* sent_state,
+    absl::optional<DeltaDiscoveryResponse>* response) {
+  NoopMutexLock mu(parent_->ads_mu_);
+  gpr_log(GPR_INFO, "ADS[%p]: Received update for type=%s name=%s", this,
+          resource_type.c_str(), resource_name.c_str());
+  auto& subscription_name_map = (*subscription_map)[resource_type];
+  if (subscription_name_map.find(resource_name) ==
+      subscription_name_map.end()) {
+    return;
+  }
+  MaybeAddToDeltaResponse(
+      resource_type, resource_name,
+      parent_->resource_map_[resource_type].resource_name_map[resource_name],
+      sent_state, response);
+  if (response->has_value()) {
+    (*response)->set_nonce(std::to_string(++sent_state->nonce));
+  }
+}
+
+void AdsServiceImpl::V3RpcService::MaybeAddToDeltaResponse(
+    const std::string& resource_type, const std::string& resource_name,
+    const ResourceState& resource_state, DeltaSentState* sent_state,
+    absl::optional<DeltaDiscoveryResponse>* response) {
+  NoopMutexLock mu(parent_->ads_mu_);
+  auto it = sent_state->resource_versions.find(resource_name);
+  if (resource_state.resource.has_value()) {
+    if (it != sent_state->resource_versions.end() &&
+        it->second == resource_state.resource_type_version) {
+      gpr_log(GPR_INFO,
+              "ADS[%p]: client does not need update for type=%s name=%s",
+              this, resource_type.c_str(), resource_name.c_str());
+      return;
+    }
+    gpr_log(GPR_INFO, "ADS[%p]: Sending update for type=%s name=%s", this,
+            resource_type.c_str(), resource_name.c_str());
+    if (!response->has_value()) response->emplace();
+    auto* resource = (*response)->add_resources();
+    resource->set_name(resource_name);
+    resource->set_version(
+        std::to_string(resource_state.resource_type_version));
+    *resource->mutable_resource() = resource_state.resource.value();
+    sent_state->resource_versions[resource_name] =
+        resource_state.resource_type_version;
+  } else {
+    if (it == sent_state->resource_versions.end()) return;
+    gpr_log(GPR_INFO, "ADS[%p]: Sending removal for type=%s name=%s", this,
+            resource_type.c_str(), resource_name.c_str());
+    if (!response->has_value()) response->emplace();
+    (*response)->add_removed_resources(resource_name);
+    sent_state->resource_versions.erase(it);
+  }
+  (*response)->set_type_url(resource_type);
+  (*response)->set_system_version_info(std::to_string(
+      parent_->resource_map_[resource_type].resource_type_version));
+}
+
+void AdsServiceImpl::V3RpcService::DeltaBlockingRead(
+    DeltaStream* stream, std::deque<DeltaDiscoveryRequest>* requests,
+    bool* stream_closed) {
+  DeltaDiscoveryRequest request;
+  bool seen_first_request = false;
+  while (stream->Read(&request)) {
+    if (!seen_first_request) {
+      EXPECT_TRUE(request.has_node());
+      EXPECT_THAT(request.node().client_features(),
+                  ::testing::UnorderedElementsAre(
+                      "envoy.lb.does_not_support_overprovisioning"));
+      seen_first_request = true;
+    }
+    {
+      grpc_core::MutexLock lock(&parent_->ads_mu_);
+      requests->emplace_back(std::move(request));
+    }
+  }
+  gpr_log(GPR_INFO, "ADS[%p]: Null read, stream closed", this);
+  grpc_core::MutexLock lock(&parent_->ads_mu_);
+  *stream_closed = true;
+}
+
 //
 // LrsServiceImpl::ClientStats
 //
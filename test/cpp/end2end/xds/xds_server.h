@@ -17,7 +17,9 @@
 #ifndef GRPC_TEST_CPP_END2END_XDS_XDS_SERVER_H
 #define GRPC_TEST_CPP_END2END_XDS_XDS_SERVER_H
 
+#include <atomic>
 #include <deque>
+#include <map>
 #include <set>
 #include <string>
 #include <thread>
@@ -78,11 +80,14 @@ class AdsServiceImpl : public std::enable_shared_from_this<AdsServiceImpl> {
   };
 
   AdsServiceImpl()
-      : v2_rpc_service_(this, /*is_v2=*/true),
-        v3_rpc_service_(this, /*is_v2=*/false) {}
+      : v2_rpc_service_(this, /*is_v2=*/true), v3_rpc_service_(this) {}
 
   bool seen_v2_client() const { return seen_v2_client_; }
   bool seen_v3_client() const { return seen_v3_client_; }
+  bool seen_delta_client() const { return seen_delta_client_; }
+
+  // The number of resources sent in delta ADS responses.
+  size_t delta_resources_sent() const { return delta_resources_sent_; }
 
   ::envoy::service::discovery::v2::AggregatedDiscoveryService::Service*
   v2_rpc_service() {
@@ -373,7 +378,7 @@ class AdsServiceImpl : public std::enable_shared_from_this<AdsServiceImpl> {
       return Status::OK;
     }
 
-   private:
+   protected:
     // NB: clang's annotalysis is confused by the use of inner template
     // classes here and *ignores* the exclusive lock annotation on some
     // functions. See https://bugs.llvm.org/show_bug.cgi?id=51368.
@@ -629,6 +634,66 @@ class AdsServiceImpl : public std::enable_shared_from_this<AdsServiceImpl> {
     const bool is_v2_;
   };
 
+  // The v3 RPC service, which also implements delta ADS.
+  class V3RpcService
+      : public RpcService<
+            ::envoy::service::discovery::v3::AggregatedDiscoveryService,
+            ::envoy::service::discovery::v3::DiscoveryRequest,
+            ::envoy::service::discovery::v3::DiscoveryResponse> {
+   public:
+    using DeltaDiscoveryRequest =
+        ::envoy::service::discovery::v3::DeltaDiscoveryRequest;
+    using DeltaDiscoveryResponse =
+        ::envoy::service::discovery::v3::DeltaDiscoveryResponse;
+    using DeltaStream =
+        ServerReaderWriter<DeltaDiscoveryResponse, DeltaDiscoveryRequest>;
+
+    explicit V3RpcService(AdsServiceImpl* parent)
+        : RpcService(parent, /*is_v2=*/false) {}
+
+    Status DeltaAggregatedResources(ServerContext* context,
+                                    DeltaStream* stream) override;
+
+   private:
+    // Delta sent state for a given resource type.
+    struct DeltaSentState {
+      int nonce = 0;
+      // The resource type version of each resource the client has.
+      std::map<std::string /* resource_name */, int> resource_versions;
+    };
+
+    // Processes a request read from the client.
+    // Populates response if needed.
+    void ProcessDeltaRequest(const DeltaDiscoveryRequest& request,
+                             UpdateQueue* update_queue,
+                             SubscriptionMap* subscription_map,
+                             DeltaSentState* sent_state,
+                             absl::optional<DeltaDiscoveryResponse>* response)
+        ABSL_EXCLUSIVE_LOCKS_REQUIRED(parent_->ads_mu_);
+
+    // Processes a resource update from the test.
+    // Populates response if needed.
+    void ProcessDeltaUpdate(const std::string& resource_type,
+                            const std::string& resource_name,
+                            SubscriptionMap* subscription_map,
+                            DeltaSentState* sent_state,
+                            absl::optional<DeltaDiscoveryResponse>* response)
+        ABSL_EXCLUSIVE_LOCKS_REQUIRED(parent_->ads_mu_);
+
+    // Adds the resource to the response if the client does not already
+    // have its current version, or lists it as removed if it no longer
+    // exists and the client has it.
+    void MaybeAddToDeltaResponse(
+        const std::string& resource_type, const std::string& resource_name,
+        const ResourceState& resource_state, DeltaSentState* sent_state,
+        absl::optional<DeltaDiscoveryResponse>* response)
+        ABSL_EXCLUSIVE_LOCKS_REQUIRED(parent_->ads_mu_);
+
+    void DeltaBlockingRead(DeltaStream* stream,
+                           std::deque<DeltaDiscoveryRequest>* requests,
+                           bool* stream_closed);
+  };
+
   // Checks whether the client needs to receive a newer version of
   // the resource.
   static bool ClientNeedsResourceUpdate(
@@ -665,13 +730,12 @@ class AdsServiceImpl : public std::enable_shared_from_this<AdsServiceImpl> {
              ::envoy::api::v2::DiscoveryRequest,
              ::envoy::api::v2::DiscoveryResponse>
       v2_rpc_service_;
-  RpcService<::envoy::service::discovery::v3::AggregatedDiscoveryService,
-             ::envoy::service::discovery::v3::DiscoveryRequest,
-             ::envoy::service::discovery::v3::DiscoveryResponse>
-      v3_rpc_service_;
+  V3RpcService v3_rpc_service_;
 
   std::atomic_bool seen_v2_client_{false};
   std::atomic_bool seen_v3_client_{false};
+  std::atomic_bool seen_delta_client_{false};
+  std::atomic<size_t> delta_resources_sent_{0};
 
   grpc_core::CondVar ads_cond_;
   grpc_core::Mutex ads_mu_;
@@ -34,6 +34,8 @@
 
 #include "src/core/ext/filters/client_channel/client_channel.h"
 #include "src/core/ext/filters/deadline/deadline_filter.h"
+#include "src/core/ext/filters/fused/fused_filters.h"
+#include "src/core/ext/filters/http/client_authority_filter.h"
 #include "src/core/ext/filters/http/client/http_client_filter.h"
 #include "src/core/ext/filters/http/message_compress/message_compress_filter.h"
 #include "src/core/ext/filters/http/server/http_server_filter.h"
@@ -95,9 +97,9 @@ class BaseChannelFixture {
   grpc_channel* const channel_;
 };
 
-static grpc_channel* CreateChannel() {
+static grpc_channel* CreateChannel(const grpc_channel_args* args = nullptr) {
   grpc_channel_credentials* creds = grpc_insecure_credentials_create();
-  grpc_channel* channel = grpc_channel_create("localhost:1234", creds, nullptr);
+  grpc_channel* channel = grpc_channel_create("localhost:1234", creds, args);
   grpc_channel_credentials_release(creds);
   return channel;
 }
@@ -107,6 +109,20 @@ class InsecureChannel : public BaseChannelFixture {
   InsecureChannel() : BaseChannelFixture(CreateChannel()) {}
 };
 
+static grpc_channel* CreateChannelWithoutArenaPool() {
+  grpc_arg arg = grpc_channel_arg_integer_create(
+      const_cast<char*>(GRPC_ARG_CALL_ARENA_POOL_SIZE), 0);
+  grpc_channel_args args = {1, &arg};
+  return CreateChannel(&args);
+}
+
+// Baseline for InsecureChannel: every call allocates and frees its arena.
+class InsecureChannelWithoutArenaPool : public BaseChannelFixture {
+ public:
+  InsecureChannelWithoutArenaPool()
+      : BaseChannelFixture(CreateChannelWithoutArenaPool()) {}
+};
+
 class LameChannel : public BaseChannelFixture {
  public:
   LameChannel()
@@ -132,6 +148,7 @@ static void BM_CallCreateDestroy(benchmark::State& state) {
 }
 
 BENCHMARK_TEMPLATE(BM_CallCreateDestroy, InsecureChannel);
+BENCHMARK_TEMPLATE(BM_CallCreateDestroy, InsecureChannelWithoutArenaPool);
 BENCHMARK_TEMPLATE(BM_CallCreateDestroy, LameChannel);
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -358,6 +375,16 @@ enum FixtureFlags : uint32_t {
 template <const grpc_channel_filter* kFilter, uint32_t kFlags>
 struct Fixture {
   const grpc_channel_filter* filter = kFilter;
+  const grpc_channel_filter* second_filter = nullptr;
+  const uint32_t flags = kFlags;
+};
+
+// Two filters stacked back to back, to compare against their fused form.
+template <const grpc_channel_filter* kFilter,
+          const grpc_channel_filter* kSecondFilter, uint32_t kFlags>
+struct FilterPairFixture {
+  const grpc_channel_filter* filter = kFilter;
+  const grpc_channel_filter* second_filter = kSecondFilter;
   const uint32_t flags = kFlags;
 };
 
@@ -528,6 +555,7 @@ static void BM_IsolatedFilter(benchmark::State& state) {
       grpc_core::ClientChannelFactory::CreateChannelArg(
           &fake_client_channel_factory),
       StringArg(GRPC_ARG_SERVER_URI, "localhost"),
+      StringArg(GRPC_ARG_DEFAULT_AUTHORITY, "localhost"),
   };
   if (fixture.flags & REQUIRES_TRANSPORT) {
     args.push_back(phony_transport::Arg());
@@ -538,6 +566,9 @@ static void BM_IsolatedFilter(benchmark::State& state) {
   if (fixture.filter != nullptr) {
     filters.push_back(fixture.filter);
   }
+  if (fixture.second_filter != nullptr) {
+    filters.push_back(fixture.second_filter);
+  }
   if (fixture.flags & CHECKS_NOT_LAST) {
     filters.push_back(&phony_filter::phony_filter);
     label << " #has_phony_filter";
@@ -630,6 +661,19 @@ BENCHMARK_TEMPLATE(BM_IsolatedFilter, HttpServerFilter, SendEmptyMetadata);
 typedef Fixture<&grpc_message_size_filter, CHECKS_NOT_LAST> MessageSizeFilter;
 BENCHMARK_TEMPLATE(BM_IsolatedFilter, MessageSizeFilter, NoOp);
 BENCHMARK_TEMPLATE(BM_IsolatedFilter, MessageSizeFilter, SendEmptyMetadata);
+typedef FilterPairFixture<&grpc_core::ClientAuthorityFilter::kFilter,
+                          &grpc_core::HttpClientFilter::kFilter,
+                          CHECKS_NOT_LAST | REQUIRES_TRANSPORT>
+    AuthorityHttpClientFilters;
+BENCHMARK_TEMPLATE(BM_IsolatedFilter, AuthorityHttpClientFilters, NoOp);
+BENCHMARK_TEMPLATE(BM_IsolatedFilter, AuthorityHttpClientFilters,
+                   SendEmptyMetadata);
+typedef Fixture<&grpc_core::kFusedAuthorityHttpClientFilter,
+                CHECKS_NOT_LAST | REQUIRES_TRANSPORT>
+    FusedAuthorityHttpClientFilter;
+BENCHMARK_TEMPLATE(BM_IsolatedFilter, FusedAuthorityHttpClientFilter, NoOp);
+BENCHMARK_TEMPLATE(BM_IsolatedFilter, FusedAuthorityHttpClientFilter,
+                   SendEmptyMetadata);
 // This cmake target is disabled for now because it depends on OpenCensus, which
 // is Bazel-only.
 // typedef Fixture<&grpc_server_load_reporting_filter, CHECKS_NOT_LAST>
@@ -22,6 +22,10 @@
 
 #include <memory>
 #include <sstream>
+#include <vector>
+
+#include "absl/memory/memory.h"
+#include "absl/strings/str_cat.h"
 
 #include <benchmark/benchmark.h>
 
@@ -283,6 +287,76 @@ class MoreRepresentativeClientInitialMetadata {
   }
 };
 
+// Only the fields a client sends identically on every request to a method:
+// after the first iterations the encoder replays its cached prefix.
+class RepeatedRequestPrefix {
+ public:
+  static constexpr bool kEnableTrueBinary = true;
+  static void Prepare(grpc_metadata_batch* b) {
+    b->Set(grpc_core::HttpSchemeMetadata(),
+           grpc_core::HttpSchemeMetadata::kHttp);
+    b->Set(grpc_core::HttpMethodMetadata(),
+           grpc_core::HttpMethodMetadata::kPost);
+    b->Set(grpc_core::HttpPathMetadata(),
+           grpc_core::Slice(grpc_core::StaticSlice::FromStaticString(
+               "/grpc.test.FooService/BarMethod")));
+    b->Set(grpc_core::HttpAuthorityMetadata(),
+           grpc_core::Slice(grpc_core::StaticSlice::FromStaticString(
+               "foo.test.google.fr:1234")));
+    b->Set(grpc_core::TeMetadata(), grpc_core::TeMetadata::kTrailers);
+    b->Set(grpc_core::ContentTypeMetadata(),
+           grpc_core::ContentTypeMetadata::kApplicationGrpc);
+  }
+};
+
+// Requests interleaving state.range(0) methods on one connection, each of them
+// with the fields of RepeatedRequestPrefix.
+static void BM_HpackEncoderEncodeInterleavedMethods(benchmark::State& state) {
+  TrackCounters track_counters;
+  grpc_core::ExecCtx exec_ctx;
+
+  auto arena = grpc_core::MakeScopedArena(1024, g_memory_allocator);
+  std::vector<std::unique_ptr<grpc_metadata_batch>> batches;
+  for (int64_t i = 0; i < state.range(0); i++) {
+    batches.push_back(absl::make_unique<grpc_metadata_batch>(arena.get()));
+    grpc_metadata_batch* b = batches.back().get();
+    RepeatedRequestPrefix::Prepare(b);
+    b->Set(grpc_core::HttpPathMetadata(),
+           grpc_core::Slice::FromCopiedString(
+               absl::StrCat("/grpc.test.FooService/BarMethod", i)));
+  }
+
+  grpc_core::HPackCompressor c;
+  grpc_transport_one_way_stats stats;
+  stats = {};
+  grpc_slice_buffer outbuf;
+  grpc_slice_buffer_init(&outbuf);
+  size_t next = 0;
+  while (state.KeepRunning()) {
+    c.EncodeHeaders(
+        grpc_core::HPackCompressor::EncodeHeaderOptions{
+            static_cast<uint32_t>(state.iterations()),
+            false,
+            RepeatedRequestPrefix::kEnableTrueBinary,
+            static_cast<size_t>(16384),
+            &stats,
+        },
+        *batches[next], &outbuf);
+    next = (next + 1) % batches.size();
+    grpc_slice_buffer_reset_and_unref_internal(&outbuf);
+    grpc_core::ExecCtx::Get()->Flush();
+  }
+  grpc_slice_buffer_destroy_internal(&outbuf);
+
+  std::ostringstream label;
+  label << "header_bytes/iter:"
+        << (static_cast<double>(stats.header_bytes) /
+            static_cast<double>(state.iterations()));
+  track_counters.AddLabel(label.str());
+  track_counters.Finish(state);
+}
+BENCHMARK(BM_HpackEncoderEncodeInterleavedMethods)->Arg(1)->Arg(4)->Arg(16);
+
 class RepresentativeServerInitialMetadata {
  public:
   static constexpr bool kEnableTrueBinary = true;
@@ -332,6 +406,8 @@ BENCHMARK_TEMPLATE(BM_HpackEncoderEncodeHeader,
 BENCHMARK_TEMPLATE(BM_HpackEncoderEncodeHeader,
                    MoreRepresentativeClientInitialMetadata)
     ->Args({0, 16384});
+BENCHMARK_TEMPLATE(BM_HpackEncoderEncodeHeader, RepeatedRequestPrefix)
+    ->Args({0, 16384});
 BENCHMARK_TEMPLATE(BM_HpackEncoderEncodeHeader,
                    RepresentativeServerInitialMetadata)
     ->Args({0, 16384});
@@ -0,0 +1,207 @@
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/* Benchmark flow control autotuning over an emulated slow link */
+
+#include <benchmark/benchmark.h>
+
+#include <grpc/support/time.h>
+
+#include "src/core/ext/transport/chttp2/transport/chttp2_transport.h"
+#include "src/core/ext/transport/chttp2/transport/internal.h"
+#include "src/proto/grpc/testing/echo.grpc.pb.h"
+#include "test/core/util/passthru_endpoint.h"
+#include "test/core/util/test_config.h"
+#include "test/core/util/trickle_endpoint.h"
+#include "test/cpp/microbenchmarks/fullstack_fixtures.h"
+#include "test/cpp/util/test_config.h"
+
+namespace grpc {
+namespace testing {
+
+/*******************************************************************************
+ * FIXTURES
+ */
+
+class TrickleConfiguration : public FixtureConfiguration {
+ public:
+  explicit TrickleConfiguration(int pacing_rate) : pacing_rate_(pacing_rate) {}
+
+  void ApplyCommonServerBuilderConfig(ServerBuilder* b) const override {
+    FixtureConfiguration::ApplyCommonServerBuilderConfig(b);
+    if (pacing_rate_ > 0) {
+      b->AddChannelArgument(GRPC_ARG_HTTP2_PACING_RATE, pacing_rate_);
+    }
+  }
+
+ private:
+  const int pacing_rate_;
+};
+
+// Runs chttp2 over an in-process link with the given bandwidth and one way
+// delay in each direction.
+class TrickledCHTTP2 : public EndpointPairFixture {
+ public:
+  TrickledCHTTP2(Service* service, int bytes_per_second, int delay_ms,
+                 bool pace)
+      : EndpointPairFixture(
+            service, MakeEndpoints(bytes_per_second, delay_ms),
+            TrickleConfiguration(pace ? bytes_per_second : 0)) {}
+
+  grpc_core::chttp2::TransportFlowControl* client_flow_control() {
+    return &reinterpret_cast<grpc_chttp2_transport*>(client_transport_)
+                ->flow_control;
+  }
+
+  // The stream window the client currently wants to advertise.
+  int64_t client_target_window() {
+    return client_flow_control()->target_initial_window_size_;
+  }
+
+ private:
+  static grpc_endpoint_pair MakeEndpoints(int bytes_per_second,
+                                          int delay_ms) {
+    grpc_endpoint_pair p;
+    grpc_passthru_endpoint_stats* stats = grpc_passthru_endpoint_stats_create();
+    grpc_passthru_endpoint_create(&p.client, &p.server, stats);
+    grpc_passthru_endpoint_stats_destroy(stats);
+    grpc_core::Duration delay = grpc_core::Duration::Milliseconds(delay_ms);
+    p.client = grpc_trickle_endpoint_create(p.client, bytes_per_second, delay);
+    p.server = grpc_trickle_endpoint_create(p.server, bytes_per_second, delay);
+    return p;
+  }
+};
+
+/*******************************************************************************
+ * BENCHMARKING KERNELS
+ */
+
+static void* tag(intptr_t x) { return reinterpret_cast<void*>(x); }
+
+// Streams messages from server to client. Besides throughput, reports how
+// long the client's flow control took to settle on a window ("ramp_ms") and
+// what it settled on, against the link's bandwidth-delay product.
+static void BM_PumpStreamServerToClient_Trickle(benchmark::State& state) {
+  const int message_size = state.range(0);
+  const int bytes_per_second = state.range(1) * 1024 / 8;
+  const int delay_ms = state.range(2);
+  EchoTestService::AsyncService service;
+  std::unique_ptr<TrickledCHTTP2> fixture(new TrickledCHTTP2(
+      &service, bytes_per_second, delay_ms, state.range(3) != 0));
+  gpr_timespec start = gpr_now(GPR_CLOCK_MONOTONIC);
+  gpr_timespec last_window_change = start;
+  int64_t last_window = fixture->client_target_window();
+  {
+    EchoResponse send_response;
+    EchoResponse recv_response;
+    if (message_size > 0) {
+      send_response.set_message(std::string(message_size, 'a'));
+    }
+    ServerContext svr_ctx;
+    ServerAsyncReaderWriter<EchoResponse, EchoRequest> response_rw(&svr_ctx);
+    service.RequestBidiStream(&svr_ctx, &response_rw, fixture->cq(),
+                              fixture->cq(), tag(0));
+    std::unique_ptr<EchoTestService::Stub> stub(
+        EchoTestService::NewStub(fixture->channel()));
+    ClientContext cli_ctx;
+    auto request_rw = stub->AsyncBidiStream(&cli_ctx, fixture->cq(), tag(1));
+    int need_tags = (1 << 0) | (1 << 1);
+    void* t;
+    bool ok;
+    while (need_tags) {
+      GPR_ASSERT(fixture->cq()->Next(&t, &ok));
+      GPR_ASSERT(ok);
+      int i = static_cast<int>(reinterpret_cast<intptr_t>(t));
+      GPR_ASSERT(need_tags & (1 << i));
+      need_tags &= ~(1 << i);
+    }
+    request_rw->Read(&recv_response, tag(0));
+    for (auto _ : state) {
+      response_rw.Write(send_response, tag(1));
+      while (true) {
+        GPR_ASSERT(fixture->cq()->Next(&t, &ok));
+        if (t == tag(0)) {
+          request_rw->Read(&recv_response, tag(0));
+        } else if (t == tag(1)) {
+          break;
+        } else {
+          GPR_ASSERT(false);
+        }
+      }
+      // Racy, but only ever compared against itself.
+      int64_t window = fixture->client_target_window();
+      if (window != last_window) {
+        last_window = window;
+        last_window_change = gpr_now(GPR_CLOCK_MONOTONIC);
+      }
+    }
+    response_rw.Finish(Status::OK, tag(1));
+    need_tags = (1 << 0) | (1 << 1);
+    while (need_tags) {
+      GPR_ASSERT(fixture->cq()->Next(&t, &ok));
+      int i = static_cast<int>(reinterpret_cast<intptr_t>(t));
+      GPR_ASSERT(need_tags & (1 << i));
+      need_tags &= ~(1 << i);
+    }
+  }
+  grpc_core::BdpEstimator* bdp =
+      fixture->client_flow_control()->bdp_estimator();
+  state.counters["ramp_ms"] =
+      gpr_time_to_millis(gpr_time_sub(last_window_change, start));
+  state.counters["target_window"] = last_window;
+  state.counters["bdp_estimate"] = bdp->EstimateBdp();
+  state.counters["min_rtt_ms"] = bdp->EstimateMinRtt() * 1000;
+  state.counters["link_bdp"] = 2.0 * bytes_per_second * delay_ms / 1000;
+  fixture->Finish(state);
+  fixture.reset();
+  state.SetBytesProcessed(static_cast<int64_t>(message_size) *
+                          state.iterations());
+}
+
+/*******************************************************************************
+ * CONFIGURATIONS
+ */
+
+static void TrickleArgs(benchmark::internal::Benchmark* b) {
+  b->ArgNames({"message_size", "bandwidth_kbits", "delay_ms", "pace"});
+  for (int message_size : {1024, 64 * 1024, 1024 * 1024}) {
+    for (int bandwidth_kbits : {1024, 16 * 1024, 256 * 1024}) {
+      for (int delay_ms : {1, 25, 100}) {
+        for (int pace : {0, 1}) {
+          b->Args({message_size, bandwidth_kbits, delay_ms, pace});
+        }
+      }
+    }
+  }
+  b->UseRealTime();
+}
+BENCHMARK(BM_PumpStreamServerToClient_Trickle)->Apply(TrickleArgs);
+
+}  // namespace testing
+}  // namespace grpc
+
+// Some distros have RunSpecifiedBenchmarks under the benchmark namespace,
+// and others do not. This allows us to support both modes.
+namespace benchmark {
+void RunTheBenchmarksNamespaced() { RunSpecifiedBenchmarks(); }
+}  // namespace benchmark
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(&argc, argv);
+  LibraryInitializer libInit;
+  ::benchmark::Initialize(&argc, argv);
+  grpc::testing::InitTest(&argc, &argv, false);
+  benchmark::RunTheBenchmarksNamespaced();
+  return 0;
+}
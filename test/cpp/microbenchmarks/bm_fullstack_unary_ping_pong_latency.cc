@@ -0,0 +1,54 @@
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Median and tail call latencies of unary ping pongs. Kept out of
+// bm_fullstack_unary_ping_pong so that timing each call doesn't add to the
+// cost measured there. Compare runs with and without GRPC_EPOLL1_BUSY_POLL_US
+// set to see the effect of busy polling.
+
+#include "test/core/util/test_config.h"
+#include "test/cpp/microbenchmarks/fullstack_unary_ping_pong.h"
+#include "test/cpp/util/test_config.h"
+
+namespace grpc {
+namespace testing {
+
+template <class Fixture>
+static void BM_UnaryPingPongLatency(benchmark::State& state) {
+  BM_UnaryPingPong<Fixture, NoOpMutator, NoOpMutator, CallLatencyPercentiles>(
+      state);
+}
+
+BENCHMARK_TEMPLATE(BM_UnaryPingPongLatency, TCP)->Args({0, 0});
+BENCHMARK_TEMPLATE(BM_UnaryPingPongLatency, MinTCP)->Args({0, 0});
+BENCHMARK_TEMPLATE(BM_UnaryPingPongLatency, UDS)->Args({0, 0});
+BENCHMARK_TEMPLATE(BM_UnaryPingPongLatency, MinUDS)->Args({0, 0});
+
+}  // namespace testing
+}  // namespace grpc
+
+// Some distros have RunSpecifiedBenchmarks under the benchmark namespace,
+// and others do not. This allows us to support both modes.
+namespace benchmark {
+void RunTheBenchmarksNamespaced() { RunSpecifiedBenchmarks(); }
+}  // namespace benchmark
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(&argc, argv);
+  LibraryInitializer libInit;
+  ::benchmark::Initialize(&argc, argv);
+  grpc::testing::InitTest(&argc, &argv, false);
+  benchmark::RunTheBenchmarksNamespaced();
+  return 0;
+}
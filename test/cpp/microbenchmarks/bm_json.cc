@@ -0,0 +1,99 @@
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/* Benchmark parsing of large service configs */
+
+#include <benchmark/benchmark.h>
+
+#include <string>
+
+#include "absl/strings/str_cat.h"
+
+#include "src/core/lib/json/json.h"
+#include "src/core/lib/json/json_view.h"
+#include "test/core/util/test_config.h"
+#include "test/cpp/microbenchmarks/helpers.h"
+#include "test/cpp/util/test_config.h"
+
+// A service config with a method config per service, of the shape a large
+// route configuration translates into.
+static std::string ServiceConfig(int num_services) {
+  std::string json = "{\"methodConfig\": [";
+  for (int i = 0; i < num_services; i++) {
+    if (i > 0) json += ", ";
+    absl::StrAppend(
+        &json, "{\"name\": [{\"service\": \"grpc.testing.Service", i,
+        "\", \"method\": \"Method\"}], \"waitForReady\": true, "
+        "\"timeout\": \"1.5s\", \"retryPolicy\": {\"maxAttempts\": 3, "
+        "\"initialBackoff\": \"0.1s\", \"maxBackoff\": \"10s\", "
+        "\"backoffMultiplier\": 1.6, \"retryableStatusCodes\": "
+        "[\"UNAVAILABLE\", \"RESOURCE_EXHAUSTED\"]}, \"description\": "
+        "\"Method config for service \\\"",
+        i, "\\\"\"}");
+  }
+  json += "]}";
+  return json;
+}
+
+static void BM_JsonParse(benchmark::State& state) {
+  std::string json_str = ServiceConfig(state.range(0));
+  for (auto _ : state) {
+    grpc_error_handle error = GRPC_ERROR_NONE;
+    grpc_core::Json json = grpc_core::Json::Parse(json_str, &error);
+    GPR_ASSERT(error == GRPC_ERROR_NONE);
+    benchmark::DoNotOptimize(json);
+  }
+  state.SetBytesProcessed(state.iterations() * json_str.size());
+}
+BENCHMARK(BM_JsonParse)->Range(1, 10000);
+
+static void BM_JsonDocumentParse(benchmark::State& state) {
+  std::string json_str = ServiceConfig(state.range(0));
+  for (auto _ : state) {
+    auto document = grpc_core::JsonDocument::Parse(json_str);
+    GPR_ASSERT(document.has_value());
+    benchmark::DoNotOptimize(document);
+  }
+  state.SetBytesProcessed(state.iterations() * json_str.size());
+}
+BENCHMARK(BM_JsonDocumentParse)->Range(1, 10000);
+
+// Parses into a view and copies it all into a Json, as a caller that still
+// needs the Json API would.
+static void BM_JsonDocumentParseToJson(benchmark::State& state) {
+  std::string json_str = ServiceConfig(state.range(0));
+  for (auto _ : state) {
+    auto document = grpc_core::JsonDocument::Parse(json_str);
+    GPR_ASSERT(document.has_value());
+    grpc_core::Json json = document->root().ToJson();
+    benchmark::DoNotOptimize(json);
+  }
+  state.SetBytesProcessed(state.iterations() * json_str.size());
+}
+BENCHMARK(BM_JsonDocumentParseToJson)->Range(1, 10000);
+
+// Some distros have RunSpecifiedBenchmarks under the benchmark namespace,
+// and others do not. This allows us to support both modes.
+namespace benchmark {
+void RunTheBenchmarksNamespaced() { RunSpecifiedBenchmarks(); }
+}  // namespace benchmark
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(&argc, argv);
+  LibraryInitializer libInit;
+  ::benchmark::Initialize(&argc, argv);
+  grpc::testing::InitTest(&argc, &argv, false);
+  benchmark::RunTheBenchmarksNamespaced();
+  return 0;
+}
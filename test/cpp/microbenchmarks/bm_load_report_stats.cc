@@ -0,0 +1,140 @@
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/* Benchmark recording per-call load report stats from many threads at once,
+   as the client channel does for every call it sends to an xDS locality or
+   a grpclb backend */
+
+#include <benchmark/benchmark.h>
+
+#include <map>
+
+#include "absl/strings/string_view.h"
+
+#include "src/core/ext/filters/client_channel/lb_policy/grpclb/grpclb_client_stats.h"
+#include "src/core/ext/xds/xds_bootstrap.h"
+#include "src/core/ext/xds/xds_client.h"
+#include "src/core/ext/xds/xds_client_stats.h"
+#include "src/core/lib/iomgr/exec_ctx.h"
+#include "test/core/util/test_config.h"
+#include "test/cpp/microbenchmarks/helpers.h"
+#include "test/cpp/util/test_config.h"
+
+namespace grpc_core {
+namespace {
+
+// The LRS server is never reached; the stats are only recorded.
+constexpr char kBootstrap[] =
+    "{\n"
+    "  \"xds_servers\": [{\n"
+    "    \"server_uri\": \"localhost:1\",\n"
+    "    \"channel_creds\": [{\"type\": \"insecure\"}]\n"
+    "  }],\n"
+    "  \"node\": {\"id\": \"bm_load_report_stats\"}\n"
+    "}";
+
+RefCountedPtr<XdsClient> g_xds_client;
+RefCountedPtr<XdsClusterLocalityStats> g_locality_stats;
+RefCountedPtr<GrpcLbClientStats> g_grpclb_stats;
+
+void SetUpLocalityStats() {
+  grpc_error_handle error = GRPC_ERROR_NONE;
+  std::unique_ptr<XdsBootstrap> bootstrap =
+      XdsBootstrap::Create(kBootstrap, &error);
+  GPR_ASSERT(error == GRPC_ERROR_NONE);
+  g_xds_client = MakeRefCounted<XdsClient>(std::move(bootstrap), nullptr);
+  g_locality_stats = g_xds_client->AddClusterLocalityStats(
+      g_xds_client->bootstrap().server(), "cluster", "eds_service",
+      MakeRefCounted<XdsLocalityName>("region", "zone", "sub_zone"));
+}
+
+void TearDownLocalityStats() {
+  g_locality_stats.reset();
+  g_xds_client.reset();
+}
+
+void BM_XdsLocalityStatsAddCall(benchmark::State& state) {
+  ExecCtx exec_ctx;
+  if (state.thread_index() == 0) SetUpLocalityStats();
+  for (auto _ : state) {
+    g_locality_stats->AddCallStarted();
+    g_locality_stats->AddCallFinished(nullptr);
+  }
+  if (state.thread_index() == 0) TearDownLocalityStats();
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_XdsLocalityStatsAddCall)->ThreadRange(1, 64)->UseRealTime();
+
+void BM_XdsLocalityStatsAddCallWithMetrics(benchmark::State& state) {
+  ExecCtx exec_ctx;
+  const std::map<absl::string_view, double> named_metrics = {
+      {"cpu_ms", 1.5}, {"db_queries", 3}};
+  if (state.thread_index() == 0) SetUpLocalityStats();
+  for (auto _ : state) {
+    g_locality_stats->AddCallStarted();
+    g_locality_stats->AddCallFinished(&named_metrics);
+  }
+  if (state.thread_index() == 0) TearDownLocalityStats();
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_XdsLocalityStatsAddCallWithMetrics)
+    ->ThreadRange(1, 64)
+    ->UseRealTime();
+
+void BM_GrpcLbClientStatsAddCall(benchmark::State& state) {
+  ExecCtx exec_ctx;
+  if (state.thread_index() == 0) {
+    g_grpclb_stats = MakeRefCounted<GrpcLbClientStats>();
+  }
+  for (auto _ : state) {
+    g_grpclb_stats->AddCallStarted();
+    g_grpclb_stats->AddCallFinished(false, true);
+  }
+  if (state.thread_index() == 0) g_grpclb_stats.reset();
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_GrpcLbClientStatsAddCall)->ThreadRange(1, 64)->UseRealTime();
+
+// The cost moved to the load reporting side: merging the per-CPU shards.
+void BM_XdsLocalityStatsSnapshot(benchmark::State& state) {
+  ExecCtx exec_ctx;
+  const std::map<absl::string_view, double> named_metrics = {
+      {"cpu_ms", 1.5}, {"db_queries", 3}};
+  SetUpLocalityStats();
+  for (auto _ : state) {
+    g_locality_stats->AddCallStarted();
+    g_locality_stats->AddCallFinished(&named_metrics);
+    benchmark::DoNotOptimize(g_locality_stats->GetSnapshotAndReset());
+  }
+  TearDownLocalityStats();
+}
+BENCHMARK(BM_XdsLocalityStatsSnapshot);
+
+}  // namespace
+}  // namespace grpc_core
+
+// Some distros have RunSpecifiedBenchmarks under the benchmark namespace,
+// and others do not. This allows us to support both modes.
+namespace benchmark {
+void RunTheBenchmarksNamespaced() { RunSpecifiedBenchmarks(); }
+}  // namespace benchmark
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(&argc, argv);
+  LibraryInitializer libInit;
+  ::benchmark::Initialize(&argc, argv);
+  grpc::testing::InitTest(&argc, &argv, false);
+  benchmark::RunTheBenchmarksNamespaced();
+  return 0;
+}
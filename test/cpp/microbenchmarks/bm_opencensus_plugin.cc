@@ -24,6 +24,9 @@
 #include "absl/base/call_once.h"
 #include "absl/strings/str_cat.h"
 #include "opencensus/stats/stats.h"
+#include "opencensus/trace/sampler.h"
+#include "opencensus/trace/trace_config.h"
+#include "opencensus/trace/trace_params.h"
 
 #include <grpc/grpc.h>
 #include <grpcpp/grpcpp.h>
@@ -104,7 +107,7 @@ static void BM_E2eLatencyCensusDisabled(benchmark::State& state) {
 }
 BENCHMARK(BM_E2eLatencyCensusDisabled);
 
-static void BM_E2eLatencyCensusEnabled(benchmark::State& state) {
+static void RunE2eLatencyCensusEnabled(benchmark::State& state) {
   grpc_core::CoreConfiguration::Reset();
   // Now start the test by registering the plugin (once in the execution)
   RegisterOnce();
@@ -125,8 +128,28 @@ static void BM_E2eLatencyCensusEnabled(benchmark::State& state) {
     grpc::Status status = stub->Echo(&context, request, &response);
   }
 }
+
+static void BM_E2eLatencyCensusEnabled(benchmark::State& state) {
+  RunE2eLatencyCensusEnabled(state);
+}
 BENCHMARK(BM_E2eLatencyCensusEnabled);
 
+void SetTraceSamplingProbability(double probability) {
+  ::opencensus::trace::TraceConfig::SetCurrentTraceParams(
+      {32, 32, 128, 32, ::opencensus::trace::ProbabilitySampler(probability)});
+}
+
+// Traces one in every state.range(0) calls. Stats are recorded for every
+// call, sampled or not, so most of the plugin's cost should not depend on
+// the sampling rate.
+static void BM_E2eLatencyCensusEnabledSampled(benchmark::State& state) {
+  SetTraceSamplingProbability(1.0 / state.range(0));
+  RunE2eLatencyCensusEnabled(state);
+  // Restore OpenCensus' default.
+  SetTraceSamplingProbability(1e-4);
+}
+BENCHMARK(BM_E2eLatencyCensusEnabledSampled)->Arg(1)->Arg(1000);
+
 int main(int argc, char** argv) {
   grpc::testing::TestEnvironment env(&argc, argv);
   ::benchmark::Initialize(&argc, argv);
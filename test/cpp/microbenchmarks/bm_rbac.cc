@@ -0,0 +1,206 @@
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/* Benchmark RBAC evaluation against large generated policies, with the
+   compiled engine and with the matcher tree it replaced */
+
+#include <benchmark/benchmark.h>
+
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "absl/memory/memory.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/string_view.h"
+
+#include <grpc/grpc_security_constants.h>
+
+#include "src/core/lib/resource_quota/resource_quota.h"
+#include "src/core/lib/security/authorization/grpc_authorization_engine.h"
+#include "src/core/lib/security/authorization/matchers.h"
+#include "test/core/util/mock_authorization_endpoint.h"
+#include "test/core/util/test_config.h"
+#include "test/cpp/microbenchmarks/helpers.h"
+#include "test/cpp/util/test_config.h"
+
+static std::unique_ptr<grpc_core::Rbac::Permission> MakeHeaderPermission(
+    absl::string_view name, absl::string_view value) {
+  return absl::make_unique<grpc_core::Rbac::Permission>(
+      grpc_core::Rbac::Permission::MakeHeaderPermission(
+          grpc_core::HeaderMatcher::Create(
+              name, grpc_core::HeaderMatcher::Type::kExact, value)
+              .value()));
+}
+
+static std::unique_ptr<grpc_core::Rbac::Permission> MakePathPermission(
+    grpc_core::StringMatcher::Type type, absl::string_view path) {
+  return absl::make_unique<grpc_core::Rbac::Permission>(
+      grpc_core::Rbac::Permission::MakePathPermission(
+          grpc_core::StringMatcher::Create(type, path).value()));
+}
+
+// Policy i allows two methods of service i, or any method for tenant i in
+// prod, to callers with the service account of namespace i or from subnet
+// i.  Callers match only policy num_policies - 1.
+static std::map<std::string, grpc_core::Rbac::Policy> MakePolicies(
+    int num_policies) {
+  using grpc_core::Rbac;
+  using grpc_core::StringMatcher;
+  std::map<std::string, Rbac::Policy> policies;
+  for (int i = 0; i < num_policies; ++i) {
+    std::vector<std::unique_ptr<Rbac::Permission>> tenant;
+    tenant.push_back(
+        MakeHeaderPermission("x-tenant", absl::StrCat("tenant", i)));
+    tenant.push_back(MakeHeaderPermission("x-env", "prod"));
+    std::vector<std::unique_ptr<Rbac::Permission>> permissions;
+    permissions.push_back(MakePathPermission(
+        StringMatcher::Type::kExact, absl::StrCat("/pkg.Service", i, "/Get")));
+    permissions.push_back(
+        MakePathPermission(StringMatcher::Type::kPrefix,
+                           absl::StrCat("/pkg.Service", i, "/List")));
+    permissions.push_back(absl::make_unique<Rbac::Permission>(
+        Rbac::Permission::MakeAndPermission(std::move(tenant))));
+    std::vector<std::unique_ptr<Rbac::Principal>> principals;
+    principals.push_back(absl::make_unique<Rbac::Principal>(
+        Rbac::Principal::MakeAuthenticatedPrincipal(
+            StringMatcher::Create(
+                StringMatcher::Type::kExact,
+                absl::StrCat("spiffe://cluster.local/ns/ns", i, "/sa/default"))
+                .value())));
+    principals.push_back(absl::make_unique<Rbac::Principal>(
+        Rbac::Principal::MakeSourceIpPrincipal(Rbac::CidrRange(
+            absl::StrCat("10.", i / 256, ".", i % 256, ".0"), 24))));
+    policies[absl::StrCat("policy", i)] = Rbac::Policy(
+        Rbac::Permission::MakeOrPermission(std::move(permissions)),
+        Rbac::Principal::MakeOrPrincipal(std::move(principals)));
+  }
+  return policies;
+}
+
+// A call from the caller that the last of num_policies policies allows.
+class Call {
+ public:
+  explicit Call(int num_policies)
+      : endpoint_(
+            "ipv4:10.0.0.1:443",
+            absl::StrCat("ipv4:10.", (num_policies - 1) / 256, ".",
+                         (num_policies - 1) % 256, ".7:12345")) {
+    auth_context_.add_cstring_property(
+        GRPC_TRANSPORT_SECURITY_TYPE_PROPERTY_NAME,
+        GRPC_TLS_TRANSPORT_SECURITY_TYPE);
+    peer_uri_ = absl::StrCat("spiffe://cluster.local/ns/ns", num_policies - 1,
+                             "/sa/default");
+    auth_context_.add_cstring_property(GRPC_PEER_URI_PROPERTY_NAME,
+                                       peer_uri_.c_str());
+    path_ = absl::StrCat("/pkg.Service", num_policies - 1, "/Get");
+    auto on_error = [](absl::string_view, const grpc_core::Slice&) { abort(); };
+    metadata_.Append(":path", grpc_core::Slice::FromCopiedString(path_),
+                     on_error);
+    metadata_.Append("x-tenant", grpc_core::Slice::FromStaticString("none"),
+                     on_error);
+    metadata_.Append("x-env", grpc_core::Slice::FromStaticString("prod"),
+                     on_error);
+  }
+
+  grpc_core::EvaluateArgs::PerChannelArgs NewConnection() {
+    return grpc_core::EvaluateArgs::PerChannelArgs(&auth_context_,
+                                                    &endpoint_);
+  }
+
+  grpc_metadata_batch* metadata() { return &metadata_; }
+
+ private:
+  grpc_core::MemoryAllocator allocator_ =
+      grpc_core::ResourceQuota::Default()
+          ->memory_quota()
+          ->CreateMemoryAllocator("bm_rbac");
+  grpc_core::ScopedArenaPtr arena_ =
+      grpc_core::MakeScopedArena(1024, &allocator_);
+  grpc_metadata_batch metadata_{arena_.get()};
+  grpc_core::MockAuthorizationEndpoint endpoint_;
+  grpc_auth_context auth_context_{nullptr};
+  std::string peer_uri_;
+  std::string path_;
+};
+
+// The per-call work before the engine was compiled: walk every policy's
+// matcher tree.
+static void BM_MatcherTree(benchmark::State& state) {
+  std::vector<std::unique_ptr<grpc_core::AuthorizationMatcher>> matchers;
+  for (auto& p : MakePolicies(state.range(0))) {
+    matchers.push_back(absl::make_unique<grpc_core::PolicyAuthorizationMatcher>(
+        std::move(p.second)));
+  }
+  Call call(state.range(0));
+  grpc_core::EvaluateArgs::PerChannelArgs connection = call.NewConnection();
+  grpc_core::EvaluateArgs args(call.metadata(), &connection);
+  for (auto _ : state) {
+    bool matched = false;
+    for (const auto& matcher : matchers) {
+      if (matcher->Matches(args)) {
+        matched = true;
+        break;
+      }
+    }
+    GPR_ASSERT(matched);
+  }
+}
+BENCHMARK(BM_MatcherTree)->Arg(30)->Arg(300);
+
+// A call on a connection whose state the engine has already cached.
+static void BM_CompiledEngine(benchmark::State& state) {
+  grpc_core::GrpcAuthorizationEngine engine(grpc_core::Rbac(
+      grpc_core::Rbac::Action::kAllow, MakePolicies(state.range(0))));
+  Call call(state.range(0));
+  grpc_core::EvaluateArgs::PerChannelArgs connection = call.NewConnection();
+  grpc_core::EvaluateArgs args(call.metadata(), &connection);
+  for (auto _ : state) {
+    GPR_ASSERT(engine.Evaluate(args).type ==
+               grpc_core::AuthorizationEngine::Decision::Type::kAllow);
+  }
+}
+BENCHMARK(BM_CompiledEngine)->Arg(30)->Arg(300);
+
+// The first call on a connection, which also evaluates the connection.
+static void BM_CompiledEngineFirstCall(benchmark::State& state) {
+  grpc_core::GrpcAuthorizationEngine engine(grpc_core::Rbac(
+      grpc_core::Rbac::Action::kAllow, MakePolicies(state.range(0))));
+  Call call(state.range(0));
+  grpc_core::EvaluateArgs::PerChannelArgs connection = call.NewConnection();
+  for (auto _ : state) {
+    connection.cache =
+        std::make_shared<grpc_core::EvaluateArgs::ConnectionCache>();
+    grpc_core::EvaluateArgs args(call.metadata(), &connection);
+    GPR_ASSERT(engine.Evaluate(args).type ==
+               grpc_core::AuthorizationEngine::Decision::Type::kAllow);
+  }
+}
+BENCHMARK(BM_CompiledEngineFirstCall)->Arg(30)->Arg(300);
+
+// Some distros have RunSpecifiedBenchmarks under the benchmark namespace,
+// and others do not. This allows us to support both modes.
+namespace benchmark {
+void RunTheBenchmarksNamespaced() { RunSpecifiedBenchmarks(); }
+}  // namespace benchmark
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(&argc, argv);
+  LibraryInitializer libInit;
+  ::benchmark::Initialize(&argc, argv);
+  grpc::testing::InitTest(&argc, &argv, false);
+  benchmark::RunTheBenchmarksNamespaced();
+  return 0;
+}
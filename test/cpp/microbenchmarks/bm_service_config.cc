@@ -0,0 +1,202 @@
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/* Benchmark service config updates applied to many channels */
+
+#include <benchmark/benchmark.h>
+
+#include <string>
+#include <vector>
+
+#include "absl/base/thread_annotations.h"
+#include "absl/memory/memory.h"
+#include "absl/strings/str_cat.h"
+
+#include <grpc/grpc.h>
+#include <grpc/grpc_security.h>
+
+#include "src/core/lib/channel/channel_args.h"
+#include "src/core/lib/config/core_configuration.h"
+#include "src/core/lib/gprpp/orphanable.h"
+#include "src/core/lib/gprpp/ref_counted_ptr.h"
+#include "src/core/lib/gprpp/sync.h"
+#include "src/core/lib/json/json.h"
+#include "src/core/lib/resolver/resolver.h"
+#include "src/core/lib/resolver/resolver_factory.h"
+#include "src/core/lib/resolver/resolver_registry.h"
+#include "src/core/lib/service_config/service_config.h"
+#include "src/core/lib/service_config/service_config_impl.h"
+#include "test/core/util/test_config.h"
+#include "test/cpp/microbenchmarks/helpers.h"
+#include "test/cpp/util/test_config.h"
+
+// The kind of service config a DNS TXT record carries: a retry policy for
+// each of a handful of services.
+static std::string ServiceConfigJson() {
+  std::string json =
+      "{\"loadBalancingConfig\": [{\"round_robin\": {}}], "
+      "\"methodConfig\": [";
+  for (int i = 0; i < 16; i++) {
+    if (i > 0) json += ", ";
+    absl::StrAppend(
+        &json, "{\"name\": [{\"service\": \"grpc.testing.Service", i,
+        "\"}], \"waitForReady\": true, \"timeout\": \"1.5s\", "
+        "\"retryPolicy\": {\"maxAttempts\": 3, \"initialBackoff\": \"0.1s\", "
+        "\"maxBackoff\": \"10s\", \"backoffMultiplier\": 1.6, "
+        "\"retryableStatusCodes\": [\"UNAVAILABLE\"]}}");
+  }
+  json += "]}";
+  return json;
+}
+
+static grpc_core::Mutex g_mu;
+static std::vector<grpc_channel_args*> g_resolver_args ABSL_GUARDED_BY(g_mu);
+
+// Keeps a copy of the channel args that a client channel gives its resolver,
+// which are the args resolvers create service configs with.
+class ArgsCapturingResolver : public grpc_core::Resolver {
+ public:
+  explicit ArgsCapturingResolver(const grpc_channel_args* args) {
+    grpc_core::MutexLock lock(&g_mu);
+    g_resolver_args.push_back(grpc_channel_args_copy(args));
+  }
+
+  void StartLocked() override {}
+  void ShutdownLocked() override {}
+};
+
+class ArgsCapturingResolverFactory : public grpc_core::ResolverFactory {
+ public:
+  absl::string_view scheme() const override { return "capture"; }
+
+  bool IsValidUri(const grpc_core::URI& /*uri*/) const override {
+    return true;
+  }
+
+  grpc_core::OrphanablePtr<grpc_core::Resolver> CreateResolver(
+      grpc_core::ResolverArgs args) const override {
+    return grpc_core::MakeOrphanable<ArgsCapturingResolver>(args.args);
+  }
+};
+
+// Returns the resolver args of two client channels to the same target.  Each
+// carries its own channel's channelz node.
+static const std::vector<grpc_channel_args*>& ClientChannelResolverArgs() {
+  static const std::vector<grpc_channel_args*>* resolver_args = [] {
+    grpc_channel_credentials* creds = grpc_insecure_credentials_create();
+    grpc_channel* channels[2];
+    for (grpc_channel*& channel : channels) {
+      channel = grpc_channel_create("capture:///server", creds, nullptr);
+      // Leaving IDLE creates the channel's resolver.
+      grpc_channel_check_connectivity_state(channel, /*try_to_connect=*/1);
+    }
+    grpc_channel_credentials_release(creds);
+    const gpr_timespec deadline = grpc_timeout_seconds_to_deadline(10);
+    auto* args = new std::vector<grpc_channel_args*>();
+    while (args->empty()) {
+      {
+        grpc_core::MutexLock lock(&g_mu);
+        if (g_resolver_args.size() == 2) *args = std::move(g_resolver_args);
+      }
+      GPR_ASSERT(gpr_time_cmp(gpr_now(GPR_CLOCK_MONOTONIC), deadline) < 0);
+      gpr_sleep_until(grpc_timeout_milliseconds_to_deadline(1));
+    }
+    for (grpc_channel* channel : channels) grpc_channel_destroy(channel);
+    return args;
+  }();
+  return *resolver_args;
+}
+
+// Each channel holds on to its current service config and, as the client
+// channel does, only applies an update whose config differs from it.  The
+// channels alternate between the resolver args of two real client channels.
+template <typename CreateFn>
+static void RunIdenticalUpdates(benchmark::State& state, CreateFn create) {
+  const std::vector<grpc_channel_args*>& resolver_args =
+      ClientChannelResolverArgs();
+  std::string json = ServiceConfigJson();
+  std::vector<grpc_core::RefCountedPtr<grpc_core::ServiceConfig>> channels(
+      state.range(0));
+  for (size_t i = 0; i < channels.size(); ++i) {
+    channels[i] = create(resolver_args[i % 2], json);
+  }
+  int64_t changed = 0;
+  for (auto _ : state) {
+    for (size_t i = 0; i < channels.size(); ++i) {
+      auto& saved = channels[i];
+      auto service_config = create(resolver_args[i % 2], json);
+      if (service_config != saved &&
+          service_config->json_string() != saved->json_string()) {
+        saved = std::move(service_config);
+        ++changed;
+      }
+    }
+  }
+  GPR_ASSERT(changed == 0);
+  state.SetItemsProcessed(state.iterations() * channels.size());
+}
+
+static void BM_ServiceConfigCreate(benchmark::State& state) {
+  auto create = [](const grpc_channel_args* args, const std::string& json) {
+    grpc_error_handle error = GRPC_ERROR_NONE;
+    auto service_config =
+        grpc_core::ServiceConfigImpl::Create(args, json, &error);
+    GPR_ASSERT(error == GRPC_ERROR_NONE);
+    return service_config;
+  };
+  // The two client channels must share a single config.
+  const std::vector<grpc_channel_args*>& resolver_args =
+      ClientChannelResolverArgs();
+  std::string json = ServiceConfigJson();
+  GPR_ASSERT(create(resolver_args[0], json) == create(resolver_args[1], json));
+  RunIdenticalUpdates(state, create);
+}
+BENCHMARK(BM_ServiceConfigCreate)->Range(1, 1000);
+
+// Parses every update from scratch, as Create() did before service configs
+// were shared.
+static void BM_ServiceConfigParse(benchmark::State& state) {
+  RunIdenticalUpdates(state, [](const grpc_channel_args* args,
+                                const std::string& json) {
+    grpc_error_handle error = GRPC_ERROR_NONE;
+    grpc_core::Json parsed = grpc_core::Json::Parse(json, &error);
+    GPR_ASSERT(error == GRPC_ERROR_NONE);
+    grpc_core::RefCountedPtr<grpc_core::ServiceConfig> service_config =
+        grpc_core::MakeRefCounted<grpc_core::ServiceConfigImpl>(
+            args, json, std::move(parsed), &error);
+    GPR_ASSERT(error == GRPC_ERROR_NONE);
+    return service_config;
+  });
+}
+BENCHMARK(BM_ServiceConfigParse)->Range(1, 1000);
+
+// Some distros have RunSpecifiedBenchmarks under the benchmark namespace,
+// and others do not. This allows us to support both modes.
+namespace benchmark {
+void RunTheBenchmarksNamespaced() { RunSpecifiedBenchmarks(); }
+}  // namespace benchmark
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(&argc, argv);
+  grpc_core::CoreConfiguration::RegisterBuilder(
+      [](grpc_core::CoreConfiguration::Builder* builder) {
+        builder->resolver_registry()->RegisterResolverFactory(
+            absl::make_unique<ArgsCapturingResolverFactory>());
+      });
+  LibraryInitializer libInit;
+  ::benchmark::Initialize(&argc, argv);
+  grpc::testing::InitTest(&argc, &argv, false);
+  benchmark::RunTheBenchmarksNamespaced();
+  return 0;
+}
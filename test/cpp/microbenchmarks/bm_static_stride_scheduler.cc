@@ -0,0 +1,84 @@
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/* Benchmark the weighted_round_robin pick path, with threads contending
+   on one scheduler, as the number of backends grows */
+
+#include <benchmark/benchmark.h>
+
+#include <map>
+#include <memory>
+#include <vector>
+
+#include "src/core/ext/filters/client_channel/lb_policy/weighted_round_robin/static_stride_scheduler.h"
+#include "src/core/lib/gprpp/sync.h"
+#include "test/core/util/test_config.h"
+#include "test/cpp/microbenchmarks/helpers.h"
+#include "test/cpp/util/test_config.h"
+
+// Returns a scheduler shared by all benchmark threads, with weights that
+// vary tenfold across the backends.
+static grpc_core::StaticStrideScheduler* GetScheduler(size_t num_backends) {
+  static auto* mu = new grpc_core::Mutex();
+  static auto* schedulers =
+      new std::map<size_t, std::unique_ptr<grpc_core::StaticStrideScheduler>>();
+  grpc_core::MutexLock lock(mu);
+  auto& scheduler = (*schedulers)[num_backends];
+  if (scheduler == nullptr) {
+    std::vector<float> weights;
+    for (size_t i = 0; i < num_backends; ++i) {
+      weights.push_back(1 + 9.0f * i / num_backends);
+    }
+    scheduler = grpc_core::StaticStrideScheduler::Make(weights, 0);
+  }
+  return scheduler.get();
+}
+
+static void BM_StaticStrideSchedulerPick(benchmark::State& state) {
+  grpc_core::StaticStrideScheduler* scheduler = GetScheduler(state.range(0));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(scheduler->Pick());
+  }
+}
+BENCHMARK(BM_StaticStrideSchedulerPick)
+    ->RangeMultiplier(10)
+    ->Range(10, 1000)
+    ->ThreadRange(1, 8);
+
+static void BM_StaticStrideSchedulerMake(benchmark::State& state) {
+  std::vector<float> weights;
+  for (int i = 0; i < state.range(0); ++i) {
+    weights.push_back(1 + 9.0f * i / state.range(0));
+  }
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(
+        grpc_core::StaticStrideScheduler::Make(weights, 0));
+  }
+}
+BENCHMARK(BM_StaticStrideSchedulerMake)->RangeMultiplier(10)->Range(10, 1000);
+
+// Some distros have RunSpecifiedBenchmarks under the benchmark namespace,
+// and others do not. This allows us to support both modes.
+namespace benchmark {
+void RunTheBenchmarksNamespaced() { RunSpecifiedBenchmarks(); }
+}  // namespace benchmark
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(&argc, argv);
+  LibraryInitializer libInit;
+  ::benchmark::Initialize(&argc, argv);
+  grpc::testing::InitTest(&argc, &argv, false);
+  benchmark::RunTheBenchmarksNamespaced();
+  return 0;
+}
@@ -0,0 +1,125 @@
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/* Benchmark subchannel key creation and lookup at EDS update scale */
+
+#include <benchmark/benchmark.h>
+
+#include <string>
+#include <vector>
+
+#include "absl/container/flat_hash_map.h"
+#include "absl/strings/str_cat.h"
+
+#include "src/core/ext/filters/client_channel/subchannel_pool_interface.h"
+#include "src/core/lib/address_utils/parse_address.h"
+#include "src/core/lib/channel/channel_args.h"
+#include "src/core/lib/iomgr/resolved_address.h"
+#include "src/core/lib/uri/uri_parser.h"
+#include "test/core/util/test_config.h"
+#include "test/cpp/microbenchmarks/helpers.h"
+#include "test/cpp/util/test_config.h"
+
+// Channel args of the size a channel typically hands its subchannels: a
+// handful of each type, in no particular order.
+class SubchannelArgs {
+ public:
+  SubchannelArgs() {
+    for (int i = 0; i < 8; i++) {
+      keys_.push_back(absl::StrCat("grpc.bm.string_arg_", 8 - i));
+      values_.push_back(absl::StrCat("value_", i));
+      keys_.push_back(absl::StrCat("grpc.bm.int_arg_", i));
+    }
+    for (int i = 0; i < 8; i++) {
+      args_.push_back(
+          grpc_channel_arg_string_create(&keys_[2 * i][0], &values_[i][0]));
+      args_.push_back(grpc_channel_arg_integer_create(&keys_[2 * i + 1][0], i));
+    }
+    c_args_ = {args_.size(), args_.data()};
+  }
+
+  const grpc_channel_args* get() const { return &c_args_; }
+
+ private:
+  std::vector<std::string> keys_;
+  std::vector<std::string> values_;
+  std::vector<grpc_arg> args_;
+  grpc_channel_args c_args_;
+};
+
+static std::vector<grpc_resolved_address> Addresses(int n) {
+  std::vector<grpc_resolved_address> addresses(n);
+  for (int i = 0; i < n; i++) {
+    auto uri = grpc_core::URI::Parse(
+        absl::StrCat("ipv4:10.", i / 65536, ".", i / 256 % 256, ".", i % 256,
+                     ":443"));
+    GPR_ASSERT(uri.ok());
+    GPR_ASSERT(grpc_parse_uri(*uri, &addresses[i]));
+  }
+  return addresses;
+}
+
+// Builds a key per endpoint, as each subchannel creation does.
+static void BM_SubchannelKeyCreate(benchmark::State& state) {
+  SubchannelArgs args;
+  auto addresses = Addresses(state.range(0));
+  for (auto _ : state) {
+    for (const auto& address : addresses) {
+      grpc_core::SubchannelKey key(address, args.get());
+      benchmark::DoNotOptimize(key);
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * addresses.size());
+}
+BENCHMARK(BM_SubchannelKeyCreate)->Range(1, 10000);
+
+// Replaces a pool's worth of subchannels with the next EDS update's: every
+// endpoint is looked up, then registered, against a pool already holding the
+// previous update's endpoints.
+static void BM_SubchannelPoolChurn(benchmark::State& state) {
+  SubchannelArgs args;
+  auto addresses = Addresses(state.range(0));
+  absl::flat_hash_map<grpc_core::SubchannelKey, int> pool;
+  for (const auto& address : addresses) {
+    pool.emplace(grpc_core::SubchannelKey(address, args.get()), 0);
+  }
+  for (auto _ : state) {
+    for (const auto& address : addresses) {
+      grpc_core::SubchannelKey key(address, args.get());
+      auto it = pool.find(key);
+      if (it == pool.end()) {
+        pool.emplace(key, 0);
+      } else {
+        ++it->second;
+      }
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * addresses.size());
+}
+BENCHMARK(BM_SubchannelPoolChurn)->Range(1, 10000);
+
+// Some distros have RunSpecifiedBenchmarks under the benchmark namespace,
+// and others do not. This allows us to support both modes.
+namespace benchmark {
+void RunTheBenchmarksNamespaced() { RunSpecifiedBenchmarks(); }
+}  // namespace benchmark
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(&argc, argv);
+  LibraryInitializer libInit;
+  ::benchmark::Initialize(&argc, argv);
+  grpc::testing::InitTest(&argc, &argv, false);
+  benchmark::RunTheBenchmarksNamespaced();
+  return 0;
+}
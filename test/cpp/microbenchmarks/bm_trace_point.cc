@@ -0,0 +1,87 @@
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/* Benchmark the overhead trace points add to the code they cover, at
+   several sampling periods */
+
+#include <benchmark/benchmark.h>
+
+#include "src/core/lib/profiling/trace_point.h"
+#include "test/core/util/test_config.h"
+#include "test/cpp/microbenchmarks/helpers.h"
+#include "test/cpp/util/test_config.h"
+
+namespace grpc_core {
+namespace {
+
+void BM_NoTracePoint(benchmark::State& state) {
+  int x = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(++x);
+  }
+}
+BENCHMARK(BM_NoTracePoint)->ThreadRange(1, 16);
+
+// state.range(0) is the sampling period; 0 turns sampling off.
+void BM_TracePointScope(benchmark::State& state) {
+  if (state.thread_index() == 0) {
+    ContinuousProfiler::SetSamplePeriod(state.range(0));
+  }
+  int x = 0;
+  for (auto _ : state) {
+    GRPC_TRACE_POINT_SCOPE("bm_trace_point");
+    benchmark::DoNotOptimize(++x);
+  }
+  if (state.thread_index() == 0) {
+    ContinuousProfiler::SetSamplePeriod(
+        ContinuousProfiler::kDefaultSamplePeriod);
+  }
+}
+BENCHMARK(BM_TracePointScope)
+    ->Arg(0)
+    ->Arg(1000)
+    ->Arg(100)
+    ->Arg(1)
+    ->ThreadRange(1, 16);
+
+// What reading the profile costs, with every thread's ring full.
+void BM_DumpChromeTraceJson(benchmark::State& state) {
+  ContinuousProfiler::SetSamplePeriod(1);
+  for (size_t i = 0; i < ContinuousProfiler::kRingSize; ++i) {
+    GRPC_TRACE_POINT_SCOPE("bm_trace_point");
+  }
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(ContinuousProfiler::DumpChromeTraceJson());
+  }
+  ContinuousProfiler::SetSamplePeriod(ContinuousProfiler::kDefaultSamplePeriod);
+}
+BENCHMARK(BM_DumpChromeTraceJson);
+
+}  // namespace
+}  // namespace grpc_core
+
+// Some distros have RunSpecifiedBenchmarks under the benchmark namespace,
+// and others do not. This allows us to support both modes.
+namespace benchmark {
+void RunTheBenchmarksNamespaced() { RunSpecifiedBenchmarks(); }
+}  // namespace benchmark
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(&argc, argv);
+  LibraryInitializer libInit;
+  ::benchmark::Initialize(&argc, argv);
+  grpc::testing::InitTest(&argc, &argv, false);
+  benchmark::RunTheBenchmarksNamespaced();
+  return 0;
+}
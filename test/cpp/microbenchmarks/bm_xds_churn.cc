@@ -0,0 +1,216 @@
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/* Benchmark the client's cost of one CDS change, with state-of-the-world and
+   delta ADS, as the number of subscribed clusters grows */
+
+#include <benchmark/benchmark.h>
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include "absl/strings/str_cat.h"
+#include "envoy/config/cluster/v3/cluster.upb.h"
+#include "envoy/config/core/v3/config_source.upb.h"
+#include "envoy/service/discovery/v3/discovery.upb.h"
+#include "google/protobuf/any.upb.h"
+#include "upb/def.hpp"
+#include "upb/upb.hpp"
+
+#include <grpc/slice.h>
+
+#include "src/core/ext/xds/upb_utils.h"
+#include "src/core/ext/xds/xds_api.h"
+#include "src/core/ext/xds/xds_bootstrap.h"
+#include "src/core/ext/xds/xds_cluster.h"
+#include "src/core/lib/debug/trace.h"
+#include "src/core/lib/slice/slice_internal.h"
+#include "test/core/util/test_config.h"
+#include "test/cpp/microbenchmarks/helpers.h"
+#include "test/cpp/util/test_config.h"
+
+static grpc_core::TraceFlag bm_xds_trace(false, "bm_xds_churn");
+
+static constexpr char kClusterTypeUrl[] =
+    "type.googleapis.com/envoy.config.cluster.v3.Cluster";
+
+// Decodes every resource in a response, as the XdsClient does.
+class ClusterDecoder : public grpc_core::XdsApi::AdsResponseParserInterface {
+ public:
+  absl::Status ProcessAdsResponseFields(AdsResponseFields /*fields*/) override {
+    return absl::OkStatus();
+  }
+
+  void ParseResource(const grpc_core::XdsEncodingContext& context,
+                     size_t /*idx*/, absl::string_view /*type_url*/,
+                     absl::string_view /*version*/,
+                     absl::string_view serialized_resource) override {
+    auto result = grpc_core::XdsClusterResourceType::Get()->Decode(
+        context, serialized_resource, /*is_v2=*/false);
+    GPR_ASSERT(result.ok() && result->resource.ok());
+    benchmark::DoNotOptimize(result);
+  }
+
+  void RemoveResource(absl::string_view /*resource_name*/) override {}
+};
+
+// An XdsApi, and the clusters the client is subscribed to.
+class Fixture {
+ public:
+  Fixture(int num_clusters, bool delta) {
+    server_.server_uri = "fake:///xds";
+    server_.channel_creds_type = "fake";
+    server_.server_features.insert("xds_v3");
+    if (delta) server_.server_features.insert("xds_delta");
+    grpc_core::XdsClusterResourceType::Get()->InitUpbSymtab(symtab_.ptr());
+    for (int i = 0; i < num_clusters; i++) {
+      names_.push_back(absl::StrCat("cluster_", i));
+      clusters_.push_back(SerializeCluster(names_.back()));
+    }
+  }
+
+  const grpc_core::XdsBootstrap::XdsServer& server() const { return server_; }
+  grpc_core::XdsApi* api() { return &api_; }
+  const std::vector<std::string>& names() const { return names_; }
+  const std::vector<std::string>& clusters() const { return clusters_; }
+
+ private:
+  std::string SerializeCluster(const std::string& name) {
+    auto* cluster = envoy_config_cluster_v3_Cluster_new(arena_.ptr());
+    envoy_config_cluster_v3_Cluster_set_name(
+        cluster, grpc_core::StdStringToUpbString(name));
+    envoy_config_cluster_v3_Cluster_set_type(
+        cluster, envoy_config_cluster_v3_Cluster_EDS);
+    auto* eds_cluster_config =
+        envoy_config_cluster_v3_Cluster_mutable_eds_cluster_config(
+            cluster, arena_.ptr());
+    auto* eds_config =
+        envoy_config_cluster_v3_Cluster_EdsClusterConfig_mutable_eds_config(
+            eds_cluster_config, arena_.ptr());
+    envoy_config_core_v3_ConfigSource_mutable_ads(eds_config, arena_.ptr());
+    size_t length;
+    char* bytes = envoy_config_cluster_v3_Cluster_serialize(
+        cluster, arena_.ptr(), &length);
+    return std::string(bytes, length);
+  }
+
+  upb::Arena arena_;
+  upb::SymbolTable symtab_;
+  grpc_core::XdsBootstrap::XdsServer server_;
+  grpc_core::CertificateProviderStore::PluginDefinitionMap
+      certificate_provider_definition_map_;
+  grpc_core::XdsApi api_{nullptr, &bm_xds_trace, nullptr,
+                         &certificate_provider_definition_map_, &symtab_};
+  std::vector<std::string> names_;
+  std::vector<std::string> clusters_;
+};
+
+// A state-of-the-world response carries every subscribed cluster, and its
+// ACK restates every name.
+static void BM_SotwClusterChange(benchmark::State& state) {
+  Fixture fixture(state.range(0), /*delta=*/false);
+  upb::Arena arena;
+  auto* response =
+      envoy_service_discovery_v3_DiscoveryResponse_new(arena.ptr());
+  envoy_service_discovery_v3_DiscoveryResponse_set_type_url(
+      response, upb_StringView_FromString(kClusterTypeUrl));
+  envoy_service_discovery_v3_DiscoveryResponse_set_version_info(
+      response, upb_StringView_FromString("2"));
+  envoy_service_discovery_v3_DiscoveryResponse_set_nonce(
+      response, upb_StringView_FromString("2"));
+  for (const std::string& cluster : fixture.clusters()) {
+    auto* any = envoy_service_discovery_v3_DiscoveryResponse_add_resources(
+        response, arena.ptr());
+    google_protobuf_Any_set_type_url(
+        any, upb_StringView_FromString(kClusterTypeUrl));
+    google_protobuf_Any_set_value(any,
+                                  grpc_core::StdStringToUpbString(cluster));
+  }
+  size_t length;
+  char* bytes = envoy_service_discovery_v3_DiscoveryResponse_serialize(
+      response, arena.ptr(), &length);
+  grpc_slice encoded = grpc_slice_from_copied_buffer(bytes, length);
+  for (auto _ : state) {
+    ClusterDecoder decoder;
+    GPR_ASSERT(fixture.api()
+                   ->ParseAdsResponse(fixture.server(), encoded, &decoder)
+                   .ok());
+    grpc_slice ack = fixture.api()->CreateAdsRequest(
+        fixture.server(), "envoy.config.cluster.v3.Cluster", "2", "2",
+        fixture.names(), GRPC_ERROR_NONE, /*populate_node=*/false);
+    grpc_slice_unref_internal(ack);
+  }
+  grpc_slice_unref_internal(encoded);
+  state.counters["response_bytes"] = length;
+}
+BENCHMARK(BM_SotwClusterChange)->RangeMultiplier(10)->Range(10, 10000);
+
+// A delta response carries only the cluster that changed, and its ACK
+// changes no subscriptions.
+static void BM_DeltaClusterChange(benchmark::State& state) {
+  Fixture fixture(state.range(0), /*delta=*/true);
+  upb::Arena arena;
+  auto* response =
+      envoy_service_discovery_v3_DeltaDiscoveryResponse_new(arena.ptr());
+  envoy_service_discovery_v3_DeltaDiscoveryResponse_set_type_url(
+      response, upb_StringView_FromString(kClusterTypeUrl));
+  envoy_service_discovery_v3_DeltaDiscoveryResponse_set_nonce(
+      response, upb_StringView_FromString("2"));
+  auto* resource =
+      envoy_service_discovery_v3_DeltaDiscoveryResponse_add_resources(
+          response, arena.ptr());
+  envoy_service_discovery_v3_Resource_set_name(
+      resource, grpc_core::StdStringToUpbString(fixture.names()[0]));
+  envoy_service_discovery_v3_Resource_set_version(
+      resource, upb_StringView_FromString("2"));
+  auto* any = envoy_service_discovery_v3_Resource_mutable_resource(
+      resource, arena.ptr());
+  google_protobuf_Any_set_type_url(any,
+                                   upb_StringView_FromString(kClusterTypeUrl));
+  google_protobuf_Any_set_value(
+      any, grpc_core::StdStringToUpbString(fixture.clusters()[0]));
+  size_t length;
+  char* bytes = envoy_service_discovery_v3_DeltaDiscoveryResponse_serialize(
+      response, arena.ptr(), &length);
+  grpc_slice encoded = grpc_slice_from_copied_buffer(bytes, length);
+  for (auto _ : state) {
+    ClusterDecoder decoder;
+    GPR_ASSERT(fixture.api()
+                   ->ParseDeltaAdsResponse(fixture.server(), encoded, &decoder)
+                   .ok());
+    grpc_slice ack = fixture.api()->CreateDeltaAdsRequest(
+        fixture.server(), "envoy.config.cluster.v3.Cluster", "2", {}, {}, {},
+        GRPC_ERROR_NONE, /*populate_node=*/false);
+    grpc_slice_unref_internal(ack);
+  }
+  grpc_slice_unref_internal(encoded);
+  state.counters["response_bytes"] = length;
+}
+BENCHMARK(BM_DeltaClusterChange)->RangeMultiplier(10)->Range(10, 10000);
+
+// Some distros have RunSpecifiedBenchmarks under the benchmark namespace,
+// and others do not. This allows us to support both modes.
+namespace benchmark {
+void RunTheBenchmarksNamespaced() { RunSpecifiedBenchmarks(); }
+}  // namespace benchmark
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(&argc, argv);
+  LibraryInitializer libInit;
+  ::benchmark::Initialize(&argc, argv);
+  grpc::testing::InitTest(&argc, &argv, false);
+  benchmark::RunTheBenchmarksNamespaced();
+  return 0;
+}
@@ -0,0 +1,215 @@
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/* Benchmark xDS route and virtual host matching as route configs grow */
+
+#include <benchmark/benchmark.h>
+
+#include <string>
+#include <vector>
+
+#include "absl/strings/str_cat.h"
+
+#include "src/core/ext/xds/xds_routing.h"
+#include "src/core/lib/resource_quota/arena.h"
+#include "src/core/lib/resource_quota/resource_quota.h"
+#include "src/core/lib/transport/metadata_batch.h"
+#include "test/core/util/test_config.h"
+#include "test/cpp/microbenchmarks/helpers.h"
+#include "test/cpp/util/test_config.h"
+
+using Matchers = grpc_core::XdsRouteConfigResource::Route::Matchers;
+
+class MatchersListIterator : public grpc_core::XdsRouting::RouteListIterator {
+ public:
+  explicit MatchersListIterator(const std::vector<Matchers>* routes)
+      : routes_(routes) {}
+
+  size_t Size() const override { return routes_->size(); }
+
+  const Matchers& GetMatchersForRoute(size_t index) const override {
+    return (*routes_)[index];
+  }
+
+ private:
+  const std::vector<Matchers>* routes_;
+};
+
+// A route table of num_routes routes, cycling through an exact path, a
+// service prefix, a regex and an exact path with a header matcher, each for
+// its own service.  The request matches only the last route.
+class Fixture {
+ public:
+  explicit Fixture(int num_routes) {
+    auto header_matcher = grpc_core::HeaderMatcher::Create(
+        "x-canary", grpc_core::HeaderMatcher::Type::kExact, "true");
+    GPR_ASSERT(header_matcher.ok());
+    for (int i = 0; i < num_routes - 1; ++i) {
+      Matchers matchers;
+      switch (i % 4) {
+        case 0:
+          matchers.path_matcher = *grpc_core::StringMatcher::Create(
+              grpc_core::StringMatcher::Type::kExact,
+              absl::StrCat("/pkg.Service", i, "/Method"));
+          break;
+        case 1:
+          matchers.path_matcher = *grpc_core::StringMatcher::Create(
+              grpc_core::StringMatcher::Type::kPrefix,
+              absl::StrCat("/pkg.Service", i, "/"));
+          break;
+        case 2:
+          matchers.path_matcher = *grpc_core::StringMatcher::Create(
+              grpc_core::StringMatcher::Type::kSafeRegex,
+              absl::StrCat("/pkg\\.Service", i, "/(Get|Set)[A-Z][a-z]*"));
+          break;
+        case 3:
+          matchers.path_matcher = *grpc_core::StringMatcher::Create(
+              grpc_core::StringMatcher::Type::kExact,
+              absl::StrCat("/pkg.Service", i, "/Method"));
+          matchers.header_matchers.push_back(*header_matcher);
+          break;
+      }
+      routes_.push_back(std::move(matchers));
+    }
+    Matchers matchers;
+    matchers.path_matcher = *grpc_core::StringMatcher::Create(
+        grpc_core::StringMatcher::Type::kPrefix, "/pkg.Target/");
+    routes_.push_back(std::move(matchers));
+    metadata_.Append("x-canary", grpc_core::Slice::FromStaticString("false"),
+                     [](absl::string_view, const grpc_core::Slice&) {
+                       abort();
+                     });
+  }
+
+  MatchersListIterator iterator() const {
+    return MatchersListIterator(&routes_);
+  }
+  grpc_metadata_batch* metadata() { return &metadata_; }
+  size_t last_route() const { return routes_.size() - 1; }
+
+ private:
+  grpc_core::MemoryAllocator allocator_ =
+      grpc_core::ResourceQuota::Default()
+          ->memory_quota()
+          ->CreateMemoryAllocator("bm_xds_routing");
+  grpc_core::ScopedArenaPtr arena_ =
+      grpc_core::MakeScopedArena(1024, &allocator_);
+  grpc_metadata_batch metadata_{arena_.get()};
+  std::vector<Matchers> routes_;
+};
+
+static constexpr char kPath[] = "/pkg.Target/Method";
+
+static void BM_LinearRouting(benchmark::State& state) {
+  Fixture fixture(state.range(0));
+  for (auto _ : state) {
+    auto route = grpc_core::XdsRouting::GetRouteForRequest(
+        fixture.iterator(), kPath, fixture.metadata());
+    GPR_ASSERT(route == fixture.last_route());
+  }
+}
+BENCHMARK(BM_LinearRouting)->RangeMultiplier(4)->Range(16, 4096);
+
+static void BM_CompiledRouting(benchmark::State& state) {
+  Fixture fixture(state.range(0));
+  grpc_core::XdsRouting::CompiledRouteList compiled(fixture.iterator());
+  for (auto _ : state) {
+    auto route = compiled.GetRouteForRequest(fixture.iterator(), kPath,
+                                             fixture.metadata());
+    GPR_ASSERT(route == fixture.last_route());
+  }
+}
+BENCHMARK(BM_CompiledRouting)->RangeMultiplier(4)->Range(16, 4096);
+
+static void BM_CompileRoutes(benchmark::State& state) {
+  Fixture fixture(state.range(0));
+  for (auto _ : state) {
+    grpc_core::XdsRouting::CompiledRouteList compiled(fixture.iterator());
+    benchmark::DoNotOptimize(compiled);
+  }
+}
+BENCHMARK(BM_CompileRoutes)->RangeMultiplier(4)->Range(16, 4096);
+
+class DomainsListIterator
+    : public grpc_core::XdsRouting::VirtualHostListIterator {
+ public:
+  explicit DomainsListIterator(
+      const std::vector<std::vector<std::string>>* virtual_hosts)
+      : virtual_hosts_(virtual_hosts) {}
+
+  size_t Size() const override { return virtual_hosts_->size(); }
+
+  const std::vector<std::string>& GetDomainsForVirtualHost(
+      size_t index) const override {
+    return (*virtual_hosts_)[index];
+  }
+
+ private:
+  const std::vector<std::vector<std::string>>* virtual_hosts_;
+};
+
+// num_vhosts virtual hosts, each with an exact and a suffix domain, and a
+// catch-all one.  The domain looked up matches the last suffix.
+static std::vector<std::vector<std::string>> MakeVirtualHosts(
+    int num_vhosts) {
+  std::vector<std::vector<std::string>> virtual_hosts;
+  for (int i = 0; i < num_vhosts - 1; ++i) {
+    virtual_hosts.push_back({absl::StrCat("svc", i, ".mesh.internal"),
+                             absl::StrCat("*.svc", i, ".mesh.internal")});
+  }
+  virtual_hosts.push_back({"*"});
+  return virtual_hosts;
+}
+
+static std::string LookedUpDomain(int num_vhosts) {
+  return absl::StrCat("canary.svc", num_vhosts - 2, ".mesh.internal");
+}
+
+static void BM_LinearVirtualHostLookup(benchmark::State& state) {
+  auto virtual_hosts = MakeVirtualHosts(state.range(0));
+  const std::string domain = LookedUpDomain(state.range(0));
+  for (auto _ : state) {
+    auto vhost = grpc_core::XdsRouting::FindVirtualHostForDomain(
+        DomainsListIterator(&virtual_hosts), domain);
+    GPR_ASSERT(vhost == virtual_hosts.size() - 2);
+  }
+}
+BENCHMARK(BM_LinearVirtualHostLookup)->RangeMultiplier(4)->Range(16, 4096);
+
+static void BM_IndexedVirtualHostLookup(benchmark::State& state) {
+  auto virtual_hosts = MakeVirtualHosts(state.range(0));
+  const std::string domain = LookedUpDomain(state.range(0));
+  DomainsListIterator iterator(&virtual_hosts);
+  grpc_core::XdsVirtualHostIndex index(iterator);
+  for (auto _ : state) {
+    auto vhost = index.Find(domain);
+    GPR_ASSERT(vhost == virtual_hosts.size() - 2);
+  }
+}
+BENCHMARK(BM_IndexedVirtualHostLookup)->RangeMultiplier(4)->Range(16, 4096);
+
+// Some distros have RunSpecifiedBenchmarks under the benchmark namespace,
+// and others do not. This allows us to support both modes.
+namespace benchmark {
+void RunTheBenchmarksNamespaced() { RunSpecifiedBenchmarks(); }
+}  // namespace benchmark
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(&argc, argv);
+  LibraryInitializer libInit;
+  ::benchmark::Initialize(&argc, argv);
+  grpc::testing::InitTest(&argc, &argv, false);
+  benchmark::RunTheBenchmarksNamespaced();
+  return 0;
+}
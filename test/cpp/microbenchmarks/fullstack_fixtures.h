@@ -28,8 +28,10 @@
 #include <grpcpp/server.h>
 #include <grpcpp/server_builder.h>
 
+#include "src/core/ext/filters/fused/fused_filter.h"
 #include "src/core/ext/transport/chttp2/transport/chttp2_transport.h"
 #include "src/core/lib/channel/channel_args.h"
+#include "src/core/lib/channel/channelz.h"
 #include "src/core/lib/iomgr/endpoint.h"
 #include "src/core/lib/iomgr/endpoint_pair.h"
 #include "src/core/lib/iomgr/exec_ctx.h"
@@ -331,6 +333,50 @@ typedef MinStackize<InProcess> MinInProcess;
 typedef MinStackize<SockPair> MinSockPair;
 typedef MinStackize<InProcessCHTTP2> MinInProcessCHTTP2;
 
+// Minimal stacks with adjacent promise based filters fused
+class FusedMinStackConfiguration : public FixtureConfiguration {
+  void ApplyCommonChannelArguments(ChannelArguments* a) const override {
+    a->SetInt(GRPC_ARG_MINIMAL_STACK, 1);
+    a->SetInt(GRPC_ARG_FUSE_FILTERS, 1);
+    FixtureConfiguration::ApplyCommonChannelArguments(a);
+  }
+
+  void ApplyCommonServerBuilderConfig(ServerBuilder* b) const override {
+    b->AddChannelArgument(GRPC_ARG_MINIMAL_STACK, 1);
+    b->AddChannelArgument(GRPC_ARG_FUSE_FILTERS, 1);
+    FixtureConfiguration::ApplyCommonServerBuilderConfig(b);
+  }
+};
+
+template <class Base>
+class FusedMinStackize : public Base {
+ public:
+  explicit FusedMinStackize(Service* service)
+      : Base(service, FusedMinStackConfiguration()) {}
+};
+
+typedef FusedMinStackize<TCP> FusedMinTCP;
+typedef FusedMinStackize<InProcessCHTTP2> FusedMinInProcessCHTTP2;
+
+// Client channels that record per-method call latency histograms
+class MethodLatencyStatsConfiguration : public FixtureConfiguration {
+  void ApplyCommonChannelArguments(ChannelArguments* a) const override {
+    a->SetInt(GRPC_ARG_CHANNELZ_METHOD_LATENCY_STATS, 1);
+    FixtureConfiguration::ApplyCommonChannelArguments(a);
+  }
+};
+
+template <class Base>
+class MethodLatencyStatsize : public Base {
+ public:
+  explicit MethodLatencyStatsize(Service* service)
+      : Base(service, MethodLatencyStatsConfiguration()) {}
+};
+
+typedef MethodLatencyStatsize<TCP> MethodLatencyStatsTCP;
+typedef MethodLatencyStatsize<InProcessCHTTP2>
+    MethodLatencyStatsInProcessCHTTP2;
+
 }  // namespace testing
 }  // namespace grpc
 
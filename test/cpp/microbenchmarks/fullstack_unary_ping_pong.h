@@ -25,8 +25,11 @@
 
 #include <benchmark/benchmark.h>
 
+#include <grpc/support/time.h>
+
 #include "src/core/lib/profiling/timers.h"
 #include "src/proto/grpc/testing/echo.grpc.pb.h"
+#include "test/core/util/histogram.h"
 #include "test/cpp/microbenchmarks/fullstack_context_mutators.h"
 #include "test/cpp/microbenchmarks/fullstack_fixtures.h"
 
@@ -39,7 +42,42 @@ namespace testing {
 
 static void* tag(intptr_t x) { return reinterpret_cast<void*>(x); }
 
-template <class Fixture, class ClientContextMutator, class ServerContextMutator>
+// Call latency recorders for BM_UnaryPingPong.
+
+// Records nothing, so that the benchmark cycle doesn't read the clock.
+class NoCallLatency {
+ public:
+  void CallStarted() {}
+  void CallFinished() {}
+  void Report(benchmark::State& /*state*/) {}
+};
+
+// Reports the median and tail latencies of calls.
+class CallLatencyPercentiles {
+ public:
+  CallLatencyPercentiles() : latency_(grpc_histogram_create(0.01, 60e9)) {}
+  ~CallLatencyPercentiles() { grpc_histogram_destroy(latency_); }
+
+  void CallStarted() { start_ = gpr_now(GPR_CLOCK_MONOTONIC); }
+  void CallFinished() {
+    gpr_timespec elapsed = gpr_time_sub(gpr_now(GPR_CLOCK_MONOTONIC), start_);
+    grpc_histogram_add(latency_, gpr_timespec_to_micros(elapsed) * 1000);
+  }
+  void Report(benchmark::State& state) {
+    state.counters["p50_us"] = grpc_histogram_percentile(latency_, 50) / 1000;
+    state.counters["p99_us"] = grpc_histogram_percentile(latency_, 99) / 1000;
+    state.counters["p999_us"] =
+        grpc_histogram_percentile(latency_, 99.9) / 1000;
+  }
+
+ private:
+  // Per call latency in nanoseconds.
+  grpc_histogram* const latency_;
+  gpr_timespec start_;
+};
+
+template <class Fixture, class ClientContextMutator, class ServerContextMutator,
+          class CallLatency = NoCallLatency>
 static void BM_UnaryPingPong(benchmark::State& state) {
   EchoTestService::AsyncService service;
   std::unique_ptr<Fixture> fixture(new Fixture(&service));
@@ -73,8 +111,10 @@ static void BM_UnaryPingPong(benchmark::State& state) {
                       fixture->cq(), tag(1));
   std::unique_ptr<EchoTestService::Stub> stub(
       EchoTestService::NewStub(fixture->channel()));
+  CallLatency latency;
   for (auto _ : state) {
     GPR_TIMER_SCOPE("BenchmarkCycle", 0);
+    latency.CallStarted();
     recv_response.Clear();
     ClientContext cli_ctx;
     ClientContextMutator cli_ctx_mut(&cli_ctx);
@@ -98,12 +138,14 @@ static void BM_UnaryPingPong(benchmark::State& state) {
       i -= 1 << tagnum;
     }
     GPR_ASSERT(recv_status.ok());
+    latency.CallFinished();
 
     senv->~ServerEnv();
     senv = new (senv) ServerEnv();
     service.RequestEcho(&senv->ctx, &senv->recv_request, &senv->response_writer,
                         fixture->cq(), fixture->cq(), tag(slot));
   }
+  latency.Report(state);
   fixture->Finish(state);
   fixture.reset();
   server_env[0]->~ServerEnv();
@@ -62,6 +62,12 @@ def massage_qps_stats(scenario_result):
             stats[
                 "core_pollset_kick_own_thread"] = massage_qps_stats_helpers.counter(
                     core_stats, "pollset_kick_own_thread")
+            stats["core_busy_polls"] = massage_qps_stats_helpers.counter(
+                core_stats, "busy_polls")
+            stats["core_busy_poll_hits"] = massage_qps_stats_helpers.counter(
+                core_stats, "busy_poll_hits")
+            stats["core_busy_poll_spins"] = massage_qps_stats_helpers.counter(
+                core_stats, "busy_poll_spins")
             stats[
                 "core_histogram_slow_lookups"] = massage_qps_stats_helpers.counter(
                     core_stats, "histogram_slow_lookups")
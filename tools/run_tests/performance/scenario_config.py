@@ -315,6 +315,21 @@ class CXXLanguage(Language):
             server_threads_per_cq=1,
             categories=[SCALABLE])
 
+        # One completion queue per server thread gives each server pollset a
+        # SO_REUSEPORT listener of its own. Compare qps_worker servers run with
+        # GRPC_EPOLL1_SHARDS=0 (one epoll set per core, connections staying on
+        # their listener's pollset) and the default of 1.
+        yield _ping_pong_scenario(
+            'cpp_protobuf_async_unary_qps_unconstrained_1cq_per_thread_insecure',
+            rpc_type='UNARY',
+            client_type='ASYNC_CLIENT',
+            server_type='ASYNC_SERVER',
+            unconstrained_client='async',
+            channels=64,
+            secure=False,
+            server_threads_per_cq=1,
+            categories=[SCALABLE])
+
         for secure in [True, False]:
             secstr = 'secure' if secure else 'insecure'
             smoketest_categories = ([SMOKETEST] if secure else [])